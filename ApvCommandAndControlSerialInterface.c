@@ -558,6 +558,107 @@ void *apvMenuOptionExitOption(void *menuSpecificOption)
 /******************************************************************************/
   } /* end of apvMenuOptionExitOption                                         */
 
+/******************************************************************************/
+/* Target instrumentation functions :                                         */
+/******************************************************************************/
+/* apvDumpComponentStatistics() :                                             */
+/*  --> dumpFile         : the stream to print to                             */
+/*  --> statisticsReport : one "APV_COMPONENT_STATISTICS" response line :     */
+/*                           "C<n> R <messages> <min>/<mean>/<max>"           */
+/*                           "C<n> S <calls> <min>/<mean>/<max>"              */
+/*                           "C<n> H <bin 0> .. <bin 7>"                      */
+/*  <-- dumpError        : error codes                                        */
+/*                                                                            */
+/* - print a target messaging layer components' residency, service time or   */
+/*   service time histogram with the target timer ticks scaled to usecs       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvDumpComponentStatistics(FILE       *dumpFile,
+                                          const char *statisticsReport)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE dumpError                                              = APV_ERROR_CODE_NONE;
+
+  unsigned int   component                                              = 0;
+  char           reportSelect                                           = 0;
+  unsigned long  count                                                  = 0,
+                 minimum                                                = 0,
+                 mean                                                   = 0,
+                 maximum                                                = 0,
+                 bins[APV_COMPONENT_STATISTICS_HISTOGRAM_BINS]          = { 0 };
+  unsigned long  binLimit                                               = 1;
+  int            bin                                                    = 0;
+
+/******************************************************************************/
+
+  if ((dumpFile == NULL) || (statisticsReport == NULL))
+    {
+    dumpError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (sscanf(statisticsReport, "C%u %c", &component, &reportSelect) != 2)
+      {
+      dumpError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      if (reportSelect == 'H')
+        {
+        if (sscanf(statisticsReport, "C%*u H %lu %lu %lu %lu %lu %lu %lu %lu",
+                   &bins[0], &bins[1], &bins[2], &bins[3], &bins[4], &bins[5], &bins[6], &bins[7]) != APV_COMPONENT_STATISTICS_HISTOGRAM_BINS)
+          {
+          dumpError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+          }
+        else
+          {
+          fprintf(dumpFile, "\n Component %2u service time histogram :", component);
+
+          for (bin = 0; bin < APV_COMPONENT_STATISTICS_HISTOGRAM_BINS; bin++)
+            {
+            binLimit = binLimit << APV_COMPONENT_STATISTICS_HISTOGRAM_SHIFT;
+
+            if (bin < (APV_COMPONENT_STATISTICS_HISTOGRAM_BINS - 1))
+              {
+              fprintf(dumpFile, "\n   < %6lu usecs : %lu", binLimit, bins[bin]);
+              }
+            else
+              {
+              fprintf(dumpFile, "\n  >= %6lu usecs : %lu", (binLimit >> APV_COMPONENT_STATISTICS_HISTOGRAM_SHIFT), bins[bin]);
+              }
+            }
+          }
+        }
+      else
+        {
+        if (sscanf(statisticsReport, "C%*u %*c %lu %lu/%lu/%lu", &count, &minimum, &mean, &maximum) != 4)
+          {
+          dumpError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+          }
+        else
+          {
+          fprintf(dumpFile, "\n Component %2u %-9s : %8lu %s min %10.3f mean %10.3f max %10.3f usecs",
+                  component,
+                  (reportSelect == 'R') ? "residency" : "service",
+                  count,
+                  (reportSelect == 'R') ? "messages" : "calls   ",
+                  ((double)minimum) / APV_COMPONENT_STATISTICS_TICKS_PER_US,
+                  ((double)mean)    / APV_COMPONENT_STATISTICS_TICKS_PER_US,
+                  ((double)maximum) / APV_COMPONENT_STATISTICS_TICKS_PER_US);
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(dumpError);
+
+/******************************************************************************/
+  } /* end of apvDumpComponentStatistics                                      */
+
 /******************************************************************************/
 /* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
 /******************************************************************************/
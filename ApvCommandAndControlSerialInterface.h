@@ -73,6 +73,15 @@
 #define APV_MENU_INPUT_PEEK_BUFFERS                32 // the menu input function can examine up to 32 "events" in the console window buffer - these 
                                                       // "events" are not removed from the keyboard buffer until a later blocking call
 
+/******************************************************************************/
+/* Component statistics reports ("APV_COMPONENT_STATISTICS" responses) are in */
+/* target timestamp ticks : ( 84MHz / 2 ) == 42 ticks per microsecond         */
+/******************************************************************************/
+
+#define APV_COMPONENT_STATISTICS_TICKS_PER_US      (42.0)
+#define APV_COMPONENT_STATISTICS_HISTOGRAM_BINS     8
+#define APV_COMPONENT_STATISTICS_HISTOGRAM_SHIFT    2 // each bin is 4x wider than the last
+
 /******************************************************************************/
 /* Type Definitions :                                                         */
 /******************************************************************************/
@@ -165,6 +174,8 @@ extern APV_ERROR_CODE  apvExecuteMenuOptions(HANDLE                        apvMe
                                             const apvScreenDescription_t *apvMenuComponents);
 extern void           *apvMenuOptionRequestArduinoSignOn(void);
 extern void           *apvMenuOptionExitOption(void);
+extern APV_ERROR_CODE  apvDumpComponentStatistics(FILE       *dumpFile,
+                                                 const char *statisticsReport);
 
 /******************************************************************************/
 
@@ -62,7 +62,8 @@ static const char apvSymbolRates[APV_BAUDS_SET][APV_BAUDS_MAXIMUM_SYMBOL_LENGTH]
   APV_BAUD_38400,
   APV_BAUD_57600,
   APV_BAUD_76800,
-  APV_BAUD_115200
+  APV_BAUD_115200,
+  APV_BAUD_230400
   };
 
 // The commands all have prefixes and the sub-fields are tacked onto these
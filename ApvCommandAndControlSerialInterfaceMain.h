@@ -37,9 +37,10 @@
 #define APV_BAUD_57600                   "57600"
 #define APV_BAUD_76800                   "76800"
 #define APV_BAUD_115200                 "115200"
+#define APV_BAUD_230400                 "230400" // the fastest rate the board UART divisor reaches within 2%
 
 #define APV_BAUDS_MAXIMUM_SYMBOL_LENGTH       7
-#define APV_BAUDS_SET                         6
+#define APV_BAUDS_SET                         7
 
 /******************************************************************************/
 /* The RealTerm serial server command prefixes :                              */
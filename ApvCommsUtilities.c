@@ -335,7 +335,8 @@ APV_ERROR_CODE apvRingBufferReportFillState(apvRingBuffer_t *ringBuffer,
 /*  <--> ringBuffer             : pointer to a ring-buffer structure          */
 /*   --> ringBufferTokenType    : [APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  = 1 | */
 /*                                 APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  = 2 | */
-/*                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD = 4]  */
+/*                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD = 4 | */
+/*                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER  = 16]  */
 /*   --> tokens                 : pointer to a transmitting buffer of         */
 /*                                1 { <token> } n                             */
 /*   --> numberOfTokensToLoad   : number of tokens to load                    */
@@ -352,13 +353,16 @@ APV_ERROR_CODE apvRingBufferReportFillState(apvRingBuffer_t *ringBuffer,
 /*   The actual number of requested tokens loaded is returned to the calling  */
 /*   function to make any decision on the fate of overloaded pipes. As a      */
 /*   general principle the ring-buffer should never have to throw outgoing    */
-/*   tokens away and should be sized as such                                  */
+/*   tokens away and should be sized as such.                                 */
+/*   Byte, word and long-word tokens are read from a packed source and zero-  */
+/*   extended into the slots, so a slot never carries stale upper bits.       */
+/*   Pointer tokens fill a whole slot                                         */
 /*                                                                            */
 /******************************************************************************/
 
 uint16_t apvRingBufferLoad(apvRingBuffer_t          *ringBuffer,
                            apvRingBufferTokenType_t  ringBufferTokenType,
-                           uint32_t                 *tokens,
+                           void                     *tokens,
                            uint16_t                  numberOfTokensToLoad,
                            bool                      interruptControl)
   {
@@ -394,38 +398,34 @@ uint16_t apvRingBufferLoad(apvRingBuffer_t          *ringBuffer,
       /* Cast the token pointer for the type of data to be loaded                   */
       /******************************************************************************/
 
-      switch(ringBufferTokenType)
-        {
-        case APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  : ringBufferTokenSize.token8Bits  = (uint8_t *)tokens;
-                                                    break;
-        case APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  : ringBufferTokenSize.token16Bits = (uint16_t *)tokens;
-                                                    break;
-        case APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD : ringBufferTokenSize.token32Bits = (uint32_t *)tokens;
-        default                                   : break;
-        case APV_RING_BUFFER_TOKEN_TYPE_HUGE_WORD : ringBufferTokenSize.token64Bits = (uint64_t *)tokens;
-                                                    break;
-        }
+      ringBufferTokenSize.tokenAny = tokens;
 
       while (numberOfTokensToLoad > 0)
         {
         /******************************************************************************/
         /* Store the tokens according to their type, so lower bit-sized tokens will   */
-        /* be correctly aligned in the (32-bit) ring-buffer element when doing a      */
-        /* multiple token load, drastically reducing the function call overhead       */
+        /* be correctly aligned in the (pointer-width) ring-buffer element when       */
+        /* doing a multiple token load, drastically reducing the call overhead        */
         /******************************************************************************/
 
         switch(ringBufferTokenType)
           {
-          case APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  : *((uint8_t *)ringBuffer->apvCommsRingBufferHead)  = *ringBufferTokenSize.token8Bits;
+          case APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  : *(ringBuffer->apvCommsRingBufferHead)             = (apvRingBufferSlotWidth_t)*ringBufferTokenSize.token8Bits;
                                                        ringBufferTokenSize.token8Bits                   =  ringBufferTokenSize.token8Bits  + 1;
                                                       break;
 
-          case APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  : *((uint16_t *)ringBuffer->apvCommsRingBufferHead) = *ringBufferTokenSize.token16Bits;
+          case APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  : *(ringBuffer->apvCommsRingBufferHead)             = (apvRingBufferSlotWidth_t)*ringBufferTokenSize.token16Bits;
                                                        ringBufferTokenSize.token16Bits                  =  ringBufferTokenSize.token16Bits + 1;
                                                       break;
 
-          case APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD : *((uint32_t *)ringBuffer->apvCommsRingBufferHead) = *ringBufferTokenSize.token32Bits;
+          case APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD : *(ringBuffer->apvCommsRingBufferHead)             = (apvRingBufferSlotWidth_t)*ringBufferTokenSize.token32Bits;
                                                        ringBufferTokenSize.token32Bits                  =  ringBufferTokenSize.token32Bits + 1;
+                                                      break;
+
+          case APV_RING_BUFFER_TOKEN_TYPE_POINTER   : *(ringBuffer->apvCommsRingBufferHead)             = *ringBufferTokenSize.tokenSlot;
+                                                       ringBufferTokenSize.tokenSlot                    =  ringBufferTokenSize.tokenSlot   + 1;
+                                                      break;
+
           default                                   : break;
 
           case APV_RING_BUFFER_TOKEN_TYPE_HUGE_WORD : *((uint64_t *)ringBuffer->apvCommsRingBufferHead) = *ringBufferTokenSize.token64Bits;
@@ -465,7 +465,8 @@ uint16_t apvRingBufferLoad(apvRingBuffer_t          *ringBuffer,
 /*  <--> ringBuffer             : pointer to a ring-buffer structure          */
 /*   --> ringBufferTokenType    : [APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  = 1 | */
 /*                                 APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  = 2 | */
-/*                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD = 4]  */
+/*                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD = 4 | */
+/*                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER  = 16]  */
 /*   --> tokens                 : pointer to a receiving buffer of            */
 /*                                1 { <token> } n                             */
 /*   --> numberOfTokensToUnLoad : number of tokens to try to unload           */
@@ -480,20 +481,24 @@ uint16_t apvRingBufferLoad(apvRingBuffer_t          *ringBuffer,
 /*   The actual number of requested tokens unloaded is returned to the        */
 /*   calling function to make any decision on the fate of underloaded pipes.  */
 /*   As a general principle the ring-buffer should never have to throw        */
-/*   incoming tokens away and should be sized as such                         */
+/*   incoming tokens away and should be sized as such.                        */
+/*   Byte, word and long-word tokens are written packed into the receiving    */
+/*   buffer; pointer tokens are written whole                                 */
 /*                                                                            */
 /******************************************************************************/
 
 uint16_t apvRingBufferUnLoad(apvRingBuffer_t          *ringBuffer,
                              apvRingBufferTokenType_t  ringBufferTokenType,
-                             uint32_t                 *tokens,
+                             void                     *tokens,
                              uint16_t                  numberOfTokensToUnLoad,
                              bool                      interruptControl)
   {
 /******************************************************************************/
 
-  uint16_t numberOfTokensUnLoaded = 0;
+  uint16_t                 numberOfTokensUnLoaded = 0;
 
+  apvRingBufferTokenSize_t ringBufferTokenSize;       // use this union to convert the pointer to use to store 
+                                                      // tokens
 /******************************************************************************/
 
   if (numberOfTokensToUnLoad > 0)
@@ -516,9 +521,28 @@ uint16_t apvRingBufferUnLoad(apvRingBuffer_t          *ringBuffer,
       ringBuffer->apvCommsRingBufferLoad = ringBuffer->apvCommsRingBufferLoad - numberOfTokensToUnLoad;
       numberOfTokensUnLoaded             = numberOfTokensToUnLoad;
 
+      ringBufferTokenSize.tokenAny       = tokens;
+
       while (numberOfTokensToUnLoad > 0)
         {
-        *tokens = *(ringBuffer->apvCommsRingBufferTail); // EXPLICIT cast from (uint32_t) to (uint8_t)
+        switch(ringBufferTokenType)
+          {
+          case APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE  : *ringBufferTokenSize.token8Bits  = (uint8_t)*(ringBuffer->apvCommsRingBufferTail);
+                                                       ringBufferTokenSize.token8Bits  =  ringBufferTokenSize.token8Bits  + 1;
+                                                      break;
+
+          case APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  : *ringBufferTokenSize.token16Bits = (uint16_t)*(ringBuffer->apvCommsRingBufferTail);
+                                                       ringBufferTokenSize.token16Bits =  ringBufferTokenSize.token16Bits + 1;
+                                                      break;
+
+          case APV_RING_BUFFER_TOKEN_TYPE_POINTER   : *ringBufferTokenSize.tokenSlot   = *(ringBuffer->apvCommsRingBufferTail);
+                                                       ringBufferTokenSize.tokenSlot   =  ringBufferTokenSize.tokenSlot   + 1;
+                                                      break;
+
+          default                                   : *ringBufferTokenSize.token32Bits = (uint32_t)*(ringBuffer->apvCommsRingBufferTail);
+                                                       ringBufferTokenSize.token32Bits =  ringBufferTokenSize.token32Bits + 1;
+                                                      break;
+          }
   
 #ifdef _APV_DEBUG_RING_BUFFERS_ 
         *(ringBuffer->apvCommsRingBufferTail) = APV_RING_BUFFER_INITIALISATION_FLAG; 
@@ -535,7 +559,6 @@ uint16_t apvRingBufferUnLoad(apvRingBuffer_t          *ringBuffer,
           ringBuffer->apvCommsRingBufferTail = ringBuffer->apvCommsRingBufferTail + 1;
           }
   
-        tokens                 = tokens                 + 1;
         numberOfTokensToUnLoad = numberOfTokensToUnLoad - 1;
         }
       }
@@ -553,6 +576,181 @@ uint16_t apvRingBufferUnLoad(apvRingBuffer_t          *ringBuffer,
 /******************************************************************************/
   } /* end of apvRingBufferUnLoad                                             */
 
+/******************************************************************************/
+/* apvRingBufferReceiveGuardInitialise() :                                    */
+/*  --> receiveGuard          : receive ring-buffer overflow state            */
+/*  --> receiveOverflowPolicy : what to give up when the ring-buffer is full  */
+/*  <-- guardError            : error codes                                   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvRingBufferReceiveGuardInitialise(apvRingBufferReceiveGuard_t   *receiveGuard,
+                                                   apvRingBufferOverflowPolicy_t  receiveOverflowPolicy)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE guardError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (receiveGuard == NULL)
+    {
+    guardError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (receiveOverflowPolicy >= APV_RING_BUFFER_OVERFLOW_POLICIES)
+      {
+      guardError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      receiveGuard->receiveOverflowPolicy = receiveOverflowPolicy;
+      receiveGuard->receiveGapPending     = false;
+      receiveGuard->receiveOverflows      = 0;
+      receiveGuard->receiveGaps           = 0;
+      }
+    }
+
+/******************************************************************************/
+
+  return(guardError);
+
+/******************************************************************************/
+  } /* end of apvRingBufferReceiveGuardInitialise                             */
+
+/******************************************************************************/
+/* apvRingBufferReceiveLoad() :                                               */
+/*  <--> ringBuffer           : a receive ring-buffer of long-word tokens     */
+/*  <--> receiveGuard         : the ring-buffers' overflow state              */
+/*   --> tokenType            : the packing of the received characters        */
+/*   --> tokens               : the received characters                       */
+/*   --> numberOfTokensToLoad : the number of received characters             */
+/*   <-- tokensLost           : received or waiting characters thrown away    */
+/*                                                                            */
+/* - load received characters and never block : when they will not fit the    */
+/*   guards' policy decides which characters are lost. Wherever characters    */
+/*   are lost a gap marker is put in the stream so the de-framer abandons the */
+/*   broken frame instead of splicing it onto the next one; if there is no    */
+/*   room for the marker it is owed and goes in ahead of the next character.  */
+/*   A hardware receive error is reported by setting 'receiveGapPending'.     */
+/*   Called from interrupt-service-routines so interrupts are not touched     */
+/*                                                                            */
+/******************************************************************************/
+
+uint16_t apvRingBufferReceiveLoad(apvRingBuffer_t             *ringBuffer,
+                                  apvRingBufferReceiveGuard_t *receiveGuard,
+                                  apvRingBufferTokenType_t     tokenType,
+                                  void                        *tokens,
+                                  uint16_t                     numberOfTokensToLoad)
+  {
+/******************************************************************************/
+
+  uint16_t tokensLost    = 0,
+           tokensLoaded  = 0,
+           tokensNeeded  = numberOfTokensToLoad;
+
+  uint32_t gapMarker     = APV_RING_BUFFER_GAP_MARKER,
+           tokenDiscard  = 0;
+
+/******************************************************************************/
+
+  if (receiveGuard->receiveGapPending == true)
+    {
+    tokensNeeded = tokensNeeded + 1;
+    }
+
+  if (tokensNeeded > (ringBuffer->apvCommsRingBufferLength - ringBuffer->apvCommsRingBufferLoad))
+    {
+    switch(receiveGuard->receiveOverflowPolicy)
+      {
+      case APV_RING_BUFFER_OVERFLOW_DROP_OLDEST : // Discard the oldest waiting characters to make room
+                                                  while ((tokensNeeded                       > (ringBuffer->apvCommsRingBufferLength - ringBuffer->apvCommsRingBufferLoad)) &&
+                                                         (ringBuffer->apvCommsRingBufferLoad != 0))
+                                                    {
+                                                    apvRingBufferUnLoad( ringBuffer,
+                                                                         APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
+                                                                        &tokenDiscard,
+                                                                         1,
+                                                                         false);
+
+                                                    tokensLost = tokensLost + 1;
+                                                    }
+
+                                                  // The gap is now at the front of the ring-buffer : the 
+                                                  // oldest waiting character becomes the marker
+                                                  if (ringBuffer->apvCommsRingBufferLoad != 0)
+                                                    {
+                                                    *(ringBuffer->apvCommsRingBufferTail) = gapMarker;
+
+                                                    if (receiveGuard->receiveGapPending == true)
+                                                      {
+                                                      receiveGuard->receiveGapPending = false;
+                                                      tokensNeeded                    = tokensNeeded - 1;
+                                                      }
+
+                                                    receiveGuard->receiveGaps = receiveGuard->receiveGaps + 1;
+                                                    tokensLost                = tokensLost                + 1;
+                                                    }
+                                                  else
+                                                    {
+                                                    if (receiveGuard->receiveGapPending == false)
+                                                      {
+                                                      receiveGuard->receiveGapPending = true;
+                                                      tokensNeeded                    = tokensNeeded + 1;
+                                                      }
+                                                    }
+                                                  break;
+
+      case APV_RING_BUFFER_OVERFLOW_RESYNC      : // Discard everything waiting and start the de-framer again
+                                                  tokensLost = tokensLost + ringBuffer->apvCommsRingBufferLoad;
+
+                                                  apvRingBufferInitialise(ringBuffer,
+                                                                          ringBuffer->apvCommsRingBufferLength);
+
+                                                  receiveGuard->receiveGapPending = true;
+                                                  break;
+
+      case APV_RING_BUFFER_OVERFLOW_DROP_NEWEST : // The characters that do not fit are lost below
+      default                                   : break;
+      }
+    }
+
+  // Any owed gap marker goes in ahead of the new characters
+  if (receiveGuard->receiveGapPending == true)
+    {
+    if (apvRingBufferLoad( ringBuffer,
+                           APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
+                          &gapMarker,
+                           1,
+                           false) != 0)
+      {
+      receiveGuard->receiveGapPending = false;
+      receiveGuard->receiveGaps       = receiveGuard->receiveGaps + 1;
+      }
+    }
+
+  tokensLoaded = apvRingBufferLoad( ringBuffer,
+                                    tokenType,
+                                    tokens,
+                                    numberOfTokensToLoad,
+                                    false);
+
+  if (tokensLoaded < numberOfTokensToLoad)
+    {
+    receiveGuard->receiveGapPending = true;
+    tokensLost                      = tokensLost + (numberOfTokensToLoad - tokensLoaded);
+    }
+
+  receiveGuard->receiveOverflows = receiveGuard->receiveOverflows + tokensLost;
+
+/******************************************************************************/
+
+  return(tokensLost);
+
+/******************************************************************************/
+  } /* end of apvRingBufferReceiveLoad                                        */
+
 /******************************************************************************/
 /* apvCreateTestMessage() :                                                   */
 /*  <--> testMessage          : pointer to the receiving message buffer       */
@@ -752,12 +950,12 @@ void apvRingBufferPrint(apvRingBuffer_t *ringBuffer)
     }
 
   printf("\n Load = %08x", ringBuffer->apvCommsRingBufferLoad);
-  printf("\n Head = %08x", (uint32_t)ringBuffer->apvCommsRingBufferHead);
-  printf("\n Tail = %08x", (uint32_t)ringBuffer->apvCommsRingBufferTail);
+  printf("\n Head = %p", (void *)ringBuffer->apvCommsRingBufferHead);
+  printf("\n Tail = %p", (void *)ringBuffer->apvCommsRingBufferTail);
   printf("\n -------------------");
   printf("\n Length = %08x", ringBuffer->apvCommsRingBufferLength);
-  printf("\n Start  = %08x", ringBuffer->apvCommsRingBufferStart);
-  printf("\n End    = %08x", ringBuffer->apvCommsRingBufferEnd);
+  printf("\n Start  = %p", (void *)ringBuffer->apvCommsRingBufferStart);
+  printf("\n End    = %p", (void *)ringBuffer->apvCommsRingBufferEnd);
   printf("\n -------------------");
   printf("\n");
 
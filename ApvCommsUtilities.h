@@ -52,13 +52,17 @@
 #define APV_RING_BUFFER_LIST_EMPTY_POINTER_CODE        ((uint32_t)0xffffffff)
 #define APV_RING_BUFFER_LIST_EMPTY_POINTER             ((apvRingBuffer_t *)(APV_RING_BUFFER_LIST_EMPTY_POINTER_CODE))
 
+// A raw <SOM> is never inside a stuffed frame so the de-framer abandons any 
+// partial frame when it meets one : it marks where received characters were lost
+#define APV_RING_BUFFER_GAP_MARKER                     ((uint32_t)APV_MESSAGING_START_OF_MESSAGE)
+
 /******************************************************************************/
 /* Type Definitions :                                                         */
 /******************************************************************************/
 
-typedef uint32_t apvRingBufferSlotWidth_t; // the ring-buffer slots are generic i.e. 
-                                           // 32-bits wide so they can hold full-
-                                           // range memory pointers if need be
+typedef uintptr_t apvRingBufferSlotWidth_t; // the ring-buffer slots are generic i.e. 
+                                            // pointer-width so they can hold full-
+                                            // range memory pointers on any build
 
 typedef struct apvRingBuffer_tTag
   {
@@ -73,9 +77,27 @@ typedef struct apvRingBuffer_tTag
 
 typedef uint64_t ringBufferEntryPointer_t;
 
+// What a receive ring-buffer gives up when received characters will not fit
+typedef enum apvRingBufferOverflowPolicy_tTag
+  {
+  APV_RING_BUFFER_OVERFLOW_DROP_NEWEST = 0, // the arriving characters are lost
+  APV_RING_BUFFER_OVERFLOW_DROP_OLDEST,     // the oldest waiting characters make room
+  APV_RING_BUFFER_OVERFLOW_RESYNC,          // everything waiting is discarded and the de-framer starts again
+  APV_RING_BUFFER_OVERFLOW_POLICIES
+  } apvRingBufferOverflowPolicy_t;
+
+// Overflow handling and accounting for a receive ring-buffer
+typedef struct apvRingBufferReceiveGuard_tTag
+  {
+  apvRingBufferOverflowPolicy_t receiveOverflowPolicy;
+  bool                          receiveGapPending;    // a gap marker is owed to the de-framer
+  uint32_t                      receiveOverflows;     // characters lost to a full ring-buffer
+  uint32_t                      receiveGaps;          // gap markers delivered to the de-framer
+  } apvRingBufferReceiveGuard_t;
+
 /******************************************************************************/
-/* The generic ring-buffer elements are 32-bits wide to allow the storage of  */
-/* bytes, words and long-words/pointers (note this is sized for a 32-bit ARM) */
+/* The generic ring-buffer elements are pointer-wide to allow the storage of  */
+/* bytes, words, long-words and pointers (32-bits on ARM, 64-bits on a host)  */
 /******************************************************************************/
 
 typedef enum apvRingBufferTokenType_tTag
@@ -84,16 +106,19 @@ typedef enum apvRingBufferTokenType_tTag
   APV_RING_BUFFER_TOKEN_TYPE_ONE_WORD  = 2,
   APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD = 4,
   APV_RING_BUFFER_TOKEN_TYPE_HUGE_WORD = 8,
-  APV_RING_BUFFER_TOKEN_TYPES          = 3
+  APV_RING_BUFFER_TOKEN_TYPE_POINTER   = 16, // a whole slot : a memory pointer on any build
+  APV_RING_BUFFER_TOKEN_TYPES          = 5
   } apvRingBufferTokenType_t;
 
-// Convert from the generic 32-bit pointer to 8, 16 or 32-bits
+// Convert from the generic token pointer to 8, 16, 32-bits or a whole slot
 typedef union apvRingBufferTokenSize_tTag
   {
-  uint8_t  *token8Bits;
-  uint16_t *token16Bits;
-  uint32_t *token32Bits;
-  uint64_t *token64Bits; // for future use
+  void                     *tokenAny;
+  uint8_t                  *token8Bits;
+  uint16_t                 *token16Bits;
+  uint32_t                 *token32Bits;
+  uint64_t                 *token64Bits; // for future use
+  apvRingBufferSlotWidth_t *tokenSlot;
   } apvRingBufferTokenSize_t;
 
 /******************************************************************************/
@@ -120,14 +145,21 @@ extern APV_ERROR_CODE apvRingBufferReportFillState(apvRingBuffer_t *ringBuffer,
                                                    bool             interruptControl);
 extern uint16_t       apvRingBufferLoad(apvRingBuffer_t           *ringBuffer,
                                         apvRingBufferTokenType_t   ringBufferTokenType,
-                                        uint32_t                  *tokens,
+                                        void                      *tokens,
                                         uint16_t                   numberOfTokensToLoad,
                                         bool                       interruptControl);
 extern uint16_t       apvRingBufferUnLoad(apvRingBuffer_t           *ringBuffer,
                                           apvRingBufferTokenType_t   ringBufferTokenType,
-                                          uint32_t                  *tokens,
+                                          void                      *tokens,
                                           uint16_t                   numberOfTokensToUnLoad,
                                           bool                       interruptControl);
+extern APV_ERROR_CODE apvRingBufferReceiveGuardInitialise(apvRingBufferReceiveGuard_t   *receiveGuard,
+                                                          apvRingBufferOverflowPolicy_t  receiveOverflowPolicy);
+extern uint16_t       apvRingBufferReceiveLoad(apvRingBuffer_t             *ringBuffer,
+                                               apvRingBufferReceiveGuard_t *receiveGuard,
+                                               apvRingBufferTokenType_t     tokenType,
+                                               void                        *tokens,
+                                               uint16_t                     numberOfTokensToLoad);
 #if (0)
 extern APV_ERROR_CODE apvCreateTestMessage(uint8_t  *testMessage,
                                            uint16_t  testMessageSomLength,
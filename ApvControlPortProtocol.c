@@ -23,6 +23,9 @@
 #include "ApvPeripheralControl.h"
 #include "ApvCommsUtilities.h"
 #include "ApvControlPortProtocol.h"
+#include "ApvMessagingLayerManager.h"
+#include "ApvInterruptLatency.h"
+#include "ApvScheduler.h"
 
 /******************************************************************************/
 /* Global Variable Definitions :                                              */
@@ -43,9 +46,68 @@ apvCommandProtocolDefinition_t apvCommandProtocol[APV_COMMAND_PROTOCOL_MESSAGE_D
       },
     APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SIGN_ON,
     NULL
+    },
+    {
+      {
+        {
+        APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT,
+          {
+          APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_COMPONENT_STATISTICS
+          }
+        }
+      },
+    APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_COMPONENT_STATISTICS,
+    apvMessagingLayerStatisticsAction
+    },
+    {
+      {
+        {
+        APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT,
+          {
+          APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_BAUD_RATE
+          }
+        }
+      },
+    APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_BAUD_RATE,
+    apvControlPortBaudRateAction
+    },
+    {
+      {
+        {
+        APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT,
+          {
+          APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_INTERRUPT_LATENCY
+          }
+        }
+      },
+    APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_INTERRUPT_LATENCY,
+    apvInterruptLatencyAction
+    },
+    {
+      {
+        {
+        APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT,
+          {
+          APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_SCHEDULER
+          }
+        }
+      },
+    APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SCHEDULER,
+    apvSchedulerAction
     }
   };
 
+apvCommandProtocolDispatch_t   apvCommandProtocolDispatch;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static uint16_t apvCommandProtocolHashIdentifier(uint32_t  hashSeed,
+                                                 uint8_t  *identifier,
+                                                 uint16_t  identifierMaximumLength,
+                                                 uint32_t *identifierHash);
+
 /******************************************************************************/
 /* Function Definitions :                                                     */
 /******************************************************************************/
@@ -89,8 +151,8 @@ APV_ERROR_CODE apvControlPortSignOn(uint8_t  *apvSignOMessage,
       while (apvSignOnMessageLength > 0)
         { // If the message is too long the extra characters will just be thrown away
         apvRingBufferLoad( apvPrimarySerialCommsTransmitBuffer,
-                           APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                          (uint32_t *)apvSignOMessage,
+                           APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                           apvSignOMessage,
                            sizeof(uint8_t),
                            false);
 
@@ -100,8 +162,8 @@ APV_ERROR_CODE apvControlPortSignOn(uint8_t  *apvSignOMessage,
 
       // Push the buffer onto the transmit buffer queue
       apvRingBufferLoad( apvUartPortPrimaryTransmitRingBuffer_p,
-                         APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                        (uint32_t *)&apvPrimarySerialCommsTransmitBuffer,
+                         APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                        &apvPrimarySerialCommsTransmitBuffer,
                          sizeof(uint8_t),
                          false);
 
@@ -117,6 +179,413 @@ APV_ERROR_CODE apvControlPortSignOn(uint8_t  *apvSignOMessage,
 /******************************************************************************/
   } /* end of apvControlPortSignOn                                            */
 
+/******************************************************************************/
+/* apvCommandProtocolHashIdentifier() :                                       */
+/*  -->  hashSeed                : perturbs the hash offset basis             */
+/*  --> *identifier              : the command identifier to hash             */
+/*  -->  identifierMaximumLength : the most characters that may be examined   */
+/*  <--  identifierHash          : the FNV-1a hash of the identifier          */
+/*  <--  identifierLength        : the number of identifier characters        */
+/*                                                                            */
+/* - hash a text command identifier in a single pass, stopping at the first   */
+/*   terminating character (any control character or space) or the maximum    */
+/*   length. The identifier length falls out of the same pass                 */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvCommandProtocolHashIdentifier(uint32_t  hashSeed,
+                                                 uint8_t  *identifier,
+                                                 uint16_t  identifierMaximumLength,
+                                                 uint32_t *identifierHash)
+  {
+/******************************************************************************/
+
+  uint16_t identifierLength = 0;
+  uint32_t hashAccumulator  = APV_COMMAND_PROTOCOL_HASH_OFFSET_BASIS ^ hashSeed;
+
+/******************************************************************************/
+
+  while ((identifierLength < identifierMaximumLength) && (*(identifier + identifierLength) > APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR))
+    {
+    hashAccumulator  = (hashAccumulator ^ *(identifier + identifierLength)) * APV_COMMAND_PROTOCOL_HASH_PRIME;
+    identifierLength = identifierLength + 1;
+    }
+
+  *identifierHash = hashAccumulator;
+
+/******************************************************************************/
+
+  return(identifierLength);
+
+/******************************************************************************/
+  } /* end of apvCommandProtocolHashIdentifier                                */
+
+/******************************************************************************/
+/* apvCommandProtocolBuildDispatch() :                                        */
+/*  --> commandProtocol            : the command protocol definitions         */
+/*  --> commandProtocolDefinitions : the number of command definitions        */
+/*  --> commandProtocolDispatch    : the dispatch table to build              */
+/*  <-- dispatchError              : error codes                              */
+/*                                                                            */
+/* - search for a hash seed that places every text command identifier in its  */
+/*   own slot of the dispatch table i.e. a perfect hash over the (fixed) set  */
+/*   of commands. This is run once at start-up so command resolution costs    */
+/*   one pass over the received identifier and one confirming comparison,     */
+/*   however many commands are defined. If no seed works the table is left    */
+/*   "not ready" and a configuration error is returned - increase the table   */
+/*   size or the number of seeds tried                                        */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvCommandProtocolBuildDispatch(apvCommandProtocolDefinition_t *commandProtocol,
+                                               uint16_t                        commandProtocolDefinitions,
+                                               apvCommandProtocolDispatch_t   *commandProtocolDispatch)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE dispatchError   = APV_ERROR_CODE_NONE;
+
+  uint32_t       hashSeed        = 0,
+                 identifierHash  = 0;
+  uint16_t       protocolMessage = 0,
+                 hashSlot        = 0;
+  bool           hashCollision   = false;
+
+/******************************************************************************/
+
+  if ((commandProtocol == NULL) || (commandProtocolDispatch == NULL))
+    {
+    dispatchError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((commandProtocolDefinitions == 0)                                       || 
+        (commandProtocolDefinitions >  APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS) ||
+        (commandProtocolDefinitions >  APV_COMMAND_PROTOCOL_HASH_TABLE_SIZE)     ||
+        (commandProtocolDefinitions >  APV_COMMAND_PROTOCOL_BINARY_OPCODE_MASK))
+      {
+      dispatchError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      commandProtocolDispatch->commandProtocolDispatchReady = false;
+
+      for (hashSeed = 0; hashSeed < APV_COMMAND_PROTOCOL_HASH_SEEDS; hashSeed++)
+        {
+        memset((void *)&commandProtocolDispatch->commandProtocolHashSlots[0], APV_COMMAND_PROTOCOL_HASH_EMPTY_SLOT, APV_COMMAND_PROTOCOL_HASH_TABLE_SIZE);
+
+        hashCollision = false;
+
+        for (protocolMessage = 0; protocolMessage < commandProtocolDefinitions; protocolMessage++)
+          {
+          // Only text commands are hashed - binary commands are resolved by their index
+          if ((commandProtocol + protocolMessage)->apvCommandProtocolFields->apvCommandProtocolFieldType == APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT)
+            {
+            commandProtocolDispatch->commandProtocolIdentifierLengths[protocolMessage] = 
+              (uint8_t)apvCommandProtocolHashIdentifier( hashSeed,
+                                                        (uint8_t *)&(commandProtocol + protocolMessage)->apvCommandProtocolFields->apvCommandProtocolField.apvCommandProtocolText[0],
+                                                         APV_COMMAND_PROTOCOL_MESSAGE_IDENTIFIER_MAXIMUM_LENGTH,
+                                                        &identifierHash);
+
+            hashSlot = (uint16_t)(identifierHash & APV_COMMAND_PROTOCOL_HASH_TABLE_MASK);
+
+            if (commandProtocolDispatch->commandProtocolHashSlots[hashSlot] != APV_COMMAND_PROTOCOL_HASH_EMPTY_SLOT)
+              {
+              hashCollision = true;
+              break;
+              }
+
+            commandProtocolDispatch->commandProtocolHashSlots[hashSlot] = (uint8_t)protocolMessage;
+            }
+          else
+            {
+            commandProtocolDispatch->commandProtocolIdentifierLengths[protocolMessage] = 0;
+            }
+          }
+
+        if (hashCollision == false)
+          {
+          commandProtocolDispatch->commandProtocolHashSeed      = hashSeed;
+          commandProtocolDispatch->commandProtocolDispatchReady = true;
+          break;
+          }
+        }
+
+      if (commandProtocolDispatch->commandProtocolDispatchReady == false)
+        {
+        dispatchError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(dispatchError);
+
+/******************************************************************************/
+  } /* end of apvCommandProtocolBuildDispatch                                 */
+
+/******************************************************************************/
+/* apvCommandProtocolResolve() :                                              */
+/*  --> commandProtocol            : the command protocol definitions         */
+/*  --> commandProtocolDefinitions : the number of command definitions        */
+/*  --> commandProtocolDispatch    : the (built) dispatch table               */
+/*  --> commandPayload             : the received message payload             */
+/*  --> commandPayloadLength       : the received message payload length      */
+/*  <-- protocolMessage            : the index of the matching definition     */
+/*  <-- resolveError               : error codes                              */
+/*                                                                            */
+/* - resolve a received command to its' protocol definition. A payload        */
+/*   starting with a byte with bit 7 set is a binary command and bits 0:6     */
+/*   are the definition index. Otherwise the leading text identifier is       */
+/*   hashed in one pass, the hash selects at most one candidate definition    */
+/*   and a single comparison confirms it                                      */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvCommandProtocolResolve(apvCommandProtocolDefinition_t *commandProtocol,
+                                         uint16_t                        commandProtocolDefinitions,
+                                         apvCommandProtocolDispatch_t   *commandProtocolDispatch,
+                                         uint8_t                        *commandPayload,
+                                         uint16_t                        commandPayloadLength,
+                                         uint16_t                       *protocolMessage)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE resolveError     = APV_ERROR_CODE_NONE;
+
+  uint32_t       identifierHash   = 0;
+  uint16_t       identifierLength = 0;
+  uint8_t        hashCandidate    = APV_COMMAND_PROTOCOL_HASH_EMPTY_SLOT;
+
+/******************************************************************************/
+
+  if ((commandProtocol == NULL) || (commandProtocolDispatch == NULL) ||
+      (commandPayload  == NULL) || (protocolMessage         == NULL))
+    {
+    resolveError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (commandProtocolDispatch->commandProtocolDispatchReady == false)
+      {
+      resolveError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+      }
+    else
+      {
+      if (commandPayloadLength == 0)
+        {
+        resolveError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+        }
+      else
+        {
+        if ((*commandPayload & APV_COMMAND_PROTOCOL_BINARY_OPCODE_FLAG) == APV_COMMAND_PROTOCOL_BINARY_OPCODE_FLAG)
+          { // Binary opcode - the definition index is in the low seven bits
+          hashCandidate = *commandPayload & APV_COMMAND_PROTOCOL_BINARY_OPCODE_MASK;
+
+          if (hashCandidate < commandProtocolDefinitions)
+            {
+            *protocolMessage = hashCandidate;
+            }
+          else
+            {
+            resolveError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+            }
+          }
+        else
+          {
+          if (commandPayloadLength > APV_COMMAND_PROTOCOL_MESSAGE_IDENTIFIER_MAXIMUM_LENGTH)
+            {
+            commandPayloadLength = APV_COMMAND_PROTOCOL_MESSAGE_IDENTIFIER_MAXIMUM_LENGTH;
+            }
+
+          identifierLength = apvCommandProtocolHashIdentifier( commandProtocolDispatch->commandProtocolHashSeed,
+                                                               commandPayload,
+                                                               commandPayloadLength,
+                                                              &identifierHash);
+
+          hashCandidate    = commandProtocolDispatch->commandProtocolHashSlots[identifierHash & APV_COMMAND_PROTOCOL_HASH_TABLE_MASK];
+
+          if ((hashCandidate    != APV_COMMAND_PROTOCOL_HASH_EMPTY_SLOT) &&
+              (hashCandidate    <  commandProtocolDefinitions)           &&
+              (identifierLength == commandProtocolDispatch->commandProtocolIdentifierLengths[hashCandidate]))
+            {
+            // The hash is only perfect over the defined identifiers - confirm the candidate
+            if (memcmp((const void *)commandPayload,
+                       (const void *)&(commandProtocol + hashCandidate)->apvCommandProtocolFields->apvCommandProtocolField.apvCommandProtocolText[0],
+                       identifierLength) == 0)
+              {
+              *protocolMessage = hashCandidate;
+              }
+            else
+              {
+              resolveError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+              }
+            }
+          else
+            {
+            resolveError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+            }
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(resolveError);
+
+/******************************************************************************/
+  } /* end of apvCommandProtocolResolve                                       */
+
+/******************************************************************************/
+/* apvControlPortBaudRateAction() :                                           */
+/*  --> messageAction : the response message buffer, holding a copy of the    */
+/*                      request :                                             */
+/*                        "APV_BAUD_RATE <baud rate>"                         */
+/*  <-- : the response message buffer                                         */
+/*                                                                            */
+/* - control protocol action : offer the primary serial link a new baud rate. */
+/*   The response reports the rate the UART divisor would actually give and   */
+/*   its' error so the host can see why a rate is refused :                   */
+/*                                                                            */
+/*     "B<requested> <actual> <error ppm> [A|R]"                              */
+/*                                                                            */
+/*   An unreadable request returns an empty payload                           */
+/*                                                                            */
+/******************************************************************************/
+
+void *apvControlPortBaudRateAction(void *messageAction)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *responseMessage = (apvMessageStructure_t *)messageAction;
+
+  uint32_t               baudRate        = 0,
+                         baudRateActual  = 0;
+  int32_t                baudRateError   = 0;
+  char                   baudRateVerdict = APV_COMMAND_PROTOCOL_BAUD_RATE_REFUSED;
+  APV_ERROR_CODE         argumentError   = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (responseMessage != NULL)
+    {
+    // The baud rate is decimal : the UART refuses any rate it cannot make
+    argumentError = apvCommandProtocolDecimalArgument(&responseMessage->apvMessagingPayload[0],
+                                                       responseMessage->apvMessagingLengthOfMessage,
+                                                       UINT32_MAX,
+                                                      &baudRate,
+                                                       NULL);
+
+    responseMessage->apvMessagingPayload[0] = '\0';
+
+    if (argumentError == APV_ERROR_CODE_NONE)
+      {
+      if (apvSerialBaudRateRequest(&apvPrimarySerialBaudRate,
+                                    baudRate,
+                                   &baudRateActual,
+                                   &baudRateError) == APV_ERROR_CODE_NONE)
+        {
+        baudRateVerdict = APV_COMMAND_PROTOCOL_BAUD_RATE_ACCEPTED;
+        }
+
+      snprintf((char *)&responseMessage->apvMessagingPayload[0], APV_MESSAGING_MAXIMUM_UNSTUFFED_MESSAGE_LENGTH, "B%lu %lu %ld %c\r",
+               (unsigned long)baudRate, (unsigned long)baudRateActual, (long)baudRateError, baudRateVerdict);
+      }
+    }
+
+/******************************************************************************/
+
+  return(messageAction);
+
+/******************************************************************************/
+  } /* end of apvControlPortBaudRateAction                                    */
+
+/******************************************************************************/
+/* apvCommandProtocolDecimalArgument() :                                      */
+/*  --> commandPayload       : a text command "<identifier> <n> [<select>]"   */
+/*  --> commandPayloadLength : length of the command                          */
+/*  --> argumentMaximum      : the largest value the caller accepts           */
+/*  <-- argumentValue        : the decimal argument                           */
+/*  <-- argumentSelect       : the optional selector character. Left as it is */
+/*                             if the command has none; NULL if the command   */
+/*                             takes no selector                              */
+/*  <-- argumentError        : error codes                                    */
+/*                                                                            */
+/* - the argument parser for the text commands' actions : skip the command    */
+/*   identifier and its' spaces, read the decimal argument and then the       */
+/*   selector. The argument is range-checked digit by digit so an over-long   */
+/*   one is refused rather than wrapped into the accepted range               */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvCommandProtocolDecimalArgument(uint8_t  *commandPayload,
+                                                 uint16_t  commandPayloadLength,
+                                                 uint32_t  argumentMaximum,
+                                                 uint32_t *argumentValue,
+                                                 char     *argumentSelect)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE argumentError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+
+  uint16_t       payloadIndex  = 0;
+  uint64_t       argument      = 0;
+  bool           argumentFound = false;
+
+/******************************************************************************/
+
+  if ((commandPayload == NULL) || (argumentValue == NULL))
+    {
+    argumentError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    // Skip the command identifier and the separating spaces
+    while ((payloadIndex < commandPayloadLength) && (commandPayload[payloadIndex] > APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR))
+      {
+      payloadIndex = payloadIndex + 1;
+      }
+
+    while ((payloadIndex < commandPayloadLength) && (commandPayload[payloadIndex] == APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR))
+      {
+      payloadIndex = payloadIndex + 1;
+      }
+
+    // Stop at the first digit that takes the argument past the maximum
+    while ((payloadIndex < commandPayloadLength) && (commandPayload[payloadIndex] >= '0') && (commandPayload[payloadIndex] <= '9') && (argument <= argumentMaximum))
+      {
+      argument      = (argument * 10) + (commandPayload[payloadIndex] - '0');
+      argumentFound = true;
+      payloadIndex  = payloadIndex + 1;
+      }
+
+    if ((argumentFound == true) && (argument <= argumentMaximum))
+      {
+      *argumentValue = (uint32_t)argument;
+      argumentError  = APV_ERROR_CODE_NONE;
+
+      while ((payloadIndex < commandPayloadLength) && (commandPayload[payloadIndex] == APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR))
+        {
+        payloadIndex = payloadIndex + 1;
+        }
+
+      // The selector is optional
+      if ((argumentSelect != NULL) && (payloadIndex < commandPayloadLength) && (commandPayload[payloadIndex] > APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR))
+        {
+        *argumentSelect = (char)commandPayload[payloadIndex];
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(argumentError);
+
+/******************************************************************************/
+  } /* end of apvCommandProtocolDecimalArgument                               */
+
 /******************************************************************************/
 /* apvStringCompare() :                                                       */
 /*  --> *templateString       : a string containing a token to find in a      */
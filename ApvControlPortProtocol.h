@@ -33,11 +33,52 @@
 #define APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_SIGN_ON           "APV_SIGN_ON"
 #define APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SIGN_ON          "APV Primary Control Protocol \r"
 
-#define APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS                1 // keep this in sync with the defined messages
+// "APV_COMPONENT_STATISTICS <component> [R|S|H|D]" : the response is built by the command action
+#define APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_COMPONENT_STATISTICS  "APV_COMPONENT_STATISTICS"
+#define APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_COMPONENT_STATISTICS ""
+
+// "APV_BAUD_RATE <baud rate>" : the response is "B<requested> <actual> <error ppm> [A|R]"; an
+// accepted rate is switched in once the response has been sent and must be confirmed by any 
+// command from the host at the new rate
+#define APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_BAUD_RATE         "APV_BAUD_RATE"
+#define APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_BAUD_RATE        ""
+
+#define APV_COMMAND_PROTOCOL_BAUD_RATE_ACCEPTED                'A'
+#define APV_COMMAND_PROTOCOL_BAUD_RATE_REFUSED                 'R'
+
+// "APV_INTERRUPT_LATENCY <source> [L|J|S|H|C]" : the response is built by the command action
+#define APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_INTERRUPT_LATENCY  "APV_INTERRUPT_LATENCY"
+#define APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_INTERRUPT_LATENCY ""
+
+// "APV_SCHEDULER <task> [R|O|U|C]" : the response is built by the command action
+#define APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_SCHEDULER         "APV_SCHEDULER"
+#define APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SCHEDULER        ""
+
+#define APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS                5 // keep this in sync with the defined messages
 
 #define APV_COMMAND_PROTOCOL_MESSAGE_IDENTIFIER_MAXIMUM_LENGTH 32 // not quite arbritrary
 #define APV_COMMAND_PROTOCOL_MESSAGE_MAXIMUM_FIELDS             4 // wholly arbitrary!
 
+/******************************************************************************/
+/* Command dispatch : text identifiers are resolved by a perfect hash built   */
+/* once at start-up over 'apvCommandProtocol[]'. Binary commands carry their  */
+/* definition index in the first payload byte with bit 7 set (ASCII command   */
+/* identifiers never set bit 7)                                               */
+/******************************************************************************/
+
+#define APV_COMMAND_PROTOCOL_HASH_TABLE_SIZE                   16 // MUST be a power-of-two and >= APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS
+#define APV_COMMAND_PROTOCOL_HASH_TABLE_MASK                   (APV_COMMAND_PROTOCOL_HASH_TABLE_SIZE - 1)
+#define APV_COMMAND_PROTOCOL_HASH_SEEDS                        64 // number of hash seeds tried before giving up on a perfect hash
+#define APV_COMMAND_PROTOCOL_HASH_EMPTY_SLOT                   ((uint8_t)0xff)
+
+#define APV_COMMAND_PROTOCOL_HASH_OFFSET_BASIS                 ((uint32_t)0x811c9dc5) // FNV-1a 32-bit
+#define APV_COMMAND_PROTOCOL_HASH_PRIME                        ((uint32_t)0x01000193)
+
+#define APV_COMMAND_PROTOCOL_IDENTIFIER_TERMINATOR             ' ' // any character <= ' ' ends a text identifier
+
+#define APV_COMMAND_PROTOCOL_BINARY_OPCODE_FLAG                ((uint8_t)0x80)
+#define APV_COMMAND_PROTOCOL_BINARY_OPCODE_MASK                ((uint8_t)0x7f)
+
 /******************************************************************************/
 /* Type Definitions :                                                         */
 /******************************************************************************/
@@ -77,6 +118,14 @@ typedef struct apvCommandProtocolDefinition_tTag
                                                                                                                          // and output to generate - IF ANY
   } apvCommandProtocolDefinition_t; 
 
+typedef struct apvCommandProtocolDispatch_tTag
+  {
+  bool     commandProtocolDispatchReady;
+  uint32_t commandProtocolHashSeed;                                                          // the seed that makes the hash perfect over the defined identifiers
+  uint8_t  commandProtocolHashSlots[APV_COMMAND_PROTOCOL_HASH_TABLE_SIZE];                    // definition index per hash slot or "empty"
+  uint8_t  commandProtocolIdentifierLengths[APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS];        // pre-computed identifier lengths
+  } apvCommandProtocolDispatch_t;
+
 /******************************************************************************/
 /* Global Variable Declarations :                                             */
 /******************************************************************************/
@@ -84,6 +133,7 @@ typedef struct apvCommandProtocolDefinition_tTag
 extern uint8_t apvSignOnMessage[APV_SIGN_ON_MESSAGE_MAXIMUM_LENGTH];
 
 extern apvCommandProtocolDefinition_t apvCommandProtocol[APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS];
+extern apvCommandProtocolDispatch_t   apvCommandProtocolDispatch;
 
 /******************************************************************************/
 /* Function Declarations :                                                    */
@@ -92,6 +142,25 @@ extern apvCommandProtocolDefinition_t apvCommandProtocol[APV_COMMAND_PROTOCOL_ME
 extern APV_ERROR_CODE apvControlPortSignOn(uint8_t  *apvSignOMessage,
                                            uint16_t  apvSignOnMessageLength);
 
+extern APV_ERROR_CODE apvCommandProtocolBuildDispatch(apvCommandProtocolDefinition_t *commandProtocol,
+                                                      uint16_t                        commandProtocolDefinitions,
+                                                      apvCommandProtocolDispatch_t   *commandProtocolDispatch);
+
+extern APV_ERROR_CODE apvCommandProtocolResolve(apvCommandProtocolDefinition_t *commandProtocol,
+                                                uint16_t                        commandProtocolDefinitions,
+                                                apvCommandProtocolDispatch_t   *commandProtocolDispatch,
+                                                uint8_t                        *commandPayload,
+                                                uint16_t                        commandPayloadLength,
+                                                uint16_t                       *protocolMessage);
+
+extern void          *apvControlPortBaudRateAction(void *messageAction);
+
+extern APV_ERROR_CODE apvCommandProtocolDecimalArgument(uint8_t  *commandPayload,
+                                                        uint16_t  commandPayloadLength,
+                                                        uint32_t  argumentMaximum,
+                                                        uint32_t *argumentValue,
+                                                        char     *argumentSelect);
+
 extern bool           apvStringCompare(char     *templateString,
                                        uint16_t  templateStringOffset,
                                        uint16_t  templateStringLength,
@@ -7,8 +7,8 @@
 /* Paul O'Brien                                                               */
 /*                                                                            */
 /*  - the event timer ISRS are preliminarily declared as "weak" by Atmel so   */
-/*    are fully instantiated here. Each timer channel is redirected through   */
-/*    the callback function assigned at system setup                          */
+/*    are fully instantiated here. Each timer channel vector is a stub into   */
+/*    the one dispatcher and the callback assigned at system setup            */
 /*                                                                            */
 /******************************************************************************/
 /* Include Files :                                                            */
@@ -21,6 +21,8 @@
 #include "ApvEventTimers.h"
 #include "ApvSystemTime.h"
 #include "ApvEventTimersIsrs.h"
+#include "ApvRegisterAccess.h"
+#include "ApvInterruptLatency.h"
 
 /******************************************************************************/
 /* Include Files :                                                            */
@@ -29,43 +31,77 @@
 /******************************************************************************/
 /* Function Definitions :                                                     */
 /******************************************************************************/
-/* TC0_Handler() :                                                            */
+/* apvEventTimerDispatch() :                                                  */
+/*  --> apvEventTimerIndex : the interrupting channel's Atmel id [ 27 .. 35 ] */
+/*                                                                            */
+/* - the one timer channel interrupt path. "TC_SR" is read once, clearing the */
+/*   events, and handed to the channel's callback from the dispatch table     */
+/*   ('apvAssignEventTimer()') if any of the events it asked for are set.     */
+/*   The entry is stamped first and the latency taken from the compare the    */
+/*   serviced events were raised by                                           */
+/*                                                                            */
 /******************************************************************************/
 
-void TC0_Handler(void)
+void apvEventTimerDispatch(uint32_t apvEventTimerIndex)
   {
 /******************************************************************************/
 
-           uint32_t apvTimerBlock   = (ID_TC0 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-           uint32_t apvTimerChannel = (ID_TC0 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
-  volatile uint32_t timerStatus    = 0;
+  apvEventTimersBlock_t  *timerBlock   = &apvEventTimerBlock[(apvEventTimerIndex - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER];
+  uint32_t                timerChannel = (apvEventTimerIndex - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
+  apvEventTimerHandler_t *timerHandler = &timerBlock->apvEventTimerChannelHandler[timerChannel];
+  uint32_t                timerStatus  = 0,
+                          entryCycles  = apvInterruptLatencyStamp(),
+                          latency      = APV_INTERRUPT_LATENCY_UNSCHEDULED;
 
 /******************************************************************************/
 
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC0);
+  if (timerBlock->apvEventTimerChannels[timerChannel] != NULL)
+    {
+    timerStatus = APV_REGISTER_READ(timerBlock->apvEventTimerChannels[timerChannel], TC_SR);
+
+    if ((timerHandler->apvEventTimerCallBack != NULL) && ((timerStatus & timerHandler->apvEventTimerStatusMask) != 0))
+      {
+      latency = apvInterruptLatencyTimerChannel(timerBlock->apvEventTimerChannels[timerChannel],
+                                                timerStatus & timerHandler->apvEventTimerStatusMask);
+
+      timerHandler->apvEventTimerCallBack(apvEventTimerIndex,
+                                          timerStatus,
+                                          timerHandler->apvEventTimerContext);
+      }
+    }
 
-  timerStatus = apvEventTimerBlock[apvTimerBlock].apvEventTimerChannels[apvTimerChannel]->TC_SR;
+  apvInterruptLatencyRecord((apvInterruptLatencySource_t)(APV_INTERRUPT_LATENCY_SOURCE_TC0 + (apvEventTimerIndex - APV_EVENT_TIMER_BASE_ID)),
+                             entryCycles,
+                             latency);
 
 /******************************************************************************/
-  } /* end of TC0_Handler                                                     */
+  } /* end of apvEventTimerDispatch                                           */
 
 /******************************************************************************/
-/* TC1_Handler() :                                                            */
+/* TC0_Handler() :                                                            */
 /******************************************************************************/
 
-void TC1_Handler(void)
+void TC0_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC1 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC1 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
+  apvEventTimerDispatch(ID_TC0);
+
+/******************************************************************************/
+  } /* end of TC0_Handler                                                    */
+
+/******************************************************************************/
+/* TC1_Handler() :                                                            */
+/******************************************************************************/
 
+void TC1_Handler(void)
+  {
 /******************************************************************************/
 
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC1);
+  apvEventTimerDispatch(ID_TC1);
 
 /******************************************************************************/
-  } /* end of TC1_Handler                                                     */
+  } /* end of TC1_Handler                                                    */
 
 /******************************************************************************/
 /* TC2_Handler() :                                                            */
@@ -75,15 +111,10 @@ void TC2_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC2 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC2 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
+  apvEventTimerDispatch(ID_TC2);
 
 /******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC2);
-
-/******************************************************************************/
-  } /* end of TC2_Handler                                                     */
+  } /* end of TC2_Handler                                                    */
 
 /******************************************************************************/
 /* TC3_Handler() :                                                            */
@@ -93,15 +124,10 @@ void TC3_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC3 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC3 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
-
-/******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC3);
+  apvEventTimerDispatch(ID_TC3);
 
 /******************************************************************************/
-  } /* end of TC3_Handler                                                     */
+  } /* end of TC3_Handler                                                    */
 
 /******************************************************************************/
 /* TC4_Handler() :                                                            */
@@ -111,15 +137,10 @@ void TC4_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC4 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC4 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
-
-/******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC4);
+  apvEventTimerDispatch(ID_TC4);
 
 /******************************************************************************/
-  } /* end of TC4_Handler                                                     */
+  } /* end of TC4_Handler                                                    */
 
 /******************************************************************************/
 /* TC5_Handler() :                                                            */
@@ -129,15 +150,10 @@ void TC5_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC5 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC5 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
+  apvEventTimerDispatch(ID_TC5);
 
 /******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC5);
-
-/******************************************************************************/
-  } /* end of TC5_Handler                                                     */
+  } /* end of TC5_Handler                                                    */
 
 /******************************************************************************/
 /* TC6_Handler() :                                                            */
@@ -147,15 +163,10 @@ void TC6_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC6 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC6 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
-
-/******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC6);
+  apvEventTimerDispatch(ID_TC6);
 
 /******************************************************************************/
-  } /* end of TC6_Handler                                                     */
+  } /* end of TC6_Handler                                                    */
 
 /******************************************************************************/
 /* TC7_Handler() :                                                            */
@@ -165,15 +176,10 @@ void TC7_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC7 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC7 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
+  apvEventTimerDispatch(ID_TC7);
 
 /******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC7);
-
-/******************************************************************************/
-  } /* end of TC7_Handler                                                     */
+  } /* end of TC7_Handler                                                    */
 
 /******************************************************************************/
 /* TC8_Handler() :                                                            */
@@ -183,15 +189,10 @@ void TC8_Handler(void)
   {
 /******************************************************************************/
 
-  uint32_t apvTimerBlock   = (ID_TC8 - APV_EVENT_TIMER_BASE_ID) / TCCHANNEL_NUMBER;
-  uint32_t apvTimerChannel = (ID_TC8 - APV_EVENT_TIMER_BASE_ID) % TCCHANNEL_NUMBER;
-
-/******************************************************************************/
-
-  apvEventTimerBlock[apvTimerBlock].apvEventTimerChannelCallBack[apvTimerChannel](ID_TC8);
+  apvEventTimerDispatch(ID_TC8);
 
 /******************************************************************************/
-  } /* end of TC8_Handler                                                     */
+  } /* end of TC8_Handler                                                    */
 
 /******************************************************************************/
 /* RTT_Handler() :                                                            */
@@ -207,8 +208,8 @@ void RTT_Handler(void)
   {
 /******************************************************************************/
 
-  volatile uint32_t coreTimerStatus = 0,
-                    modeRegister    = 0;
+  volatile uint32_t modeRegister = 0;
+           uint32_t entryCycles  = apvInterruptLatencyStamp();
 
 /******************************************************************************/
 
@@ -216,12 +217,18 @@ void RTT_Handler(void)
   apvCoreTimerFlag = APV_CORE_TIMER_FLAG_HIGH;
 
   // Read the core timer status register to cancel the interrupt
-  coreTimerStatus = RTT->RTT_SR;
+  (void)APV_REGISTER_READ(RTT, RTT_SR);
 
   // Reload and restart the timer - carefully!
   modeRegister = RTT->RTT_MR;
   modeRegister = modeRegister | RTT_MR_RTTRST;
-  RTT->RTT_MR  = modeRegister;
+  APV_REGISTER_COMMAND(RTT, RTT_MR, modeRegister);
+
+  // The alarm runs from the slow clock so its' expiry cannot be placed on the
+  // cycle counter : only the service time is kept
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_RTT,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
 
 /******************************************************************************/
   } /* end of RTT_Handler                                                     */
@@ -238,6 +245,11 @@ void RTT_Handler(void)
 
 void SysTick_Handler(void)
   {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp(),
+           latency     = apvInterruptLatencySysTick();
+
 /******************************************************************************/
 
   // Flag the fast background loop
@@ -245,6 +257,10 @@ void SysTick_Handler(void)
 
   apvExecuteDurationTimers(&apvCoreTimeBaseBlock);
 
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_SYSTICK,
+                            entryCycles,
+                            latency);
+
 /******************************************************************************/
   } /* end of SysTick_Handler                                                 */
 
@@ -17,6 +17,7 @@
 #include "ApvSystemTime.h"
 #include "ApvEventTimers.h"
 #include "ApvUtilities.h"
+#include "ApvRegisterAccess.h"
 
 /******************************************************************************/
 /* Global Variable Definitions :                                              */
@@ -30,6 +31,40 @@ volatile apvCoreTimerFlag_t  apvCoreTimerFlag            = APV_CORE_TIMER_FLAG_L
 // flag may help to detect overloading as development continues
 bool                         apvSystemTimerInUseFlag     = false;
 
+// The free-running timer channel read for fine-grained timestamps and the channel
+// counting its' wraps for the 64-bit timestamp (if configured)
+TcChannel                   *apvEventTimerTimestampChannel     = NULL,
+                            *apvEventTimerTimestampHighChannel = NULL;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void     apvDurationTimersReset(apvCoreTimerBlock_t *coreTimerBlock);
+static void     apvDurationTimersAdvance(apvCoreTimerBlock_t *coreTimerBlock,
+                                         uint32_t             elapsedTicks);
+static void     apvDurationTimerEnqueue(apvCoreTimerBlock_t *coreTimerBlock,
+                                        uint32_t             timerIndex,
+                                        uint32_t             timerTicks);
+static void     apvDurationTimerDequeue(apvCoreTimerBlock_t *coreTimerBlock,
+                                        uint32_t             timerIndex);
+static void     apvDurationTimerDefer(apvCoreTimerBlock_t *coreTimerBlock,
+                                      uint32_t             timerIndex);
+static void     apvDurationTimerUnDefer(apvCoreTimerBlock_t *coreTimerBlock,
+                                        uint32_t             timerIndex);
+static uint32_t apvDurationTimerFromHandle(apvCoreTimerBlock_t      *coreTimerBlock,
+                                           apvDurationTimerHandle_t  timerHandle);
+static uint32_t apvDurationTimerTicklessElapsed(apvCoreTimerBlock_t *coreTimerBlock);
+static void     apvDurationTimerTicklessArm(apvCoreTimerBlock_t *coreTimerBlock);
+static uint64_t apvDurationTimerMinimum(uint64_t                 durationTimerInterval,
+                                        apvDurationTimerSource_t durationTimerSource);
+static uint64_t apvDurationTimerScale(uint64_t                 durationTimerInterval,
+                                      apvDurationTimerSource_t durationTimerSource);
+static uint64_t apvTimeScale(uint64_t timeValue,
+                             uint8_t  scalePreShift,
+                             uint32_t scaleMultiplier,
+                             uint8_t  scaleShift);
+
 /******************************************************************************/
 /* Function Definitions :                                                     */
 /******************************************************************************/
@@ -60,7 +95,6 @@ APV_ERROR_CODE apvInitialiseSystemTimer(apvCoreTimerBlock_t *coreTimerBlock,
 
   APV_ERROR_CODE systemTimerError = APV_ERROR_CODE_NONE;
 
-  uint32_t       timerIndex      = 0;
   uint64_t       timeBaseDivider = 0;
 
 /******************************************************************************/
@@ -91,20 +125,15 @@ APV_ERROR_CODE apvInitialiseSystemTimer(apvCoreTimerBlock_t *coreTimerBlock,
         }
 
       // Compute the number of ticks required
-      timeBaseDivider = systemTimerInterval / APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL;
+      timeBaseDivider = apvTimeScale(systemTimerInterval,
+                                     0,
+                                     APV_SYSTEM_TIMER_NS_CLOCKS_MULTIPLIER,
+                                     APV_SYSTEM_TIMER_NS_CLOCKS_SHIFT);
 
       coreTimerBlock->timeBaseDivider = timeBaseDivider;
 
       // Initialise the timer set
-      for (timerIndex = 0; timerIndex < APV_CORE_TIMER_DURATION_TIMERS; timerIndex++)
-        {
-        coreTimerBlock->durationTimer[timerIndex].durationTimerCallBack              = NULL;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerDownCounter           = APV_DURATION_TIMER_EXPIRED;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedTicks        = APV_DURATION_TIMER_EXPIRED;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerIndex                 = APV_DURATION_TIMER_NULL_INDEX;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedMicroSeconds = 0;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerType                  = APV_DURATION_TIMER_TYPE_NONE;
-        }
+      apvDurationTimersReset(coreTimerBlock);
       }
     }
 
@@ -186,6 +215,67 @@ APV_ERROR_CODE apvStartSystemTimer(apvCoreTimerBlock_t *coreTimerBlock)
 /******************************************************************************/
   } /* end of apvStartSystemTimer                                             */
 
+/******************************************************************************/
+/* apvStartTicklessTimer() :                                                  */
+/*                                                                            */
+/*  --> coreTimerBlock : the single core-timer block, set up by               */
+/*                       'apvInitialiseSystemTimer()'                         */
+/*                                                                            */
+/*  <-- systemTimerError : error codes                                        */
+/*                                                                            */
+/* - run the duration timers without the periodic system tick. The free-      */
+/*   running timestamp channel ('apvConfigureFreeRunningEventTimer()') RB     */
+/*   compare is set for the next timer due and moved on every assign, de-     */
+/*   assign and retrigger, so the interrupt rate follows the timers and not   */
+/*   the tick. Its' interrupt MUST be enabled in the NVIC by the caller and   */
+/*   lands in 'apvDurationTimerTicklessCallBack()'. Timing is still in whole  */
+/*   ticks of 'APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD'                         */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvStartTicklessTimer(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE systemTimerError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    systemTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    { // Cannot start if the system timer is already in use or there is nothing to compare against
+    if ((apvSystemTimerInUseFlag         == true) ||
+        (coreTimerBlock->timeBaseDivider == 0)    ||
+        (apvEventTimerTimestampChannel   == NULL))
+      {
+      systemTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+      }
+    else
+      {
+      APV_CRITICAL_REGION_ENTRY();
+
+      apvSystemTimerInUseFlag = true;
+
+      // Timers assigned before now count from now
+      coreTimerBlock->durationTimerTicklessChannel = apvEventTimerTimestampChannel;
+      coreTimerBlock->durationTimerTicklessBase    = APV_REGISTER_READ(apvEventTimerTimestampChannel, TC_CV);
+
+      apvDurationTimerTicklessArm(coreTimerBlock);
+
+      APV_CRITICAL_REGION_EXIT();
+      }
+    }
+
+/******************************************************************************/
+
+  return(systemTimerError);
+
+/******************************************************************************/
+  } /* end of apvStartTicklessTimer                                           */
+
 /******************************************************************************/
 /* apvInitialiseCoreTimer() :                                                 */
 /*                                                                            */
@@ -218,7 +308,6 @@ APV_ERROR_CODE apvInitialiseCoreTimer(apvCoreTimerBlock_t *coreTimerBlock,
 
   APV_ERROR_CODE coreTimerError  = APV_ERROR_CODE_NONE;
 
-  uint32_t       timerIndex      = 0;
   uint64_t       timeBaseDivider = 0;
 
 /******************************************************************************/
@@ -234,352 +323,1099 @@ APV_ERROR_CODE apvInitialiseCoreTimer(apvCoreTimerBlock_t *coreTimerBlock,
       coreTimerInterval = APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL;
       }
 
-    // Compute the timebase divider
-    timeBaseDivider = (coreTimerInterval * APV_CORE_TIMER_CLOCK_RATE) / APV_CORE_TIMER_CLOCK_RATE_SCALER;
+    // Compute the timebase divider : past the exact range the estimate may be one high
+    timeBaseDivider = apvTimeScale(coreTimerInterval,
+                                   0,
+                                   APV_CORE_TIMER_NS_SCLK_MULTIPLIER,
+                                   APV_CORE_TIMER_NS_SCLK_SHIFT);
+
+    if ((timeBaseDivider * APV_CORE_TIMER_NS_SCLK_DENOMINATOR) > (coreTimerInterval * APV_CORE_TIMER_NS_SCLK_NUMERATOR))
+      {
+      timeBaseDivider = timeBaseDivider - 1;
+      }
 
     coreTimerBlock->timeBaseDivider = timeBaseDivider;
 
     // Initialise the timer set
-    for (timerIndex = 0; timerIndex < APV_CORE_TIMER_DURATION_TIMERS; timerIndex++)
-      {
-      coreTimerBlock->durationTimer[timerIndex].durationTimerCallBack              = NULL;
-      coreTimerBlock->durationTimer[timerIndex].durationTimerDownCounter           = APV_DURATION_TIMER_EXPIRED;
-      coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedTicks        = APV_DURATION_TIMER_EXPIRED;
-      coreTimerBlock->durationTimer[timerIndex].durationTimerIndex                 = APV_DURATION_TIMER_NULL_INDEX;
-      coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedMicroSeconds = 0;
-      coreTimerBlock->durationTimer[timerIndex].durationTimerType                  = APV_DURATION_TIMER_TYPE_NONE;
-      }
+    apvDurationTimersReset(coreTimerBlock);
     }
 
     // Load the alarm register with one period per interrupt
-    RTT->RTT_AR = APV_CORE_TIMER_SINGLE_PERIOD;
+    APV_REGISTER_COMMAND(RTT, RTT_AR, APV_CORE_TIMER_SINGLE_PERIOD);
 
     // Load the timebase counter, enable the alarm interrupt and restart the timer
-    RTT->RTT_MR = (((uint32_t)timeBaseDivider) & APV_CORE_TIMER_CLOCK_DIVIDER_MASK) | RTT_MR_ALMIEN | RTT_MR_RTTRST;
+    APV_REGISTER_COMMAND(RTT, RTT_MR, (((uint32_t)timeBaseDivider) & APV_CORE_TIMER_CLOCK_DIVIDER_MASK) | RTT_MR_ALMIEN | RTT_MR_RTTRST);
+
+/******************************************************************************/
+
+  return(coreTimerError);
+
+/******************************************************************************/
+  } /* end of apvInitialiseCoreTimer                                          */
+
+/******************************************************************************/
+/* apvAssignDurationTimer() :                                                 */
+/*  --> coreTimerBlock        : the single core-timer block                   */
+/*  --> durationTimerCallBack : function to execute on timer expiry. This is  */
+/*                              the communications conduit from the generic   */
+/*                              core timers to the requesting process!        */
+/*  --> durationTimerContext  : passed to the callback (may be NULL)          */
+/*  --> durationTimerType     : [ APV_DURATION_TIMER_TYPE_NONE = 0 |          */
+/*                                APV_DURATION_TIMER_TYPE_ONE_SHOT |          */
+/*                                APV_DURATION_TIMER_TYPE_PERIODIC ]          */
+/*  --> durationTimerInterval : duration of the timer in nanoseconds; at most */
+/*                              APV_DURATION_TIMER_MAXIMUM_TICKS ticks        */
+/*  --> timerHandle           : the allocated process timer's handle or       */
+/*                              APV_DURATION_TIMER_NULL_HANDLE                */
+/*                                                                            */
+/*  <-- durationTimerError    : error codes                                   */
+/*                                                                            */
+/* - allocate a process timer off the free list. The communications conduit   */
+/*   from the core timer set to a requesting timer is the callback. When a    */
+/*   duration timer expires this callback will run from the main loop         */
+/*   ('apvRunDurationTimerCallBacks()') - not from the timer interrupt - so a */
+/*   slow callback delays only the main loop. THIS MECHANISM IS NOT INTENDED  */
+/*   FOR FINE-TIMED INTERRUPTS - USE A DEDICATED INTERRUPT TIMER FOR THAT -   */
+/*   IMPLEMENTED SIMILAR TO THE BACKGROUND LOOP TICK                          */
+/*                                                                            */
+/* Reference : SAM3X8E Datasheet 23.03.15 "Real-time Timer (RTT)", p234       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvAssignDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
+                                      void                    (*durationTimerCallBack)(void *durationEventMessage),
+                                      void                     *durationTimerContext,
+                                      apvDurationTimerType_t    durationTimerType,
+                                      uint64_t                  durationTimerInterval,
+                                      apvDurationTimerSource_t  durationTimerSource,
+                                      apvDurationTimerHandle_t *timerHandle
+                                      )
+  {
+/******************************************************************************/
+
+   APV_ERROR_CODE      durationTimerError  = APV_ERROR_CODE_NONE;
+   uint32_t            durationTimerTicks  = 0,
+                       timerIndex          = APV_DURATION_TIMER_NULL_INDEX;
+   uint64_t            scaledTicks         = 0;
+   apvDurationTimer_t *durationTimer       = NULL;
+
+/******************************************************************************/
+
+  if ((coreTimerBlock == NULL) || (durationTimerCallBack == NULL) || (timerHandle == NULL))
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    *timerHandle = APV_DURATION_TIMER_NULL_HANDLE;
+
+    // There is a minimum timing interval due to the chip architecture. The duration 
+    // timer counts down a number of ticks
+    durationTimerInterval = apvDurationTimerMinimum(durationTimerInterval,
+                                                    durationTimerSource);
+
+    scaledTicks           = apvDurationTimerScale(durationTimerInterval,
+                                                  durationTimerSource);
+
+    if ((durationTimerType >= APV_DURATION_TIMER_TYPES) || (scaledTicks > APV_DURATION_TIMER_MAXIMUM_TICKS))
+      {
+      durationTimerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      { 
+      durationTimerTicks = (uint32_t)scaledTicks;
+
+      /******************************************************************************/
+      /* The free timer is popped, filled and started in one critical region : an   */
+      /* interrupt or a callback can safely assign timers of its' own meanwhile     */
+      /******************************************************************************/
+
+      APV_CRITICAL_REGION_ENTRY();
+
+      timerIndex = coreTimerBlock->durationTimerFreeHead;
+
+      if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+        {
+        durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+
+        coreTimerBlock->durationTimerFreeHead = durationTimer->durationTimerFreeNext;
+
+        durationTimer->durationTimerFreeNext              = APV_DURATION_TIMER_NULL_INDEX;
+        durationTimer->durationTimerRequestedMicroSeconds = durationTimerInterval;
+        durationTimer->durationTimerRequestedTicks        = durationTimerTicks;
+        durationTimer->durationTimerSlackTicks            = 0;
+        durationTimer->durationTimerCallBack              = durationTimerCallBack;
+        durationTimer->durationTimerContext               = durationTimerContext;
+        durationTimer->durationTimerMissed                = 0;
+        durationTimer->durationTimerType                  = durationTimerType;
+        durationTimer->durationTimerSource                = durationTimerSource;
+        durationTimer->durationTimerHandle                = (durationTimer->durationTimerGeneration << APV_DURATION_TIMER_HANDLE_INDEX_BITS) | timerIndex;
+
+        apvDurationTimerEnqueue(coreTimerBlock,
+                                timerIndex,
+                                durationTimerTicks + apvDurationTimerTicklessElapsed(coreTimerBlock));
+
+        apvDurationTimerTicklessArm(coreTimerBlock);
+
+        *timerHandle = durationTimer->durationTimerHandle;
+        }
+
+      APV_CRITICAL_REGION_EXIT();
+
+      /******************************************************************************/
+
+      if (timerIndex == APV_DURATION_TIMER_NULL_INDEX)
+        { // Every timer is in use
+        durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvAssignDurationTimer                                          */
+
+/******************************************************************************/
+/* apvDeAssignDurationTimer() :                                               */
+/*  --> coreTimerBlock        : the single core-timer block                   */
+/*  --> timerHandle           : the process timer's handle; set to            */
+/*                              APV_DURATION_TIMER_NULL_HANDLE when freed     */
+/*                                                                            */
+/*  <-- durationTimerError    : error codes                                   */
+/*                                                                            */
+/* - stop a duration timer and put it back on the free list. Its' generation  */
+/*   moves on so any copy of the handle still held is refused from now on     */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvDeAssignDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
+                                        apvDurationTimerHandle_t *timerHandle)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE      durationTimerError = APV_ERROR_CODE_NONE;
+  uint32_t            timerIndex         = APV_DURATION_TIMER_NULL_INDEX;
+  apvDurationTimer_t *durationTimer      = NULL;
+
+/******************************************************************************/
+
+  if ((coreTimerBlock == NULL) || (timerHandle == NULL))
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_CRITICAL_REGION_ENTRY();
+
+    timerIndex = apvDurationTimerFromHandle(coreTimerBlock,
+                                            *timerHandle);
+
+    if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+
+      apvDurationTimerDequeue(coreTimerBlock,
+                              timerIndex);
+
+      // A callback still waiting would otherwise run for a timer that has gone
+      apvDurationTimerUnDefer(coreTimerBlock,
+                              timerIndex);
+
+      apvDurationTimerTicklessArm(coreTimerBlock);
+
+      durationTimer->durationTimerHandle     = APV_DURATION_TIMER_NULL_HANDLE;
+      durationTimer->durationTimerGeneration = (durationTimer->durationTimerGeneration + 1) & APV_DURATION_TIMER_GENERATION_MASK;
+      durationTimer->durationTimerType       = APV_DURATION_TIMER_TYPE_NONE;
+      durationTimer->durationTimerSlackTicks = 0;
+      durationTimer->durationTimerCallBack   = NULL;
+      durationTimer->durationTimerContext    = NULL;
+
+      durationTimer->durationTimerFreeNext  = coreTimerBlock->durationTimerFreeHead;
+      coreTimerBlock->durationTimerFreeHead = timerIndex;
+      }
+
+    APV_CRITICAL_REGION_EXIT();
+
+    if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      *timerHandle = APV_DURATION_TIMER_NULL_HANDLE;
+      }
+    else
+      { // A stale or made-up handle : nothing is touched
+      durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvDeAssignDurationTimer                                        */
+
+/******************************************************************************/
+/* apvReTriggerDurationTimer() :                                              */
+/*  --> coreTimerBlock        : the single core-timer block                   */
+/*  --> timerHandle           : the process timer's handle                    */
+/*  --> durationTimerInterval : duration of the timer in nanoseconds; at most */
+/*                              APV_DURATION_TIMER_MAXIMUM_TICKS ticks        */
+/*                                                                            */
+/*  <-- durationTimerError    : error codes                                   */
+/*                                                                            */
+/* - retrigger a duration timer with the same or a different period. A timer  */
+/*   that is still running is taken out of the queue and put back at its new  */
+/*   expiry; an expired one-shot timer is started again. The period is        */
+/*   converted for the tick source the timer was assigned with                */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvReTriggerDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
+                                         apvDurationTimerHandle_t  timerHandle,
+                                         uint64_t                  durationTimerInterval)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE           durationTimerError  = APV_ERROR_CODE_NONE;
+  uint32_t                 timerIndex          = APV_DURATION_TIMER_NULL_INDEX,
+                           durationTimerTicks  = 0;
+  uint64_t                 scaledTicks         = 0;
+  apvDurationTimerSource_t durationTimerSource = APV_DURATION_TIMER_SOURCE_SYSTICK;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_CRITICAL_REGION_ENTRY();
+
+    timerIndex = apvDurationTimerFromHandle(coreTimerBlock,
+                                            timerHandle);
+
+    if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      durationTimerSource   = coreTimerBlock->durationTimer[timerIndex].durationTimerSource;
+
+      durationTimerInterval = apvDurationTimerMinimum(durationTimerInterval,
+                                                      durationTimerSource);
+
+      scaledTicks           = apvDurationTimerScale(durationTimerInterval,
+                                                    durationTimerSource);
+
+      // An interval out of range leaves the timer running as it was
+      if (scaledTicks > APV_DURATION_TIMER_MAXIMUM_TICKS)
+        {
+        durationTimerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+        }
+      else
+        {
+        durationTimerTicks = (uint32_t)scaledTicks;
+
+        apvDurationTimerDequeue(coreTimerBlock,
+                                timerIndex);
+
+        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedMicroSeconds = durationTimerInterval;
+        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedTicks        = durationTimerTicks;
+
+        apvDurationTimerEnqueue(coreTimerBlock,
+                                timerIndex,
+                                durationTimerTicks + apvDurationTimerTicklessElapsed(coreTimerBlock));
+
+        apvDurationTimerTicklessArm(coreTimerBlock);
+        }
+      }
+
+    APV_CRITICAL_REGION_EXIT();
+
+    if (timerIndex == APV_DURATION_TIMER_NULL_INDEX)
+      {
+      durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvReTriggerDurationTimer                                       */
+
+/******************************************************************************/
+/* apvSetDurationTimerSlack() :                                               */
+/*  --> coreTimerBlock     : the single core-timer block                      */
+/*  --> timerHandle        : the process timer's handle                       */
+/*  --> durationTimerSlack : nanoseconds the expiry may be put off by or      */
+/*                           APV_DURATION_TIMER_SLACK_NONE                    */
+/*                                                                            */
+/*  <-- durationTimerError : error codes                                      */
+/*                                                                            */
+/* - tickless mode : let a timer that need not expire exactly share a compare */
+/*   interrupt with the timers due shortly after it. The slack is rounded     */
+/*   down to whole ticks so a timer is never later than asked; a periodic     */
+/*   timer's slack is kept under its' period. It lasts until the timer is     */
+/*   de-assigned and is kept through a retrigger                              */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSetDurationTimerSlack(apvCoreTimerBlock_t      *coreTimerBlock,
+                                        apvDurationTimerHandle_t  timerHandle,
+                                        uint64_t                  durationTimerSlack)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE durationTimerError = APV_ERROR_CODE_NONE;
+  uint32_t       timerIndex         = APV_DURATION_TIMER_NULL_INDEX;
+  uint64_t       slackTicks         = 0;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_CRITICAL_REGION_ENTRY();
+
+    timerIndex = apvDurationTimerFromHandle(coreTimerBlock,
+                                            timerHandle);
+
+    if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      slackTicks = apvDurationTimerScale(durationTimerSlack,
+                                         coreTimerBlock->durationTimer[timerIndex].durationTimerSource);
+
+      if (slackTicks > APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS)
+        {
+        slackTicks = APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS;
+        }
+
+      coreTimerBlock->durationTimer[timerIndex].durationTimerSlackTicks = (uint32_t)slackTicks;
+
+      apvDurationTimerTicklessArm(coreTimerBlock);
+      }
+
+    APV_CRITICAL_REGION_EXIT();
+
+    if (timerIndex == APV_DURATION_TIMER_NULL_INDEX)
+      {
+      durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvSetDurationTimerSlack                                        */
+
+/******************************************************************************/
+/* apvExecuteDurationTimers() :                                               */
+/*                                                                            */
+/*  --> coreTimerBlock        : the single core-timer block                   */
+/*                                                                            */
+/*  <-- durationTimerError    : error codes                                   */
+/*                                                                            */
+/* - one tick of the core-timer process timers or, in tickless mode, the      */
+/*   compare interrupt : count the elapsed ticks off the delta queue, defer   */
+/*   the expired timers' callbacks and set the compare for the next timer due */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvExecuteDurationTimers(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE durationTimerError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (coreTimerBlock->durationTimerTicklessChannel == NULL)
+      {
+      apvDurationTimersAdvance(coreTimerBlock,
+                               APV_DURATION_TIMER_TICK);
+      }
+    else
+      { // A timer is due or a long wait has reached its' next step
+      apvDurationTimersAdvance(coreTimerBlock,
+                               apvDurationTimerTicklessElapsed(coreTimerBlock));
+
+      apvDurationTimerTicklessArm(coreTimerBlock);
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvExecuteDurationTimers                                        */
+
+/******************************************************************************/
+/* apvRunDurationTimerCallBacks() :                                           */
+/*                                                                            */
+/*  --> coreTimerBlock        : the single core-timer block                   */
+/*                                                                            */
+/*  <-- durationTimerError    : error codes                                   */
+/*                                                                            */
+/* - main loop : run the callbacks of the expired timers, oldest first, with  */
+/*   interrupts masked only to take each off the deferred list. At most one   */
+/*   pass of the timer set is run per call; if more are waiting the core      */
+/*   timer flag is raised again so the main loop comes back before sleeping   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvRunDurationTimerCallBacks(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE   durationTimerError    = APV_ERROR_CODE_NONE;
+  uint32_t         timerIndex            = APV_DURATION_TIMER_NULL_INDEX,
+                   callBacks             = 0;
+  void           (*durationTimerCallBack)(void *durationEventMessage) = NULL;
+  void            *durationTimerContext  = NULL;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    do
+      {
+      APV_CRITICAL_REGION_ENTRY();
+
+      timerIndex = coreTimerBlock->durationTimerDeferredHead;
+
+      if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+        {
+        durationTimerCallBack = coreTimerBlock->durationTimer[timerIndex].durationTimerCallBack;
+        durationTimerContext  = coreTimerBlock->durationTimer[timerIndex].durationTimerContext;
+
+        // Taken off first : if the timer expires again while the callback runs it is deferred again
+        apvDurationTimerUnDefer(coreTimerBlock,
+                                timerIndex);
+        }
+
+      APV_CRITICAL_REGION_EXIT();
+
+      if (timerIndex != APV_DURATION_TIMER_NULL_INDEX)
+        {
+        durationTimerCallBack(durationTimerContext);
+
+        callBacks = callBacks + 1;
+        }
+      }
+    while ((timerIndex != APV_DURATION_TIMER_NULL_INDEX) && (callBacks < APV_CORE_TIMER_DURATION_TIMERS));
+
+    if (coreTimerBlock->durationTimerDeferredHead != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      apvCoreTimerFlag = APV_CORE_TIMER_FLAG_HIGH;
+      }
+    }
+
+/******************************************************************************/
+
+  return(durationTimerError);
+
+/******************************************************************************/
+  } /* end of apvRunDurationTimerCallBacks                                    */
+
+/******************************************************************************/
+/* apvDurationTimersReset() :                                                 */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*                                                                            */
+/* - free every duration timer onto the free list and empty the delta queue   */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimersReset(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  uint32_t timerIndex = 0;
+
+/******************************************************************************/
+
+  for (timerIndex = 0; timerIndex < APV_CORE_TIMER_DURATION_TIMERS; timerIndex++)
+    {
+    coreTimerBlock->durationTimer[timerIndex].durationTimerCallBack              = NULL;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedTicks        = APV_DURATION_TIMER_EXPIRED;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerDelta                 = APV_DURATION_TIMER_EXPIRED;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerSlackTicks            = 0;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerNext                  = APV_DURATION_TIMER_NULL_INDEX;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerPrevious              = APV_DURATION_TIMER_NULL_INDEX;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerQueued                = false;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerDeferredNext          = APV_DURATION_TIMER_NULL_INDEX;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerDeferred              = false;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerMissed                = 0;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerContext               = NULL;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerHandle                = APV_DURATION_TIMER_NULL_HANDLE;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerGeneration            = 0;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerFreeNext              = ((timerIndex + 1) < APV_CORE_TIMER_DURATION_TIMERS) ? (timerIndex + 1) : APV_DURATION_TIMER_NULL_INDEX;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedMicroSeconds = 0;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerType                  = APV_DURATION_TIMER_TYPE_NONE;
+    coreTimerBlock->durationTimer[timerIndex].durationTimerSource                = APV_DURATION_TIMER_SOURCE_SYSTICK;
+    }
+
+  coreTimerBlock->durationTimerQueueHead       = APV_DURATION_TIMER_NULL_INDEX;
+  coreTimerBlock->durationTimerTicklessChannel = NULL;
+  coreTimerBlock->durationTimerTicklessBase    = 0;
+  coreTimerBlock->durationTimerDeferredHead    = APV_DURATION_TIMER_NULL_INDEX;
+  coreTimerBlock->durationTimerDeferredTail    = APV_DURATION_TIMER_NULL_INDEX;
+  coreTimerBlock->durationTimerFreeHead        = 0;
+
+/******************************************************************************/
+  } /* end of apvDurationTimersReset                                          */
+
+/******************************************************************************/
+/* apvDurationTimersAdvance() :                                               */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> elapsedTicks   : ticks gone by since the queue base                   */
+/*                                                                            */
+/* - take every timer due within the elapsed ticks off the delta queue in     */
+/*   expiry order and count the rest off the head. Each expiry moves the      */
+/*   queue base up to it, so a periodic timer is put back a full period on    */
+/*   from its' own expiry (however late this runs) before its' callback is    */
+/*   deferred. The cost is O(expired timers), not O(timers)                   */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimersAdvance(apvCoreTimerBlock_t *coreTimerBlock,
+                                     uint32_t             elapsedTicks)
+  {
+/******************************************************************************/
+
+  uint32_t            timerIndex    = coreTimerBlock->durationTimerQueueHead;
+  apvDurationTimer_t *durationTimer = NULL;
+
+/******************************************************************************/
+
+  // Timers due on the same tick follow the first with a zero delta
+  while ((timerIndex                                                   != APV_DURATION_TIMER_NULL_INDEX) &&
+         (coreTimerBlock->durationTimer[timerIndex].durationTimerDelta <= elapsedTicks))
+    {
+    durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+
+    elapsedTicks                              = elapsedTicks - durationTimer->durationTimerDelta;
+    coreTimerBlock->durationTimerTicklessBase = coreTimerBlock->durationTimerTicklessBase + (durationTimer->durationTimerDelta * APV_DURATION_TIMER_TICKLESS_TICK_COUNTS);
+    durationTimer->durationTimerDelta         = APV_DURATION_TIMER_EXPIRED;
+
+    apvDurationTimerDequeue(coreTimerBlock,
+                            timerIndex);
+
+    if (durationTimer->durationTimerType == APV_DURATION_TIMER_TYPE_PERIODIC)
+      {
+      apvDurationTimerEnqueue(coreTimerBlock,
+                              timerIndex,
+                              durationTimer->durationTimerRequestedTicks);
+      }
+
+    apvDurationTimerDefer(coreTimerBlock,
+                          timerIndex);
+
+    timerIndex = coreTimerBlock->durationTimerQueueHead;
+    }
+
+  if ((timerIndex != APV_DURATION_TIMER_NULL_INDEX) && (elapsedTicks != 0))
+    {
+    coreTimerBlock->durationTimer[timerIndex].durationTimerDelta = coreTimerBlock->durationTimer[timerIndex].durationTimerDelta - elapsedTicks;
+    coreTimerBlock->durationTimerTicklessBase                    = coreTimerBlock->durationTimerTicklessBase + (elapsedTicks * APV_DURATION_TIMER_TICKLESS_TICK_COUNTS);
+    }
+
+/******************************************************************************/
+  } /* end of apvDurationTimersAdvance                                        */
+
+/******************************************************************************/
+/* apvDurationTimerEnqueue() :                                                */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> timerIndex     : the process timer to start                           */
+/*  --> timerTicks     : ticks from the queue base to its' expiry             */
+/*                                                                            */
+/* - MUST be called with interrupts masked or from the tick : walk the delta  */
+/*   queue spending the ticks on the timers due no later, then insert the     */
+/*   timer with what is left and take that off its' successors' delta         */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimerEnqueue(apvCoreTimerBlock_t *coreTimerBlock,
+                                    uint32_t             timerIndex,
+                                    uint32_t             timerTicks)
+  {
+/******************************************************************************/
+
+  apvDurationTimer_t *durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+  uint32_t            previous      = APV_DURATION_TIMER_NULL_INDEX,
+                      next          = coreTimerBlock->durationTimerQueueHead;
+
+/******************************************************************************/
+
+  if (timerTicks < APV_DURATION_TIMER_MINIMUM_TICKS)
+    {
+    timerTicks = APV_DURATION_TIMER_MINIMUM_TICKS;
+    }
+
+  // Timers due on the same tick expire in the order they were started
+  while ((next != APV_DURATION_TIMER_NULL_INDEX) && (coreTimerBlock->durationTimer[next].durationTimerDelta <= timerTicks))
+    {
+    timerTicks = timerTicks - coreTimerBlock->durationTimer[next].durationTimerDelta;
+    previous   = next;
+    next       = coreTimerBlock->durationTimer[next].durationTimerNext;
+    }
+
+  durationTimer->durationTimerDelta    = timerTicks;
+  durationTimer->durationTimerNext     = next;
+  durationTimer->durationTimerPrevious = previous;
+  durationTimer->durationTimerQueued   = true;
+
+  if (next != APV_DURATION_TIMER_NULL_INDEX)
+    {
+    coreTimerBlock->durationTimer[next].durationTimerDelta    = coreTimerBlock->durationTimer[next].durationTimerDelta - timerTicks;
+    coreTimerBlock->durationTimer[next].durationTimerPrevious = timerIndex;
+    }
+
+  if (previous != APV_DURATION_TIMER_NULL_INDEX)
+    {
+    coreTimerBlock->durationTimer[previous].durationTimerNext = timerIndex;
+    }
+  else
+    {
+    coreTimerBlock->durationTimerQueueHead = timerIndex;
+    }
+
+/******************************************************************************/
+  } /* end of apvDurationTimerEnqueue                                         */
+
+/******************************************************************************/
+/* apvDurationTimerDequeue() :                                                */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> timerIndex     : the process timer to stop                            */
+/*                                                                            */
+/* - MUST be called with interrupts masked or from the tick : unlink a        */
+/*   running timer, handing its' delta on to its' successor so the expiry of  */
+/*   the rest of the queue is unchanged                                       */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimerDequeue(apvCoreTimerBlock_t *coreTimerBlock,
+                                    uint32_t             timerIndex)
+  {
+/******************************************************************************/
+
+  apvDurationTimer_t *durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+
+/******************************************************************************/
+
+  if (durationTimer->durationTimerQueued == true)
+    {
+    if (durationTimer->durationTimerNext != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      coreTimerBlock->durationTimer[durationTimer->durationTimerNext].durationTimerDelta    = coreTimerBlock->durationTimer[durationTimer->durationTimerNext].durationTimerDelta + 
+                                                                                              durationTimer->durationTimerDelta;
+      coreTimerBlock->durationTimer[durationTimer->durationTimerNext].durationTimerPrevious = durationTimer->durationTimerPrevious;
+      }
+
+    if (durationTimer->durationTimerPrevious != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      coreTimerBlock->durationTimer[durationTimer->durationTimerPrevious].durationTimerNext = durationTimer->durationTimerNext;
+      }
+    else
+      {
+      coreTimerBlock->durationTimerQueueHead = durationTimer->durationTimerNext;
+      }
+
+    durationTimer->durationTimerNext     = APV_DURATION_TIMER_NULL_INDEX;
+    durationTimer->durationTimerPrevious = APV_DURATION_TIMER_NULL_INDEX;
+    durationTimer->durationTimerDelta    = APV_DURATION_TIMER_EXPIRED;
+    durationTimer->durationTimerQueued   = false;
+    }
+
+/******************************************************************************/
+  } /* end of apvDurationTimerDequeue                                         */
+
+/******************************************************************************/
+/* apvDurationTimerDefer() :                                                  */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> timerIndex     : the expired process timer                            */
+/*                                                                            */
+/* - MUST be called with interrupts masked or from the tick : add an expired  */
+/*   timer to the tail of the deferred list. A timer already on it is only    */
+/*   counted as missed so the list never holds more than the timer set        */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimerDefer(apvCoreTimerBlock_t *coreTimerBlock,
+                                  uint32_t             timerIndex)
+  {
+/******************************************************************************/
+
+  apvDurationTimer_t *durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+
+/******************************************************************************/
+
+  if (durationTimer->durationTimerDeferred == true)
+    {
+    durationTimer->durationTimerMissed = durationTimer->durationTimerMissed + 1;
+    }
+  else
+    {
+    durationTimer->durationTimerDeferred     = true;
+    durationTimer->durationTimerDeferredNext = APV_DURATION_TIMER_NULL_INDEX;
+
+    if (coreTimerBlock->durationTimerDeferredTail != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      coreTimerBlock->durationTimer[coreTimerBlock->durationTimerDeferredTail].durationTimerDeferredNext = timerIndex;
+      }
+    else
+      {
+      coreTimerBlock->durationTimerDeferredHead = timerIndex;
+      }
+
+    coreTimerBlock->durationTimerDeferredTail = timerIndex;
+    }
+
+/******************************************************************************/
+  } /* end of apvDurationTimerDefer                                           */
+
+/******************************************************************************/
+/* apvDurationTimerUnDefer() :                                                */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> timerIndex     : the process timer to take off the deferred list      */
+/*                                                                            */
+/* - MUST be called with interrupts masked : the list is singly-linked so     */
+/*   the predecessor is searched for; it is nearly always the head            */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvDurationTimerUnDefer(apvCoreTimerBlock_t *coreTimerBlock,
+                                    uint32_t             timerIndex)
+  {
+/******************************************************************************/
+
+  apvDurationTimer_t *durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+  uint32_t            previous      = APV_DURATION_TIMER_NULL_INDEX,
+                      next          = coreTimerBlock->durationTimerDeferredHead;
+
+/******************************************************************************/
+
+  if (durationTimer->durationTimerDeferred == true)
+    {
+    while ((next != APV_DURATION_TIMER_NULL_INDEX) && (next != timerIndex))
+      {
+      previous = next;
+      next     = coreTimerBlock->durationTimer[next].durationTimerDeferredNext;
+      }
+
+    if (previous != APV_DURATION_TIMER_NULL_INDEX)
+      {
+      coreTimerBlock->durationTimer[previous].durationTimerDeferredNext = durationTimer->durationTimerDeferredNext;
+      }
+    else
+      {
+      coreTimerBlock->durationTimerDeferredHead = durationTimer->durationTimerDeferredNext;
+      }
+
+    if (coreTimerBlock->durationTimerDeferredTail == timerIndex)
+      {
+      coreTimerBlock->durationTimerDeferredTail = previous;
+      }
+
+    durationTimer->durationTimerDeferredNext = APV_DURATION_TIMER_NULL_INDEX;
+    durationTimer->durationTimerDeferred     = false;
+    }
+
+/******************************************************************************/
+  } /* end of apvDurationTimerUnDefer                                         */
+
+/******************************************************************************/
+/* apvDurationTimerFromHandle() :                                             */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  --> timerHandle    : a duration timer handle from the caller              */
+/*  <-- timerIndex     : the timer's slot or APV_DURATION_TIMER_NULL_INDEX if */
+/*                       the handle is not one currently assigned             */
+/*                                                                            */
+/* - the index is range-checked before the slot is read and the whole handle  */
+/*   must match the slot's so a freed or reused timer's handle is refused     */
+/*                                                                            */
+/******************************************************************************/
+
+static uint32_t apvDurationTimerFromHandle(apvCoreTimerBlock_t      *coreTimerBlock,
+                                           apvDurationTimerHandle_t  timerHandle)
+  {
+/******************************************************************************/
+
+  uint32_t timerIndex = timerHandle & APV_DURATION_TIMER_HANDLE_INDEX_MASK;
+
+/******************************************************************************/
+
+  if ((timerHandle                                                    == APV_DURATION_TIMER_NULL_HANDLE) ||
+      (timerIndex                                                     >= APV_CORE_TIMER_DURATION_TIMERS) ||
+      (coreTimerBlock->durationTimer[timerIndex].durationTimerHandle != timerHandle))
+    {
+    timerIndex = APV_DURATION_TIMER_NULL_INDEX;
+    }
+
+/******************************************************************************/
+
+  return(timerIndex);
+
+/******************************************************************************/
+  } /* end of apvDurationTimerFromHandle                                      */
+
+/******************************************************************************/
+/* apvDurationTimerTicklessElapsed() :                                        */
+/*  --> coreTimerBlock : the single core-timer block                          */
+/*  <-- elapsedTicks   : whole ticks since the queue base; always 0 with the  */
+/*                       periodic tick                                        */
+/*                                                                            */
+/* - MUST be called with interrupts masked or from the compare interrupt. An  */
+/*   empty queue has nothing counted from its' base so it is moved up to now  */
+/*                                                                            */
+/******************************************************************************/
+
+static uint32_t apvDurationTimerTicklessElapsed(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  uint32_t elapsedTicks = 0,
+           timestamp    = 0;
+
+/******************************************************************************/
+
+  if (coreTimerBlock->durationTimerTicklessChannel != NULL)
+    {
+    timestamp = APV_REGISTER_READ(coreTimerBlock->durationTimerTicklessChannel, TC_CV);
+
+    if (coreTimerBlock->durationTimerQueueHead == APV_DURATION_TIMER_NULL_INDEX)
+      {
+      coreTimerBlock->durationTimerTicklessBase = timestamp;
+      }
+    else
+      { // The compare never waits long enough for the counter to lap the base
+      elapsedTicks = (timestamp - coreTimerBlock->durationTimerTicklessBase) / APV_DURATION_TIMER_TICKLESS_TICK_COUNTS;
+      }
+    }
 
 /******************************************************************************/
 
-  return(coreTimerError);
+  return(elapsedTicks);
 
 /******************************************************************************/
-  } /* end of apvInitialiseCoreTimer                                          */
+  } /* end of apvDurationTimerTicklessElapsed                                 */
 
 /******************************************************************************/
-/* apvAssignDurationTimer() :                                                 */
-/*  --> coreTimerBlock        : the single core-timer block                   */
-/*  --> durationTimerCallBack : function to execute on timer expiry. This is  */
-/*                              the communications conduit from the generic   */
-/*                              core timers to the requesting process!        */
-/*  --> durationTimerType     : [ APV_DURATION_TIMER_TYPE_NONE = 0 |          */
-/*                                APV_DURATION_TIMER_TYPE_ONE_SHOT |          */
-/*                                APV_DURATION_TIMER_TYPE_PERIODIC ]          */
-/*  --> durationTimerInterval : duration of the timer in nanoseconds          */
-/*  --> timerIndex            : the allocated process timer index (if any)    */
-/*                                                                            */
-/*  <-- durationTimerError    : error codes                                   */
+/* apvDurationTimerTicklessArm() :                                            */
+/*  --> coreTimerBlock : the single core-timer block                          */
 /*                                                                            */
-/* - allocate a process timer. The communications conduit from the core timer */
-/*   set to a requesting timer is the callback. When a duration timer expires */
-/*   this callback will run...if all the duration timers expire at the same   */
-/*   time ALL the callbacks will run. As a good design principle any and all  */
-/*   callbacks should do very little other than set a flag! THIS MECHANISM IS */
-/*   NOT INTENDED FOR FINE-TIMED INTERRUPTS - USE A DEDICATED INTERRUPT TIMER */
-/*   FOR THAT - IMPLEMENTED SIMILAR TO THE BACKGROUND LOOP TICK               */
-/*                                                                            */
-/* Reference : SAM3X8E Datasheet 23.03.15 "Real-time Timer (RTT)", p234       */
+/* - MUST be called with interrupts masked or from the compare interrupt :    */
+/*   set the compare for the head of the delta queue or switch the interrupt  */
+/*   off if the queue is empty. Timers with slack move the compare out to the */
+/*   earliest latest-acceptable expiry of the timers due by then, so they all */
+/*   expire on the one interrupt; only those timers are visited. A wait       */
+/*   longer than the compare range is made in steps and a compare already     */
+/*   passed (or too close to be sure of) is brought forward to just ahead of  */
+/*   the counter. Nothing to do with the periodic tick                        */
 /*                                                                            */
 /******************************************************************************/
 
-APV_ERROR_CODE apvAssignDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
-                                      void                    (*durationTimerCallBack)(void *durationEventMessage),
-                                      apvDurationTimerType_t    durationTimerType,
-                                      uint64_t                  durationTimerInterval,
-                                      apvDurationTimerSource_t  durationTimerSource,
-                                      uint32_t                 *timerIndex
-                                      )
+static void apvDurationTimerTicklessArm(apvCoreTimerBlock_t *coreTimerBlock)
   {
 /******************************************************************************/
 
-   APV_ERROR_CODE durationTimerError  = APV_ERROR_CODE_NONE;
-   uint32_t       durationTimerTicks  = 0;
+  TcChannel          *ticklessChannel = coreTimerBlock->durationTimerTicklessChannel;
+  apvDurationTimer_t *durationTimer   = NULL;
+  uint32_t            timerIndex      = APV_DURATION_TIMER_NULL_INDEX,
+                      headTicks       = 0,
+                      expiryTicks     = 0,
+                      latestTicks     = 0,
+                      compare         = 0,
+                      timestamp       = 0;
 
 /******************************************************************************/
 
-  if ((coreTimerBlock == NULL) || (durationTimerCallBack == NULL))
-    {
-    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
-    }
-  else
+  if (ticklessChannel != NULL)
     {
-    if (durationTimerType >= APV_DURATION_TIMER_TYPES)
+    if (coreTimerBlock->durationTimerQueueHead == APV_DURATION_TIMER_NULL_INDEX)
       {
-      durationTimerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      APV_REGISTER_COMMAND(ticklessChannel, TC_IDR, TC_IDR_CPBS);
       }
     else
-      { 
-      // There is a minimum timing interval due to the chip architecture
-      if (durationTimerSource == APV_DURATION_TIMER_SOURCE_RTT)
+      {
+      timerIndex = coreTimerBlock->durationTimerQueueHead;
+      headTicks  = APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS + APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS;
+
+      // Walk the timers due no later than the earliest latest-acceptable expiry found so far.
+      // 'expiryTicks' never passes 'headTicks' so the sums are compared as differences
+      while ((timerIndex != APV_DURATION_TIMER_NULL_INDEX) && (coreTimerBlock->durationTimer[timerIndex].durationTimerDelta <= (headTicks - expiryTicks)))
         {
-        if (durationTimerInterval < APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL)
-          {
-          durationTimerInterval = APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL;
+        durationTimer = &coreTimerBlock->durationTimer[timerIndex];
+        expiryTicks   = expiryTicks + durationTimer->durationTimerDelta;
+        latestTicks   = durationTimer->durationTimerSlackTicks;
+
+        if ((durationTimer->durationTimerType == APV_DURATION_TIMER_TYPE_PERIODIC) && (latestTicks >= durationTimer->durationTimerRequestedTicks))
+          { // A later expiry would run into the next period
+          latestTicks = durationTimer->durationTimerRequestedTicks - APV_DURATION_TIMER_TICK;
           }
 
-        // The duration timer counts down a number of ticks
-        durationTimerTicks = durationTimerInterval / APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL;
-        }
-      else
-        {
-        if (durationTimerInterval < APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL)
+        if (latestTicks < (headTicks - expiryTicks))
           {
-          durationTimerInterval = APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL;
+          headTicks = expiryTicks + latestTicks;
           }
 
-        durationTimerTicks = durationTimerInterval / APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD;
+        timerIndex = durationTimer->durationTimerNext;
         }
 
-      /******************************************************************************/
-      /* The set of available process timers is small, just do a linear search for  */
-      /* a free one - the mechanism below will only work if only one process at a   */
-      /* uses this code. IF THAT IS NOT THE CASE PROTECT THE WHOLE BLOCK!           */
-      /******************************************************************************/
-
-      *timerIndex = 0;
-
-      while ((coreTimerBlock->durationTimer[*timerIndex].durationTimerIndex != APV_DURATION_TIMER_NULL_INDEX) && 
-             (*timerIndex                                                   <  APV_CORE_TIMER_DURATION_TIMERS))
+      if (headTicks > APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS)
         {
-        *timerIndex = *timerIndex + 1;
+        headTicks = APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS;
         }
 
-      if (*timerIndex != APV_CORE_TIMER_DURATION_TIMERS)
-        { // Initialise the requested process timer block
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerDownCounter           =  durationTimerTicks;
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerRequestedMicroSeconds =  durationTimerInterval;
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerRequestedTicks        =  durationTimerTicks;
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerCallBack              =  durationTimerCallBack;
-
-        /******************************************************************************/
-        /* At this point the interrupt service routine can execute the timer if these */
-        /* fields are populated. Ensure coherency!                                    */
-        /******************************************************************************/
-
-        APV_CRITICAL_REGION_ENTRY();
-
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerIndex                 = *timerIndex;
-        coreTimerBlock->durationTimer[*timerIndex].durationTimerType                  =  durationTimerType;
+      compare   = coreTimerBlock->durationTimerTicklessBase + (headTicks * APV_DURATION_TIMER_TICKLESS_TICK_COUNTS);
+      timestamp = APV_REGISTER_READ(ticklessChannel, TC_CV);
 
-        APV_CRITICAL_REGION_EXIT();
-
-        /******************************************************************************/
-        }
-      else
+      // A compare "behind" the counter wraps to a huge distance
+      if (((compare - timestamp) < APV_DURATION_TIMER_TICKLESS_GUARD_COUNTS) ||
+          ((compare - timestamp) > APV_DURATION_TIMER_TICKLESS_COMPARE_RANGE))
         {
-        durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+        compare = timestamp + APV_DURATION_TIMER_TICKLESS_GUARD_COUNTS;
         }
+
+      APV_REGISTER_COMMAND(ticklessChannel, TC_RB,  compare);
+      APV_REGISTER_COMMAND(ticklessChannel, TC_IER, TC_IER_CPBS);
       }
     }
 
 /******************************************************************************/
-
-  return(durationTimerError);
-
-/******************************************************************************/
-  } /* end of apvAssignDurationTimer                                          */
+  } /* end of apvDurationTimerTicklessArm                                     */
 
 /******************************************************************************/
-/* apvDeAssignDurationTimer() :                                               */
-/*  --> coreTimerBlock        : the single core-timer block                   */
-/*  --> timerIndex            : the allocated process timer index (if any)    */
-/*                                                                            */
-/*  - remove a duration timer from the list                                   */
+/* apvDurationTimerMinimum() :                                                */
+/*  --> durationTimerInterval : the requested interval in nanoseconds         */
+/*  --> durationTimerSource   : the tick the timer counts                     */
+/*  <-- durationTimerInterval : the interval raised to the sources' minimum   */
 /*                                                                            */
 /******************************************************************************/
 
-APV_ERROR_CODE apvDeAssignDurationTimer(apvCoreTimerBlock_t *coreTimerBlock,
-                                        uint32_t            *timerIndex)
+static uint64_t apvDurationTimerMinimum(uint64_t                 durationTimerInterval,
+                                        apvDurationTimerSource_t durationTimerSource)
   {
 /******************************************************************************/
 
-  APV_ERROR_CODE durationTimerError = APV_ERROR_CODE_NONE;
-  uint32_t       durationTimerIndex = 0;
+  uint64_t minimumInterval = APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL;
 
 /******************************************************************************/
 
-  if ((coreTimerBlock != NULL) && (*timerIndex < APV_CORE_TIMER_DURATION_TIMERS))
+  if (durationTimerSource == APV_DURATION_TIMER_SOURCE_RTT)
     {
-    // Search for this index
-    while (durationTimerIndex < APV_CORE_TIMER_DURATION_TIMERS)
-      {
-      // If the index is found deallocate it's slot
-      if (durationTimerIndex == *timerIndex)
-        {
-        APV_CRITICAL_REGION_ENTRY();
-
-         coreTimerBlock->durationTimer[*timerIndex].durationTimerIndex = APV_DURATION_TIMER_NULL_INDEX;
-         coreTimerBlock->durationTimer[*timerIndex].durationTimerType  = APV_DURATION_TIMER_TYPE_NONE;
-
-        APV_CRITICAL_REGION_EXIT();
-
-        *timerIndex = APV_DURATION_TIMER_NULL_INDEX;
-
-        break;
-        }
-
-      durationTimerIndex = durationTimerIndex + 1;
-      }
-
-    // If the loop fell out without finding the index - error!
-    if (durationTimerIndex == APV_CORE_TIMER_DURATION_TIMERS)
-      {
-      durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;     
-      }
+    minimumInterval = APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL;
     }
-  else
+
+  if (durationTimerInterval < minimumInterval)
     {
-    durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+    durationTimerInterval = minimumInterval;
     }
 
 /******************************************************************************/
 
-  return(durationTimerError);
+  return(durationTimerInterval);
 
 /******************************************************************************/
-  } /* end of apvDeAssignDurationTimer                                        */
+  } /* end of apvDurationTimerMinimum                                         */
 
 /******************************************************************************/
-/* apvReTriggerDurationTimer() :                                              */
-/*  --> coreTimerBlock        : the single core-timer block                   */
-/*  --> timerIndex            : the allocated process timer index (if any)    */
-/*  --> durationTimerInterval : duration of the timer in nanoseconds          */
+/* apvDurationTimerScale() :                                                  */
+/*  --> durationTimerInterval : an interval in nanoseconds                    */
+/*  --> durationTimerSource   : the tick the timer counts                     */
+/*  <-- durationTimerTicks    : the interval in whole ticks of that source    */
 /*                                                                            */
-/* - retrigger a duration timer with the same or a different period           */
+/* - the RTT counts 'APV_CORE_TIMER_NS_TICKS'; SysTick and the tickless       */
+/*   compare count 'APV_DURATION_TIMER_NS_TICKS'                              */
 /*                                                                            */
 /******************************************************************************/
 
-APV_ERROR_CODE apvReTriggerDurationTimer(apvCoreTimerBlock_t *coreTimerBlock,
-                                         uint32_t             timerIndex,
-                                         uint64_t             durationTimerInterval)
+static uint64_t apvDurationTimerScale(uint64_t                 durationTimerInterval,
+                                      apvDurationTimerSource_t durationTimerSource)
   {
 /******************************************************************************/
 
-  APV_ERROR_CODE durationTimerError = APV_ERROR_CODE_NONE;
-  uint32_t       durationTimerIndex = 0,
-                 durationTimerTicks = 0;
+  uint64_t durationTimerTicks = 0;
 
 /******************************************************************************/
 
-  if ((coreTimerBlock != NULL) && (timerIndex < APV_CORE_TIMER_DURATION_TIMERS))
+  if (durationTimerSource == APV_DURATION_TIMER_SOURCE_RTT)
     {
-    // Search for this index
-    while (durationTimerIndex < APV_CORE_TIMER_DURATION_TIMERS)
-      {
-      // If the index is found reset the timer interval
-      if (durationTimerIndex == timerIndex)
-        {
-        if (durationTimerInterval < APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL)
-          {
-          durationTimerInterval = APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL;
-          }
-
-        durationTimerTicks = durationTimerInterval / APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD;
-
-        APV_CRITICAL_REGION_ENTRY();
-
-        coreTimerBlock->durationTimer[timerIndex].durationTimerDownCounter           =  durationTimerTicks;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedMicroSeconds =  durationTimerInterval;
-        coreTimerBlock->durationTimer[timerIndex].durationTimerRequestedTicks        =  durationTimerTicks;
-
-        APV_CRITICAL_REGION_EXIT();
-
-        break;
-        }
-
-      durationTimerIndex = durationTimerIndex + 1;
-      }
-
-    // If the loop fell out without finding the index - error!
-    if (durationTimerIndex == APV_CORE_TIMER_DURATION_TIMERS)
-      {
-      durationTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;     
-      }
+    durationTimerTicks = apvTimeScale(durationTimerInterval,
+                                      0,
+                                      APV_CORE_TIMER_NS_TICKS_MULTIPLIER,
+                                      APV_CORE_TIMER_NS_TICKS_SHIFT);
     }
   else
     {
-    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    durationTimerTicks = apvTimeScale(durationTimerInterval,
+                                      APV_DURATION_TIMER_NS_TICKS_PRESHIFT,
+                                      APV_DURATION_TIMER_NS_TICKS_MULTIPLIER,
+                                      APV_DURATION_TIMER_NS_TICKS_SHIFT);
     }
 
 /******************************************************************************/
 
-  return(durationTimerError);
+  return(durationTimerTicks);
 
 /******************************************************************************/
-  } /* end of apvReTriggerDurationTimer                                       */
+  } /* end of apvDurationTimerScale                                           */
 
 /******************************************************************************/
-/* apvExecuteDurationTimers() :                                               */
-/*                                                                            */
-/*  --> coreTimerBlock        : the single core-timer block                   */
-/*                                                                            */
-/*  <-- durationTimerError    : error codes                                   */
+/* apvTimeScale() :                                                           */
+/*  --> timeValue       : the time to convert                                 */
+/*  --> scalePreShift   : the power of two taken out of the ratio's           */
+/*                        denominator                                         */
+/*  --> scaleMultiplier : the ratio scaled by ( 2 ^ scaleShift )              */
+/*  --> scaleShift      : [ 32 .. 63 ]                                        */
+/*  <-- scaledValue     : ( timeValue x ratio ) rounded down                  */
 /*                                                                            */
-/* - decrement any assigned core-timer process timers. At count zero reload   */
-/*   the down-counter and execute the callback function for that process      */
-/*   timer                                                                    */
+/* - a fixed-point conversion in place of a 64-bit divide : the value is      */
+/*   split into 32-bit halves so the product needs only two 32 x 32 -> 64     */
+/*   multiplies and cannot overflow                                           */
 /*                                                                            */
 /******************************************************************************/
 
-APV_ERROR_CODE apvExecuteDurationTimers(apvCoreTimerBlock_t *coreTimerBlock)
+static uint64_t apvTimeScale(uint64_t timeValue,
+                             uint8_t  scalePreShift,
+                             uint32_t scaleMultiplier,
+                             uint8_t  scaleShift)
   {
 /******************************************************************************/
 
-  APV_ERROR_CODE      durationTimerError = APV_ERROR_CODE_NONE;
-  uint32_t            timerIndex         = 0;
-
-  apvDurationTimer_t *durationTimer = NULL;
+  uint64_t scaledValue = 0;
 
 /******************************************************************************/
 
-  if (coreTimerBlock == NULL)
-    {
-    durationTimerError = APV_ERROR_CODE_NULL_PARAMETER;
-    }
-  else
-    {
-    while (timerIndex < APV_CORE_TIMER_DURATION_TIMERS)
-      {
-      // Dereference the process timer (in case the optimiser...doesn't!)
-      durationTimer = &coreTimerBlock->durationTimer[timerIndex];
-
-      if ((durationTimer->durationTimerIndex != APV_DURATION_TIMER_NULL_INDEX) &&
-          (durationTimer->durationTimerType  != APV_DURATION_TIMER_TYPE_NONE))
-        { // This process timer is populated, decrement the counter
-        durationTimer->durationTimerDownCounter = 
-            durationTimer->durationTimerDownCounter - 1;
-
-        if (durationTimer->durationTimerDownCounter == 0)
-          { // The timer has reached zero. If it is periodic restart it
-          if (durationTimer->durationTimerType == APV_DURATION_TIMER_TYPE_PERIODIC)
-            {
-            durationTimer->durationTimerDownCounter = 
-                durationTimer->durationTimerRequestedTicks;
-            }
-
-          // Execute the callback
-          durationTimer->durationTimerCallBack((void *)&timerIndex);
-          }
-        }
+  timeValue   = timeValue >> scalePreShift;
 
-      timerIndex = timerIndex + 1;
-      }
-    }
+  scaledValue =  ((uint64_t)((uint32_t)(timeValue >> 32))) * scaleMultiplier;
+  scaledValue = scaledValue + ((((uint64_t)((uint32_t)timeValue)) * scaleMultiplier) >> 32);
+  scaledValue = scaledValue >> (scaleShift - APV_TIME_SCALE_SHIFT_MINIMUM);
 
 /******************************************************************************/
 
-  return(durationTimerError);
+  return(scaledValue);
 
 /******************************************************************************/
-  } /* end of apvExecuteDurationTimers                                        */
+  } /* end of apvTimeScale                                                    */
 
 /******************************************************************************/
 /* apvInitialiseEventTimerBlocks() :                                          */
@@ -622,9 +1458,11 @@ APV_ERROR_CODE apvInitialiseEventTimerBlocks(apvEventTimersBlock_t *apvEventTime
 
         for (channels = 0; channels < TCCHANNEL_NUMBER; channels++)
           {
-          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannels[channels]        = NULL;  // null timer channel addresses
-          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelCallBack[channels] = NULL;  // null timer callback addresses
-          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelInUse[channels]    = false; // mark all channels as free
+          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannels[channels]                               = NULL;  // null timer channel addresses
+          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelHandler[channels].apvEventTimerCallBack   = NULL;  // no interrupt dispatch
+          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelHandler[channels].apvEventTimerContext    = NULL;
+          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelHandler[channels].apvEventTimerStatusMask = 0;
+          (apvEventTimerBlock + numberOfTimerBlocks)->apvEventTimerChannelInUse[channels]                           = false; // mark all channels as free
           }
 
         }
@@ -647,18 +1485,25 @@ APV_ERROR_CODE apvInitialiseEventTimerBlocks(apvEventTimersBlock_t *apvEventTime
 /*  --> apvEventTimerBlockBaseAddress : BASE (low) address of the event timer */
 /*                                      blocks                                */
 /*  --> apvEventTimerChannelCallBack  : address of the timer channel callback */
-/*                                      function                              */
+/*                                      function or NULL if the channel will  */
+/*                                      not interrupt                         */
+/*  --> apvEventTimerChannelContext   : handed to the callback unchanged      */
+/*  --> apvEventTimerStatusMask       : the "TC_SR" events the callback is    */
+/*                                      called for                            */
 /*                                                                            */
 /*  <-- apvEventTimerError            : error codes                           */
 /*                                                                            */
-/* - get an event timer block BCR address, timer channel addresses and assign */
-/*   an interrupt service routine callback function address                   */
+/* - get an event timer block BCR address, timer channel addresses and fill   */
+/*   in the channel's entry in the interrupt dispatch table                   */
+/*   ('apvEventTimerDispatch()')                                              */
 /*                                                                            */
 /******************************************************************************/
 
 APV_ERROR_CODE apvAssignEventTimer(uint16_t                timerChannel,
                                    apvEventTimersBlock_t  *apvEventTimerBlockBaseAddress,
-                                   void                  (*apvEventTimerChannelCallBack)(uint32_t apvEventTimerIndex))
+                                   apvEventTimerCallBack_t apvEventTimerChannelCallBack,
+                                   void                   *apvEventTimerChannelContext,
+                                   uint32_t                apvEventTimerStatusMask)
   {
 /******************************************************************************/
 
@@ -671,7 +1516,7 @@ APV_ERROR_CODE apvAssignEventTimer(uint16_t                timerChannel,
 
 /******************************************************************************/
 
-  if ((apvEventTimerChannelCallBack == NULL) || (apvEventTimerBlockBaseAddress == NULL))
+  if (apvEventTimerBlockBaseAddress == NULL)
     {
     apvEventTimerError = APV_ERROR_CODE_NULL_PARAMETER;
     }
@@ -691,25 +1536,27 @@ APV_ERROR_CODE apvAssignEventTimer(uint16_t                timerChannel,
         case APV_EVENT_TIMER_2 : (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock                              = (uint32_t *)(&(TC2->TC_BCR));           // address of the BCR for this block
                                  eventTimerChannelAddress                                                                           = ((TcChannel *)TC2) + eventTimerChannel; // address of this timer channel in this block
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]        = eventTimerChannelAddress;
-                                 (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelCallBack[eventTimerChannel] = apvEventTimerChannelCallBack;
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[eventTimerChannel]    = true;
                                  break;
 
         case APV_EVENT_TIMER_1 : (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock                              = (uint32_t *)(&(TC1->TC_BCR));           // address of the BCR for this block
                                  eventTimerChannelAddress                                                                           = ((TcChannel *)TC1) + eventTimerChannel; // address of this timer channel in this block
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]        = eventTimerChannelAddress;
-                                 (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelCallBack[eventTimerChannel] = apvEventTimerChannelCallBack;
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[eventTimerChannel]    = true;
                                  break;
 
         case APV_EVENT_TIMER_0 : (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock                              = (uint32_t *)(&(TC0->TC_BCR));           // address of the BCR for this block
                                  eventTimerChannelAddress                                                                           = ((TcChannel *)TC0) + eventTimerChannel; // address of this timer channel in this block
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]        = eventTimerChannelAddress;
-                                 (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelCallBack[eventTimerChannel] = apvEventTimerChannelCallBack;
                                  (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[eventTimerChannel]    = true;
 
         default                : break;
         }
+
+      // Written last : the dispatcher may already be looking at this entry
+      (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelHandler[eventTimerChannel].apvEventTimerContext    = apvEventTimerChannelContext;
+      (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelHandler[eventTimerChannel].apvEventTimerStatusMask = apvEventTimerStatusMask;
+      (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelHandler[eventTimerChannel].apvEventTimerCallBack   = apvEventTimerChannelCallBack;
       }
     }
 
@@ -761,7 +1608,8 @@ APV_ERROR_CODE apvConfigureWaveformEventTimer(uint16_t
   uint16_t       eventTimerBlock          = 0,
                  eventTimerChannel        = 0;
 
-  uint32_t      *eventTimerBlockRegisters = NULL;
+  Tc            *eventTimerBlockRegisters = NULL;
+  TcChannel     *eventTimerChannelAddress = NULL;
 
 /******************************************************************************/
 
@@ -786,89 +1634,84 @@ APV_ERROR_CODE apvConfigureWaveformEventTimer(uint16_t
         }
       else
         {
-        uint64_t timerDivisor = 1,
-                 timerTarget  = (uint64_t)timeBaseTarget;
+        uint32_t timerShift  = 0;
+        uint64_t timerTarget = 0;
 
-        // Guard against division by zero
-        if (timerTarget == 0)
+        // The period in MCK counts rounded up, less one : "UP_RC" counts ( RC + 1 ) clocks a period
+        timerTarget = apvTimeScale((uint64_t)timeBaseTarget,
+                                   0,
+                                   APV_EVENT_TIMER_NS_COUNTS_MULTIPLIER,
+                                   APV_EVENT_TIMER_NS_COUNTS_SHIFT);
+
+        if ((timerTarget * APV_EVENT_TIMER_NS_COUNTS_DENOMINATOR) == (((uint64_t)timeBaseTarget) * APV_EVENT_TIMER_NS_COUNTS_NUMERATOR))
           {
-          timerTarget = APV_EVENT_TIMER_INVERSE_NANOSECONDS;
+          timerTarget = timerTarget - 1;
           }
 
-        timerTarget = timerTarget << APV_EVENT_TIMER_TIMEBASE_SCALER;     // numerical scaling for the divisions required
-        timerTarget = timerTarget /  APV_EVENT_TIMER_INVERSE_NANOSECONDS; // this many nanoseconds (timerTarget * (1 x 10 ^ -9))
-        timerTarget = timerTarget *  APV_EVENT_TIMER_TIMEBASE_BASECLOCK;  // this fraction of the base CPU clock
-
-        // Dereference the general event timer block registers
-        eventTimerBlockRegisters = (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock;
+        // Dereference the general event timer block registers and the channel
+        eventTimerBlockRegisters = (Tc *)(apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock;
+        eventTimerChannelAddress = (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel];
 
-        // Compute the timebase divisor for the requested channel (only supporting /2, /8, /32 and /128)
+        // Compute the timebase divisor for the requested channel as a shift (only supporting /2, /8, /32 and /128)
         switch(channelClock)
           {
-          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_3 : timerDivisor = timerDivisor * APV_EVENT_TIMER_DIVISOR_x4; // 4 x  1  =  4
-          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_2 : timerDivisor = timerDivisor * APV_EVENT_TIMER_DIVISOR_x4; // 4 x  4  = 16, 4 x  1 =  4 
-          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_1 : timerDivisor = timerDivisor * APV_EVENT_TIMER_DIVISOR_x4; // 4 x 16 =  64, 4 x  4 = 16, 4 x 1 = 4
-          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_0 : timerDivisor = timerDivisor * APV_EVENT_TIMER_DIVISOR_x2; // 2 x 64 = 128, 2 x 16 = 32, 2 x 4 = 8, 2 x 1 = 2,
+          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_3 : timerShift = timerShift + APV_EVENT_TIMER_DIVISOR_x4_SHIFT; // 2 + 0  = 2
+          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_2 : timerShift = timerShift + APV_EVENT_TIMER_DIVISOR_x4_SHIFT; // 2 + 2  = 4, 2 + 0 = 2
+          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_1 : timerShift = timerShift + APV_EVENT_TIMER_DIVISOR_x4_SHIFT; // 2 + 4  = 6, 2 + 2 = 4, 2 + 0 = 2
+          case APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_0 : timerShift = timerShift + APV_EVENT_TIMER_DIVISOR_x2_SHIFT; // 1 + 6  = 7, 1 + 4 = 5, 1 + 2 = 3, 1 + 0 = 1
 
           default                                    :
                                                        break;
           }
 
-        timerTarget = timerTarget /  timerDivisor;                    // pre-scale the CPU clock
-        timerTarget = timerTarget >> APV_EVENT_TIMER_TIMEBASE_SCALER; // remove the numerical scaling
+        timerTarget = timerTarget >> timerShift; // pre-scale the CPU clock
 
         switch(eventTimerBlock)
           {
-          case APV_EVENT_TIMER_2 : ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CMR = channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC;
-                                   ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_RC  = timerTarget;
+          case APV_EVENT_TIMER_2 : APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_CMR, channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC);
+                                   APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_RC,  timerTarget);
 
                                    if (interruptEnable == true)
                                      {
-                                     ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER = 
-                                                 ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER | TC_IER_CPCS;
+                                     APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_IER, TC_IER_CPCS);
                                      }
 
                                    if (externalClock2 != APV_EVENT_TIMER_CHANNEL_TIMER_XC2_NONE)
                                      {
                                      // Load the TC2XC2S field of the BMR
-                                     *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) = 
-                                          *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) | externalClock2;
+                                     APV_REGISTER_COMMAND(eventTimerBlockRegisters, TC_BMR, eventTimerBlockRegisters->TC_BMR | externalClock2);
                                      }
 
                                    break;
 
-          case APV_EVENT_TIMER_1 : ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CMR = channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC;
-                                   ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_RC  = timerTarget;
+          case APV_EVENT_TIMER_1 : APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_CMR, channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC);
+                                   APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_RC,  timerTarget);
 
                                    if (interruptEnable == true)
                                      {
-                                     ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER = 
-                                                 ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER | TC_IER_CPCS;
+                                     APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_IER, TC_IER_CPCS);
                                      }
 
                                    if (externalClock1 != APV_EVENT_TIMER_CHANNEL_TIMER_XC1_NONE)
                                      {
                                      // Load the TC1XC1S field of the BMR
-                                     *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) = 
-                                          *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) | externalClock1;
+                                     APV_REGISTER_COMMAND(eventTimerBlockRegisters, TC_BMR, eventTimerBlockRegisters->TC_BMR | externalClock1);
                                      }
 
                                    break;
 
-          case APV_EVENT_TIMER_0 : ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CMR = channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC;
-                                   ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_RC  = timerTarget;
+          case APV_EVENT_TIMER_0 : APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_CMR, channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC);
+                                   APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_RC,  timerTarget);
 
                                    if (interruptEnable == true)
                                      {
-                                     ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER = 
-                                                 ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_IER | TC_IER_CPCS;
+                                     APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_IER, TC_IER_CPCS);
                                      }
 
                                    if (externalClock0 != APV_EVENT_TIMER_CHANNEL_TIMER_XC0_NONE)
                                      {
                                      // Load the TC0XC0S field of the BMR
-                                     *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) = 
-                                          *(eventTimerBlockRegisters + APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET) | externalClock1;
+                                     APV_REGISTER_COMMAND(eventTimerBlockRegisters, TC_BMR, eventTimerBlockRegisters->TC_BMR | externalClock0);
                                      }
 
           default                : break;
@@ -935,13 +1778,13 @@ APV_ERROR_CODE apvSwitchWaveformEventTimer(uint16_t                           ti
         {
         if (apvEventTimerSwitch == false)
           {
-          ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CCR = TC_CCR_CLKDIS; // 0b1 | 0b0
+          APV_REGISTER_COMMAND(((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]), TC_CCR, TC_CCR_CLKDIS); // 0b1 | 0b0
           }
         else
           {
-          ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CCR = (~((uint32_t)TC_CCR_CLKDIS)); // EXPLICITLY clear CLKDIS first
+          APV_REGISTER_COMMAND(((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]), TC_CCR, (~((uint32_t)TC_CCR_CLKDIS))); // EXPLICITLY clear CLKDIS first
 
-          ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel])->TC_CCR = TC_CCR_CLKEN; // 0b0 | 0b1
+          APV_REGISTER_COMMAND(((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel]), TC_CCR, TC_CCR_CLKEN); // 0b0 | 0b1
           }
         }
       }
@@ -955,147 +1798,338 @@ APV_ERROR_CODE apvSwitchWaveformEventTimer(uint16_t                           ti
    } /* end of apvSwitchWaveformEventTimer                                    */
 
 /******************************************************************************/
-/* apvEventTimerChannel0CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvConfigureFreeRunningEventTimer() :                                      */
+/*  --> timerChannel : timer instance and channel : [ 27 .. 35 ] ==           */
+/*                                                    0 { instance } 2 +      */
+/*                                                    0 { channel  } 2        */
+/*  --> apvEventTimerBlockBaseAddress : BASE (low) address of the event timer */
+/*                                      blocks                                */
+/*  --> channelClock                  : channel clock source                  */
+/*  <-- apvEventTimerError            : event timer error codes               */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - setup an event timer channel as a free-running 32-bit up-counter with   */
+/*    no interrupts. The channel becomes the timestamp source read by         */
+/*    'apvEventTimerTimestamp()'. The "wave select" mode is UP i.e. the       */
+/*    counter wraps from 0xffffffff to 0 so timestamp differences computed    */
+/*    in unsigned 32-bit arithmetic are always correct across one wrap. The   */
+/*    external event is XC0 with no edge selected : this leaves TIOB an       */
+/*    output so the RB compare ('apvStartTicklessTimer()') is available       */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel0CallBack(uint32_t apvEventTimerIndex)
+APV_ERROR_CODE apvConfigureFreeRunningEventTimer(uint16_t                           timerChannel,
+                                                 apvEventTimersBlock_t             *apvEventTimerBlockBaseAddress,
+                                                 apvEventTimerChannelClockSource_t  channelClock)
   {
 /******************************************************************************/
 
-  apvEventTimerHotShot.Flags.APV_EVENT_TIMER_CHANNEL_0_FLAG = APV_EVENT_TIMER_FLAG_SET;
+  APV_ERROR_CODE apvEventTimerError       = APV_ERROR_CODE_NONE;
+
+  uint16_t       eventTimerBlock          = 0,
+                 eventTimerChannel        = 0;
+
+  TcChannel     *eventTimerChannelAddress = NULL;
+
+/******************************************************************************/
+
+  if (apvEventTimerBlockBaseAddress == NULL)
+    {
+    apvEventTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    eventTimerBlock   = (timerChannel - ID_TC0) / TCCHANNEL_NUMBER;
+    eventTimerChannel = (timerChannel - ID_TC0) % TCCHANNEL_NUMBER;
+
+    if ((eventTimerBlock >= TCCHANNEL_NUMBER) || (eventTimerChannel >= TCCHANNEL_NUMBER) || (channelClock > APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_4))
+      {
+      apvEventTimerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      if ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[eventTimerChannel] == false)
+        {
+        apvEventTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+        }
+      else
+        {
+        eventTimerChannelAddress = (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel];
+
+        APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_CMR, channelClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP | TC_CMR_EEVT_XC0);
+        APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_IDR, ~((uint32_t)0)); // no interrupts from this channel
+
+        apvEventTimerTimestampChannel = eventTimerChannelAddress;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(apvEventTimerError);
 
 /******************************************************************************/
-  } /* end of apvEventTimerChannel0CallBack                                   */
+  } /* end of apvConfigureFreeRunningEventTimer                               */
 
 /******************************************************************************/
-/* apvEventTimerChannel1CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvConfigureChainedEventTimer() :                                          */
+/*  --> timerChannel        : the free-running timestamp channel              */
+/*                            ('apvConfigureFreeRunningEventTimer()')         */
+/*  --> chainedTimerChannel : a second channel in the same timer block        */
+/*  --> apvEventTimerBlockBaseAddress : BASE (low) address of the event timer */
+/*                                      blocks                                */
+/*  <-- apvEventTimerError            : event timer error codes               */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - chain a channel to the timestamp channel through the block's external   */
+/*    clocks to make the 64-bit timestamp ('apvEventTimerTimestamp64()'). The */
+/*    timestamp channel's TIOA is set by the RA compare half-way through the  */
+/*    count and cleared by the RC compare at the wrap; the chained channel is */
+/*    clocked by TIOA through XC<n> and so counts once per wrap. Both are     */
+/*    then started by the caller, the chained channel first                   */
+/*                                                                            */
+/* Reference : SAM3X8E Datasheet 23.03.15 "Timer Counter (TC)"                */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel1CallBack(uint32_t apvEventTimerIndex)
+APV_ERROR_CODE apvConfigureChainedEventTimer(uint16_t               timerChannel,
+                                             uint16_t               chainedTimerChannel,
+                                             apvEventTimersBlock_t *apvEventTimerBlockBaseAddress)
   {
 /******************************************************************************/
-/******************************************************************************/
-  } /* end of apvEventTimerChannel1CallBack                                   */
 
-/******************************************************************************/
-/* apvEventTimerChannel2CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
-/*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
-/*                                                                            */
+  APV_ERROR_CODE                    apvEventTimerError       = APV_ERROR_CODE_NONE;
+
+  uint16_t                          eventTimerBlock          = 0,
+                                    eventTimerChannel        = 0,
+                                    chainedTimerBlock        = 0,
+                                    chainedChannel           = 0;
+
+  Tc                               *eventTimerBlockRegisters = NULL;
+  TcChannel                        *eventTimerChannelAddress = NULL,
+                                   *chainedChannelAddress    = NULL;
+
+  apvEventTimerChannelClockSource_t chainedClock             = APV_EVENT_TIMER_CHANNEL_TIMER_XC0;
+  uint32_t                          chainedClockSource       = 0;
+
 /******************************************************************************/
 
-void apvEventTimerChannel2CallBack(uint32_t apvEventTimerIndex)
-  {
+  if (apvEventTimerBlockBaseAddress == NULL)
+    {
+    apvEventTimerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    eventTimerBlock   = (timerChannel        - ID_TC0) / TCCHANNEL_NUMBER;
+    eventTimerChannel = (timerChannel        - ID_TC0) % TCCHANNEL_NUMBER;
+    chainedTimerBlock = (chainedTimerChannel - ID_TC0) / TCCHANNEL_NUMBER;
+    chainedChannel    = (chainedTimerChannel - ID_TC0) % TCCHANNEL_NUMBER;
+
+    // TIOA only reaches the external clocks of its' own block
+    if ((eventTimerBlock >= TCCHANNEL_NUMBER) || (chainedTimerBlock != eventTimerBlock) || (chainedChannel == eventTimerChannel))
+      {
+      apvEventTimerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      eventTimerChannelAddress = (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[eventTimerChannel];
+      chainedChannelAddress    = (apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannels[chainedChannel];
+
+      if (((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[eventTimerChannel] == false) ||
+          ((apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerChannelInUse[chainedChannel]    == false) ||
+          (eventTimerChannelAddress                                                                        != apvEventTimerTimestampChannel))
+        {
+        apvEventTimerError = APV_ERROR_CODE_EVENT_TIMER_INITIALISATION_ERROR;
+        }
+      else
+        {
+        eventTimerBlockRegisters = (Tc *)(apvEventTimerBlockBaseAddress + eventTimerBlock)->apvEventTimerBlock;
+
+        // The chained channel uses its' "own" external clock, selecting the timestamp channel's TIOA
+        switch(chainedChannel)
+          {
+          case 2  : chainedClock       = APV_EVENT_TIMER_CHANNEL_TIMER_XC2;
+                    chainedClockSource = (eventTimerChannel == 0) ? APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TIOA0 : APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TIOA1;
+                    break;
+
+          case 1  : chainedClock       = APV_EVENT_TIMER_CHANNEL_TIMER_XC1;
+                    chainedClockSource = (eventTimerChannel == 0) ? APV_EVENT_TIMER_CHANNEL_TIMER_XC1_TIOA0 : APV_EVENT_TIMER_CHANNEL_TIMER_XC1_TIOA2;
+                    break;
+
+          default : chainedClock       = APV_EVENT_TIMER_CHANNEL_TIMER_XC0;
+                    chainedClockSource = (eventTimerChannel == 1) ? APV_EVENT_TIMER_CHANNEL_TIMER_XC0_TIOA1 : APV_EVENT_TIMER_CHANNEL_TIMER_XC0_TIOA2;
+                    break;
+          }
+
+        // Load the TC<n>XC<n>S field of the BMR
+        APV_REGISTER_COMMAND(eventTimerBlockRegisters, TC_BMR, eventTimerBlockRegisters->TC_BMR | chainedClockSource);
+
+        APV_REGISTER_COMMAND(chainedChannelAddress, TC_CMR, chainedClock | TC_CMR_WAVE | TC_CMR_WAVSEL_UP);
+        APV_REGISTER_COMMAND(chainedChannelAddress, TC_IDR, ~((uint32_t)0)); // no interrupts from this channel
+
+        // TIOA : one rising edge per wrap, well away from the wrap itself
+        APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_RA,  APV_EVENT_TIMER_TIMESTAMP_EDGE);
+        APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_RC,  APV_EVENT_TIMER_TIMESTAMP_WRAP);
+        APV_REGISTER_COMMAND(eventTimerChannelAddress, TC_CMR, eventTimerChannelAddress->TC_CMR | TC_CMR_ACPA_SET | TC_CMR_ACPC_CLEAR);
+
+        apvEventTimerTimestampHighChannel = chainedChannelAddress;
+        }
+      }
+    }
+
 /******************************************************************************/
+
+  return(apvEventTimerError);
+
 /******************************************************************************/
-  } /* end of apvEventTimerChannel2CallBack                                   */
+  } /* end of apvConfigureChainedEventTimer                                   */
 
 /******************************************************************************/
-/* apvEventTimerChannel3CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvEventTimerTimestamp() :                                                 */
+/*  <-- : the free-running timestamp counter value or 0 if there is none      */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - read the free-running timestamp counter. At MCK/2 one tick is 23.8nsecs */
+/*    ('APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US' ticks per microsecond). This  */
+/*    is the low word of 'apvEventTimerTimestamp64()' : the cheaper read for  */
+/*    intervals shorter than one wrap (~102 seconds). Anything that keeps a   */
+/*    time uses 'apvEventTimerTimestamp64()' instead                          */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel3CallBack(uint32_t apvEventTimerIndex)
+uint32_t apvEventTimerTimestamp(void)
   {
 /******************************************************************************/
-/******************************************************************************/
-  } /* end of apvEventTimerChannel3CallBack                                   */
 
-/******************************************************************************/
-/* apvEventTimerChannel4CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
-/*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
-/*                                                                            */
+  uint32_t timestamp = 0;
+
 /******************************************************************************/
 
-void apvEventTimerChannel4CallBack(uint32_t apvEventTimerIndex)
-  {
+  if (apvEventTimerTimestampChannel != NULL)
+    {
+    timestamp = APV_REGISTER_READ(apvEventTimerTimestampChannel, TC_CV);
+    }
+
 /******************************************************************************/
+
+  return(timestamp);
+
 /******************************************************************************/
-  } /* end of apvEventTimerChannel4CallBack                                   */
+  } /* end of apvEventTimerTimestamp                                          */
 
 /******************************************************************************/
-/* apvEventTimerChannel5CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvEventTimerTimestamp64() :                                               */
+/*  <-- timestamp : the 64-bit timestamp count since the channels started,    */
+/*                  the bare 32-bit count if there is no chained channel or 0 */
+/*                  if there is no timestamp channel                          */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - read the 64-bit timestamp ('apvConfigureChainedEventTimer()'). Nothing  */
+/*    is written so it is safe from any context without masking interrupts :  */
+/*    the high count is read either side of the low count and the read is     */
+/*    repeated if it moved or if the low count is just past the TIOA edge     */
+/*    where the high count may not have caught up. At MCK/2 the count wraps   */
+/*    after ~13900 years                                                      */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel5CallBack(uint32_t apvEventTimerIndex)
+uint64_t apvEventTimerTimestamp64(void)
   {
 /******************************************************************************/
-/******************************************************************************/
-  } /* end of apvEventTimerChannel5CallBack                                   */
 
-/******************************************************************************/
-/* apvEventTimerChannel6CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
-/*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
-/*                                                                            */
+  uint64_t timestamp     = 0;
+  uint32_t timestampLow  = 0,
+           timestampHigh = 0,
+           highCheck     = 0;
+
 /******************************************************************************/
 
-void apvEventTimerChannel6CallBack(uint32_t apvEventTimerIndex)
-  {
+  if (apvEventTimerTimestampChannel != NULL)
+    {
+    if (apvEventTimerTimestampHighChannel != NULL)
+      {
+      do
+        {
+        timestampHigh = APV_REGISTER_READ(apvEventTimerTimestampHighChannel, TC_CV);
+        timestampLow  = APV_REGISTER_READ(apvEventTimerTimestampChannel,     TC_CV);
+        highCheck     = APV_REGISTER_READ(apvEventTimerTimestampHighChannel, TC_CV);
+        }
+      while ((timestampHigh                                   != highCheck) ||
+             ((timestampLow - APV_EVENT_TIMER_TIMESTAMP_EDGE)  < APV_EVENT_TIMER_TIMESTAMP_GUARD_COUNTS));
+
+      // Past the edge the high count already includes the coming wrap
+      if (timestampLow >= APV_EVENT_TIMER_TIMESTAMP_EDGE)
+        {
+        timestampHigh = timestampHigh - 1;
+        }
+
+      timestamp = (((uint64_t)timestampHigh) << APV_EVENT_TIMER_TIMESTAMP_HIGH_SHIFT) | timestampLow;
+      }
+    else
+      {
+      timestamp = APV_REGISTER_READ(apvEventTimerTimestampChannel, TC_CV);
+      }
+    }
+
 /******************************************************************************/
+
+  return(timestamp);
+
 /******************************************************************************/
-  } /* end of apvEventTimerChannel6CallBack                                   */
+  } /* end of apvEventTimerTimestamp64                                        */
 
 /******************************************************************************/
-/* apvEventTimerChannel7CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvEventTimerHotShotCallBack() :                                           */
+/*  --> apvEventTimerIndex   : the interrupting channel                       */
+/*  --> apvEventTimerStatus  : "TC_SR" as read by the vector                  */
+/*  --> apvEventTimerContext : not used                                       */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - flag the channel's event for the main loop in 'apvEventTimerHotShot'    */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel7CallBack(uint32_t apvEventTimerIndex)
+void apvEventTimerHotShotCallBack(uint32_t  apvEventTimerIndex,
+                                  uint32_t  apvEventTimerStatus,
+                                  void     *apvEventTimerContext)
   {
 /******************************************************************************/
+
+  apvEventTimerHotShot.FlagPole = apvEventTimerHotShot.FlagPole | (((uint32_t)1) << (apvEventTimerIndex - APV_EVENT_TIMER_BASE_ID));
+
 /******************************************************************************/
-  } /* end of apvEventTimerChannel7CallBack                                   */
+  } /* end of apvEventTimerHotShotCallBack                                    */
 
 /******************************************************************************/
-/* apvEventTimerChannel8CallBack() :                                          */
-/*  --> apvEventTimerIndex : can be used to signal an event on this timer     */
-/*                           channel                                          */
+/* apvDurationTimerTicklessCallBack() :                                       */
+/*  --> apvEventTimerIndex   : the timestamp channel                          */
+/*  --> apvEventTimerStatus  : "TC_SR" as read by the vector                  */
+/*  --> apvEventTimerContext : the core-timer block ('apvCoreTimerBlock_t *') */
 /*                                                                            */
-/*  - callback handler for intra interrupt service routine use on channel 0   */
+/*  - in tickless mode the timestamp channel's RB compare stands in for the   */
+/*    system tick ('apvStartTicklessTimer()')                                 */
 /*                                                                            */
 /******************************************************************************/
 
-void apvEventTimerChannel8CallBack(uint32_t apvEventTimerIndex)
+void apvDurationTimerTicklessCallBack(uint32_t  apvEventTimerIndex,
+                                      uint32_t  apvEventTimerStatus,
+                                      void     *apvEventTimerContext)
   {
 /******************************************************************************/
+
+  apvCoreTimerBlock_t *coreTimerBlock = (apvCoreTimerBlock_t *)apvEventTimerContext;
+
+/******************************************************************************/
+
+  if ((coreTimerBlock != NULL) && (coreTimerBlock->durationTimerTicklessChannel != NULL))
+    {
+    // Flag the fast background loop
+    apvCoreTimerFlag = APV_CORE_TIMER_FLAG_HIGH;
+
+    apvExecuteDurationTimers(coreTimerBlock);
+    }
+
 /******************************************************************************/
-  } /* end of apvEventTimerChannel8CallBack                                   */
+  } /* end of apvDurationTimerTicklessCallBack                                */
 
 /******************************************************************************/
 /* apvDurationStateTimer() :                                                  */
-/*   --> stateTimerIndex : currently a dummy message to this duration timer   */
-/*                         callback function                                  */
+/*   --> stateTimerIndex : the context given at assignment : unused           */
 /* - duration timer callback function                                         */
 /*                                                                            */
 /******************************************************************************/
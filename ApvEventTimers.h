@@ -34,10 +34,8 @@
 #define APV_SYSTEM_TIMER_CLOCK_MAXIMUM_INTERVAL (APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL * APV_SYSTEM_TIMER_MAXIMUM_TICKS)
 #define APV_SYSTEM_TIMER_CLOCK_MAXIMUM_PERIOD   APV_SYSTEM_TIMER_CLOCK_MAXIMUM_INTERVAL
 
-#define APV_EVENT_TIMER_BLOCK_REGISTER_OFFSET   (sizeof(uint32_t))
 
 #define APV_EVENT_TIMER_TIMEBASE_BASECLOCK      ((uint64_t)84000000)   // SAM3X8E/A CPU CLOCK MHz
-#define APV_EVENT_TIMER_TIMEBASE_SCALER         (32)                   // scale by 2 ^ 32
 #define APV_EVENT_TIMER_INVERSE_NANOSECONDS     ((uint64_t)1000000000) // one-second in nanoseconds
 
 #define APV_EVENT_TIMER_TIMEBASE_MINIMUM        ((uint32_t)10)         // nanoseconds
@@ -45,6 +43,27 @@
 
 #define APV_EVENT_TIMER_DIVISOR_x2              ((uint64_t)2)
 #define APV_EVENT_TIMER_DIVISOR_x4              ((uint64_t)4)
+#define APV_EVENT_TIMER_DIVISOR_x2_SHIFT        (1)                    // the divisors as shifts of the MCK count
+#define APV_EVENT_TIMER_DIVISOR_x4_SHIFT        (2)
+
+// The free-running timestamp counter runs at ( 84MHz / 2 ) = 23.8nsecs per tick and wraps every ~102 seconds
+#define APV_EVENT_TIMER_TIMESTAMP_CLOCK         APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_0
+#define APV_EVENT_TIMER_TIMESTAMP_RATE          (APV_EVENT_TIMER_TIMEBASE_BASECLOCK / APV_EVENT_TIMER_DIVISOR_x2)
+#define APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US  ((uint32_t)(APV_EVENT_TIMER_TIMESTAMP_RATE / 1000000))
+
+// The 64-bit timestamp : a chained channel counts the timestamp channel's TIOA rising edges. TIOA is set by
+// the RA compare half-way through the count and cleared by the RC compare at the wrap, so the high count
+// runs one ahead of the wraps through the top half of the low count
+#define APV_EVENT_TIMER_TIMESTAMP_EDGE          ((uint32_t)0x80000000)
+#define APV_EVENT_TIMER_TIMESTAMP_WRAP          ((uint32_t)0)
+#define APV_EVENT_TIMER_TIMESTAMP_GUARD_COUNTS  APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US // the high count may lag the edge by this much
+#define APV_EVENT_TIMER_TIMESTAMP_HIGH_SHIFT    (32)
+
+// Time bases : 'apvEventTimerTimestamp64()' is THE firmware time base - the scheduler, the messaging layer
+// residency and service times and any time kept across calls are read from it. 'apvEventTimerTimestamp()'
+// is only its' low word, for a caller that cannot afford the chained read and never spans a wrap. The
+// interrupt latency figures ('ApvInterruptLatency.h') deliberately use the core cycle counter instead as
+// they are taken in the exception entry at core clock resolution and are never compared with a timestamp
 
 #define APV_CORE_TIMER_CLOCK_RATE               ((uint64_t)32768)            // the main RTT clock rate
 #define APV_CORE_TIMER_CLOCK_MINIMUM_DIVIDER    ((uint64_t)3)                // less than 3 results in unstable interrupt operation
@@ -56,10 +75,83 @@
 #define APV_CORE_TIMER_CLOCK_DIVIDER_MASK       ((uint32_t)0x0000ffff)       // RTT->RTT_MR : mode register RTPRES mask
 #define APV_CORE_TIMER_SINGLE_PERIOD            ((uint32_t)1)                // interrupt after one (SCLK * prescaler) tick
 
-#define APV_CORE_TIMER_DURATION_TIMERS          16                           // this is enough ? Do not want to use "malloc()"!
+#ifndef APV_CORE_TIMER_DURATION_TIMERS                                       // the pool is sized at build time : no "malloc()"!
+#define APV_CORE_TIMER_DURATION_TIMERS          16
+#endif
 
 #define APV_DURATION_TIMER_EXPIRED               0
 #define APV_DURATION_TIMER_NULL_INDEX           ((uint32_t)~0)
+#define APV_DURATION_TIMER_MINIMUM_TICKS        ((uint32_t)1)                // a shorter request still waits for the next tick
+#define APV_DURATION_TIMER_MAXIMUM_TICKS        (((uint32_t)~0) >> 1)        // a longer request is refused : the delta queue sums cannot wrap
+#define APV_DURATION_TIMER_TICK                 ((uint32_t)1)                // the periodic tick advances the timers by one
+#define APV_DURATION_TIMER_SLACK_NONE           ((uint64_t)0)                // the timer expires on its' own tick
+
+// A duration timer handle is the slot index under the slot's generation. The generation moves on
+// every time the slot is freed so a handle kept past 'apvDeAssignDurationTimer()' no longer matches
+#define APV_DURATION_TIMER_HANDLE_INDEX_BITS    (16)
+#define APV_DURATION_TIMER_HANDLE_INDEX_MASK    ((1u << APV_DURATION_TIMER_HANDLE_INDEX_BITS) - 1u)
+#define APV_DURATION_TIMER_GENERATION_MASK      ((uint32_t)(~0) >> APV_DURATION_TIMER_HANDLE_INDEX_BITS)
+#define APV_DURATION_TIMER_NULL_HANDLE          ((apvDurationTimerHandle_t)~0)
+
+// The top index is never used so no handle can be mistaken for the null handle
+#if (APV_CORE_TIMER_DURATION_TIMERS > APV_DURATION_TIMER_HANDLE_INDEX_MASK)
+#error "APV_CORE_TIMER_DURATION_TIMERS : too many duration timers for the handle index"
+#endif
+
+// Tickless mode : the duration timer tick in timestamp counts ( 150usecs at MCK/2 == 6300 )
+#define APV_DURATION_TIMER_TICKLESS_TICK_COUNTS    ((uint32_t)((APV_EVENT_TIMER_TIMESTAMP_RATE * APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD) / APV_EVENT_TIMER_INVERSE_NANOSECONDS))
+#define APV_DURATION_TIMER_TICKLESS_COMPARE_RANGE  (((uint32_t)1) << 30)        // longest compare ~25.6secs : keeps well clear of the 32-bit wrap
+#define APV_DURATION_TIMER_TICKLESS_MAXIMUM_TICKS  (APV_DURATION_TIMER_TICKLESS_COMPARE_RANGE / APV_DURATION_TIMER_TICKLESS_TICK_COUNTS)
+#define APV_DURATION_TIMER_TICKLESS_GUARD_COUNTS   (APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US * 2) // a compare must be at least this far ahead of the counter
+
+/******************************************************************************/
+/* Fixed-point time conversions : a 64-bit divide is a library call of some   */
+/* hundreds of cycles on the Cortex-M3. Each nanosecond conversion the timers */
+/* make is instead "(( x >> pre-shift ) * multiplier ) >> shift", two 32 x 32 */
+/* multiplies in 'apvTimeScale()'. The multiplier is the rounded-up ratio     */
+/* scaled by ( 2 ^ shift ), worked out by the compiler; the shift is the      */
+/* largest that keeps the multiplier within 32 bits. The pre-shift takes a    */
+/* power of two out of the denominator. A result is exact up to the limit     */
+/* given and at most one count high beyond it                                 */
+/******************************************************************************/
+
+#define APV_TIME_SCALE_MULTIPLIER(numerator, denominator, shift) ((uint32_t)(((((uint64_t)(numerator)) << (shift)) + (denominator) - 1) / (denominator)))
+#define APV_TIME_SCALE_SHIFT_MINIMUM               (32)                         // the multiply keeps the high word of the low product
+
+// Nanoseconds to SysTick duration timer ticks ( 150000 == 16 x 9375 ) : exact to ~114secs
+#define APV_DURATION_TIMER_NS_TICKS_PRESHIFT       (4)
+#define APV_DURATION_TIMER_NS_TICKS_SHIFT          (45)
+#define APV_DURATION_TIMER_NS_TICKS_MULTIPLIER     APV_TIME_SCALE_MULTIPLIER(1, (APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD >> APV_DURATION_TIMER_NS_TICKS_PRESHIFT), APV_DURATION_TIMER_NS_TICKS_SHIFT)
+
+// Nanoseconds to RTT duration timer ticks ( 91553nsecs ) : exact to ~8secs
+#define APV_CORE_TIMER_NS_TICKS_SHIFT              (48)
+#define APV_CORE_TIMER_NS_TICKS_MULTIPLIER         APV_TIME_SCALE_MULTIPLIER(1, APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL, APV_CORE_TIMER_NS_TICKS_SHIFT)
+
+// Nanoseconds to SysTick clocks ( 12nsecs ) : exact to ~8.5secs, beyond the 0.2secs maximum
+#define APV_SYSTEM_TIMER_NS_CLOCKS_SHIFT           (35)
+#define APV_SYSTEM_TIMER_NS_CLOCKS_MULTIPLIER      APV_TIME_SCALE_MULTIPLIER(1, APV_SYSTEM_TIMER_CLOCK_MINIMUM_INTERVAL, APV_SYSTEM_TIMER_NS_CLOCKS_SHIFT)
+
+// Nanoseconds to RTT SCLK periods ( 32768 / 10 ^ 9 == 64 / 1953125 ) : exact to ~45msecs; the
+// prescaler reaches ~2secs so the result is checked against the ratio and stepped back if high
+#define APV_CORE_TIMER_CLOCK_RATE_COMMON           ((uint64_t)512)              // the highest common factor of the clock rate and 10 ^ 9
+#define APV_CORE_TIMER_NS_SCLK_NUMERATOR           (APV_CORE_TIMER_CLOCK_RATE        / APV_CORE_TIMER_CLOCK_RATE_COMMON)
+#define APV_CORE_TIMER_NS_SCLK_DENOMINATOR         (APV_CORE_TIMER_CLOCK_RATE_SCALER / APV_CORE_TIMER_CLOCK_RATE_COMMON)
+#define APV_CORE_TIMER_NS_SCLK_SHIFT               (46)
+#define APV_CORE_TIMER_NS_SCLK_MULTIPLIER          APV_TIME_SCALE_MULTIPLIER(APV_CORE_TIMER_NS_SCLK_NUMERATOR, APV_CORE_TIMER_NS_SCLK_DENOMINATOR, APV_CORE_TIMER_NS_SCLK_SHIFT)
+
+// Nanoseconds to event timer MCK counts ( 84 x 10 ^ 6 / 10 ^ 9 == 21 / 250 ) : exact to ~1.56secs,
+// beyond the 1sec timebase maximum. The slower channel clocks are this count shifted down
+#define APV_EVENT_TIMER_TIMEBASE_COMMON            ((uint64_t)4000000)          // the highest common factor of the base clock and 10 ^ 9
+#define APV_EVENT_TIMER_NS_COUNTS_NUMERATOR        (APV_EVENT_TIMER_TIMEBASE_BASECLOCK  / APV_EVENT_TIMER_TIMEBASE_COMMON)
+#define APV_EVENT_TIMER_NS_COUNTS_DENOMINATOR      (APV_EVENT_TIMER_INVERSE_NANOSECONDS / APV_EVENT_TIMER_TIMEBASE_COMMON)
+#define APV_EVENT_TIMER_NS_COUNTS_SHIFT            (35)
+#define APV_EVENT_TIMER_NS_COUNTS_MULTIPLIER       APV_TIME_SCALE_MULTIPLIER(APV_EVENT_TIMER_NS_COUNTS_NUMERATOR, APV_EVENT_TIMER_NS_COUNTS_DENOMINATOR, APV_EVENT_TIMER_NS_COUNTS_SHIFT)
+
+#if (APV_DURATION_TIMER_NS_TICKS_SHIFT < APV_TIME_SCALE_SHIFT_MINIMUM) || (APV_CORE_TIMER_NS_TICKS_SHIFT   < APV_TIME_SCALE_SHIFT_MINIMUM) || \
+    (APV_SYSTEM_TIMER_NS_CLOCKS_SHIFT  < APV_TIME_SCALE_SHIFT_MINIMUM) || (APV_CORE_TIMER_NS_SCLK_SHIFT    < APV_TIME_SCALE_SHIFT_MINIMUM) || \
+    (APV_EVENT_TIMER_NS_COUNTS_SHIFT   < APV_TIME_SCALE_SHIFT_MINIMUM)
+#error "APV_TIME_SCALE_SHIFT_MINIMUM : a fixed-point conversion shift is too small"
+#endif
 
 #define APV_CORE_TIMER_ID                       ID_RTT                       // core timer interrupt ID (Atmel id 3)
 
@@ -76,7 +168,9 @@ typedef enum apvEventTimerUse_tTag
   APV_EVENT_TIMER_BASE_ID            = ID_TC0,
   APV_EVENT_TIMER_GENERAL_PURPOSE_ID = APV_EVENT_TIMER_BASE_ID,
   APV_EVENT_TIMER_RESERVED_1,
+  APV_EVENT_TIMER_TIMESTAMP_ID       = APV_EVENT_TIMER_RESERVED_1,
   APV_EVENT_TIMER_RESERVED_2,
+  APV_EVENT_TIMER_TIMESTAMP_HIGH_ID  = APV_EVENT_TIMER_RESERVED_2,
   APV_EVENT_TIMER_RESERVED_3,
   APV_EVENT_TIMER_RESERVED_4,
   APV_EVENT_TIMER_RESERVED_5,
@@ -102,8 +196,8 @@ typedef enum apvEventTimerChannelClockSource_tTag
   APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_3 = TC_CMR_TCCLKS_TIMER_CLOCK4, // ( 84MHz / 128 ) = 1.524usecs
   APV_EVENT_TIMER_CHANNEL_TIMER_CLOCK_4 = TC_CMR_TCCLKS_TIMER_CLOCK5, // internal SCLK
   APV_EVENT_TIMER_CHANNEL_TIMER_XC0     = TC_CMR_TCCLKS_XC0,
-  APV_EVENT_TIMER_CHANNEL_TIMER_XC1     = TC_CMR_TCCLKS_XC2,
-  APV_EVENT_TIMER_CHANNEL_TIMER_XC2     = TC_CMR_TCCLKS_XC0,
+  APV_EVENT_TIMER_CHANNEL_TIMER_XC1     = TC_CMR_TCCLKS_XC1,
+  APV_EVENT_TIMER_CHANNEL_TIMER_XC2     = TC_CMR_TCCLKS_XC2,
   APV_EVENT_TIMER_CHANNEL_TIMERS        = 8
   } apvEventTimerChannelClockSource_t;
 
@@ -126,17 +220,34 @@ typedef enum apvEventTimerChannelClockExtC1_tTag
 typedef enum apvEventTimerChannelClockExtC2_tTag
   {
   APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TCLK2 = TC_BMR_TC2XC2S_TCLK2,
-  APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TIOA0 = TC_BMR_TC2XC2S_TIOA2,
+  APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TIOA0 = TC_BMR_TC2XC2S_TIOA0,
   APV_EVENT_TIMER_CHANNEL_TIMER_XC2_TIOA1 = TC_BMR_TC2XC2S_TIOA1,
   APV_EVENT_TIMER_CHANNEL_TIMER_XC2_NONE  = -1
   } apvEventTimerChannelClockExtC2_t;
 
+/******************************************************************************/
+/* Every timer channel interrupt goes through the one dispatcher : the vector */
+/* reads "TC_SR" once (which clears the events) and the channel's callback is */
+/* called with it if any of the events in its' status mask are set            */
+/******************************************************************************/
+
+typedef void (*apvEventTimerCallBack_t)(uint32_t  apvEventTimerIndex,   // Atmel id : [ 27 .. 35 ]
+                                        uint32_t  apvEventTimerStatus,  // "TC_SR" as read by the vector
+                                        void     *apvEventTimerContext);
+
+typedef struct apvEventTimerHandler_tTag
+  {
+  apvEventTimerCallBack_t  apvEventTimerCallBack;   // NULL : the channel raises no interrupts
+  void                    *apvEventTimerContext;    // handed to the callback unchanged
+  uint32_t                 apvEventTimerStatusMask; // the "TC_SR" events the callback is wanted for
+  } apvEventTimerHandler_t;
+
 typedef struct apvEventTimersBlock_tTag
   {
-  uint32_t  *apvEventTimerBlock; // address of the block control registers etc.,.
-  TcChannel *apvEventTimerChannels[TCCHANNEL_NUMBER];
-  void      (*apvEventTimerChannelCallBack[TCCHANNEL_NUMBER])(uint32_t apvEventTimerIndex);
-  bool       apvEventTimerChannelInUse[TCCHANNEL_NUMBER];
+  uint32_t               *apvEventTimerBlock; // address of the block control registers etc.,.
+  TcChannel              *apvEventTimerChannels[TCCHANNEL_NUMBER];
+  apvEventTimerHandler_t  apvEventTimerChannelHandler[TCCHANNEL_NUMBER];
+  bool                    apvEventTimerChannelInUse[TCCHANNEL_NUMBER];
   } apvEventTimersBlock_t;
 
 typedef enum apvDurationTimerType_tTag
@@ -161,18 +272,48 @@ typedef enum apvDurationTimerSource_tTag
   APV_DURATION_TIMER_SOURCES
   } apvDurationTimerSource_t;
 
+typedef uint32_t apvDurationTimerHandle_t;
+
 /******************************************************************************/
-/* Holding structure for the core timer-derived process timer set             */
+/* Holding structure for the core timer-derived process timer set. Running    */
+/* timers are kept in a delta queue ordered by expiry : each holds the ticks  */
+/* left after the timer ahead of it expires so a tick only decrements the     */
+/* head and only the timers expiring on that tick are visited.                */
+/* In tickless mode there is no periodic tick : the free-running timestamp    */
+/* channel's RB compare is set for the head's expiry, counted in whole ticks  */
+/* from the queue base, and the interrupt comes only when a timer is due.     */
+/* The interrupt never runs a callback : an expired timer joins the deferred  */
+/* list and 'apvRunDurationTimerCallBacks()' calls it from the main loop with */
+/* the context it was assigned with.                                          */
+/* A timer may be given slack : its' expiry can be put off by up to that much */
+/* so that timers due close together share one compare interrupt. The         */
+/* compare is set for the earliest "latest acceptable" expiry of the timers   */
+/* whose windows overlap the heads' and every timer due by then expires       */
+/* together. A periodic timer keeps its' phase however late it was run. With  */
+/* the periodic tick every tick interrupts anyway and slack has no effect.    */
+/* Free timers are kept on a free list so assigning and de-assigning take the */
+/* same time however big the pool is; users hold a handle, never the index    */
 /******************************************************************************/
 
 typedef struct apvDurationTimer_tTag
   {
-  uint32_t                durationTimerIndex;                                  // 0 { durationTimer[index] } 31
-  uint32_t                durationTimerRequestedMicroSeconds;                  // lots of microseconds
-  uint32_t                durationTimerRequestedTicks;                         // the reload value for the down counter
-  uint32_t                durationTimerDownCounter;                            // just test for zero
-  void                   (*durationTimerCallBack)(void *durationEventMessage); // called when the timer expires
-  apvDurationTimerType_t  durationTimerType;                                   // a number of timer types can be supported
+  apvDurationTimerHandle_t durationTimerHandle;                                  // the handle it is assigned under or APV_DURATION_TIMER_NULL_HANDLE
+  uint32_t                 durationTimerGeneration;                              // the generation of the next handle for this slot
+  uint32_t                 durationTimerFreeNext;                                // free list link while unassigned : APV_DURATION_TIMER_NULL_INDEX ends it
+  uint32_t                 durationTimerRequestedMicroSeconds;                   // lots of microseconds
+  uint32_t                 durationTimerRequestedTicks;                          // the reload value for a periodic timer
+  uint32_t                 durationTimerDelta;                                   // ticks after the timer ahead in the queue expires
+  uint32_t                 durationTimerSlackTicks;                              // ticks the expiry may be put off to share a wakeup
+  uint32_t                 durationTimerNext;                                    // delta queue links : APV_DURATION_TIMER_NULL_INDEX
+  uint32_t                 durationTimerPrevious;                                // ends the queue either way
+  bool                     durationTimerQueued;                                  // running i.e. in the delta queue
+  uint32_t                 durationTimerDeferredNext;                            // deferred list link : APV_DURATION_TIMER_NULL_INDEX ends it
+  bool                     durationTimerDeferred;                                // expired and waiting for its' callback
+  uint32_t                 durationTimerMissed;                                  // expiries folded into a callback still waiting
+  void                    (*durationTimerCallBack)(void *durationEventMessage);  // called from the main loop when the timer expires
+  void                    *durationTimerContext;                                 // the callback's argument
+  apvDurationTimerType_t   durationTimerType;                                    // a number of timer types can be supported
+  apvDurationTimerSource_t durationTimerSource;                                  // the tick the interval was converted for; kept for a retrigger
   } apvDurationTimer_t;
 
 typedef struct apvCoreTimerBlock_tTag
@@ -180,6 +321,12 @@ typedef struct apvCoreTimerBlock_tTag
   uint32_t           timeBaseDivider;                               // the value loaded into RTT->RTT_MR:RTPRES from which all 
                                                                     // duration timers are derived
   apvDurationTimer_t durationTimer[APV_CORE_TIMER_DURATION_TIMERS]; // a fixed number of duration timers is allocated
+  uint32_t           durationTimerQueueHead;                        // the next timer to expire or APV_DURATION_TIMER_NULL_INDEX
+  TcChannel         *durationTimerTicklessChannel;                  // tickless mode compare channel or NULL for the periodic tick
+  uint32_t           durationTimerTicklessBase;                     // timestamp count the head's delta is counted from
+  uint32_t           durationTimerDeferredHead;                     // expired timers oldest first or APV_DURATION_TIMER_NULL_INDEX
+  uint32_t           durationTimerDeferredTail;
+  uint32_t           durationTimerFreeHead;                         // the next timer to assign or APV_DURATION_TIMER_NULL_INDEX
   } apvCoreTimerBlock_t;
 
 /******************************************************************************/
@@ -192,6 +339,9 @@ extern volatile apvCoreTimerFlag_t  apvCoreTimerFlag,
 
 extern bool                         apvSystemTimerInUseFlag;
 
+extern TcChannel                   *apvEventTimerTimestampChannel,
+                                   *apvEventTimerTimestampHighChannel;
+
 /******************************************************************************/
 /* Function Declarations :                                                    */
 /******************************************************************************/
@@ -199,25 +349,33 @@ extern bool                         apvSystemTimerInUseFlag;
 extern APV_ERROR_CODE apvInitialiseSystemTimer(apvCoreTimerBlock_t *coreTimerBlock,
                                                uint64_t             systemTimerInterval);
 extern APV_ERROR_CODE apvStartSystemTimer(apvCoreTimerBlock_t *coreTimerBlock);
+extern APV_ERROR_CODE apvStartTicklessTimer(apvCoreTimerBlock_t *coreTimerBlock);
 extern APV_ERROR_CODE apvInitialiseCoreTimer(apvCoreTimerBlock_t *coreTimerBlock,
                                              uint64_t             coreTimerInterval);
 extern APV_ERROR_CODE apvAssignDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
                                              void                    (*durationTimerCallBack)(void *durationEventMessage),
+                                             void                     *durationTimerContext,
                                              apvDurationTimerType_t    durationTimerType,
                                              uint64_t                  durationTimerInterval,
                                              apvDurationTimerSource_t  durationTimerSource,
-                                             uint32_t                 *timerIndex);
-extern APV_ERROR_CODE apvDeAssignDurationTimer(apvCoreTimerBlock_t *coreTimerBlock,
-                                               uint32_t            *timerIndex);
-extern APV_ERROR_CODE apvReTriggerDurationTimer(apvCoreTimerBlock_t *coreTimerBlock,
-                                                uint32_t             timerIndex,
-                                                uint64_t             durationTimerInterval);
+                                             apvDurationTimerHandle_t *timerHandle);
+extern APV_ERROR_CODE apvDeAssignDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
+                                               apvDurationTimerHandle_t *timerHandle);
+extern APV_ERROR_CODE apvReTriggerDurationTimer(apvCoreTimerBlock_t      *coreTimerBlock,
+                                                apvDurationTimerHandle_t  timerHandle,
+                                                uint64_t                  durationTimerInterval);
+extern APV_ERROR_CODE apvSetDurationTimerSlack(apvCoreTimerBlock_t      *coreTimerBlock,
+                                               apvDurationTimerHandle_t  timerHandle,
+                                               uint64_t                  durationTimerSlack);
 extern APV_ERROR_CODE apvExecuteDurationTimers(apvCoreTimerBlock_t *coreTimerBlock);
+extern APV_ERROR_CODE apvRunDurationTimerCallBacks(apvCoreTimerBlock_t *coreTimerBlock);
 extern APV_ERROR_CODE apvInitialiseEventTimerBlocks(apvEventTimersBlock_t *apvEventTimerBlock,
                                                     uint32_t               numberOfTimerBlocks);
 extern APV_ERROR_CODE apvAssignEventTimer(uint16_t                timerChannel,
                                           apvEventTimersBlock_t  *apvEventTimerBlockBaseAddress,
-                                          void                  (*apvEventTimerChannelCallBack)(uint32_t apvEventTimerIndex));
+                                          apvEventTimerCallBack_t apvEventTimerChannelCallBack,
+                                          void                   *apvEventTimerChannelContext,
+                                          uint32_t                apvEventTimerStatusMask);
 extern APV_ERROR_CODE apvConfigureWaveformEventTimer(uint16_t                           timerChannel,
                                                      apvEventTimersBlock_t             *apvEventTimerBlockBaseAddress,
                                                      apvEventTimerChannelClockSource_t  channelClock,
@@ -229,16 +387,21 @@ extern APV_ERROR_CODE apvConfigureWaveformEventTimer(uint16_t
 extern APV_ERROR_CODE apvSwitchWaveformEventTimer(uint16_t                           timerChannel,
                                                   apvEventTimersBlock_t             *apvEventTimerBlockBaseAddress,
                                                   bool                               apvEventTimerSwitch);
-
-extern void           apvEventTimerChannel0CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel1CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel2CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel3CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel4CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel5CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel6CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel7CallBack(uint32_t apvEventTimerIndex);
-extern void           apvEventTimerChannel8CallBack(uint32_t apvEventTimerIndex);
+extern APV_ERROR_CODE apvConfigureFreeRunningEventTimer(uint16_t                           timerChannel,
+                                                        apvEventTimersBlock_t             *apvEventTimerBlockBaseAddress,
+                                                        apvEventTimerChannelClockSource_t  channelClock);
+extern APV_ERROR_CODE apvConfigureChainedEventTimer(uint16_t               timerChannel,
+                                                    uint16_t               chainedTimerChannel,
+                                                    apvEventTimersBlock_t *apvEventTimerBlockBaseAddress);
+extern uint32_t       apvEventTimerTimestamp(void);
+extern uint64_t       apvEventTimerTimestamp64(void);
+
+extern void           apvEventTimerHotShotCallBack(uint32_t  apvEventTimerIndex,
+                                                   uint32_t  apvEventTimerStatus,
+                                                   void     *apvEventTimerContext);
+extern void           apvDurationTimerTicklessCallBack(uint32_t  apvEventTimerIndex,
+                                                       uint32_t  apvEventTimerStatus,
+                                                       void     *apvEventTimerContext);
 extern void           apvDurationStateTimer(void *stateTimerIndex);
 
 /******************************************************************************/
@@ -19,6 +19,8 @@
 /* Function Declarations :                                                    */
 /******************************************************************************/
 
+extern void apvEventTimerDispatch(uint32_t apvEventTimerIndex);
+
 extern void TC0_Handler(void);
 extern void TC1_Handler(void);
 extern void TC2_Handler(void);
@@ -0,0 +1,546 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvInterruptLatency.c                                                      */
+/* 18.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - interrupt latency and jitter instrumentation from the core cycle counter */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sam3x8e.h>
+#include "ApvError.h"
+#include "ApvUtilities.h"
+#include "ApvRegisterAccess.h"
+#include "ApvMessageHandling.h"
+#include "ApvControlPortProtocol.h"
+#include "ApvInterruptLatency.h"
+
+/******************************************************************************/
+/* Global Variable Definitions :                                              */
+/******************************************************************************/
+
+apvInterruptLatencyStatistics_t apvInterruptLatencyStatistics[APV_INTERRUPT_LATENCY_SOURCES];
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvInterruptLatencyInitialise() :                                          */
+/*  <-- latencyError : error codes                                            */
+/*                                                                            */
+/* - start the DWT cycle counter and clear every sources' figures. The trace  */
+/*   enable in "DEMCR" must be set or "CYCCNT" does not count                 */
+/*                                                                            */
+/* Reference : ARMv7-M Architecture Reference Manual "The Data Watchpoint and */
+/*             Trace unit"                                                    */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvInterruptLatencyInitialise(void)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE latencyError  = APV_ERROR_CODE_NONE;
+
+  uint16_t       latencySource = 0;
+
+/******************************************************************************/
+
+  APV_REGISTER_COMMAND(CoreDebug, DEMCR,  (APV_REGISTER_READ(CoreDebug, DEMCR) | CoreDebug_DEMCR_TRCENA_Msk));
+  APV_REGISTER_COMMAND(DWT,       CYCCNT, 0);
+  APV_REGISTER_COMMAND(DWT,       CTRL,   (APV_REGISTER_READ(DWT, CTRL) | DWT_CTRL_CYCCNTENA_Msk));
+
+  for (latencySource = 0; latencySource < APV_INTERRUPT_LATENCY_SOURCES; latencySource++)
+    {
+    apvInterruptLatencyClear((apvInterruptLatencySource_t)latencySource);
+    }
+
+/******************************************************************************/
+
+  return(latencyError);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyInitialise                                   */
+
+/******************************************************************************/
+/* apvInterruptLatencyStamp() :                                               */
+/*  <-- : the core cycle counter                                              */
+/*                                                                            */
+/* - one read of "CYCCNT" : differences in unsigned 32-bit arithmetic are     */
+/*   good across one wrap (~51 seconds at 84MHz)                              */
+/*                                                                            */
+/******************************************************************************/
+
+uint32_t apvInterruptLatencyStamp(void)
+  {
+/******************************************************************************/
+
+  return(APV_REGISTER_READ(DWT, CYCCNT));
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyStamp                                        */
+
+/******************************************************************************/
+/* apvInterruptLatencySysTick() :                                             */
+/*  <-- : core cycles since the "SysTick" expiry                              */
+/*                                                                            */
+/* - "SysTick" counts the core clock down to zero, raises its' exception and  */
+/*   reloads "LOAD" : what it has counted down since is how late the handler  */
+/*   is. Call at the top of the handler, before anything else                 */
+/*                                                                            */
+/******************************************************************************/
+
+uint32_t apvInterruptLatencySysTick(void)
+  {
+/******************************************************************************/
+
+  uint32_t tickReload = SysTick->LOAD & SysTick_LOAD_RELOAD_Msk,
+           tickValue  = APV_REGISTER_READ(SysTick, VAL);
+
+/******************************************************************************/
+
+  return(tickReload - tickValue);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencySysTick                                      */
+
+/******************************************************************************/
+/* apvInterruptLatencyTimerChannel() :                                        */
+/*  --> timerChannel : the interrupting timer channel                         */
+/*  --> timerStatus  : the channel events being serviced (from "TC_SR")       */
+/*  <-- : core cycles since the earliest of the serviced events or            */
+/*        APV_INTERRUPT_LATENCY_UNSCHEDULED                                   */
+/*                                                                            */
+/* - a compare event happened when the counter passed the compare register    */
+/*   so the counter now, less the register, is how late the handler is. An RC */
+/*   compare that restarts the counter ("WAVSEL" UP_RC) and an overflow both  */
+/*   leave the counter counting from zero. Channels clocked from "SLCK" or    */
+/*   "XC<n>" run at no fixed ratio to the core clock and are not measured     */
+/*                                                                            */
+/******************************************************************************/
+
+uint32_t apvInterruptLatencyTimerChannel(TcChannel *timerChannel,
+                                         uint32_t   timerStatus)
+  {
+/******************************************************************************/
+
+  uint32_t timerMode     = 0,
+           timerClock    = 0,
+           timerCount    = 0,
+           timerElapsed  = 0,
+           latencyCycles = APV_INTERRUPT_LATENCY_UNSCHEDULED;
+
+/******************************************************************************/
+
+  if (timerChannel != NULL)
+    {
+    timerMode  = timerChannel->TC_CMR;
+    timerClock = timerMode & TC_CMR_TCCLKS_Msk;
+
+    if (timerClock <= TC_CMR_TCCLKS_TIMER_CLOCK4)
+      {
+      timerCount = timerChannel->TC_CV;
+
+      if ((timerStatus & TC_SR_CPCS) == TC_SR_CPCS)
+        {
+        if ((timerMode & (TC_CMR_WAVE | TC_CMR_WAVSEL_Msk)) == (TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC))
+          {
+          timerElapsed = timerCount;
+          }
+        else
+          {
+          timerElapsed = timerCount - timerChannel->TC_RC;
+          }
+
+        latencyCycles = timerElapsed;
+        }
+
+      if ((timerStatus & TC_SR_CPBS) == TC_SR_CPBS)
+        {
+        timerElapsed = timerCount - timerChannel->TC_RB;
+
+        if ((latencyCycles == APV_INTERRUPT_LATENCY_UNSCHEDULED) || (timerElapsed > latencyCycles))
+          {
+          latencyCycles = timerElapsed;
+          }
+        }
+
+      if ((timerStatus & TC_SR_CPAS) == TC_SR_CPAS)
+        {
+        timerElapsed = timerCount - timerChannel->TC_RA;
+
+        if ((latencyCycles == APV_INTERRUPT_LATENCY_UNSCHEDULED) || (timerElapsed > latencyCycles))
+          {
+          latencyCycles = timerElapsed;
+          }
+        }
+
+      if ((timerStatus & TC_SR_COVFS) == TC_SR_COVFS)
+        {
+        if ((latencyCycles == APV_INTERRUPT_LATENCY_UNSCHEDULED) || (timerCount > latencyCycles))
+          {
+          latencyCycles = timerCount;
+          }
+        }
+
+      // Counts to cycles : MCK / 2, 8, 32 or 128
+      if (latencyCycles != APV_INTERRUPT_LATENCY_UNSCHEDULED)
+        {
+        latencyCycles = latencyCycles << (APV_INTERRUPT_LATENCY_TIMER_CLOCK_SHIFT_BASE + (timerClock * APV_INTERRUPT_LATENCY_TIMER_CLOCK_SHIFT_STEP));
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(latencyCycles);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyTimerChannel                                 */
+
+/******************************************************************************/
+/* apvInterruptLatencyRecord() :                                              */
+/*  --> latencySource : the interrupt source                                  */
+/*  --> entryCycles   : 'apvInterruptLatencyStamp()' at the handlers' entry   */
+/*  --> latencyCycles : cycles from the scheduled expiry to the entry or      */
+/*                      APV_INTERRUPT_LATENCY_UNSCHEDULED                     */
+/*                                                                            */
+/* - called last thing in the handler : the exit is stamped here. Each source */
+/*   is only ever recorded from its' own handler so no locking is needed      */
+/*                                                                            */
+/******************************************************************************/
+
+void apvInterruptLatencyRecord(apvInterruptLatencySource_t latencySource,
+                               uint32_t                    entryCycles,
+                               uint32_t                    latencyCycles)
+  {
+/******************************************************************************/
+
+  apvInterruptLatencyStatistics_t *statistics    = NULL;
+  uint32_t                         serviceCycles = apvInterruptLatencyStamp() - entryCycles,
+                                   jitterCycles  = 0,
+                                   latencyBin    = 0,
+                                   binCycles     = 0;
+
+/******************************************************************************/
+
+  if (latencySource < APV_INTERRUPT_LATENCY_SOURCES)
+    {
+    statistics = &apvInterruptLatencyStatistics[latencySource];
+
+    statistics->latencyEntries      = statistics->latencyEntries      + 1;
+    statistics->latencyServiceTotal = statistics->latencyServiceTotal + serviceCycles;
+
+    if (serviceCycles < statistics->latencyServiceMinimum)
+      {
+      statistics->latencyServiceMinimum = serviceCycles;
+      }
+
+    if (serviceCycles > statistics->latencyServiceMaximum)
+      {
+      statistics->latencyServiceMaximum = serviceCycles;
+      }
+
+    if (latencyCycles != APV_INTERRUPT_LATENCY_UNSCHEDULED)
+      {
+      // The jitter needs a previous latency to compare with
+      if (statistics->latencyScheduled != 0)
+        {
+        jitterCycles = (latencyCycles > statistics->latencyLast) ? (latencyCycles - statistics->latencyLast) : (statistics->latencyLast - latencyCycles);
+
+        statistics->latencyJitterTotal = statistics->latencyJitterTotal + jitterCycles;
+
+        if (jitterCycles < statistics->latencyJitterMinimum)
+          {
+          statistics->latencyJitterMinimum = jitterCycles;
+          }
+
+        if (jitterCycles > statistics->latencyJitterMaximum)
+          {
+          statistics->latencyJitterMaximum = jitterCycles;
+          }
+        }
+
+      statistics->latencyScheduled = statistics->latencyScheduled + 1;
+      statistics->latencyTotal     = statistics->latencyTotal     + latencyCycles;
+      statistics->latencyLast      = latencyCycles;
+
+      if (latencyCycles < statistics->latencyMinimum)
+        {
+        statistics->latencyMinimum = latencyCycles;
+        }
+
+      if (latencyCycles > statistics->latencyMaximum)
+        {
+        statistics->latencyMaximum = latencyCycles;
+        }
+
+      // Find the histogram bin : the first bin is < 32 cycles, each bin after is 4x wider
+      binCycles = latencyCycles / APV_INTERRUPT_LATENCY_HISTOGRAM_BASE;
+
+      while ((binCycles != 0) && (latencyBin < (APV_INTERRUPT_LATENCY_HISTOGRAM_BINS - 1)))
+        {
+        binCycles  = binCycles >> APV_INTERRUPT_LATENCY_HISTOGRAM_SHIFT;
+        latencyBin = latencyBin + 1;
+        }
+
+      statistics->latencyHistogram[latencyBin] = statistics->latencyHistogram[latencyBin] + 1;
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyRecord                                       */
+
+/******************************************************************************/
+/* apvInterruptLatencyClear() :                                               */
+/*  --> latencySource : the interrupt source                                  */
+/*  <-- latencyError  : error codes                                           */
+/*                                                                            */
+/* - start a sources' figures again, e.g. before and after a change, so a     */
+/*   regression is not hidden in the figures from before it                   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvInterruptLatencyClear(apvInterruptLatencySource_t latencySource)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                   latencyError = APV_ERROR_CODE_NONE;
+  apvInterruptLatencyStatistics_t *statistics   = NULL;
+
+/******************************************************************************/
+
+  if (latencySource >= APV_INTERRUPT_LATENCY_SOURCES)
+    {
+    latencyError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    statistics = &apvInterruptLatencyStatistics[latencySource];
+
+    APV_CRITICAL_REGION_ENTRY();
+
+    memset((void *)statistics, 0, sizeof(apvInterruptLatencyStatistics_t));
+
+    statistics->latencyMinimum        = APV_INTERRUPT_LATENCY_MINIMUM_RESET;
+    statistics->latencyJitterMinimum  = APV_INTERRUPT_LATENCY_MINIMUM_RESET;
+    statistics->latencyServiceMinimum = APV_INTERRUPT_LATENCY_MINIMUM_RESET;
+
+    APV_CRITICAL_REGION_EXIT();
+    }
+
+/******************************************************************************/
+
+  return(latencyError);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyClear                                        */
+
+/******************************************************************************/
+/* apvInterruptLatencyReport() :                                              */
+/*  --> latencySource       : the interrupt source                            */
+/*  --> reportSelect        : [ 'L' == latency | 'J' == jitter |              */
+/*                              'S' == service time |                         */
+/*                              'H' == latency histogram | 'C' == clear ]     */
+/*  --> report              : the report text buffer                          */
+/*  --> reportMaximumLength : the report text buffer length                   */
+/*  <-- latencyError        : error codes                                     */
+/*                                                                            */
+/* - format one line of a sources' figures from a copy taken with interrupts  */
+/*   masked. All times are core cycles. The latency, jitter and service time  */
+/*   lines are :                                                              */
+/*     "I<source> <select> <count> <minimum>/<mean>/<maximum>\r"              */
+/*   the histogram line is :                                                  */
+/*     "I<source> H <bin 0> .. <bin 7>\r"                                     */
+/*   and clearing answers "I<source> C\r". Each line fits in a single         */
+/*   (unstuffed) message payload                                              */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvInterruptLatencyReport(apvInterruptLatencySource_t  latencySource,
+                                         char                         reportSelect,
+                                         char                        *report,
+                                         uint16_t                     reportMaximumLength)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                  latencyError = APV_ERROR_CODE_NONE;
+
+  apvInterruptLatencyStatistics_t statistics;
+  uint32_t                        count        = 0,
+                                  minimum      = 0,
+                                  maximum      = 0,
+                                  binCount     = 0;
+  uint64_t                        total        = 0;
+  uint16_t                        reportLength = 0,
+                                  bin          = 0;
+
+/******************************************************************************/
+
+  if (report == NULL)
+    {
+    latencyError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((latencySource >= APV_INTERRUPT_LATENCY_SOURCES) || (reportMaximumLength == 0))
+      {
+      latencyError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      APV_CRITICAL_REGION_ENTRY();
+
+      statistics = apvInterruptLatencyStatistics[latencySource];
+
+      APV_CRITICAL_REGION_EXIT();
+
+      switch(reportSelect)
+        {
+        case APV_INTERRUPT_LATENCY_SELECT_LATENCY   : count   = statistics.latencyScheduled;
+                                                      minimum = statistics.latencyMinimum;
+                                                      maximum = statistics.latencyMaximum;
+                                                      total   = statistics.latencyTotal;
+                                                      break;
+
+        case APV_INTERRUPT_LATENCY_SELECT_JITTER    : count   = (statistics.latencyScheduled != 0) ? (statistics.latencyScheduled - 1) : 0;
+                                                      minimum = statistics.latencyJitterMinimum;
+                                                      maximum = statistics.latencyJitterMaximum;
+                                                      total   = statistics.latencyJitterTotal;
+                                                      break;
+
+        case APV_INTERRUPT_LATENCY_SELECT_SERVICE   : count   = statistics.latencyEntries;
+                                                      minimum = statistics.latencyServiceMinimum;
+                                                      maximum = statistics.latencyServiceMaximum;
+                                                      total   = statistics.latencyServiceTotal;
+                                                      break;
+
+        case APV_INTERRUPT_LATENCY_SELECT_HISTOGRAM : break;
+
+        case APV_INTERRUPT_LATENCY_SELECT_CLEAR     : latencyError = apvInterruptLatencyClear(latencySource);
+                                                      break;
+
+        default                                     : latencyError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+                                                      break;
+        }
+
+      if (latencyError == APV_ERROR_CODE_NONE)
+        {
+        if (reportSelect == APV_INTERRUPT_LATENCY_SELECT_CLEAR)
+          {
+          snprintf(report, reportMaximumLength, "I%u %c\r", (unsigned int)latencySource, reportSelect);
+          }
+        else
+          {
+          if (reportSelect == APV_INTERRUPT_LATENCY_SELECT_HISTOGRAM)
+            {
+            reportLength = snprintf(report, reportMaximumLength, "I%u %c", (unsigned int)latencySource, reportSelect);
+
+            for (bin = 0; (bin < APV_INTERRUPT_LATENCY_HISTOGRAM_BINS) && (reportLength < reportMaximumLength); bin++)
+              {
+              binCount = statistics.latencyHistogram[bin];
+
+              if (binCount > APV_INTERRUPT_LATENCY_HISTOGRAM_LIMIT)
+                {
+                binCount = APV_INTERRUPT_LATENCY_HISTOGRAM_LIMIT;
+                }
+
+              reportLength = reportLength + snprintf(report + reportLength, reportMaximumLength - reportLength, " %lu", (unsigned long)binCount);
+              }
+
+            if (reportLength < reportMaximumLength)
+              {
+              snprintf(report + reportLength, reportMaximumLength - reportLength, "\r");
+              }
+            }
+          else
+            {
+            if (count == 0)
+              { // Nothing recorded yet - report zeroes rather than the minimum reset value
+              minimum = 0;
+              total   = 0;
+              }
+            else
+              {
+              total = total / count;
+              }
+
+            snprintf(report, reportMaximumLength, "I%u %c %lu %lu/%lu/%lu\r",
+                     (unsigned int)latencySource, reportSelect, (unsigned long)count,
+                     (unsigned long)minimum, (unsigned long)total, (unsigned long)maximum);
+            }
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(latencyError);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyReport                                       */
+
+/******************************************************************************/
+/* apvInterruptLatencyAction() :                                              */
+/*  --> messageAction : the response message buffer, holding a copy of the    */
+/*                      request :                                             */
+/*                        "APV_INTERRUPT_LATENCY <source> [L|J|S|H|C]"        */
+/*  <-- : the response message buffer                                         */
+/*                                                                            */
+/* - control protocol action : replace the request payload with one line of   */
+/*   the selected sources' figures. An unreadable request returns an empty    */
+/*   payload                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+void *apvInterruptLatencyAction(void *messageAction)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *responseMessage = (apvMessageStructure_t *)messageAction;
+
+  uint32_t               latencySource   = 0;
+  char                   reportSelect    = APV_INTERRUPT_LATENCY_SELECT_LATENCY;
+  APV_ERROR_CODE         argumentError   = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (responseMessage != NULL)
+    {
+    // The source index is decimal
+    argumentError = apvCommandProtocolDecimalArgument(&responseMessage->apvMessagingPayload[0],
+                                                       responseMessage->apvMessagingLengthOfMessage,
+                                                       (APV_INTERRUPT_LATENCY_SOURCES - 1),
+                                                      &latencySource,
+                                                      &reportSelect);
+
+    responseMessage->apvMessagingPayload[0] = '\0';
+
+    if (argumentError == APV_ERROR_CODE_NONE)
+      {
+      apvInterruptLatencyReport((apvInterruptLatencySource_t)latencySource,
+                                 reportSelect,
+                                (char *)&responseMessage->apvMessagingPayload[0],
+                                 APV_MESSAGING_MAXIMUM_UNSTUFFED_MESSAGE_LENGTH);
+      }
+    }
+
+/******************************************************************************/
+
+  return(messageAction);
+
+/******************************************************************************/
+  } /* end of apvInterruptLatencyAction                                       */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,134 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvInterruptLatency.h                                                      */
+/* 18.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - interrupt latency and jitter instrumentation. Each instrumented handler  */
+/*   stamps its' entry from the core cycle counter (DWT "CYCCNT") and, where  */
+/*   the interrupt was scheduled by a counter (the "SysTick" reload or a      */
+/*   timer channel compare), how long ago that expiry was. Per-source figures */
+/*   are reported over the control port by "APV_INTERRUPT_LATENCY"            */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_INTERRUPT_LATENCY_H_
+#define _APV_INTERRUPT_LATENCY_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sam3x8e.h>
+#include "ApvError.h"
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+/******************************************************************************/
+/* All times are core clock cycles ( 84MHz : 11.9nsecs ). The latency is from */
+/* the scheduled expiry to the handlers' first instruction; the jitter is the */
+/* change in latency from one entry to the next and the service time is the   */
+/* handlers' entry to exit. Sources with no scheduled expiry (the serial and  */
+/* SPI handlers) record only the service time                                 */
+/******************************************************************************/
+
+#define APV_INTERRUPT_LATENCY_UNSCHEDULED            ((uint32_t)0xffffffff) // the handler has no expiry to measure from
+
+#define APV_INTERRUPT_LATENCY_HISTOGRAM_BINS         8                      // latency histogram bins
+#define APV_INTERRUPT_LATENCY_HISTOGRAM_BASE         ((uint32_t)32)         // the first bin is < 32 cycles ( 381nsecs )
+#define APV_INTERRUPT_LATENCY_HISTOGRAM_SHIFT        2                      // each bin is 4x wider than the last : ... >= 524288 cycles
+#define APV_INTERRUPT_LATENCY_HISTOGRAM_LIMIT        ((uint32_t)0xffff)     // reported bin counts saturate here
+#define APV_INTERRUPT_LATENCY_MINIMUM_RESET          ((uint32_t)0xffffffff)
+
+// Timer channel counts to core cycles : "TIMER_CLOCK1" .. "TIMER_CLOCK4" are MCK / 2, 8, 32 and 128
+#define APV_INTERRUPT_LATENCY_TIMER_CLOCK_SHIFT_BASE 1
+#define APV_INTERRUPT_LATENCY_TIMER_CLOCK_SHIFT_STEP 2
+
+// Latency report selectors (the optional last field of the latency command)
+#define APV_INTERRUPT_LATENCY_SELECT_LATENCY         'L'
+#define APV_INTERRUPT_LATENCY_SELECT_JITTER          'J'
+#define APV_INTERRUPT_LATENCY_SELECT_SERVICE         'S'
+#define APV_INTERRUPT_LATENCY_SELECT_HISTOGRAM       'H'
+#define APV_INTERRUPT_LATENCY_SELECT_CLEAR           'C'
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef enum apvInterruptLatencySource_tTag
+  {
+  APV_INTERRUPT_LATENCY_SOURCE_SYSTICK = 0,
+  APV_INTERRUPT_LATENCY_SOURCE_TC0,
+  APV_INTERRUPT_LATENCY_SOURCE_TC1,
+  APV_INTERRUPT_LATENCY_SOURCE_TC2,
+  APV_INTERRUPT_LATENCY_SOURCE_TC3,
+  APV_INTERRUPT_LATENCY_SOURCE_TC4,
+  APV_INTERRUPT_LATENCY_SOURCE_TC5,
+  APV_INTERRUPT_LATENCY_SOURCE_TC6,
+  APV_INTERRUPT_LATENCY_SOURCE_TC7,
+  APV_INTERRUPT_LATENCY_SOURCE_TC8,
+  APV_INTERRUPT_LATENCY_SOURCE_UART,
+  APV_INTERRUPT_LATENCY_SOURCE_SPI0,
+  APV_INTERRUPT_LATENCY_SOURCE_RTT,
+  APV_INTERRUPT_LATENCY_SOURCE_USART0,
+  APV_INTERRUPT_LATENCY_SOURCE_USART1,
+  APV_INTERRUPT_LATENCY_SOURCE_USART2,
+  APV_INTERRUPT_LATENCY_SOURCE_USART3,
+  APV_INTERRUPT_LATENCY_SOURCES
+  } apvInterruptLatencySource_t;
+
+typedef struct apvInterruptLatencyStatistics_tTag
+  {
+  uint32_t latencyEntries;                                               // handler entries
+  uint32_t latencyScheduled;                                             // entries with a scheduled expiry
+  uint32_t latencyMinimum;                                               // expiry to entry
+  uint32_t latencyMaximum;
+  uint64_t latencyTotal;
+  uint32_t latencyLast;                                                  // the last latency, for the jitter
+  uint32_t latencyJitterMinimum;                                         // latency change between successive entries
+  uint32_t latencyJitterMaximum;
+  uint64_t latencyJitterTotal;
+  uint32_t latencyServiceMinimum;                                        // entry to exit
+  uint32_t latencyServiceMaximum;
+  uint64_t latencyServiceTotal;
+  uint32_t latencyHistogram[APV_INTERRUPT_LATENCY_HISTOGRAM_BINS];
+  } apvInterruptLatencyStatistics_t;
+
+/******************************************************************************/
+/* Global Variable Declarations :                                             */
+/******************************************************************************/
+
+extern apvInterruptLatencyStatistics_t apvInterruptLatencyStatistics[APV_INTERRUPT_LATENCY_SOURCES];
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern APV_ERROR_CODE apvInterruptLatencyInitialise(void);
+extern uint32_t       apvInterruptLatencyStamp(void);
+extern uint32_t       apvInterruptLatencySysTick(void);
+extern uint32_t       apvInterruptLatencyTimerChannel(TcChannel *timerChannel,
+                                                      uint32_t   timerStatus);
+extern void           apvInterruptLatencyRecord(apvInterruptLatencySource_t latencySource,
+                                                uint32_t                    entryCycles,
+                                                uint32_t                    latencyCycles);
+extern APV_ERROR_CODE apvInterruptLatencyClear(apvInterruptLatencySource_t latencySource);
+extern APV_ERROR_CODE apvInterruptLatencyReport(apvInterruptLatencySource_t  latencySource,
+                                                char                         reportSelect,
+                                                char                        *report,
+                                                uint16_t                     reportMaximumLength);
+extern void          *apvInterruptLatencyAction(void *messageAction);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
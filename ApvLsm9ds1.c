@@ -26,6 +26,7 @@
 #include "ApvCommsUtilities.h"
 #include "ApvEventTimers.h"
 #include "ApvLsm9ds1.h"
+#include "ApvInterruptLatency.h"
 
 /******************************************************************************/
 /* Global Variables :                                                         */
@@ -723,8 +724,8 @@ APV_ERROR_CODE apvInitialiseLsm9ds1(Spi                  *spiControlBlock_p,
   {
 /******************************************************************************/
 
-  APV_ERROR_CODE lsm9ds1Error         = APV_ERROR_CODE_NONE;
-  uint32_t       apvLsm9ds1TimerIndex = APV_DURATION_TIMER_NULL_INDEX;
+  APV_ERROR_CODE           lsm9ds1Error          = APV_ERROR_CODE_NONE;
+  apvDurationTimerHandle_t apvLsm9ds1TimerHandle = APV_DURATION_TIMER_NULL_HANDLE;
 
 /******************************************************************************/
 /* The device startup is a simple state-machine of timed events - get a timer */
@@ -732,22 +733,32 @@ APV_ERROR_CODE apvInitialiseLsm9ds1(Spi                  *spiControlBlock_p,
 
   lsm9ds1Error = apvAssignDurationTimer( apvCoreTimerBlock,
                                          apvLsm9ds1StateTimer,
+                                         NULL,
                                          APV_DURATION_TIMER_TYPE_ONE_SHOT,    // single-shot
                                          APV_EVENT_TIMER_INVERSE_NANOSECONDS, // one second period
                                          APV_DURATION_TIMER_SOURCE_SYSTICK,
-                                        &apvLsm9ds1TimerIndex);
+                                        &apvLsm9ds1TimerHandle);
+
+  lsm9ds1Error = apvSetDurationTimerSlack(apvCoreTimerBlock,
+                                          apvLsm9ds1TimerHandle,
+                                          APV_LSM9DS1_STARTUP_TIMER_SLACK);
                                                
+  // The main loop is not running yet : the timer callback is run from here
   while (apvLsm9ds1TimerFlag == false)
-    ;
+    {
+    apvRunDurationTimerCallBacks(apvCoreTimerBlock);
+    }
 
   apvLsm9ds1TimerFlag = false;
 
   lsm9ds1Error = apvReTriggerDurationTimer(apvCoreTimerBlock,
-                                           apvLsm9ds1TimerIndex,
+                                           apvLsm9ds1TimerHandle,
                                            (APV_EVENT_TIMER_INVERSE_NANOSECONDS * 10));
 
   while (apvLsm9ds1TimerFlag == false)
-    ;
+    {
+    apvRunDurationTimerCallBacks(apvCoreTimerBlock);
+    }
 
 /******************************************************************************/
 /* Check the accelerometer and gyroscope device is alive by requesting the    */
@@ -788,12 +799,20 @@ void apvLsm9ds1StateTimer(void *durationEventMessage)
 
 void SPI0_Handler(void)
   {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
 /******************************************************************************/
 
   apvSPI0ReceiverReady = true;
 
   NVIC_ClearPendingIRQ(SPI0_IRQn);
 
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_SPI0,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
+
 /******************************************************************************/
   } /* end of SPI0_Handler                                                    */
 
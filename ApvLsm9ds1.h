@@ -26,6 +26,9 @@
 /* Constants :                                                                */
 /******************************************************************************/
 
+// The start-up waits are minimums : the timer may share a later wakeup by this much (nanoseconds)
+#define APV_LSM9DS1_STARTUP_TIMER_SLACK                  ((uint64_t)10000000)
+
 // Section 5.2, p31
 #define APV_LSM9DS1_TRANSACTION_READ                     ((APV_LSM9DS1_FIELD_SIZE)0x01)
 #define APV_LSM9DS1_TRANSACTION_WRITE                    ((APV_LSM9DS1_FIELD_SIZE)0x00)
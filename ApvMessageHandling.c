@@ -261,6 +261,9 @@ APV_ERROR_CODE apvMessageStructureInitialisation(apvMessageStructure_t *messageS
   messageStructure->apvMessagingCrcLowToken                               = 0;
   messageStructure->apvMessagingCrcHighToken                              = 0;
   messageStructure->apvMessagingEndOfMessageToken                         = 0;
+  messageStructure->apvMessagingReferenceCount                            = 0;
+  messageStructure->apvMessagingHomePool                                  = NULL;
+  messageStructure->apvMessagingEnqueueTimestamp                          = 0;
 
   messageStructure->apvMessagingPayloadMaximumLength = messagePayloadMaximumLength;
 
@@ -398,8 +401,7 @@ APV_MESSAGING_STATE_CODE apvDeFrameMessageInitialisation(apvRingBuffer_t
 
   APV_MESSAGING_STATE_CODE  deFramingError   = APV_STATE_MACHINE_CODE_NONE;
 
-  uint32_t                  *messageBuffer   =  NULL,
-                           **messageBuffer_p = &messageBuffer;
+  apvMessageStructure_t    *messageBuffer    =  NULL;
 
 /******************************************************************************/
 
@@ -422,18 +424,15 @@ APV_MESSAGING_STATE_CODE apvDeFrameMessageInitialisation(apvRingBuffer_t
     {
     // Get a message buffer from the "free" list
     if (apvRingBufferUnLoad( messageFreeBuffers,
-                             APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                            (uint32_t *)messageBuffer_p,
+                             APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                            &messageBuffer,
                              1,
                              true) != 0)
       {
       // KEEP THIS FOR THE FINAL READ-BACK WHEN THE MESSAGE HAS BEEN ASSEMBLED, USE THE STATE-MACHINE MESSAGE-FRAME FOR ASSEMBLY
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW]           = (apvMessageStateVariable_t)(((apvMessageStateEntryPointer_t)ringBuffer)          & APV_UINT64_POINTER_UINT32_MASK);
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_HIGH]          = (apvMessageStateVariable_t)0; // pointers are only 32-bits wide on Cortex-M
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]        = (apvMessageStateVariable_t)(((apvMessageStateEntryPointer_t)messageBuffer)       & APV_UINT64_POINTER_UINT32_MASK);
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_HIGH]       = (apvMessageStateVariable_t)0; // pointers are only 32-bits wide on Cortex-M
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS_LOW]  = (apvMessageStateVariable_t)(((apvMessageStateEntryPointer_t)messageFreeBuffers)  & APV_UINT64_POINTER_UINT32_MASK);
-      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS_HIGH] = (apvMessageStateVariable_t)0; // pointers are only 32-bits wide on Cortex-M
+      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER]          = (apvMessageStateVariable_t)ringBuffer;
+      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]       = (apvMessageStateVariable_t)messageBuffer;
+      messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS] = (apvMessageStateVariable_t)messageFreeBuffers;
       }
     else
       {
@@ -474,6 +473,49 @@ APV_MESSAGING_STATE_CODE apvDeFrameMessage(apvMessagingDeFramingState_t *message
 /******************************************************************************/
   } /* end of apvDeFrameMessage                                               */
 
+/******************************************************************************/
+/* apvDeFrameMessageStateMachineCreate() :                                    */
+/*  <-- messageStateMachine   : a table of APV_MESSAGE_FRAME_STATES states    */
+/*  --> messageStateVariables : the state-variable cache for this table       */
+/*  <-- creationError         : error codes                                   */
+/*                                                                            */
+/* - make a private copy of the message de-framing state-machine with its     */
+/*   own state-variable cache so more than one serial port can be de-framed   */
+/*   at once without the partial frames getting mixed up                      */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvDeFrameMessageStateMachineCreate(apvMessagingDeFramingState_t *messageStateMachine,
+                                                   apvMessagingStateVariables_t *messageStateVariables)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE creationError = APV_ERROR_CODE_NONE;
+
+  uint16_t       frameState    = 0;
+
+/******************************************************************************/
+
+  if ((messageStateMachine == NULL) || (messageStateVariables == NULL))
+    {
+    creationError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    for (frameState = APV_MESSAGE_FRAME_STATE_NULL; frameState < APV_MESSAGE_FRAME_STATES; frameState++)
+      {
+      *(messageStateMachine + frameState)                          = apvMessagingDeFramingStateMachine[frameState];
+      (messageStateMachine + frameState)->apvMessageStateVariables = messageStateVariables;
+      }
+    }
+
+/******************************************************************************/
+
+  return(creationError);
+
+/******************************************************************************/
+  } /* end of apvDeFrameMessageStateMachineCreate                             */
+
 /******************************************************************************/
 /* Message de-framing state machine functions :                               */
 /******************************************************************************/
@@ -532,7 +574,7 @@ APV_MESSAGING_STATE_CODE apvMessageDeFramingInitialise(apvMessagingDeFramingStat
   messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FRAME_CHECK]            = APV_MESSAGE_FRAME_STATE_FRAME_REPORTER;
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // If a message buffer has been allocated point to it else prevent this state machine EVER progressing
   if (messageBufferPointer != NULL)
@@ -573,23 +615,23 @@ APV_MESSAGING_STATE_CODE apvMessageDeFramingInBoundSignalAndLogicalPlanes(apvMes
 
   APV_MESSAGING_STATE_CODE  apvStateError        = APV_STATE_MACHINE_CODE_NONE;
 
-  apvPointerConversion_t    ringBufferPointer;
+  apvRingBuffer_t          *ringBuffer           = NULL;
   apvMessageStructure_t    *messageBufferPointer = NULL;
 
 /******************************************************************************/
 
-  // Compute the ring-buffer structure address
-  ringBufferPointer.apvPointerConversion = (apvMessageStateEntryPointer_t)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW];
+  // Recover the ring-buffer structure address
+  ringBuffer           = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER];
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // Get the next token off the ring-buffer if it exists
-  if (apvRingBufferUnLoad((apvRingBuffer_t *)(ringBufferPointer.apvPointerConversion),
-                          APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                          ((uint32_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN])),
-                          1,
-                          true) != 0)
+  if (apvRingBufferUnLoad( ringBuffer,
+                           APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                          &messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN],
+                           1,
+                           true) != 0)
     {
     if ((messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN] & APV_MESSAGE_PAYLOAD_CHARACTER_MASK) == APV_MESSAGING_START_OF_MESSAGE)
       { // <SOM> signals a false message start so go back to the start
@@ -631,23 +673,23 @@ APV_MESSAGING_STATE_CODE apvMessageDeFramingOutBoundSignalAndLogicalPlanes(apvMe
 
   APV_MESSAGING_STATE_CODE  apvStateError        = APV_STATE_MACHINE_CODE_NONE;
 
-  apvPointerConversion_t    ringBufferPointer;
+  apvRingBuffer_t          *ringBuffer           = NULL;
   apvMessageStructure_t    *messageBufferPointer = NULL;
 
 /******************************************************************************/
 
-  // Compute the ring-buffer structure address
-  ringBufferPointer.apvPointerConversion = (apvMessageStateEntryPointer_t)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW];
+  // Recover the ring-buffer structure address
+  ringBuffer           = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER];
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // Get the next token off the ring-buffer if it exists
-  if (apvRingBufferUnLoad((apvRingBuffer_t *)(ringBufferPointer.apvPointerConversion),
-                          APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                          ((uint32_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN])),
-                          1,
-                          true) != 0)
+  if (apvRingBufferUnLoad( ringBuffer,
+                           APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                          &messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN],
+                           1,
+                           true) != 0)
     {
     if ((messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN] & APV_MESSAGE_PAYLOAD_CHARACTER_MASK) == APV_MESSAGING_START_OF_MESSAGE)
       { // <SOM> signals a false message start so go back to the start
@@ -689,23 +731,23 @@ APV_MESSAGING_STATE_CODE apvMessageDeFramingMessageLength(apvMessagingDeFramingS
 
   APV_MESSAGING_STATE_CODE  apvStateError        = APV_STATE_MACHINE_CODE_NONE;
 
-  apvPointerConversion_t    ringBufferPointer;
+  apvRingBuffer_t          *ringBuffer           = NULL;
   apvMessageStructure_t    *messageBufferPointer = NULL;
 
 /******************************************************************************/
 
-  // Compute the ring-buffer structure address
-  ringBufferPointer.apvPointerConversion = (apvMessageStateEntryPointer_t)((*(apvMessageStateEntryPointer_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW])));
+  // Recover the ring-buffer structure address
+  ringBuffer           = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER];
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // Get the next token off the ring-buffer if it exists
-  if (apvRingBufferUnLoad((apvRingBuffer_t *)(ringBufferPointer.apvPointerConversion),
-                          APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                          ((uint32_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN])),
-                          1,
-                          true) != 0)
+  if (apvRingBufferUnLoad( ringBuffer,
+                           APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                          &messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN],
+                           1,
+                           true) != 0)
     {
     if ((messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN] == APV_MESSAGING_START_OF_MESSAGE) & APV_MESSAGE_PAYLOAD_CHARACTER_MASK)
       { // <SOM> signals a false message start so go back to the first state
@@ -752,23 +794,23 @@ APV_MESSAGING_STATE_CODE apvMessageDeFramingDataByte(apvMessagingDeFramingState_
 
   APV_MESSAGING_STATE_CODE  apvStateError        = APV_STATE_MACHINE_CODE_NONE;
 
-  apvPointerConversion_t    ringBufferPointer;
+  apvRingBuffer_t          *ringBuffer           = NULL;
   apvMessageStructure_t    *messageBufferPointer = NULL;
 
 /******************************************************************************/
 
-  // Compute the ring-buffer structure address
-  ringBufferPointer.apvPointerConversion = (apvMessageStateEntryPointer_t)((*(apvMessageStateEntryPointer_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW])));
+  // Recover the ring-buffer structure address
+  ringBuffer           = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER];
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // Get the next token off the ring-buffer if it exists
-  if (apvRingBufferUnLoad((apvRingBuffer_t *)(ringBufferPointer.apvPointerConversion),
-                          APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                          ((uint32_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN])),
-                          1,
-                          true) != 0)
+  if (apvRingBufferUnLoad( ringBuffer,
+                           APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                          &messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN],
+                           1,
+                           true) != 0)
     {
     // Compute the running CRC
     apvComputeCrc((uint8_t)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN], 
@@ -901,25 +943,25 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingCrcBytes(apvMessagingDeFramingStat
 
   APV_MESSAGING_STATE_CODE  apvStateError        = APV_STATE_MACHINE_CODE_NONE;
 
-  apvPointerConversion_t    ringBufferPointer;
+  apvRingBuffer_t          *ringBuffer           = NULL;
   apvMessageStructure_t    *messageBufferPointer = NULL;
 
 /******************************************************************************/
 
-  // Compute the ring-buffer structure address
-  ringBufferPointer.apvPointerConversion = (apvMessageStateEntryPointer_t)((*(apvMessageStateEntryPointer_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW])));
+  // Recover the ring-buffer structure address
+  ringBuffer           = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_RING_BUFFER];
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   if (messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_PAYLOAD_LENGTH] < APV_CRC_WORD_WIDTH)
     {
      // Get the next token off the ring-buffer if it exists
-    if (apvRingBufferUnLoad((apvRingBuffer_t *)(ringBufferPointer.apvPointerConversion),
-                            APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                            ((uint32_t *)(&messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN])),
-                            1,
-                            true) != 0)
+    if (apvRingBufferUnLoad( ringBuffer,
+                             APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                            &messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN],
+                             1,
+                             true) != 0)
       {
       // Divide the running CRC by the pre-computed message CRC
       apvComputeCrc(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN], 
@@ -966,7 +1008,7 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingCrcCheck(apvMessagingDeFramingStat
 /******************************************************************************/
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   // Test if the CRC check has passed
   if (messageBufferPointer->apvMessagingCrcLowToken == APV_CRC_GENERATOR_FINAL_VALUE)
@@ -991,7 +1033,11 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingCrcCheck(apvMessagingDeFramingStat
 /* <--> messageStateMachine : the message state machine table                 */
 /* <--  apvStateError       : error codes                                     */
 /*                                                                            */
-/* - deliver an error-free message to a higher layer :                        */
+/* - deliver an error-free message to a higher layer. The state machine needs */
+/*   a fresh message buffer before the decoded one can be handed over; with   */
+/*   no fresh buffer or no room on the target components' input ring the      */
+/*   message is dropped, counted against the target component, and its'       */
+/*   buffer left for re-use                                                   */
 /*                                                                            */
 /******************************************************************************/
 
@@ -1001,10 +1047,8 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingReporter(apvMessagingDeFramingStat
 
   APV_MESSAGING_STATE_CODE  apvStateError           =  APV_STATE_MACHINE_CODE_NONE;
 
-  apvMessageStructure_t    *liveMessageBuffer       =  NULL;
-
-  uint32_t                  *newMessageBuffer       =  NULL,
-                           **newMessageBuffer_p     = &newMessageBuffer;
+  apvMessageStructure_t    *liveMessageBuffer       =  NULL,
+                           *newMessageBuffer        =  NULL;
 
   apvCommsPlanes_t          targetCommsPlane        =  APV_COMMS_PLANE_UNUSED_0;
   apvSignalPlanes_t         targetSignalPlane       =  APV_SIGNAL_PLANE_UNUSED_0;
@@ -1013,6 +1057,8 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingReporter(apvMessagingDeFramingStat
                            *targetInputPort         =  NULL,
                           **targetInputPort_p       = &targetInputPort;
 
+  uint16_t                  targetComponent         =  0;
+
 /******************************************************************************/
 
   // All done, start looking for another message
@@ -1021,7 +1067,7 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingReporter(apvMessagingDeFramingStat
     apvMessageSuccessCounters[APV_MESSAGE_SUCCESS_COUNTER] = apvMessageSuccessCounters[APV_MESSAGE_SUCCESS_COUNTER] + 1;
 
     // A message has been successfully decoded...get ready to detach it
-    liveMessageBuffer = (apvMessageStructure_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW];
+    liveMessageBuffer = (apvMessageStructure_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER];
 
     // Does it have a legal destination in the upper layers ? If not, just leave the message buffer for re-use
     targetCommsPlane  = liveMessageBuffer->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  & APV_MESSAGE_PLANE_MASK;
@@ -1036,33 +1082,46 @@ APV_MESSAGING_STATE_CODE apvMessagingDeFramingReporter(apvMessagingDeFramingStat
                                                    &apvMessagingLayerComponents[0],
                                                     targetInputPort_p) == true)
           {
-          // If possible load the new message onto the messaging layer components' input port
-          if (apvRingBufferLoad( targetInputPort,
-                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                                (uint32_t *)&liveMessageBuffer,
-                                 1,
-                                 true) != 0)
+          targetComponent         = apvMessagingLayerRoutes[targetCommsPlane][targetSignalPlane];
+
+          // Get the next token off the ring-buffer if it exists
+          freeMessageBufferRing_p = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS];
+
+          if (apvRingBufferUnLoad( freeMessageBufferRing_p,
+                                   APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                  &newMessageBuffer,
+                                   1,
+                                   true) != 0)
             {
-            // Get the next token off the ring-buffer if it exists
-            freeMessageBufferRing_p = (apvRingBuffer_t *)messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS_LOW];
-
-            if (apvRingBufferUnLoad( freeMessageBufferRing_p,
-                                     APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                                    (uint32_t *)newMessageBuffer_p,
-                                     1,
-                                     true) != 0)
+            apvMessagingLayerStampMessage(liveMessageBuffer);
+
+            // If possible load the new message onto the messaging layer components' input port
+            if (apvRingBufferLoad( targetInputPort,
+                                   APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                  &liveMessageBuffer,
+                                   1,
+                                   true) != 0)
               {
               // Attach the new message buffer to the state machine
-              messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW] = (apvMessageStateVariable_t)newMessageBuffer;
+              messageStateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER] = (apvMessageStateVariable_t)newMessageBuffer;
               }
             else
-              { // Now we are screwed...
-              apvStateError = APV_ERROR_CODE_RING_BUFFER_EMPTY;
+              { // No room on the components' input ring : put the new message buffer back
+              apvRingBufferLoad( freeMessageBufferRing_p,
+                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                &newMessageBuffer,
+                                 1,
+                                 true);
 
-              while(true)
-                ;
+              apvMessagingLayerRecordDrop(targetComponent,
+                                          APV_MESSAGING_LAYER_DROP_RING_FULL);
               }
             }
+          else
+            { // No fresh message buffer : the decoded one stays attached and is re-used
+            apvMessagingLayerRecordDrop(targetComponent,
+                                        APV_MESSAGING_LAYER_DROP_NO_BUFFER);
+            }
           }
         }
       else
@@ -1106,9 +1165,9 @@ APV_ERROR_CODE apvCreateMessageBuffers(apvRingBuffer_t       *apvMessageBufferSe
   {
 /******************************************************************************/
 
-  APV_ERROR_CODE  messageError  = APV_ERROR_CODE_NONE;
+  APV_ERROR_CODE         messageError  = APV_ERROR_CODE_NONE;
 
-  uint32_t        messageBuffer =  0;
+  apvMessageStructure_t *messageBuffer = NULL;
 
 /******************************************************************************/
 
@@ -1135,11 +1194,11 @@ APV_ERROR_CODE apvCreateMessageBuffers(apvRingBuffer_t       *apvMessageBufferSe
           }
         else
           { // Assign the address of the ring buffer to the controlling ring-buffer
-          messageBuffer = (uint32_t)(apvMessageBuffers + apvMessageBufferSetSize);
+          messageBuffer = apvMessageBuffers + apvMessageBufferSetSize;
 
           if (apvRingBufferLoad(apvMessageBufferSet,
-                                APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                                (uint32_t *)&messageBuffer,
+                                APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                &messageBuffer,
                                 1,
                                 false) == 0)
             {
@@ -1182,7 +1241,7 @@ void apvMessageStructurePrint(apvMessagingDeFramingState_t *stateMachine)
 /******************************************************************************/
 
   // Compute the message buffer structure address
-  messageBufferPointer = (apvMessageStructure_t *)(stateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW]);
+  messageBufferPointer = (apvMessageStructure_t *)(stateMachine->apvMessageStateVariables->apvMessageStateVariables[APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER]);
 
   printf("\n");
   printf("\n Message Structure :");
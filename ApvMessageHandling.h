@@ -106,9 +106,6 @@
 
 #define APV_MESSAGE_STATE_VARIABLE_CACHE_LENGTH        APV_GENERIC_STATE_VARIABLE_CACHE_LENGTH
 
-#define APV_UINT64_POINTER_UINT32_MASK                ((uint32_t)0xffffffff) // 64-bit pointer packing/unpacking
-#define APV_UINT64_POINTER_UINT32_SHIFT               ((uint32_t)32)
-
 #define APV_MESSAGE_FREE_BUFFER_SET_SIZE              16 // the message buffers available to pass between comms layers
 
 /******************************************************************************/
@@ -186,6 +183,9 @@ typedef struct apvMessageStructure_tTag
   uint8_t                       apvMessagingCrcHighToken;
   uint8_t                       apvMessagingEndOfMessageToken;
   uint16_t                      apvMessagingPayloadMaximumLength;
+  uint8_t                       apvMessagingReferenceCount;                                // the number of ADDITIONAL holders of a shared (published) message buffer
+  apvRingBuffer_t              *apvMessagingHomePool;                                      // the pool the last holder of a shared message buffer returns it to
+  uint64_t                      apvMessagingEnqueueTimestamp;                              // 64-bit timestamp when the message was put on a components' input ring
   } apvMessageStructure_t;
 
 // For convenience in message handling alias to an array
@@ -223,21 +223,17 @@ typedef enum apvMessagingFrameStateVariable_tTag
   APV_MESSAGE_FRAME_STATE_VARIABLE_NEW_TOKEN        = APV_GENERIC_STATE_VARIABLE_2, 
   APV_MESSAGE_FRAME_STATE_VARIABLE_LAST_TOKEN       = APV_GENERIC_STATE_VARIABLE_3,
   APV_MESSAGE_FRAME_STATE_VARIABLE_CRC_SUM          = APV_GENERIC_STATE_VARIABLE_4,
-  APV_MESSAGE_FRAME_STATE_RING_BUFFER_LOW           = APV_GENERIC_STATE_VARIABLE_5,
-  APV_MESSAGE_FRAME_STATE_RING_BUFFER_HIGH          = APV_GENERIC_STATE_VARIABLE_6,
-  APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_LOW        = APV_GENERIC_STATE_VARIABLE_7,
-  APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER_HIGH       = APV_GENERIC_STATE_VARIABLE_8,
-  APV_MESSAGE_FRAME_STATE_PAYLOAD_LENGTH            = APV_GENERIC_STATE_VARIABLE_9,
-  APV_MESSAGE_FRAME_STATE_FRAME_CHECK               = APV_GENERIC_STATE_VARIABLE_10,
-  APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS_LOW  = APV_GENERIC_STATE_VARIABLE_11,
-  APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS_HIGH = APV_GENERIC_STATE_VARIABLE_12,
+  APV_MESSAGE_FRAME_STATE_RING_BUFFER               = APV_GENERIC_STATE_VARIABLE_5, // the state-variables are pointer-width so
+  APV_MESSAGE_FRAME_STATE_MESSAGE_BUFFER            = APV_GENERIC_STATE_VARIABLE_6, // these three each hold a whole pointer
+  APV_MESSAGE_FRAME_STATE_PAYLOAD_LENGTH            = APV_GENERIC_STATE_VARIABLE_7,
+  APV_MESSAGE_FRAME_STATE_FRAME_CHECK               = APV_GENERIC_STATE_VARIABLE_8,
+  APV_MESSAGE_FRAME_STATE_FREE_MESSAGE_BUFFERS      = APV_GENERIC_STATE_VARIABLE_9,
   APV_MESSAGE_FRAME_STATE_VARIABLE_CACHE_LENGTH     = APV_GENERIC_STATE_VARIABLE_CACHE_LENGTH
   } apvMessagingFrameStateVariable_t;
 
 typedef APV_GENERIC_STATE_CODE APV_MESSAGING_STATE_CODE;
 
-typedef uint32_t apvMessageStateVariable_t;     // state-variable type
-typedef uint32_t apvMessageStateEntryPointer_t; // state-entry pointer type
+typedef uintptr_t apvMessageStateVariable_t; // state-variable type : wide enough to carry a pointer
 
 // A set of variables to carry information between states
 typedef struct apvMessagingStateVariables_tTag
@@ -309,6 +305,8 @@ extern APV_MESSAGING_STATE_CODE apvDeFrameMessageInitialisation(apvRingBuffer_t
                                                                 apvRingBuffer_t              *messageFreeBuffers,
                                                                 apvMessagingDeFramingState_t *messageState);
 extern APV_MESSAGING_STATE_CODE apvDeFrameMessage(apvMessagingDeFramingState_t *messageStateMachine);
+extern APV_ERROR_CODE           apvDeFrameMessageStateMachineCreate(apvMessagingDeFramingState_t *messageStateMachine,
+                                                                    apvMessagingStateVariables_t *messageStateVariables);
 
 extern void                     apvMessageStructurePrint(apvMessagingDeFramingState_t *stateMachine);
 
@@ -68,12 +68,13 @@
 
 #include <stdio.h>
 #include <string.h>
-#include "apvError.h"
+#include "ApvError.h"
 #include "ApvCommsUtilities.h"
 #include "ApvMessageHandling.h"
 #include "ApvMessagingLayerManager.h"
 #include "ApvControlPortProtocol.h"
 #include "ApvPeripheralControl.h"
+#include "ApvEventTimers.h"
 
 /******************************************************************************/
 /* Constants :                                                                */
@@ -91,6 +92,15 @@
 apvMessagingLayerComponent_t apvMessagingLayerComponents[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
 bool                         apvMessagingLayerComponentReady[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
 
+/******************************************************************************/
+/* The number of component table entries in use i.e. one more than the        */
+/* highest loaded component, and the (comms, signal) plane route table giving */
+/* the component serving each plane pair                                      */
+/******************************************************************************/
+
+uint16_t                     apvMessagingLayerComponentCount = 0;
+uint8_t                      apvMessagingLayerRoutes[APV_COMMS_PLANES][APV_SIGNAL_PLANES];
+
 /******************************************************************************/
 /* Definition of the messaging layer message buffers and the holding ring-    */
 /* buffer                                                                     */
@@ -109,6 +119,37 @@ apvMessageStructure_t apvMessagingLayerFreeBuffers[APV_MESSAGING_LAYER_FREE_MESS
 apvRingBuffer_t       apvMessagingLayerComponentSerialUartTxBuffer,
                       apvMessagingLayerComponentSerialUartRxBuffer;
 
+apvRingBuffer_t       apvMessagingLayerComponentSerialPortTxBuffer[APV_SERIAL_PORTS],
+                      apvMessagingLayerComponentSerialPortRxBuffer[APV_SERIAL_PORTS];
+
+/******************************************************************************/
+/* Definition of the publish/subscribe subscriptions and the per-planes       */
+/* subscription lists (indices of the first subscription in delivery order)   */
+/******************************************************************************/
+
+apvMessagingLayerSubscription_t apvMessagingLayerSubscriptions[APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE];
+uint8_t                         apvMessagingLayerSubscriptionLists[APV_COMMS_PLANES][APV_SIGNAL_PLANES];
+
+/******************************************************************************/
+/* Per-component residency and service time statistics, indexed in step with  */
+/* 'apvMessagingLayerComponents[]'                                            */
+/******************************************************************************/
+
+apvMessagingLayerComponentStatistics_t apvMessagingLayerStatistics[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static APV_ERROR_CODE apvMessagingLayerComponentFill(uint16_t           messagingLayerComponentIndex,
+                                                     apvRingBuffer_t   *messagingInputBufferPool,
+                                                     apvRingBuffer_t   *messagingOutputBufferPool,
+                                                     apvRingBuffer_t   *messagingLayerMessageBuffers,
+                                                     apvCommsPlanes_t   messagingLayerCommsPlane,
+                                                     apvSignalPlanes_t  messagingLayerSignalPlane,
+                                                     void             (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                                                                                      struct apvMessagingLayerComponent_tTag *allComponents));
+
 /******************************************************************************/
 /* Function Definitions :                                                     */
 /******************************************************************************/
@@ -120,7 +161,7 @@ apvRingBuffer_t       apvMessagingLayerComponentSerialUartTxBuffer,
 /*  <-- layerComponentError            : component errors                     */
 /*                                                                            */
 /* - clear out all of the entries in the message layer handler definition     */
-/*   array                                                                    */
+/*   array and empty the plane route table                                    */
 /*                                                                            */
 /******************************************************************************/
 
@@ -146,11 +187,17 @@ APV_ERROR_CODE apvMessagingLayerComponentInitialise(apvMessagingLayerComponent_t
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerComponentLoaded  = false;
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerInputBufferPool  = NULL;
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerOutputBufferPool = NULL;
+      (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerInputBuffers     = NULL;
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerCommsPlane       = APV_COMMS_PLANE_UNUSED_0;
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerSignalPlane      = APV_SIGNAL_PLANE_UNUSED_0;
       (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerServiceManager   = NULL;
+      (messagingLayerComponents + messagingLayerComponentEntries)->messagingLayerServiceReady     = NULL;
       }
     while (messagingLayerComponentEntries > 0);
+
+    apvMessagingLayerComponentCount = 0;
+
+    memset((void *)&apvMessagingLayerRoutes[0][0], APV_MESSAGING_LAYER_ROUTE_NULL, sizeof(apvMessagingLayerRoutes));
     }
 
 /******************************************************************************/
@@ -183,7 +230,7 @@ APV_ERROR_CODE apvMessagingLayerComponentInitialise(apvMessagingLayerComponent_t
 /*   comms and signal planes, input port and output port message buffer       */
 /*   sources/sinks and the component handling function. NOTE that a single    */
 /*   messaging layer component MUST!NOT! be connected to more than one        */
-/*   physical server port                                                     */
+/*   physical server port. Only the global component table is supported       */
 /*                                                                            */
 /******************************************************************************/
 
@@ -204,28 +251,26 @@ APV_ERROR_CODE apvMessagingLayerComponentLoad(apvMessagingLayerPlaneHandlers_t
 
 /******************************************************************************/
 
-  if ((messagingLayerComponents       == NULL) || (messagingInputBufferPool     == NULL) ||
-      (messagingOutputBufferPool      == NULL) || (messagingLayerServiceManager == NULL) || 
-      (messagingLayerMessageBuffers   == NULL) ||
-      (messagingLayerComponentEntries == 0)    || (messagingLayerComponentIndex > messagingLayerComponentEntries))
+  if ((messagingLayerComponents != &apvMessagingLayerComponents[0]) || (messagingLayerComponentEntries == 0))
     {
     layerComponentError = APV_ERROR_CODE_NULL_PARAMETER;
     }
   else
     {
-    // Initialise the components' message buffer holding ring
-    if (apvRingBufferInitialise(messagingLayerMessageBuffers,
-                                APV_MESSAGINIG_COMPONENT_MESSAGE_RING_BUFFER_SIZE) == APV_ERROR_CODE_NONE)
+    if ((messagingLayerComponentIndex >= messagingLayerComponentEntries) || (messagingLayerComponentIndex >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE))
+      {
+      layerComponentError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
       {
-
       // Match the compnent index to it's entry in the messaging layer definition array
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerComponentLoaded  = true;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerInputBufferPool  = messagingInputBufferPool;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerOutputBufferPool = messagingOutputBufferPool;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerInputBuffers     = messagingLayerMessageBuffers;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerCommsPlane       = messagingLayerCommsPlane;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerSignalPlane      = messagingLayerSignalPlane;
-      (messagingLayerComponents + messagingLayerComponentIndex)->messagingLayerServiceManager   = messagingLayerServiceManager;
+      layerComponentError = apvMessagingLayerComponentFill((uint16_t)messagingLayerComponentIndex,
+                                                           messagingInputBufferPool,
+                                                           messagingOutputBufferPool,
+                                                           messagingLayerMessageBuffers,
+                                                           messagingLayerCommsPlane,
+                                                           messagingLayerSignalPlane,
+                                                           messagingLayerServiceManager);
       }
     }
 
@@ -237,316 +282,1786 @@ APV_ERROR_CODE apvMessagingLayerComponentLoad(apvMessagingLayerPlaneHandlers_t
   } /* apvMessagingLayerComponentLoad                                         */
 
 /******************************************************************************/
-/* apvMessagingLayerGetComponentInputPort() :                                 */
-/*  --> componentCommsPlane         : comms plane id                          */
-/*  --> componentSignalPlane        : signalling plane id                     */
-/*  --> messagingLayerComponents    : definition of the messaging layer       */
-/*                                    components                              */
-/*  --> componentInpuMessageBuffers : address of the components' input        */
-/*                                    message buffer holding ring-buffer      */
-/*  <-- componentExistence          : [ false == 0 | true == !0 ]             */
+/* apvMessagingLayerComponentRegister() :                                     */
+/*  --> messagingInputBufferPool     : pool the components' input message     */
+/*                                     buffers are returned to                */
+/*  --> messagingOutputBufferPool    : pool the component draws its' output   */
+/*                                     message buffers from                   */
+/*  --> messagingLayerMessageBuffers : the components' holding ring of        */
+/*                                     borrowed message buffers               */
+/*  --> messagingLayerCommsPlane     : comms plane identifier                 */
+/*  --> messagingLayerSignalPlane    : signalling plane identifier            */
+/*  --> messagingLayerServiceManager : message layer component handling       */
+/*                                     function                               */
+/*  <-- componentHandle              : the components' handle (table index)   */
+/*  <-- layerComponentError          : component errors                       */
 /*                                                                            */
-/* - look to see if a messaging layer component exists and if it does return  */
-/*   'true' and the address of it's message buffer input holding ring-buffer  */
+/* - load a component into the first free slot of the component table and     */
+/*   route its' (comms, signal) plane pair to it. No compile-time slot is     */
+/*   needed; the handle is used to deregister the component and to read its'  */
+/*   statistics                                                               */
 /*                                                                            */
 /******************************************************************************/
 
-bool apvMessagingLayerGetComponentInputPort(apvCommsPlanes_t               componentCommsPlane, 
-                                            apvSignalPlanes_t              componentSignalPlane,
-                                            apvMessagingLayerComponent_t  *messagingLayerComponents,
-                                            apvRingBuffer_t              **componentInpuMessageBuffers)
+APV_ERROR_CODE apvMessagingLayerComponentRegister(apvRingBuffer_t   *messagingInputBufferPool,
+                                                  apvRingBuffer_t   *messagingOutputBufferPool,
+                                                  apvRingBuffer_t   *messagingLayerMessageBuffers,
+                                                  apvCommsPlanes_t   messagingLayerCommsPlane,
+                                                  apvSignalPlanes_t  messagingLayerSignalPlane,
+                                                  void             (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                                                                                   struct apvMessagingLayerComponent_tTag *allComponents),
+                                                  uint16_t          *componentHandle)
   {
 /******************************************************************************/
 
-  bool     componentExistence = false;
+  APV_ERROR_CODE layerComponentError = APV_ERROR_CODE_NONE;
 
-  uint16_t component          = 0;
+  uint16_t       component           = 0;
 
 /******************************************************************************/
 
-  if (messagingLayerComponents != NULL)
+  if (componentHandle == NULL)
+    {
+    layerComponentError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
     {
-    // For now the messaging layer component array is short so a simple linear
-    // search for components will not take much time
-    for (component = 0; component < APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE; component++)
+    // Find the first free slot - registration is rare so a linear search is fine
+    while ((component                                                   <  APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE) &&
+           (apvMessagingLayerComponents[component].messagingLayerComponentLoaded == true))
       {
-      if ((messagingLayerComponents + component)->messagingLayerComponentLoaded == true)
-        { // This compnent entry exists...
-        if ((messagingLayerComponents + component)->messagingLayerCommsPlane == componentCommsPlane)
-          { // The comms layer id matches...
-          if ((messagingLayerComponents + component)->messagingLayerSignalPlane == componentSignalPlane)
-            { // The signal layer id matches...
-            if ((messagingLayerComponents + component)->messagingLayerInputBuffers != NULL)
-              { // The input message buffer port has been initialised - return its' address and stop searching
-              *componentInpuMessageBuffers = (messagingLayerComponents + component)->messagingLayerInputBuffers;
-               componentExistence          = true;
-               component                   = APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE;
-              }
-            }
-          }
+      component = component + 1;
+      }
+
+    if (component == APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+      {
+      layerComponentError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+      }
+    else
+      {
+      layerComponentError = apvMessagingLayerComponentFill(component,
+                                                           messagingInputBufferPool,
+                                                           messagingOutputBufferPool,
+                                                           messagingLayerMessageBuffers,
+                                                           messagingLayerCommsPlane,
+                                                           messagingLayerSignalPlane,
+                                                           messagingLayerServiceManager);
+
+      if (layerComponentError == APV_ERROR_CODE_NONE)
+        {
+        *componentHandle = component;
         }
       }
     }
 
 /******************************************************************************/
 
-  return(componentExistence);
+  return(layerComponentError);
 
 /******************************************************************************/
-  } /* end of apvMessagingLayerGetComponentInputPort                          */
+  } /* end of apvMessagingLayerComponentRegister                              */
 
 /******************************************************************************/
-/* Messaging layer handling functions :                                       */
-/******************************************************************************/
-/* apvMessagingLayerSerialUARTInputHandler() :                                */
-/*  --> thisComponent : points to this handlers' component definition         */
-/*  --> allComponents : points to the list of handlers' component definitions */
+/* apvMessagingLayerComponentDeregister() :                                   */
+/*  --> componentHandle     : the handle returned by registration             */
+/*  <-- layerComponentError : component errors                                */
 /*                                                                            */
-/* - all component handlers are data-driven; by definition there are one or   */
-/*   more messages on this components' input buffer to consume                */
+/* - unload a component : remove its' route and subscriptions, release any    */
+/*   messages still waiting on its' input ring and free the table slot. A     */
+/*   subscription left behind would deliver to whatever component is next     */
+/*   registered into the slot. The background loop bound shrinks back to the  */
+/*   highest component still loaded                                           */
 /*                                                                            */
 /******************************************************************************/
 
-void apvMessagingLayerSerialUARTInputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
-                                             struct apvMessagingLayerComponent_tTag *allComponents)
+APV_ERROR_CODE apvMessagingLayerComponentDeregister(uint16_t componentHandle)
   {
 /******************************************************************************/
 
-  apvMessageStructure_t  *uartInputMessage  = NULL,
-                         *uartOutputMessage = NULL;
-
-  apvCommsPlanes_t        targetCommsPlane;
-  apvSignalPlanes_t       targetSignalPlane;
-
-  apvRingBuffer_t        *targetInputPort   = NULL,
-                        **targetInputPort_p = &targetInputPort;
+  APV_ERROR_CODE                layerComponentError = APV_ERROR_CODE_NONE;
 
-  uint16_t                protocolMessage   = 0;
+  apvMessagingLayerComponent_t *component           = NULL;
+  apvMessageStructure_t        *waitingMessage      = NULL;
+  uint16_t                      subscription        = 0;
 
 /******************************************************************************/
 
-  // Pull a message from the input ring-buffer (which by definition exists
-  // otherwise this function would not have been called)
-  apvRingBufferUnLoad( thisComponent->messagingLayerInputBuffers,
-                       APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                      (uint32_t *)&uartInputMessage,
-                       1,
-                       true);
-
-  /******************************************************************************/
-  /* Serial port messages can be "local" i.e. handled only in the serial        */
-  /* messaging layer, or "remote" i.e. to be passed to other components for     */
-  /* resolution                                                                 */
-  /******************************************************************************/
+  if (componentHandle >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+    {
+    layerComponentError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    component = &apvMessagingLayerComponents[componentHandle];
 
-  targetCommsPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken  & APV_MESSAGE_PLANE_MASK;
+    if (component->messagingLayerComponentLoaded == false)
+      {
+      layerComponentError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+      }
+    else
+      {
+      apvMessagingLayerRoutes[component->messagingLayerCommsPlane][component->messagingLayerSignalPlane] = APV_MESSAGING_LAYER_ROUTE_NULL;
 
-  if (apvMessageFramerCheckCommsPlane(targetCommsPlane) == true)
-    {
-    if (targetCommsPlane == APV_COMMS_PLANE_SERIAL_UART)
-      { 
-      // These messages are "local", to be resolved here - get the command from the message buffer
-      for (protocolMessage = 0; protocolMessage < APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS; protocolMessage++)
+      // Every subscription is on exactly one plane list so a pass over the table finds them all
+      for (subscription = 0; subscription < APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE; subscription++)
         {
-        // The message command type must be a string
-        if (apvCommandProtocol[protocolMessage].apvCommandProtocolFields->apvCommandProtocolFieldType == APV_COMMAND_PROTOCOL_FIELD_TYPE_TEXT)
+        if ((apvMessagingLayerSubscriptions[subscription].subscriptionLoaded    == true) &&
+            (apvMessagingLayerSubscriptions[subscription].subscriptionComponent == componentHandle))
           {
-          if (apvStringCompare((char *)&apvCommandProtocol[protocolMessage].apvCommandProtocolFields->apvCommandProtocolField.apvCommandProtocolText, 
-                               0, 
-                               strlen(apvCommandProtocol[protocolMessage].apvCommandProtocolFields->apvCommandProtocolField.apvCommandProtocolText),
-                               (char *)&uartInputMessage->apvMessagingPayload[0],
-                               0,
-                               0,
-                               false) == true)
-            {
-            break;
-            }
+          apvMessagingLayerUnsubscribe(subscription);
           }
         }
 
-      // Has the message type been found ?
-      if (protocolMessage < APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS)
+      component->messagingLayerComponentLoaded     = false;
+      apvMessagingLayerComponentReady[componentHandle] = false;
+
+      while (apvRingBufferUnLoad( component->messagingLayerInputBuffers,
+                                  APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                 &waitingMessage,
+                                  1,
+                                  true) != 0)
         {
-        // Get a message buffer from the messaging layer message buffer pool ("output" in this case) 
-        // if one exists - otherwise no response is possible
-        if (apvRingBufferUnLoad( thisComponent->messagingLayerOutputBufferPool,
-                                 APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                                (uint32_t *)&uartOutputMessage,
-                                 1,
-                                 true) != 0)
-          {
-          targetSignalPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT;
-        
-          if (apvMessageFramerCheckSignalPlane(targetSignalPlane) == true) // signal plane id exists
-            {
-            if (apvMessagingLayerGetComponentInputPort(targetCommsPlane, 
-                                                       targetSignalPlane,
-                                                       allComponents,
-                                                       targetInputPort_p) == true)
-              {
-              // Re-route the message; first copy the contents. This is a pain but otherwise keeping 
-              // the input and output message buffers straight is a nightmare!
-              *uartOutputMessage = *uartInputMessage;
-      
-               // If the response message is present, put that in the output buffer
-               if (apvCommandProtocol[protocolMessage].commandProtocolMessageResponse != NULL)
-                 {
-                 strcpy((char *)&uartOutputMessage->apvMessagingPayload[0], (const char *)&apvCommandProtocol[protocolMessage].commandProtocolMessageResponse[0]);
-                 }
+        apvMessagingLayerReleaseMessage(waitingMessage,
+                                        component->messagingLayerInputBufferPool);
+        }
 
-               uartOutputMessage->apvMessagingLengthOfMessage = strlen((const char *)&apvCommandProtocol[protocolMessage].commandProtocolMessageResponse[0]);
+      component->messagingLayerInputBufferPool  = NULL;
+      component->messagingLayerOutputBufferPool = NULL;
+      component->messagingLayerInputBuffers     = NULL;
+      component->messagingLayerCommsPlane       = APV_COMMS_PLANE_UNUSED_0;
+      component->messagingLayerSignalPlane      = APV_SIGNAL_PLANE_UNUSED_0;
+      component->messagingLayerServiceManager   = NULL;
+      component->messagingLayerServiceReady     = NULL;
 
-               // But - change the "inbound" channel codes...the "outbound" channel codes are not 
-               // really of interest as this message is destined for the hardware output port
-               uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken = 
-                                                       uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken;
-      
-               apvRingBufferLoad( targetInputPort,
-                                  APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                                 (uint32_t *)&uartOutputMessage,
-                                  1,
-                                  true);
-              }
-            }
-          }
+      while ((apvMessagingLayerComponentCount                                                      >  0) &&
+             (apvMessagingLayerComponents[apvMessagingLayerComponentCount - 1].messagingLayerComponentLoaded == false))
+        {
+        apvMessagingLayerComponentCount = apvMessagingLayerComponentCount - 1;
         }
       }
+    }
+
+/******************************************************************************/
+
+  return(layerComponentError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerComponentDeregister                            */
+
+/******************************************************************************/
+/* apvMessagingLayerComponentGate() :                                         */
+/*  --> componentHandle            : the components' handle (table index)     */
+/*  --> messagingLayerServiceReady : the components' readiness gate or NULL   */
+/*  <-- layerComponentError        : component errors                         */
+/*                                                                            */
+/* - a component whose output can back up (a transmitter with a fixed number  */
+/*   of frame slots, a pool of response buffers) is given a gate. While the   */
+/*   gate is closed its' waiting messages stay on its' input ring instead of  */
+/*   being taken off and thrown away; a full input ring then pushes back on   */
+/*   the components feeding it                                                */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerComponentGate(uint16_t   componentHandle,
+                                              bool     (*messagingLayerServiceReady)(struct apvMessagingLayerComponent_tTag *thisComponent))
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE layerComponentError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (componentHandle >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+    {
+    layerComponentError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    if (apvMessagingLayerComponents[componentHandle].messagingLayerComponentLoaded == false)
+      {
+      layerComponentError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+      }
     else
-      { 
-      // These messages need to be sent somewhere else, get a message buffer from the messaging
-      // layer message buffer pool ("output" in this case) if one exists, otherwise no response
-      // is possible
-      if (apvRingBufferUnLoad( thisComponent->messagingLayerOutputBufferPool,
-                               APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                              (uint32_t *)&uartOutputMessage,
-                               1,
-                               true) != 0)
+      {
+      apvMessagingLayerComponents[componentHandle].messagingLayerServiceReady = messagingLayerServiceReady;
+      }
+    }
+
+/******************************************************************************/
+
+  return(layerComponentError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerComponentGate                                  */
+
+/******************************************************************************/
+/* apvMessagingLayerComponentWaiting() :                                      */
+/*  --> componentHandle  : the components' handle (table index)               */
+/*  <-- componentWaiting : [ false == nothing to do |                         */
+/*                           true  == run the components' service manager ]   */
+/*                                                                            */
+/* - a component is serviced when it is loaded, has at least one message on   */
+/*   its' input ring and its' gate (if any) is open                           */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerComponentWaiting(uint16_t componentHandle)
+  {
+/******************************************************************************/
+
+  bool                          componentWaiting = false;
+
+  apvMessagingLayerComponent_t *component        = NULL;
+  uint16_t                      messageCount     = 0;
+
+/******************************************************************************/
+
+  if (componentHandle < APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+    {
+    component = &apvMessagingLayerComponents[componentHandle];
+
+    if (component->messagingLayerComponentLoaded == true)
+      {
+      if (apvRingBufferReportFillState( component->messagingLayerInputBuffers,
+                                       &messageCount,
+                                        true) == APV_ERROR_CODE_NONE)
         {
-        // Find the corresponding components' message buffer input port
-        targetCommsPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken  & APV_MESSAGE_PLANE_MASK;
-        targetSignalPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT;
-    
-        if (apvMessageFramerCheckSignalPlane(targetSignalPlane) == true) // signal plane id exists
+        if (messageCount != 0)
           {
-          if (apvMessagingLayerGetComponentInputPort(targetCommsPlane, 
-                                                     targetSignalPlane,
-                                                     allComponents,
-                                                     targetInputPort_p) == true)
+          if ((component->messagingLayerServiceReady == NULL) || (component->messagingLayerServiceReady(component) == true))
             {
-            // Re-route the message; first copy the contents. This is a pain but otherwise keeping 
-            // the input and output message buffers straight is a nightmare!
-            *uartOutputMessage = *uartInputMessage;
-
-             // But - change the "inbound" channel codes...the "outbound" channel codes will need to be 
-             // determined by the target channel
-             uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken = 
-                                                     uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken;
-
-             apvRingBufferLoad( targetInputPort,
-                                APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                               (uint32_t *)&uartOutputMessage,
-                                1,
-                                true);
+            componentWaiting = true;
             }
           }
         }
       }
-    } // if apvMessageFramerCheckCommsPlane()
+    }
 
-  // Finally put the exhausted input message buffer back on the messaging layer 
-  // message buffer pool. If this fails there is no recovery here
-  apvRingBufferLoad( thisComponent->messagingLayerInputBufferPool,
-                     APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                    (uint32_t *)&uartInputMessage,
-                     1,
-                     true);
+/******************************************************************************/
+
+  return(componentWaiting);
 
 /******************************************************************************/
-  } /* end of apvMessagingLayerSerialUARTInputHandler                         */
+  } /* end of apvMessagingLayerComponentWaiting                               */
 
 /******************************************************************************/
-/* apvMessagingLayerSerialUARTOutputHandler() :                               */
-/*  --> thisComponent : points to this handlers' component definition         */
-/*  --> allComponents : points to the list of handlers' component definitions */
+/* apvMessagingLayerComponentsWaiting() :                                     */
+/*  <-- componentsWaiting : [ false == no component can run |                 */
+/*                            true  == at least one component can run ]       */
 /*                                                                            */
-/* - all component handlers are data-driven; by definition there are one or   */
-/*   more messages on this components' input buffer to consume                */
+/* - the background loops' last look before sleeping : a gate opened by an    */
+/*   interrupt (e.g. a transmit frame slot freed) after the component scan    */
+/*   must not leave its' waiting messages asleep until the next interrupt     */
 /*                                                                            */
 /******************************************************************************/
 
-void apvMessagingLayerSerialUARTOutputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
-                                              struct apvMessagingLayerComponent_tTag *allComponents)
+bool apvMessagingLayerComponentsWaiting(void)
   {
 /******************************************************************************/
 
-  apvMessageStructure_t *uartOutputMessage                    = NULL,
-                         uartModifiedOutputMessage;
+  bool     componentsWaiting = false;
 
-  uint16_t               uartModifiedOutputMessageFinalLength = 0;
+  uint16_t component         = 0;
 
 /******************************************************************************/
 
-  // Pull a message from the input ring-buffer (which by definition exists
-  // otherwise this function would not have been called)
-  apvRingBufferUnLoad( thisComponent->messagingLayerInputBuffers,
-                       APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                      (uint32_t *)&uartOutputMessage,
-                       1,
-                       true);
-
-  // Assuming the incoming message is a bit "raw", re-frame the payload using the 
-  // same message parameters otherwise
-  if (apvFrameMessage(&uartModifiedOutputMessage,
-                       uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  &  APV_MESSAGE_PLANE_MASK,
-                       uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  >> APV_MESSAGE_PLANE_SHIFT,
-                       uartOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken &  APV_MESSAGE_PLANE_MASK,
-                       uartOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT,
-                      &uartOutputMessage->apvMessagingPayload[0],
-                       strlen((const char *)&uartOutputMessage->apvMessagingPayload[0]),
-                      &uartModifiedOutputMessageFinalLength
-                      ) == APV_ERROR_CODE_NONE)
+  while ((componentsWaiting == false) && (component < apvMessagingLayerComponentCount))
     {
-    APV_CRITICAL_REGION_ENTRY();
+    componentsWaiting = apvMessagingLayerComponentWaiting(component);
+    component         = component + 1;
+    }
 
-    if (transmitInterrupt == false)
-      {
-      // Put as many characters as possible on the serial UART hardware output ring
-      apvRingBufferLoad( apvPrimarySerialCommsTransmitBuffer,
-                         APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
-                        (uint32_t *)&uartOutputMessage->apvMessagingPayload[1],
-                         (uartOutputMessage->apvMessagingLengthOfMessage - 1),
-                         false);
+/******************************************************************************/
 
-      apvUartCharacterTransmitPrime(ApvUartControlBlock_p,
-                                    uartOutputMessage->apvMessagingPayload[0],
-                                    false);
+  return(componentsWaiting);
 
-      transmitInterrupt = true;
-      APV_CRITICAL_REGION_EXIT();
+/******************************************************************************/
+  } /* end of apvMessagingLayerComponentsWaiting                              */
+
+/******************************************************************************/
+/* apvMessagingLayerComponentFill() :                                         */
+/*  --> messagingLayerComponentIndex : the component table slot to fill       */
+/*  --> ...                          : as 'apvMessagingLayerComponentLoad()'  */
+/*  <-- layerComponentError          : component errors                       */
+/*                                                                            */
+/* - fill in a free component table slot, initialise the components' input    */
+/*   ring and add the components' route. A (comms, signal) plane pair can     */
+/*   only be served by one component                                          */
+/*                                                                            */
+/******************************************************************************/
+
+static APV_ERROR_CODE apvMessagingLayerComponentFill(uint16_t           messagingLayerComponentIndex,
+                                                     apvRingBuffer_t   *messagingInputBufferPool,
+                                                     apvRingBuffer_t   *messagingOutputBufferPool,
+                                                     apvRingBuffer_t   *messagingLayerMessageBuffers,
+                                                     apvCommsPlanes_t   messagingLayerCommsPlane,
+                                                     apvSignalPlanes_t  messagingLayerSignalPlane,
+                                                     void             (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                                                                                      struct apvMessagingLayerComponent_tTag *allComponents))
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                layerComponentError = APV_ERROR_CODE_NONE;
+
+  apvMessagingLayerComponent_t *component           = &apvMessagingLayerComponents[messagingLayerComponentIndex];
+
+/******************************************************************************/
+
+  if ((messagingInputBufferPool     == NULL) || (messagingOutputBufferPool    == NULL) ||
+      (messagingLayerMessageBuffers == NULL) || (messagingLayerServiceManager == NULL))
+    {
+    layerComponentError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((messagingLayerCommsPlane >= APV_COMMS_PLANES) || (messagingLayerSignalPlane >= APV_SIGNAL_PLANES))
+      {
+      layerComponentError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
       }
     else
       {
-      // Put as many characters as possible on the serial UART hardware output ring
-      apvRingBufferLoad( apvPrimarySerialCommsTransmitBuffer,
-                         APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
-                        (uint32_t *)&uartOutputMessage->apvMessagingPayload[0],
-                         uartOutputMessage->apvMessagingLengthOfMessage,
-                         false);
-      }
+      if ((component->messagingLayerComponentLoaded                                         == true) ||
+          (apvMessagingLayerRoutes[messagingLayerCommsPlane][messagingLayerSignalPlane] != APV_MESSAGING_LAYER_ROUTE_NULL))
+        {
+        layerComponentError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+        }
+      else
+        {
+        // Initialise the components' message buffer holding ring
+        layerComponentError = apvRingBufferInitialise(messagingLayerMessageBuffers,
+                                                      APV_MESSAGINIG_COMPONENT_MESSAGE_RING_BUFFER_SIZE);
 
-    APV_CRITICAL_REGION_EXIT();
+        if (layerComponentError == APV_ERROR_CODE_NONE)
+          {
+          component->messagingLayerInputBufferPool  = messagingInputBufferPool;
+          component->messagingLayerOutputBufferPool = messagingOutputBufferPool;
+          component->messagingLayerInputBuffers     = messagingLayerMessageBuffers;
+          component->messagingLayerCommsPlane       = messagingLayerCommsPlane;
+          component->messagingLayerSignalPlane      = messagingLayerSignalPlane;
+          component->messagingLayerServiceManager   = messagingLayerServiceManager;
+          component->messagingLayerServiceReady     = NULL;
+          component->messagingLayerComponentLoaded  = true;
+
+          apvMessagingLayerRoutes[messagingLayerCommsPlane][messagingLayerSignalPlane] = (uint8_t)messagingLayerComponentIndex;
+
+          if (messagingLayerComponentIndex >= apvMessagingLayerComponentCount)
+            {
+            apvMessagingLayerComponentCount = messagingLayerComponentIndex + 1;
+            }
+          }
+        }
+      }
     }
 
-  // Finally put the exhausted message buffer back on the messaging layer 
-  // message buffer pool. If this fails there is no recovery here
-  apvRingBufferLoad( thisComponent->messagingLayerInputBufferPool,
-                     APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                    (uint32_t *)&uartOutputMessage,
-                     1,
-                     true);
+/******************************************************************************/
+
+  return(layerComponentError);
 
 /******************************************************************************/
-  } /* end of apvMessagingLayerSerialUARTOutputHandler                        */
+  } /* end of apvMessagingLayerComponentFill                                  */
+
+/******************************************************************************/
+/* apvMessagingLayerGetComponentInputPort() :                                 */
+/*  --> componentCommsPlane         : comms plane id                          */
+/*  --> componentSignalPlane        : signalling plane id                     */
+/*  --> messagingLayerComponents    : definition of the messaging layer       */
+/*                                    components                              */
+/*  --> componentInpuMessageBuffers : address of the components' input        */
+/*                                    message buffer holding ring-buffer      */
+/*  <-- componentExistence          : [ false == 0 | true == !0 ]             */
+/*                                                                            */
+/* - look to see if a messaging layer component exists and if it does return  */
+/*   'true' and the address of it's message buffer input holding ring-buffer. */
+/*   The plane route table makes this a single lookup however many components */
+/*   are loaded                                                               */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerGetComponentInputPort(apvCommsPlanes_t               componentCommsPlane, 
+                                            apvSignalPlanes_t              componentSignalPlane,
+                                            apvMessagingLayerComponent_t  *messagingLayerComponents,
+                                            apvRingBuffer_t              **componentInpuMessageBuffers)
+  {
+/******************************************************************************/
+
+  bool    componentExistence = false;
+
+  uint8_t component          = APV_MESSAGING_LAYER_ROUTE_NULL;
+
+/******************************************************************************/
+
+  if ((messagingLayerComponents    != NULL)             && (componentInpuMessageBuffers != NULL) &&
+      (componentCommsPlane         <  APV_COMMS_PLANES) && (componentSignalPlane        <  APV_SIGNAL_PLANES))
+    {
+    component = apvMessagingLayerRoutes[componentCommsPlane][componentSignalPlane];
+
+    if (component != APV_MESSAGING_LAYER_ROUTE_NULL)
+      { // The plane pair is routed to a loaded component...
+      if ((messagingLayerComponents + component)->messagingLayerInputBuffers != NULL)
+        { // The input message buffer port has been initialised - return its' address
+        *componentInpuMessageBuffers = (messagingLayerComponents + component)->messagingLayerInputBuffers;
+         componentExistence          = true;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(componentExistence);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerGetComponentInputPort                          */
+
+/******************************************************************************/
+/* Publish/subscribe functions :                                              */
+/******************************************************************************/
+/* apvMessagingLayerSubscriptionInitialise() :                                */
+/*  <-- subscriptionError : error codes                                       */
+/*                                                                            */
+/* - clear out all subscriptions and empty every planes' subscription list    */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerSubscriptionInitialise(void)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE subscriptionError = APV_ERROR_CODE_NONE;
+
+  uint16_t       subscription      = 0;
+
+/******************************************************************************/
+
+  for (subscription = 0; subscription < APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE; subscription++)
+    {
+    apvMessagingLayerSubscriptions[subscription].subscriptionLoaded        = false;
+    apvMessagingLayerSubscriptions[subscription].subscriptionCommsPlane    = APV_COMMS_PLANE_UNUSED_0;
+    apvMessagingLayerSubscriptions[subscription].subscriptionSignalPlane   = APV_SIGNAL_PLANE_UNUSED_0;
+    apvMessagingLayerSubscriptions[subscription].subscriptionComponent     = 0;
+    apvMessagingLayerSubscriptions[subscription].subscriptionDeliveryOrder = 0;
+    apvMessagingLayerSubscriptions[subscription].subscriptionDropPolicy    = APV_MESSAGING_LAYER_DROP_NEWEST;
+    apvMessagingLayerSubscriptions[subscription].subscriptionNext          = APV_MESSAGING_LAYER_SUBSCRIPTION_NULL;
+    apvMessagingLayerSubscriptions[subscription].subscriptionDelivered     = 0;
+    apvMessagingLayerSubscriptions[subscription].subscriptionDropped       = 0;
+    }
+
+  memset((void *)&apvMessagingLayerSubscriptionLists[0][0], APV_MESSAGING_LAYER_SUBSCRIPTION_NULL, sizeof(apvMessagingLayerSubscriptionLists));
+
+/******************************************************************************/
+
+  return(subscriptionError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSubscriptionInitialise                         */
+
+/******************************************************************************/
+/* apvMessagingLayerSubscribe() :                                             */
+/*  --> subscriptionCommsPlane    : comms plane id to subscribe to            */
+/*  --> subscriptionSignalPlane   : signalling plane id to subscribe to       */
+/*  --> subscriptionComponent     : the subscribers' index in the messaging   */
+/*                                  layer component table                     */
+/*  --> subscriptionDeliveryOrder : subscribers on the same planes are        */
+/*                                  delivered to lowest-order first           */
+/*  --> subscriptionDropPolicy    : drop newest or oldest when the            */
+/*                                  subscribers' input ring is full           */
+/*  <-- subscriptionHandle        : identifies the subscription               */
+/*  <-- subscriptionError         : error codes                               */
+/*                                                                            */
+/* - add a component to the subscription list of a (comms, signal) plane      */
+/*   pair. The list is kept in delivery order so publishing is one walk of    */
+/*   the list                                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerSubscribe(apvCommsPlanes_t               subscriptionCommsPlane,
+                                          apvSignalPlanes_t              subscriptionSignalPlane,
+                                          uint16_t                       subscriptionComponent,
+                                          uint8_t                        subscriptionDeliveryOrder,
+                                          apvMessagingLayerDropPolicy_t  subscriptionDropPolicy,
+                                          uint16_t                      *subscriptionHandle)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE  subscriptionError = APV_ERROR_CODE_NONE;
+
+  uint16_t        subscription      = 0;
+  uint8_t        *subscriptionLink  = NULL;
+
+/******************************************************************************/
+
+  if (subscriptionHandle == NULL)
+    {
+    subscriptionError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((apvMessageFramerCheckCommsPlane(subscriptionCommsPlane)   == false)                    ||
+        (apvMessageFramerCheckSignalPlane(subscriptionSignalPlane) == false)                    ||
+        (subscriptionComponent                                     >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE) ||
+        (subscriptionDropPolicy                                    >= APV_MESSAGING_LAYER_DROP_POLICIES))
+      {
+      subscriptionError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      // Find a free subscription
+      for (subscription = 0; subscription < APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE; subscription++)
+        {
+        if (apvMessagingLayerSubscriptions[subscription].subscriptionLoaded == false)
+          {
+          break;
+          }
+        }
+
+      if (subscription == APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE)
+        {
+        subscriptionError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+        }
+      else
+        {
+        apvMessagingLayerSubscriptions[subscription].subscriptionLoaded        = true;
+        apvMessagingLayerSubscriptions[subscription].subscriptionCommsPlane    = subscriptionCommsPlane;
+        apvMessagingLayerSubscriptions[subscription].subscriptionSignalPlane   = subscriptionSignalPlane;
+        apvMessagingLayerSubscriptions[subscription].subscriptionComponent     = subscriptionComponent;
+        apvMessagingLayerSubscriptions[subscription].subscriptionDeliveryOrder = subscriptionDeliveryOrder;
+        apvMessagingLayerSubscriptions[subscription].subscriptionDropPolicy    = subscriptionDropPolicy;
+        apvMessagingLayerSubscriptions[subscription].subscriptionDelivered     = 0;
+        apvMessagingLayerSubscriptions[subscription].subscriptionDropped       = 0;
+
+        // Insert the subscription into the planes' list in delivery order (equal orders are 
+        // delivered in the order they subscribed)
+        subscriptionLink = &apvMessagingLayerSubscriptionLists[subscriptionCommsPlane][subscriptionSignalPlane];
+
+        while ((*subscriptionLink != APV_MESSAGING_LAYER_SUBSCRIPTION_NULL) &&
+               (apvMessagingLayerSubscriptions[*subscriptionLink].subscriptionDeliveryOrder <= subscriptionDeliveryOrder))
+          {
+          subscriptionLink = &apvMessagingLayerSubscriptions[*subscriptionLink].subscriptionNext;
+          }
+
+        apvMessagingLayerSubscriptions[subscription].subscriptionNext = *subscriptionLink;
+        *subscriptionLink                                             = (uint8_t)subscription;
+
+        *subscriptionHandle = subscription;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(subscriptionError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSubscribe                                      */
+
+/******************************************************************************/
+/* apvMessagingLayerUnsubscribe() :                                           */
+/*  --> subscriptionHandle : identifies the subscription                      */
+/*  <-- subscriptionError  : error codes                                      */
+/*                                                                            */
+/* - remove a subscription from its' planes' subscription list                */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerUnsubscribe(uint16_t subscriptionHandle)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE  subscriptionError = APV_ERROR_CODE_NONE;
+
+  uint8_t        *subscriptionLink  = NULL;
+
+/******************************************************************************/
+
+  if ((subscriptionHandle >= APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE) ||
+      (apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionLoaded == false))
+    {
+    subscriptionError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    subscriptionLink = &apvMessagingLayerSubscriptionLists[apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionCommsPlane]
+                                                          [apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionSignalPlane];
+
+    while ((*subscriptionLink != APV_MESSAGING_LAYER_SUBSCRIPTION_NULL) && (*subscriptionLink != subscriptionHandle))
+      {
+      subscriptionLink = &apvMessagingLayerSubscriptions[*subscriptionLink].subscriptionNext;
+      }
+
+    if (*subscriptionLink == subscriptionHandle)
+      {
+      *subscriptionLink = apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionNext;
+      }
+
+    apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionLoaded = false;
+    apvMessagingLayerSubscriptions[subscriptionHandle].subscriptionNext   = APV_MESSAGING_LAYER_SUBSCRIPTION_NULL;
+    }
+
+/******************************************************************************/
+
+  return(subscriptionError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerUnsubscribe                                    */
+
+/******************************************************************************/
+/* apvMessagingLayerPlaneHasSubscribers() :                                   */
+/*  --> commsPlane       : comms plane id                                     */
+/*  --> signalPlane      : signalling plane id                                */
+/*  <-- planeSubscribers : [ false == no subscribers | true == subscribers ]  */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerPlaneHasSubscribers(apvCommsPlanes_t  commsPlane,
+                                          apvSignalPlanes_t signalPlane)
+  {
+/******************************************************************************/
+
+  bool planeSubscribers = false;
+
+/******************************************************************************/
+
+  if ((commsPlane < APV_COMMS_PLANES) && (signalPlane < APV_SIGNAL_PLANES))
+    {
+    if (apvMessagingLayerSubscriptionLists[commsPlane][signalPlane] != APV_MESSAGING_LAYER_SUBSCRIPTION_NULL)
+      {
+      planeSubscribers = true;
+      }
+    }
+
+/******************************************************************************/
+
+  return(planeSubscribers);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerPlaneHasSubscribers                            */
+
+/******************************************************************************/
+/* apvMessagingLayerPublish() :                                               */
+/*  --> commsPlane        : comms plane id to publish on                      */
+/*  --> signalPlane       : signalling plane id to publish on                 */
+/*  --> message           : the message buffer to publish                     */
+/*  --> messageHomePool   : the pool the message buffer is returned to when   */
+/*                          the last holder releases it                       */
+/*  --> allComponents     : the messaging layer component table               */
+/*  <-- messageDeliveries : the number of subscribers the message reached     */
+/*  <-- publishError      : error codes                                       */
+/*                                                                            */
+/* - deliver one message buffer to every subscriber of a (comms, signal)      */
+/*   plane pair by loading a REFERENCE to it onto each subscribers' input     */
+/*   ring - no message copies are made. Each delivery adds one holder to the  */
+/*   message; the publisher keeps its' own reference and MUST still release   */
+/*   the message with 'apvMessagingLayerReleaseMessage()'. Subscribers MUST   */
+/*   NOT modify a shared message                                              */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerPublish(apvCommsPlanes_t              commsPlane,
+                                        apvSignalPlanes_t             signalPlane,
+                                        apvMessageStructure_t        *message,
+                                        apvRingBuffer_t              *messageHomePool,
+                                        apvMessagingLayerComponent_t *allComponents,
+                                        uint16_t                     *messageDeliveries)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                publishError       = APV_ERROR_CODE_NONE;
+
+  uint8_t                       subscription       = APV_MESSAGING_LAYER_SUBSCRIPTION_NULL;
+  apvMessagingLayerComponent_t *subscriber         = NULL;
+  apvMessageStructure_t        *droppedMessage     = NULL;
+
+/******************************************************************************/
+
+  if ((message == NULL) || (messageHomePool == NULL) || (allComponents == NULL) || (messageDeliveries == NULL))
+    {
+    publishError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((commsPlane >= APV_COMMS_PLANES) || (signalPlane >= APV_SIGNAL_PLANES))
+      {
+      publishError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      *messageDeliveries            = 0;
+       message->apvMessagingHomePool = messageHomePool;
+
+      // Every subscriber sees the same enqueue time
+      apvMessagingLayerStampMessage(message);
+
+      subscription = apvMessagingLayerSubscriptionLists[commsPlane][signalPlane];
+
+      while (subscription != APV_MESSAGING_LAYER_SUBSCRIPTION_NULL)
+        {
+        subscriber = allComponents + apvMessagingLayerSubscriptions[subscription].subscriptionComponent;
+
+        if ((subscriber->messagingLayerComponentLoaded == true) && (subscriber->messagingLayerInputBuffers != NULL))
+          {
+          // Make room by releasing the subscribers' oldest message if that is its' policy
+          if ((apvMessagingLayerSubscriptions[subscription].subscriptionDropPolicy     == APV_MESSAGING_LAYER_DROP_OLDEST) &&
+              (subscriber->messagingLayerInputBuffers->apvCommsRingBufferLoad >= subscriber->messagingLayerInputBuffers->apvCommsRingBufferLength))
+            {
+            if (apvRingBufferUnLoad( subscriber->messagingLayerInputBuffers,
+                                     APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                    &droppedMessage,
+                                     1,
+                                     true) != 0)
+              {
+              apvMessagingLayerReleaseMessage(droppedMessage,
+                                              subscriber->messagingLayerInputBufferPool);
+
+              apvMessagingLayerSubscriptions[subscription].subscriptionDropped = apvMessagingLayerSubscriptions[subscription].subscriptionDropped + 1;
+              }
+            }
+
+          // Count the new holder before the subscriber can see the message
+          message->apvMessagingReferenceCount = message->apvMessagingReferenceCount + 1;
+
+          if (apvRingBufferLoad( subscriber->messagingLayerInputBuffers,
+                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                &message,
+                                 1,
+                                 true) != 0)
+            {
+            *messageDeliveries = *messageDeliveries + 1;
+
+            apvMessagingLayerSubscriptions[subscription].subscriptionDelivered = apvMessagingLayerSubscriptions[subscription].subscriptionDelivered + 1;
+            }
+          else
+            { // The subscriber is full - the newest message is dropped
+            message->apvMessagingReferenceCount = message->apvMessagingReferenceCount - 1;
+
+            apvMessagingLayerSubscriptions[subscription].subscriptionDropped = apvMessagingLayerSubscriptions[subscription].subscriptionDropped + 1;
+            }
+          }
+
+        subscription = apvMessagingLayerSubscriptions[subscription].subscriptionNext;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(publishError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerPublish                                        */
+
+/******************************************************************************/
+/* apvMessagingLayerReleaseMessage() :                                        */
+/*  --> message            : the message buffer to release                    */
+/*  --> messageDefaultPool : the pool an unshared message buffer is returned  */
+/*                           to                                               */
+/*  <-- releaseError       : error codes                                      */
+/*                                                                            */
+/* - give up one hold on a message buffer. A shared message buffer is only    */
+/*   returned to its' home pool when the last holder releases it; an un-      */
+/*   shared message buffer goes straight back to the default pool. All        */
+/*   holders run in the background loop so no critical region is needed for   */
+/*   the reference count                                                      */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerReleaseMessage(apvMessageStructure_t *message,
+                                               apvRingBuffer_t       *messageDefaultPool)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE   releaseError = APV_ERROR_CODE_NONE;
+
+  apvRingBuffer_t *messagePool  = messageDefaultPool;
+
+/******************************************************************************/
+
+  if (message == NULL)
+    {
+    releaseError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (message->apvMessagingReferenceCount != 0)
+      {
+      message->apvMessagingReferenceCount = message->apvMessagingReferenceCount - 1;
+      }
+    else
+      {
+      if (message->apvMessagingHomePool != NULL)
+        {
+        messagePool                   = message->apvMessagingHomePool;
+        message->apvMessagingHomePool = NULL;
+        }
+
+      if (messagePool == NULL)
+        {
+        releaseError = APV_ERROR_CODE_NULL_PARAMETER;
+        }
+      else
+        {
+        // If this fails there is no recovery here
+        apvRingBufferLoad( messagePool,
+                           APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                          &message,
+                           1,
+                           true);
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(releaseError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerReleaseMessage                                 */
+
+/******************************************************************************/
+/* Instrumentation functions :                                                */
+/******************************************************************************/
+/* apvMessagingLayerStatisticsInitialise() :                                  */
+/*  <-- statisticsError : error codes                                         */
+/*                                                                            */
+/* - clear the residency and service time statistics of every component       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerStatisticsInitialise(void)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE statisticsError = APV_ERROR_CODE_NONE;
+
+  uint16_t       component       = 0;
+
+/******************************************************************************/
+
+  memset((void *)&apvMessagingLayerStatistics[0], 0, sizeof(apvMessagingLayerStatistics));
+
+  for (component = 0; component < APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE; component++)
+    {
+    apvMessagingLayerStatistics[component].statisticsResidencyMinimum = APV_MESSAGING_LAYER_STATISTICS_MINIMUM_RESET;
+    apvMessagingLayerStatistics[component].statisticsServiceMinimum   = APV_MESSAGING_LAYER_STATISTICS_MINIMUM_RESET;
+    }
+
+/******************************************************************************/
+
+  return(statisticsError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerStatisticsInitialise                           */
+
+/******************************************************************************/
+/* apvMessagingLayerStampMessage() :                                          */
+/*  --> message : the message buffer about to be loaded onto a components'    */
+/*                input ring                                                  */
+/*                                                                            */
+/* - record the enqueue time of a message from the 64-bit timestamp           */
+/*                                                                            */
+/******************************************************************************/
+
+void apvMessagingLayerStampMessage(apvMessageStructure_t *message)
+  {
+/******************************************************************************/
+
+  if (message != NULL)
+    {
+    message->apvMessagingEnqueueTimestamp = apvEventTimerTimestamp64();
+    }
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerStampMessage                                   */
+
+/******************************************************************************/
+/* apvMessagingLayerRecordResidency() :                                       */
+/*  --> componentIndex  : the components' index in the component table        */
+/*  --> message         : the message buffer just taken off the components'   */
+/*                        input ring                                          */
+/*  <-- statisticsError : error codes                                         */
+/*                                                                            */
+/* - accumulate the time a message waited on a components' input ring. The    */
+/*   64-bit timestamp never wraps; a residency too long for the 32-bit        */
+/*   minimum/maximum is recorded as the limit                                 */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerRecordResidency(uint16_t               componentIndex,
+                                                apvMessageStructure_t *message)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                          statisticsError = APV_ERROR_CODE_NONE;
+
+  apvMessagingLayerComponentStatistics_t *statistics      = NULL;
+  uint64_t                                residency       = 0;
+
+/******************************************************************************/
+
+  if (message == NULL)
+    {
+    statisticsError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (componentIndex >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+      {
+      statisticsError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      statistics = &apvMessagingLayerStatistics[componentIndex];
+      residency  = apvEventTimerTimestamp64() - message->apvMessagingEnqueueTimestamp;
+
+      if (residency > APV_MESSAGING_LAYER_STATISTICS_TIME_LIMIT)
+        {
+        residency = APV_MESSAGING_LAYER_STATISTICS_TIME_LIMIT;
+        }
+
+      statistics->statisticsMessages       = statistics->statisticsMessages       + 1;
+      statistics->statisticsResidencyTotal = statistics->statisticsResidencyTotal + residency;
+
+      if (residency < statistics->statisticsResidencyMinimum)
+        {
+        statistics->statisticsResidencyMinimum = (uint32_t)residency;
+        }
+
+      if (residency > statistics->statisticsResidencyMaximum)
+        {
+        statistics->statisticsResidencyMaximum = (uint32_t)residency;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(statisticsError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerRecordResidency                                */
+
+/******************************************************************************/
+/* apvMessagingLayerRecordService() :                                         */
+/*  --> componentIndex  : the components' index in the component table        */
+/*  --> serviceStart    : 64-bit timestamp before the service manager call    */
+/*  --> serviceEnd      : 64-bit timestamp after the service manager call     */
+/*  <-- statisticsError : error codes                                         */
+/*                                                                            */
+/* - accumulate the execution time of one service manager call and bin it in  */
+/*   the components' service time histogram                                   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerRecordService(uint16_t componentIndex,
+                                              uint64_t serviceStart,
+                                              uint64_t serviceEnd)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                          statisticsError = APV_ERROR_CODE_NONE;
+
+  apvMessagingLayerComponentStatistics_t *statistics      = NULL;
+  uint64_t                                serviceTime     = serviceEnd - serviceStart;
+  uint32_t                                serviceBinTime  = 0;
+  uint16_t                                serviceBin      = 0;
+
+/******************************************************************************/
+
+  if (componentIndex >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE)
+    {
+    statisticsError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    statistics = &apvMessagingLayerStatistics[componentIndex];
+
+    if (serviceTime > APV_MESSAGING_LAYER_STATISTICS_TIME_LIMIT)
+      {
+      serviceTime = APV_MESSAGING_LAYER_STATISTICS_TIME_LIMIT;
+      }
+
+    statistics->statisticsServiceCalls = statistics->statisticsServiceCalls + 1;
+    statistics->statisticsServiceTotal = statistics->statisticsServiceTotal + serviceTime;
+
+    if (serviceTime < statistics->statisticsServiceMinimum)
+      {
+      statistics->statisticsServiceMinimum = (uint32_t)serviceTime;
+      }
+
+    if (serviceTime > statistics->statisticsServiceMaximum)
+      {
+      statistics->statisticsServiceMaximum = (uint32_t)serviceTime;
+      }
+
+    // Find the histogram bin : the first bin is < 4usecs, each bin after is 4x wider
+    serviceBinTime = ((uint32_t)serviceTime / APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US) >> APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_SHIFT;
+
+    while ((serviceBinTime != 0) && (serviceBin < (APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_BINS - 1)))
+      {
+      serviceBinTime = serviceBinTime >> APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_SHIFT;
+      serviceBin     = serviceBin + 1;
+      }
+
+    statistics->statisticsServiceHistogram[serviceBin] = statistics->statisticsServiceHistogram[serviceBin] + 1;
+    }
+
+/******************************************************************************/
+
+  return(statisticsError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerRecordService                                  */
+
+/******************************************************************************/
+/* apvMessagingLayerRecordDrop() :                                            */
+/*  --> componentIndex  : the components' index in the component table        */
+/*  --> drop            : why the message was dropped                         */
+/*  <-- statisticsError : error codes                                         */
+/*                                                                            */
+/* - count one message the messaging layer had to throw away. Drops are only  */
+/*   recorded from the background loop so no critical region is needed        */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerRecordDrop(uint16_t                componentIndex,
+                                           apvMessagingLayerDrop_t drop)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE statisticsError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if ((componentIndex >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE) || (drop >= APV_MESSAGING_LAYER_DROPS))
+    {
+    statisticsError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    apvMessagingLayerStatistics[componentIndex].statisticsDrops[drop] = apvMessagingLayerStatistics[componentIndex].statisticsDrops[drop] + 1;
+    }
+
+/******************************************************************************/
+
+  return(statisticsError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerRecordDrop                                     */
+
+/******************************************************************************/
+/* apvMessagingLayerReportStatistics() :                                      */
+/*  --> componentIndex      : the components' index in the component table    */
+/*  --> reportSelect        : [ 'R' == residency | 'S' == service time |      */
+/*                              'H' == service time histogram |               */
+/*                              'D' == dropped messages ]                     */
+/*  --> report              : the report text buffer                          */
+/*  --> reportMaximumLength : the report text buffer length                   */
+/*  <-- statisticsError     : error codes                                     */
+/*                                                                            */
+/* - format one line of a components' statistics. All times are timestamp     */
+/*   ticks. The residency and service time lines are :                        */
+/*     "C<component> <select> <count> <minimum>/<mean>/<maximum>\r"           */
+/*   the histogram line is :                                                  */
+/*     "C<component> H <bin 0> .. <bin 7>\r"                                  */
+/*   and the dropped messages line is :                                       */
+/*     "C<component> D <ring full> <no buffer> <transmit refused>\r"          */
+/*   Each line fits in a single (unstuffed) message payload                   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvMessagingLayerReportStatistics(uint16_t  componentIndex,
+                                                 char      reportSelect,
+                                                 char     *report,
+                                                 uint16_t  reportMaximumLength)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE                          statisticsError = APV_ERROR_CODE_NONE;
+
+  apvMessagingLayerComponentStatistics_t *statistics      = NULL;
+  uint32_t                                count           = 0,
+                                          minimum         = 0,
+                                          maximum         = 0,
+                                          binCount        = 0;
+  uint64_t                                total           = 0;
+  uint16_t                                reportLength    = 0,
+                                          bin             = 0;
+
+/******************************************************************************/
+
+  if (report == NULL)
+    {
+    statisticsError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((componentIndex >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE) || (reportMaximumLength == 0))
+      {
+      statisticsError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      statistics = &apvMessagingLayerStatistics[componentIndex];
+
+      switch(reportSelect)
+        {
+        case APV_MESSAGING_LAYER_STATISTICS_SELECT_RESIDENCY : count   = statistics->statisticsMessages;
+                                                               minimum = statistics->statisticsResidencyMinimum;
+                                                               maximum = statistics->statisticsResidencyMaximum;
+                                                               total   = statistics->statisticsResidencyTotal;
+                                                               break;
+
+        case APV_MESSAGING_LAYER_STATISTICS_SELECT_SERVICE   : count   = statistics->statisticsServiceCalls;
+                                                               minimum = statistics->statisticsServiceMinimum;
+                                                               maximum = statistics->statisticsServiceMaximum;
+                                                               total   = statistics->statisticsServiceTotal;
+                                                               break;
+
+        case APV_MESSAGING_LAYER_STATISTICS_SELECT_HISTOGRAM : break;
+
+        case APV_MESSAGING_LAYER_STATISTICS_SELECT_DROPS     : break;
+
+        default                                              : statisticsError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+                                                               break;
+        }
+
+      if (statisticsError == APV_ERROR_CODE_NONE)
+        {
+        if (reportSelect == APV_MESSAGING_LAYER_STATISTICS_SELECT_HISTOGRAM)
+          {
+          reportLength = snprintf(report, reportMaximumLength, "C%u %c", (unsigned int)componentIndex, reportSelect);
+
+          for (bin = 0; (bin < APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_BINS) && (reportLength < reportMaximumLength); bin++)
+            {
+            binCount = statistics->statisticsServiceHistogram[bin];
+
+            if (binCount > APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_LIMIT)
+              {
+              binCount = APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_LIMIT;
+              }
+
+            reportLength = reportLength + snprintf(report + reportLength, reportMaximumLength - reportLength, " %lu", (unsigned long)binCount);
+            }
+
+          if (reportLength < reportMaximumLength)
+            {
+            snprintf(report + reportLength, reportMaximumLength - reportLength, "\r");
+            }
+          }
+        else
+          {
+          if (reportSelect == APV_MESSAGING_LAYER_STATISTICS_SELECT_DROPS)
+            {
+            snprintf(report, reportMaximumLength, "C%u %c %lu %lu %lu\r",
+                     (unsigned int)componentIndex, reportSelect,
+                     (unsigned long)statistics->statisticsDrops[APV_MESSAGING_LAYER_DROP_RING_FULL],
+                     (unsigned long)statistics->statisticsDrops[APV_MESSAGING_LAYER_DROP_NO_BUFFER],
+                     (unsigned long)statistics->statisticsDrops[APV_MESSAGING_LAYER_DROP_TRANSMIT]);
+            }
+          else
+            {
+            if (count == 0)
+              { // Nothing recorded yet - report zeroes rather than the minimum reset value
+              minimum = 0;
+              total   = 0;
+              }
+            else
+              {
+              total = total / count;
+              }
+
+            snprintf(report, reportMaximumLength, "C%u %c %lu %lu/%lu/%lu\r",
+                     (unsigned int)componentIndex, reportSelect, (unsigned long)count,
+                     (unsigned long)minimum, (unsigned long)total, (unsigned long)maximum);
+            }
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(statisticsError);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerReportStatistics                               */
+
+/******************************************************************************/
+/* apvMessagingLayerStatisticsAction() :                                      */
+/*  --> messageAction : the response message buffer, holding a copy of the    */
+/*                      request :                                             */
+/*                        "APV_COMPONENT_STATISTICS <component> [R|S|H|D]"    */
+/*  <-- : the response message buffer                                         */
+/*                                                                            */
+/* - control protocol action : replace the request payload with one line of   */
+/*   the selected components' statistics. An unreadable request returns an    */
+/*   empty payload                                                            */
+/*                                                                            */
+/******************************************************************************/
+
+void *apvMessagingLayerStatisticsAction(void *messageAction)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *responseMessage = (apvMessageStructure_t *)messageAction;
+
+  uint32_t               componentIndex  = 0;
+  char                   reportSelect    = APV_MESSAGING_LAYER_STATISTICS_SELECT_SERVICE;
+  APV_ERROR_CODE         argumentError   = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (responseMessage != NULL)
+    {
+    // The component index is decimal
+    argumentError = apvCommandProtocolDecimalArgument(&responseMessage->apvMessagingPayload[0],
+                                                       responseMessage->apvMessagingLengthOfMessage,
+                                                       (APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE - 1),
+                                                      &componentIndex,
+                                                      &reportSelect);
+
+    responseMessage->apvMessagingPayload[0] = '\0';
+
+    if (argumentError == APV_ERROR_CODE_NONE)
+      {
+      apvMessagingLayerReportStatistics( componentIndex,
+                                         reportSelect,
+                                        (char *)&responseMessage->apvMessagingPayload[0],
+                                         APV_MESSAGING_MAXIMUM_UNSTUFFED_MESSAGE_LENGTH);
+      }
+    }
+
+/******************************************************************************/
+
+  return(messageAction);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerStatisticsAction                               */
+
+/******************************************************************************/
+/* Messaging layer handling functions :                                       */
+/******************************************************************************/
+/* apvMessagingLayerSerialUARTInputHandler() :                                */
+/*  --> thisComponent : points to this handlers' component definition         */
+/*  --> allComponents : points to the list of handlers' component definitions */
+/*                                                                            */
+/* - all component handlers are data-driven; by definition there are one or   */
+/*   more messages on this components' input buffer to consume                */
+/*                                                                            */
+/******************************************************************************/
+
+void apvMessagingLayerSerialUARTInputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                             struct apvMessagingLayerComponent_tTag *allComponents)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t  *uartInputMessage  = NULL,
+                         *uartOutputMessage = NULL;
+
+  apvCommsPlanes_t        targetCommsPlane;
+  apvSignalPlanes_t       targetSignalPlane;
+
+  apvRingBuffer_t        *targetInputPort   = NULL,
+                        **targetInputPort_p = &targetInputPort;
+
+  uint16_t                protocolMessage   = 0,
+                          messageDeliveries = 0;
+
+  bool                    messageDelivered  = false;
+
+/******************************************************************************/
+
+  // Pull a message from the input ring-buffer (which by definition exists
+  // otherwise this function would not have been called)
+  apvRingBufferUnLoad( thisComponent->messagingLayerInputBuffers,
+                       APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                      &uartInputMessage,
+                       1,
+                       true);
+
+  apvMessagingLayerRecordResidency((uint16_t)(thisComponent - allComponents),
+                                   uartInputMessage);
+
+  /******************************************************************************/
+  /* Serial port messages can be "local" i.e. handled only in the serial        */
+  /* messaging layer of the port they arrived on, or "remote" i.e. to be passed */
+  /* to other components for resolution. This handler serves the UART and any   */
+  /* USART port; the response goes back out on the same comms plane            */
+  /******************************************************************************/
+
+  targetCommsPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken  & APV_MESSAGE_PLANE_MASK;
+
+  if (apvMessageFramerCheckCommsPlane(targetCommsPlane) == true)
+    {
+    if (targetCommsPlane == thisComponent->messagingLayerCommsPlane)
+      { 
+      // These messages are "local", to be resolved here - get the command from the message buffer. 
+      // Resolution is a single pass over the command identifier (or a binary opcode lookup)
+      // however many commands are defined
+      if (apvCommandProtocolResolve(&apvCommandProtocol[0],
+                                     APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS,
+                                    &apvCommandProtocolDispatch,
+                                    &uartInputMessage->apvMessagingPayload[0],
+                                     uartInputMessage->apvMessagingLengthOfMessage,
+                                    &protocolMessage) == APV_ERROR_CODE_NONE)
+        {
+        // A command has been heard on the primary link so its' current baud rate works both ways
+        if (thisComponent->messagingLayerCommsPlane == APV_COMMS_PLANE_SERIAL_UART)
+          {
+          apvSerialBaudRateConfirm(&apvPrimarySerialBaudRate);
+          }
+
+        // Get a message buffer from the messaging layer message buffer pool ("output" in this case) 
+        // if one exists - otherwise no response is possible
+        if (apvRingBufferUnLoad( thisComponent->messagingLayerOutputBufferPool,
+                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                &uartOutputMessage,
+                                 1,
+                                 true) != 0)
+          {
+          targetSignalPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT;
+        
+          if (apvMessageFramerCheckSignalPlane(targetSignalPlane) == true) // signal plane id exists
+            {
+            if (apvMessagingLayerGetComponentInputPort(targetCommsPlane, 
+                                                       targetSignalPlane,
+                                                       allComponents,
+                                                       targetInputPort_p) == true)
+              {
+              // Re-route the message; first copy the contents. This is a pain but otherwise keeping 
+              // the input and output message buffers straight is a nightmare!
+              *uartOutputMessage = *uartInputMessage;
+      
+               // If the command has an action it builds the response from the request, otherwise 
+               // put the fixed response message in the output buffer
+               if (apvCommandProtocol[protocolMessage].commandProtocolMessageAction != NULL)
+                 {
+                 apvCommandProtocol[protocolMessage].commandProtocolMessageAction((void *)uartOutputMessage);
+                 }
+               else
+                 {
+                 strcpy((char *)&uartOutputMessage->apvMessagingPayload[0], (const char *)&apvCommandProtocol[protocolMessage].commandProtocolMessageResponse[0]);
+                 }
+
+               uartOutputMessage->apvMessagingLengthOfMessage = strlen((const char *)&uartOutputMessage->apvMessagingPayload[0]);
+
+               // But - change the "inbound" channel codes...the "outbound" channel codes are not 
+               // really of interest as this message is destined for the hardware output port
+               uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken = 
+                                                       uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken;
+
+               apvMessagingLayerStampMessage(uartOutputMessage);
+
+               if (apvRingBufferLoad( targetInputPort,
+                                      APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                     &uartOutputMessage,
+                                      1,
+                                      true) != 0)
+                 {
+                 messageDelivered = true;
+                 }
+               else
+                 {
+                 apvMessagingLayerRecordDrop(apvMessagingLayerRoutes[targetCommsPlane][targetSignalPlane],
+                                             APV_MESSAGING_LAYER_DROP_RING_FULL);
+                 }
+              }
+            }
+
+          // An undelivered response gives its' message buffer straight back to the pool
+          if (messageDelivered == false)
+            {
+            apvRingBufferLoad( thisComponent->messagingLayerOutputBufferPool,
+                               APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                              &uartOutputMessage,
+                               1,
+                               true);
+            }
+          }
+        else
+          {
+          apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                      APV_MESSAGING_LAYER_DROP_NO_BUFFER);
+          }
+        }
+      }
+    else
+      { 
+      targetSignalPlane = uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT;
+
+      if (apvMessagingLayerPlaneHasSubscribers(targetCommsPlane,
+                                               targetSignalPlane) == true)
+        {
+        // Fan the message out by reference to every subscriber of the target planes - no message
+        // copies are made and the message buffer goes back to its' pool when the last subscriber 
+        // has finished with it. The "inbound" channel codes are changed in-place
+        uartInputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken = 
+                                                uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken;
+
+        apvMessagingLayerPublish( targetCommsPlane,
+                                  targetSignalPlane,
+                                  uartInputMessage,
+                                  thisComponent->messagingLayerInputBufferPool,
+                                  allComponents,
+                                 &messageDeliveries);
+        }
+      else
+        {
+        // These messages need to be sent somewhere else, get a message buffer from the messaging
+        // layer message buffer pool ("output" in this case) if one exists, otherwise no response
+        // is possible
+        if (apvRingBufferUnLoad( thisComponent->messagingLayerOutputBufferPool,
+                                 APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                &uartOutputMessage,
+                                 1,
+                                 true) != 0)
+          {
+          // Find the corresponding components' message buffer input port
+          if (apvMessageFramerCheckSignalPlane(targetSignalPlane) == true) // signal plane id exists
+            {
+            if (apvMessagingLayerGetComponentInputPort(targetCommsPlane, 
+                                                       targetSignalPlane,
+                                                       allComponents,
+                                                       targetInputPort_p) == true)
+              {
+              // Re-route the message; first copy the contents. This is a pain but otherwise keeping 
+              // the input and output message buffers straight is a nightmare!
+              *uartOutputMessage = *uartInputMessage;
+
+               // But - change the "inbound" channel codes...the "outbound" channel codes will need to be 
+               // determined by the target channel
+               uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken = 
+                                                       uartInputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken;
+
+               apvMessagingLayerStampMessage(uartOutputMessage);
+
+               if (apvRingBufferLoad( targetInputPort,
+                                      APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                                     &uartOutputMessage,
+                                      1,
+                                      true) != 0)
+                 {
+                 messageDelivered = true;
+                 }
+               else
+                 {
+                 apvMessagingLayerRecordDrop(apvMessagingLayerRoutes[targetCommsPlane][targetSignalPlane],
+                                             APV_MESSAGING_LAYER_DROP_RING_FULL);
+                 }
+              }
+            }
+
+          // An undelivered copy gives its' message buffer straight back to the pool
+          if (messageDelivered == false)
+            {
+            apvRingBufferLoad( thisComponent->messagingLayerOutputBufferPool,
+                               APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                              &uartOutputMessage,
+                               1,
+                               true);
+            }
+          }
+        else
+          {
+          apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                      APV_MESSAGING_LAYER_DROP_NO_BUFFER);
+          }
+        }
+      }
+    } // if apvMessageFramerCheckCommsPlane()
+
+  // Finally release the exhausted input message buffer back to the messaging layer 
+  // message buffer pool (once all subscribers, if any, have also released it)
+  apvMessagingLayerReleaseMessage(uartInputMessage,
+                                  thisComponent->messagingLayerInputBufferPool);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialUARTInputHandler                         */
+
+/******************************************************************************/
+/* apvMessagingLayerSerialUARTOutputHandler() :                               */
+/*  --> thisComponent : points to this handlers' component definition         */
+/*  --> allComponents : points to the list of handlers' component definitions */
+/*                                                                            */
+/* - all component handlers are data-driven; by definition there are one or   */
+/*   more messages on this components' input buffer to consume                */
+/*                                                                            */
+/******************************************************************************/
+
+void apvMessagingLayerSerialUARTOutputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                              struct apvMessagingLayerComponent_tTag *allComponents)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *uartOutputMessage                    = NULL,
+                         uartModifiedOutputMessage;
+
+  uint16_t               uartModifiedOutputMessageFinalLength = 0;
+
+/******************************************************************************/
+
+  // Pull a message from the input ring-buffer (which by definition exists
+  // otherwise this function would not have been called)
+  apvRingBufferUnLoad( thisComponent->messagingLayerInputBuffers,
+                       APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                      &uartOutputMessage,
+                       1,
+                       true);
+
+  apvMessagingLayerRecordResidency((uint16_t)(thisComponent - allComponents),
+                                   uartOutputMessage);
+
+  // Assuming the incoming message is a bit "raw", re-frame the payload using the 
+  // same message parameters otherwise
+  if (apvFrameMessage(&uartModifiedOutputMessage,
+                       uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  &  APV_MESSAGE_PLANE_MASK,
+                       uartOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  >> APV_MESSAGE_PLANE_SHIFT,
+                       uartOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken &  APV_MESSAGE_PLANE_MASK,
+                       uartOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT,
+                      &uartOutputMessage->apvMessagingPayload[0],
+                       strlen((const char *)&uartOutputMessage->apvMessagingPayload[0]),
+                      &uartModifiedOutputMessageFinalLength
+                      ) == APV_ERROR_CODE_NONE)
+    {
+    if (apvPrimarySerialTransmitMode == APV_SERIAL_TRANSMIT_MODE_PDC)
+      {
+      // Hand the whole frame to the PDC; it is copied so the message buffer can be released. The 
+      // gate only lets this component run with a frame slot free so a refusal here is a real loss
+      if (apvUartFrameTransmitPrime((Uart *)ApvUartControlBlock_p,
+                                    &apvPrimarySerialPdcTransmit,
+                                    &uartOutputMessage->apvMessagingPayload[0],
+                                     uartOutputMessage->apvMessagingLengthOfMessage) != APV_ERROR_CODE_NONE)
+        {
+        apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                    APV_MESSAGING_LAYER_DROP_TRANSMIT);
+        }
+      }
+    else
+      {
+      APV_CRITICAL_REGION_ENTRY();
+
+      if (transmitInterrupt == false)
+        {
+        // Put as many characters as possible on the serial UART hardware output ring
+        if (apvRingBufferLoad( apvPrimarySerialCommsTransmitBuffer,
+                               APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                              (uint32_t *)&uartOutputMessage->apvMessagingPayload[1],
+                               (uartOutputMessage->apvMessagingLengthOfMessage - 1),
+                               false) != (uartOutputMessage->apvMessagingLengthOfMessage - 1))
+          {
+          apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                      APV_MESSAGING_LAYER_DROP_TRANSMIT);
+          }
+
+        apvUartCharacterTransmitPrime((Uart *)ApvUartControlBlock_p,
+                                      uartOutputMessage->apvMessagingPayload[0],
+                                      false);
+
+        transmitInterrupt = true;
+        APV_CRITICAL_REGION_EXIT();
+        }
+      else
+        {
+        // Put as many characters as possible on the serial UART hardware output ring
+        if (apvRingBufferLoad( apvPrimarySerialCommsTransmitBuffer,
+                               APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                              (uint32_t *)&uartOutputMessage->apvMessagingPayload[0],
+                               uartOutputMessage->apvMessagingLengthOfMessage,
+                               false) != uartOutputMessage->apvMessagingLengthOfMessage)
+          {
+          apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                      APV_MESSAGING_LAYER_DROP_TRANSMIT);
+          }
+        }
+
+      APV_CRITICAL_REGION_EXIT();
+      }
+    }
+
+  // Finally release the exhausted message buffer back to the messaging layer 
+  // message buffer pool - it may be shared with other subscribers
+  apvMessagingLayerReleaseMessage(uartOutputMessage,
+                                  thisComponent->messagingLayerInputBufferPool);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialUARTOutputHandler                        */
+
+/******************************************************************************/
+/* apvMessagingLayerSerialUARTInputReady() :                                  */
+/*  --> thisComponent  : points to this handlers' component definition        */
+/*  <-- componentReady : [ false == hold the waiting messages |               */
+/*                         true  == run the handler ]                         */
+/*                                                                            */
+/* - the input handler needs a buffer from its' output pool for a response    */
+/*   or a copy; with none free the request waits for the output handler to    */
+/*   release one rather than being thrown away                                */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerSerialUARTInputReady(struct apvMessagingLayerComponent_tTag *thisComponent)
+  {
+/******************************************************************************/
+
+  bool     componentReady = false;
+
+  uint16_t poolCount      = 0;
+
+/******************************************************************************/
+
+  if (apvRingBufferReportFillState( thisComponent->messagingLayerOutputBufferPool,
+                                   &poolCount,
+                                    true) == APV_ERROR_CODE_NONE)
+    {
+    if (poolCount != 0)
+      {
+      componentReady = true;
+      }
+    }
+
+/******************************************************************************/
+
+  return(componentReady);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialUARTInputReady                           */
+
+/******************************************************************************/
+/* apvMessagingLayerSerialUARTOutputReady() :                                 */
+/*  --> thisComponent  : points to this handlers' component definition        */
+/*  <-- componentReady : [ false == hold the waiting messages |               */
+/*                         true  == run the handler ]                         */
+/*                                                                            */
+/* - in PDC mode the transmitter only has 'APV_SERIAL_PDC_TRANSMIT_FRAMES'    */
+/*   frame slots. Responses wait on this components' input ring until the     */
+/*   "ENDTX" interrupt frees a slot                                           */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerSerialUARTOutputReady(struct apvMessagingLayerComponent_tTag *thisComponent)
+  {
+/******************************************************************************/
+
+  bool componentReady = true;
+
+/******************************************************************************/
+
+  if (apvPrimarySerialTransmitMode == APV_SERIAL_TRANSMIT_MODE_PDC)
+    {
+    componentReady = apvSerialPdcTransmitSpace(&apvPrimarySerialPdcTransmit);
+    }
+
+/******************************************************************************/
+
+  return(componentReady);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialUARTOutputReady                          */
+
+/******************************************************************************/
+/* apvMessagingLayerSerialPortOutputReady() :                                 */
+/*  --> thisComponent  : points to this handlers' component definition        */
+/*  <-- componentReady : [ false == hold the waiting messages |               */
+/*                         true  == run the handler ]                         */
+/*                                                                            */
+/* - a USART port copies each frame onto its' transmit ring. Responses wait   */
+/*   on this components' input ring until the ring has room for the longest   */
+/*   frame                                                                    */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvMessagingLayerSerialPortOutputReady(struct apvMessagingLayerComponent_tTag *thisComponent)
+  {
+/******************************************************************************/
+
+  bool             componentReady = true;
+  apvSerialPort_t *serialPort     = NULL;
+
+/******************************************************************************/
+
+  serialPort = apvSerialPortFindByCommsPlane(thisComponent->messagingLayerCommsPlane);
+
+  // Without an open port the handler only releases the messages
+  if (serialPort != NULL)
+    {
+    componentReady = apvSerialPortTransmitSpace(serialPort,
+                                                APV_MESSAGING_MAXIMUM_PAYLOAD_LENGTH);
+    }
+
+/******************************************************************************/
+
+  return(componentReady);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialPortOutputReady                          */
+
+/******************************************************************************/
+/* apvMessagingLayerSerialPortOutputHandler() :                               */
+/*  --> thisComponent : points to this handlers' component definition         */
+/*  --> allComponents : points to the list of handlers' component definitions */
+/*                                                                            */
+/* - the USART equivalent of the serial UART output handler : the frame goes  */
+/*   out of the serial port bound to this components' comms plane. A frame    */
+/*   the port has no room for is dropped and counted by the port              */
+/*                                                                            */
+/******************************************************************************/
+
+void apvMessagingLayerSerialPortOutputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                              struct apvMessagingLayerComponent_tTag *allComponents)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *portOutputMessage                    = NULL,
+                         portModifiedOutputMessage;
+
+  uint16_t               portModifiedOutputMessageFinalLength = 0;
+
+  apvSerialPort_t       *serialPort                           = NULL;
+
+/******************************************************************************/
+
+  // Pull a message from the input ring-buffer (which by definition exists
+  // otherwise this function would not have been called)
+  apvRingBufferUnLoad( thisComponent->messagingLayerInputBuffers,
+                       APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                      &portOutputMessage,
+                       1,
+                       true);
+
+  apvMessagingLayerRecordResidency((uint16_t)(thisComponent - allComponents),
+                                   portOutputMessage);
+
+  serialPort = apvSerialPortFindByCommsPlane(thisComponent->messagingLayerCommsPlane);
+
+  if (serialPort != NULL)
+    {
+    // Check the message frames using the same message parameters
+    if (apvFrameMessage(&portModifiedOutputMessage,
+                         portOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  &  APV_MESSAGE_PLANE_MASK,
+                         portOutputMessage->apvMessagingInBoundPlanesToken.apvMessagePlanesToken  >> APV_MESSAGE_PLANE_SHIFT,
+                         portOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken &  APV_MESSAGE_PLANE_MASK,
+                         portOutputMessage->apvMessagingOutBoundPlanesToken.apvMessagePlanesToken >> APV_MESSAGE_PLANE_SHIFT,
+                        &portOutputMessage->apvMessagingPayload[0],
+                         strlen((const char *)&portOutputMessage->apvMessagingPayload[0]),
+                        &portModifiedOutputMessageFinalLength
+                        ) == APV_ERROR_CODE_NONE)
+      {
+      // The frame is copied onto the ports' transmit ring so the message buffer can be released. The
+      // gate only lets this component run with room for a frame so a refusal here is a real loss
+      if (apvSerialPortTransmit( serialPort,
+                                &portOutputMessage->apvMessagingPayload[0],
+                                 portOutputMessage->apvMessagingLengthOfMessage) != APV_ERROR_CODE_NONE)
+        {
+        apvMessagingLayerRecordDrop((uint16_t)(thisComponent - allComponents),
+                                    APV_MESSAGING_LAYER_DROP_TRANSMIT);
+        }
+      }
+    }
+
+  // Finally release the exhausted message buffer back to the messaging layer 
+  // message buffer pool - it may be shared with other subscribers
+  apvMessagingLayerReleaseMessage(portOutputMessage,
+                                  thisComponent->messagingLayerInputBufferPool);
+
+/******************************************************************************/
+  } /* end of apvMessagingLayerSerialPortOutputHandler                        */
 
 /******************************************************************************/
 /* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
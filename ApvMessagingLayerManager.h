@@ -74,6 +74,7 @@
 #include <stdint.h>
 #include "ApvCommsUtilities.h"
 #include "ApvMessageHandling.h"
+#include "ApvSerialPort.h"
 
 /******************************************************************************/
 /* Constants :                                                                */
@@ -107,22 +108,62 @@
 
 /******************************************************************************/
 /* The next 4 entries in the messaging layer definition array are SPI         */
-/* channels defined in pairs :                                                */
+/* channels defined in pairs, starting at the component offset :              */
 /******************************************************************************/
 
 #define APV_PLANE_SPI_CONTROL_nn(signalPlaneIndex,componentOffset) \
-                 APV_PLANE_SPI_CONTROL_0_##signalPlaneIndex = (((uint8_t)(APV_COMMS_PLANE_SPI_0 * componentOffset)) + ((uint8_t)APV_SIGNAL_PLANE_CONTROL_##signalPlaneIndex))
+                 APV_PLANE_SPI_CONTROL_0_##signalPlaneIndex = (((uint8_t)(componentOffset)) + ((uint8_t)APV_SIGNAL_PLANE_CONTROL_##signalPlaneIndex))
 
 #define APV_PLANE_SPI_DATA_nn(signalPlaneIndex,componentOffset) \
-                 APV_PLANE_SPI_DATA_0_##signalPlaneIndex = (((uint8_t)(APV_COMMS_PLANE_SPI_0 * componentOffset)) + ((uint8_t)APV_SIGNAL_PLANE_DATA_##signalPlaneIndex))
+                 APV_PLANE_SPI_DATA_0_##signalPlaneIndex = (((uint8_t)(componentOffset)) + ((uint8_t)APV_SIGNAL_PLANE_DATA_##signalPlaneIndex))
 
 /******************************************************************************/
+/* The fixed component slots above are only the first entries of the          */
+/* component table. Further components are registered at run-time with        */
+/* 'apvMessagingLayerComponentRegister()' which hands back the components'    */
+/* table index as its' handle. The table is statically allocated to its'      */
+/* maximum size; the background loop only visits entries up to the highest    */
+/* loaded component ('apvMessagingLayerComponentCount')                       */
+/******************************************************************************/
 
-#define APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE        (APV_MESSAGING_LAYER_COMPONENT_ENTRIES)
+#define APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE        32 // the component table capacity, MUST be >= APV_MESSAGING_LAYER_COMPONENT_ENTRIES and < 255
+#define APV_MESSAGING_LAYER_ROUTE_NULL                    ((uint8_t)0xff)
 #define APV_MESSAGING_LAYER_FREE_MESSAGE_BUFFER_SET_SIZE  16 // the pool of inter-messaging layer message buffers
 
 #define APV_MESSAGINIG_COMPONENT_MESSAGE_RING_BUFFER_SIZE 16 // a messaging layer components' message buffer holding ring
 
+/******************************************************************************/
+/* Publish/subscribe : any number of components can subscribe to a (comms,    */
+/* signal) plane pair. A message published on the pair is delivered to every  */
+/* subscriber BY REFERENCE - the message buffer carries a count of its'       */
+/* additional holders and only goes back to its' pool when the last holder    */
+/* releases it                                                                */
+/******************************************************************************/
+
+#define APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE            16 // total subscriptions over all planes
+#define APV_MESSAGING_LAYER_SUBSCRIPTION_NULL             ((uint8_t)0xff)
+
+/******************************************************************************/
+/* Per-component instrumentation : a message is timestamped from the 64-bit   */
+/* timestamp when it is loaded onto a components' input ring and again        */
+/* when the component takes it off ("residency"). The service time is timed   */
+/* around each call of the components' service manager. All times are kept in */
+/* timestamp ticks ('APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US' per usec). Every */
+/* message the layer has to throw away is counted by cause                    */
+/******************************************************************************/
+
+#define APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_BINS     8 // service time histogram bins
+#define APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_SHIFT    2 // each bin is 4x wider than the last : < 4usecs, < 16usecs, ... >= 16384usecs
+#define APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_LIMIT    ((uint32_t)0xffff) // reported bin counts saturate here
+#define APV_MESSAGING_LAYER_STATISTICS_MINIMUM_RESET      ((uint32_t)0xffffffff)
+#define APV_MESSAGING_LAYER_STATISTICS_TIME_LIMIT         ((uint64_t)0xffffffff) // longer times are recorded as this
+
+// Statistics report selectors (the optional last field of the statistics command)
+#define APV_MESSAGING_LAYER_STATISTICS_SELECT_RESIDENCY   'R'
+#define APV_MESSAGING_LAYER_STATISTICS_SELECT_SERVICE     'S'
+#define APV_MESSAGING_LAYER_STATISTICS_SELECT_HISTOGRAM   'H'
+#define APV_MESSAGING_LAYER_STATISTICS_SELECT_DROPS       'D'
+
 /******************************************************************************/
 /* Type Definitions :                                                         */
 /******************************************************************************/
@@ -156,20 +197,75 @@ typedef struct apvMessagingLayerComponent_tTag
                                                            // this ring-buffer is owned by the component which does NOT own any message buffers
   void             (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
                                                    struct apvMessagingLayerComponent_tTag *allComponents);  // the instance of a manager function
+  bool             (*messagingLayerServiceReady)(struct apvMessagingLayerComponent_tTag *thisComponent);    // optional gate : NULL == the manager runs whenever a message is waiting,
+                                                                                                            // otherwise waiting messages are held until the gate is open
   } apvMessagingLayerComponent_t;
 
+// What to do when a subscribers' input ring is full at delivery time
+typedef enum apvMessagingLayerDropPolicy_tTag
+  {
+  APV_MESSAGING_LAYER_DROP_NEWEST = 0, // the subscriber does not see the new message
+  APV_MESSAGING_LAYER_DROP_OLDEST,     // the subscribers' oldest waiting message is released to make room
+  APV_MESSAGING_LAYER_DROP_POLICIES
+  } apvMessagingLayerDropPolicy_t;
+
+typedef struct apvMessagingLayerSubscription_tTag
+  {
+  bool                          subscriptionLoaded;        // mark occupied subscriptions
+  apvCommsPlanes_t              subscriptionCommsPlane;    // the comms plane subscribed to
+  apvSignalPlanes_t             subscriptionSignalPlane;   // the signal plane subscribed to
+  uint16_t                      subscriptionComponent;     // the subscribers' index in the messaging layer component table
+  uint8_t                       subscriptionDeliveryOrder; // subscribers on the same planes are delivered to lowest-order first
+  apvMessagingLayerDropPolicy_t subscriptionDropPolicy;
+  uint8_t                       subscriptionNext;          // the next subscription on the same planes
+  uint32_t                      subscriptionDelivered;     // messages delivered to this subscriber
+  uint32_t                      subscriptionDropped;       // messages dropped by the policy
+  } apvMessagingLayerSubscription_t;
+
+// Why a message was dropped; counted against the component that could not take it
+typedef enum apvMessagingLayerDrop_tTag
+  {
+  APV_MESSAGING_LAYER_DROP_RING_FULL = 0, // the components' input ring was full
+  APV_MESSAGING_LAYER_DROP_NO_BUFFER,     // no message buffer for the copy or the response
+  APV_MESSAGING_LAYER_DROP_TRANSMIT,      // the transmitter refused the frame
+  APV_MESSAGING_LAYER_DROPS
+  } apvMessagingLayerDrop_t;
+
+typedef struct apvMessagingLayerComponentStatistics_tTag
+  {
+  uint32_t statisticsMessages;                                                        // messages taken off the components' input ring
+  uint32_t statisticsResidencyMinimum;                                                // input ring residency in timestamp ticks
+  uint32_t statisticsResidencyMaximum;
+  uint64_t statisticsResidencyTotal;
+  uint32_t statisticsServiceCalls;                                                    // service manager calls
+  uint32_t statisticsServiceMinimum;                                                  // service manager execution time in timestamp ticks
+  uint32_t statisticsServiceMaximum;
+  uint64_t statisticsServiceTotal;
+  uint32_t statisticsServiceHistogram[APV_MESSAGING_LAYER_STATISTICS_HISTOGRAM_BINS];
+  uint32_t statisticsDrops[APV_MESSAGING_LAYER_DROPS];                                // messages lost by cause
+  } apvMessagingLayerComponentStatistics_t;
+
 /******************************************************************************/
 /* Global Variable Declarations :                                             */
 /******************************************************************************/
 
-extern apvMessagingLayerComponent_t apvMessagingLayerComponents[APV_MESSAGING_LAYER_COMPONENT_ENTRIES];
+extern apvMessagingLayerComponent_t apvMessagingLayerComponents[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
 extern bool                         apvMessagingLayerComponentReady[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
+extern uint16_t                     apvMessagingLayerComponentCount;
+extern uint8_t                      apvMessagingLayerRoutes[APV_COMMS_PLANES][APV_SIGNAL_PLANES];
 
 extern apvRingBuffer_t              apvMessagingLayerFreeBufferSet;
 extern apvMessageStructure_t        apvMessagingLayerFreeBuffers[APV_MESSAGING_LAYER_FREE_MESSAGE_BUFFER_SET_SIZE];
 
 extern apvRingBuffer_t              apvMessagingLayerComponentSerialUartTxBuffer;
 extern apvRingBuffer_t              apvMessagingLayerComponentSerialUartRxBuffer;
+extern apvRingBuffer_t              apvMessagingLayerComponentSerialPortTxBuffer[APV_SERIAL_PORTS];
+extern apvRingBuffer_t              apvMessagingLayerComponentSerialPortRxBuffer[APV_SERIAL_PORTS];
+
+extern apvMessagingLayerSubscription_t apvMessagingLayerSubscriptions[APV_MESSAGING_LAYER_SUBSCRIPTIONS_SIZE];
+extern uint8_t                         apvMessagingLayerSubscriptionLists[APV_COMMS_PLANES][APV_SIGNAL_PLANES];
+
+extern apvMessagingLayerComponentStatistics_t apvMessagingLayerStatistics[APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE];
 
 /******************************************************************************/
 /* Function Declarations :                                                    */
@@ -188,15 +284,68 @@ extern APV_ERROR_CODE apvMessagingLayerComponentLoad(apvMessagingLayerPlaneHandl
                                                      void                            (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
                                                                                                                      struct apvMessagingLayerComponent_tTag *allComponents));
 
+extern APV_ERROR_CODE apvMessagingLayerComponentRegister(apvRingBuffer_t   *messagingInputBufferPool,
+                                                         apvRingBuffer_t   *messagingOutputBufferPool,
+                                                         apvRingBuffer_t   *messagingLayerMessageBuffers,
+                                                         apvCommsPlanes_t   messagingLayerCommsPlane,
+                                                         apvSignalPlanes_t  messagingLayerSignalPlane,
+                                                         void             (*messagingLayerServiceManager)(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                                                                                          struct apvMessagingLayerComponent_tTag *allComponents),
+                                                         uint16_t          *componentHandle);
+extern APV_ERROR_CODE apvMessagingLayerComponentDeregister(uint16_t componentHandle);
+extern APV_ERROR_CODE apvMessagingLayerComponentGate(uint16_t   componentHandle,
+                                                     bool     (*messagingLayerServiceReady)(struct apvMessagingLayerComponent_tTag *thisComponent));
+extern bool           apvMessagingLayerComponentWaiting(uint16_t componentHandle);
+extern bool           apvMessagingLayerComponentsWaiting(void);
+
 extern bool           apvMessagingLayerGetComponentInputPort(apvCommsPlanes_t               componentCommsPlane, 
                                                              apvSignalPlanes_t              componentSignalPlane,
                                                              apvMessagingLayerComponent_t  *messagingLayerComponents,
                                                              apvRingBuffer_t              **componentInpuMessageBuffers);
 
+extern APV_ERROR_CODE apvMessagingLayerSubscriptionInitialise(void);
+extern APV_ERROR_CODE apvMessagingLayerSubscribe(apvCommsPlanes_t               subscriptionCommsPlane,
+                                                 apvSignalPlanes_t              subscriptionSignalPlane,
+                                                 uint16_t                       subscriptionComponent,
+                                                 uint8_t                        subscriptionDeliveryOrder,
+                                                 apvMessagingLayerDropPolicy_t  subscriptionDropPolicy,
+                                                 uint16_t                      *subscriptionHandle);
+extern APV_ERROR_CODE apvMessagingLayerUnsubscribe(uint16_t subscriptionHandle);
+extern bool           apvMessagingLayerPlaneHasSubscribers(apvCommsPlanes_t  commsPlane,
+                                                           apvSignalPlanes_t signalPlane);
+extern APV_ERROR_CODE apvMessagingLayerPublish(apvCommsPlanes_t              commsPlane,
+                                               apvSignalPlanes_t             signalPlane,
+                                               apvMessageStructure_t        *message,
+                                               apvRingBuffer_t              *messageHomePool,
+                                               apvMessagingLayerComponent_t *allComponents,
+                                               uint16_t                     *messageDeliveries);
+extern APV_ERROR_CODE apvMessagingLayerReleaseMessage(apvMessageStructure_t *message,
+                                                      apvRingBuffer_t       *messageDefaultPool);
+
+extern APV_ERROR_CODE apvMessagingLayerStatisticsInitialise(void);
+extern void           apvMessagingLayerStampMessage(apvMessageStructure_t *message);
+extern APV_ERROR_CODE apvMessagingLayerRecordResidency(uint16_t               componentIndex,
+                                                       apvMessageStructure_t *message);
+extern APV_ERROR_CODE apvMessagingLayerRecordService(uint16_t componentIndex,
+                                                     uint64_t serviceStart,
+                                                     uint64_t serviceEnd);
+extern APV_ERROR_CODE apvMessagingLayerRecordDrop(uint16_t                componentIndex,
+                                                  apvMessagingLayerDrop_t drop);
+extern APV_ERROR_CODE apvMessagingLayerReportStatistics(uint16_t  componentIndex,
+                                                        char      reportSelect,
+                                                        char     *report,
+                                                        uint16_t  reportMaximumLength);
+extern void          *apvMessagingLayerStatisticsAction(void *messageAction);
+
 extern void           apvMessagingLayerSerialUARTInputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
                                                               struct apvMessagingLayerComponent_tTag *allComponents);
 extern void           apvMessagingLayerSerialUARTOutputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
                                                                struct apvMessagingLayerComponent_tTag *allComponents);
+extern bool           apvMessagingLayerSerialUARTInputReady(struct apvMessagingLayerComponent_tTag *thisComponent);
+extern bool           apvMessagingLayerSerialUARTOutputReady(struct apvMessagingLayerComponent_tTag *thisComponent);
+extern bool           apvMessagingLayerSerialPortOutputReady(struct apvMessagingLayerComponent_tTag *thisComponent);
+extern void           apvMessagingLayerSerialPortOutputHandler(struct apvMessagingLayerComponent_tTag *thisComponent,
+                                                               struct apvMessagingLayerComponent_tTag *allComponents);
 
 /******************************************************************************/
 
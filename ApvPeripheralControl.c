@@ -21,22 +21,24 @@
 #include "ApvSystemTime.h"
 #include "ApvEventTimers.h"
 #include "ApvCommsUtilities.h"
+#include "ApvRegisterAccess.h"
 #include "ApvPeripheralControl.h"
+#include "ApvSerial.h"
 
 /******************************************************************************/
 /* Global Variable Definitions :                                              */
 /******************************************************************************/
 
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
          Pmc                          ApvPeripheralControlBlock;                                      // shadow peripheral control block
-         Pmc                         *ApvPeripheralControlBlock_p = PMC;                              // physical block address
-
          Uart                         ApvUartControlBlock;                                            // shadow UART control block
-volatile Uart                        *ApvUartControlBlock_p       = UART;                             // physical block address
-
-         Spi                          ApvSpi0ControlBlock,                                            // Shadow SPI control block
-                                     *ApvSpi0ControlBlock_p       = SPI0;                             // physical block address
-
+         Spi                          ApvSpi0ControlBlock;                                            // Shadow SPI control block
          apvInterruptPriorityLevel_t  apvInterruptPriorities[APV_DEVICE_INTERRUPT_PRIORITIES_PACKED]; // "packed" array of SAM3A device interrupt priorities
+#endif
+
+         Pmc                         *ApvPeripheralControlBlock_p = PMC;                              // physical block address
+volatile Uart                        *ApvUartControlBlock_p       = UART;                             // physical block address
+         Spi                         *ApvSpi0ControlBlock_p       = SPI0;                             // physical block address
 
 /******************************************************************************/
 /* Function Definitions :                                                     */
@@ -51,8 +53,9 @@ volatile Uart                        *ApvUartControlBlock_p       = UART;
 /*   using the Rowley CrossWorks toolset many of the other clocks are handled */
 /*   by startup code i.e. "SAM3XA_Startup.s", "system_sam3xa.c/.h" and        */
 /*   "sam3x8e.h" among others. The peripheral clock registers are "write-     */
-/*   only" and are shadowed by "ApvPeripheralControlBlock". Periherals are    */
-/*   consistently indentified by ID "position" in either PCxR0 or PCxR1       */
+/*   only" and in debug builds are shadowed by "ApvPeripheralControlBlock".   */
+/*   Periherals are consistently indentified by ID "position" in either PCxR0 */
+/*   or PCxR1                                                                 */
 /*                                                                            */
 /* Reference : "Atmel-11057C-ATARM-SAM3X-SAM3A-Datasheet_23-Mar-15",          */
 /*             p542 - 3, p563 - 4                                             */
@@ -81,13 +84,11 @@ APV_ERROR_CODE apvSwitchPeripheralClock(apvPeripheralId_t peripheralId,
       {
       if (peripheralSwitch == true)
         {
-        ApvPeripheralControlBlock.PMC_PCER0    = ApvPeripheralControlBlock.PMC_PCER0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCER0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCER0, (1 << peripheralId));
         }
       else
         {
-        ApvPeripheralControlBlock.PMC_PCDR0    = ApvPeripheralControlBlock.PMC_PCER1 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCDR0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCDR0, (1 << peripheralId));
         }
       }
 
@@ -95,13 +96,11 @@ APV_ERROR_CODE apvSwitchPeripheralClock(apvPeripheralId_t peripheralId,
       {
       if (peripheralSwitch == true)
         {
-        ApvPeripheralControlBlock.PMC_PCER1    = ApvPeripheralControlBlock.PMC_PCER1 | (1 << (ID_TC5 - peripheralId));
-        ApvPeripheralControlBlock_p->PMC_PCER1 = (1 << (ID_TC5 - peripheralId));
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCER1, (1 << (ID_TC5 - peripheralId)));
         }
       else
         {
-        ApvPeripheralControlBlock.PMC_PCDR1    = ApvPeripheralControlBlock.PMC_PCDR1 | (1 << (ID_TC5 - peripheralId));
-        ApvPeripheralControlBlock_p->PMC_PCDR1 = (1 << (ID_TC5 - peripheralId));
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCDR1, (1 << (ID_TC5 - peripheralId)));
         }
       }
 
@@ -114,13 +113,11 @@ APV_ERROR_CODE apvSwitchPeripheralClock(apvPeripheralId_t peripheralId,
       {
       if (peripheralSwitch == true)
         {
-        ApvPeripheralControlBlock.PMC_PCER0    = ApvPeripheralControlBlock.PMC_PCER0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCER0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCER0, (1 << peripheralId));
         }
       else
         {
-        ApvPeripheralControlBlock.PMC_PCDR0    = ApvPeripheralControlBlock.PMC_PCDR0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCDR0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCDR0, (1 << peripheralId));
         }
       }
 
@@ -132,13 +129,11 @@ APV_ERROR_CODE apvSwitchPeripheralClock(apvPeripheralId_t peripheralId,
       {
       if (peripheralSwitch == true)
         {
-        ApvPeripheralControlBlock.PMC_PCER0 = ApvPeripheralControlBlock.PMC_PCER0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCER0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCER0, (1 << peripheralId));
         }
       else
         {
-        ApvPeripheralControlBlock.PMC_PCDR0    = ApvPeripheralControlBlock.PMC_PCDR0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCDR0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCDR0, (1 << peripheralId));
         }
       }
 
@@ -150,13 +145,11 @@ APV_ERROR_CODE apvSwitchPeripheralClock(apvPeripheralId_t peripheralId,
       {
       if (peripheralSwitch == true)
         {
-        ApvPeripheralControlBlock.PMC_PCER0    = ApvPeripheralControlBlock.PMC_PCER0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCER0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCER0, (1 << peripheralId));
         }
       else
         {
-        ApvPeripheralControlBlock.PMC_PCDR0    = ApvPeripheralControlBlock.PMC_PCDR0 | (1 << peripheralId);
-        ApvPeripheralControlBlock_p->PMC_PCDR0 = (1 << peripheralId);
+        APV_REGISTER_WRITE_ACCUMULATE(ApvPeripheralControlBlock_p, ApvPeripheralControlBlock, PMC_PCDR0, (1 << peripheralId));
         }
       }
 
@@ -329,6 +322,54 @@ APV_ERROR_CODE apvSwitchPeripheralLines(apvPeripheralId_t peripheralLineId,
 
                                       break;
 
+        /******************************************************************************/
+        /* USART0 - 3 : Arduino usage :                                               */
+        /* -------------------------------------------------------------------------- */
+        /*  Arduino   |   I/O   | Peripheral |   Atmel    |          Notes            */
+        /*    Name    |   Pin   |   Select   |    Name    |                           */
+        /* -------------------------------------------------------------------------- */
+        /*    RX1     | PIOA/10 |     'A'    |    RXD0    |                           */
+        /*    TX1     | PIOA/11 |     'A'    |    TXD0    |                           */
+        /*    RX2     | PIOA/12 |     'A'    |    RXD1    |                           */
+        /*    TX2     | PIOA/13 |     'A'    |    TXD1    |                           */
+        /*    A11     | PIOB/20 |     'A'    |    TXD2    |                           */
+        /*    A12     | PIOB/21 |     'A'    |    RXD2    | shared with SPI0_NPCS2    */
+        /*    TX3     | PIOD/4  |     'B'    |    TXD3    |                           */
+        /*    RX3     | PIOD/5  |     'B'    |    RXD3    |                           */
+        /******************************************************************************/
+
+        case APV_PERIPHERAL_ID_USART0 : // Program PIOA/10 and PIOA/11 as peripheral 'A'
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PDR  = PIO_PDR_P10 | PIO_PDR_P11;
+                                        peripheralABSelect = ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_ABSR;
+                                        peripheralABSelect = peripheralABSelect & (uint32_t)(~(PIO_ABSR_P10 | PIO_ABSR_P11));
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_ABSR = peripheralABSelect;
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PUER = PIO_PUER_P10 | PIO_PUER_P11;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART1 : // Program PIOA/12 and PIOA/13 as peripheral 'A'
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PDR  = PIO_PDR_P12 | PIO_PDR_P13;
+                                        peripheralABSelect = ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_ABSR;
+                                        peripheralABSelect = peripheralABSelect & (uint32_t)(~(PIO_ABSR_P12 | PIO_ABSR_P13));
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_ABSR = peripheralABSelect;
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PUER = PIO_PUER_P12 | PIO_PUER_P13;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART2 : // Program PIOB/20 and PIOB/21 as peripheral 'A' - this takes PIOB/21 away from SPI0_NPCS2
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_B]->PIO_PDR  = PIO_PDR_P20 | PIO_PDR_P21;
+                                        peripheralABSelect = ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_B]->PIO_ABSR;
+                                        peripheralABSelect = peripheralABSelect & (uint32_t)(~(PIO_ABSR_P20 | PIO_ABSR_P21));
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_B]->PIO_ABSR = peripheralABSelect;
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_B]->PIO_PUER = PIO_PUER_P20 | PIO_PUER_P21;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART3 : // Program PIOD/4 and PIOD/5 as peripheral 'B'
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_D]->PIO_PDR  = PIO_PDR_P4 | PIO_PDR_P5;
+                                        peripheralABSelect = ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_D]->PIO_ABSR;
+                                        peripheralABSelect = peripheralABSelect | PIO_ABSR_P4 | PIO_ABSR_P5;
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_D]->PIO_ABSR = peripheralABSelect;
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_D]->PIO_PUER = PIO_PUER_P4 | PIO_PUER_P5;
+                                        break;
+
         default                     :
                                       break;
         }
@@ -356,6 +397,22 @@ APV_ERROR_CODE apvSwitchPeripheralLines(apvPeripheralId_t peripheralLineId,
         case APV_PERIPHERAL_ID_SPI0 :
                                       break;
 
+        case APV_PERIPHERAL_ID_USART0 : // Hand the lines back to the PIO
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PER = PIO_PER_P10 | PIO_PER_P11;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART1 :
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_A]->PIO_PER = PIO_PER_P12 | PIO_PER_P13;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART2 :
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_B]->PIO_PER = PIO_PER_P20 | PIO_PER_P21;
+                                        break;
+
+        case APV_PERIPHERAL_ID_USART3 :
+                                        ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUP_D]->PIO_PER = PIO_PER_P4 | PIO_PER_P5;
+                                        break;
+
         default                     :
                                       break;
         }
@@ -380,14 +437,10 @@ APV_ERROR_CODE apvSwitchPeripheralLines(apvPeripheralId_t peripheralLineId,
 /*                          APV_UART_CHANNEL_MODE_AUTOMATIC       = 1 |       */
 /*                          APV_UART_CHANNEL_MODE_LOCAL_LOOPBACK  = 2 |       */
 /*                          APV_UART_CHANNEL_MODE_REMOTE_LOOPBACK = 3 ]       */
-/*  --> uartBaudRate    : [ APV_UART_BAUD_RATE_SELECT_9600   = 0 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_19200  = 1 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_38400  = 2 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_57600  = 3 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_76800  = 4 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_96000  = 5 |            */
-/*                          APV_UART_BAUD_RATE_SELECT_152000 = 6 ]            */
-/*  <-- uartErrorCode   : error codes                                         */
+/*  --> uartBaudRate       : any baud rate the UART divisor can reach         */
+/*  <-- uartBaudRateActual : the baud rate the divisor actually gives         */
+/*  <-- uartBaudRateError  : the baud rate error in parts-per-million         */
+/*  <-- uartErrorCode      : error codes                                      */
 /*                                                                            */
 /*  - prepare the UART for duplex serial comms                                */
 /*                                                                            */
@@ -395,9 +448,11 @@ APV_ERROR_CODE apvSwitchPeripheralLines(apvPeripheralId_t peripheralLineId,
 /*                                                                            */
 /******************************************************************************/
 
-APV_ERROR_CODE apvConfigureUart(apvUartParity_t            uartParity,
-                                apvUartChannelMode_t       uartChannelMode,
-                                apvUartBaudRateSelection_t uartBaudRate)
+APV_ERROR_CODE apvConfigureUart(apvUartParity_t       uartParity,
+                                apvUartChannelMode_t  uartChannelMode,
+                                uint32_t              uartBaudRate,
+                                uint32_t             *uartBaudRateActual,
+                                int32_t              *uartBaudRateError)
   {
 /******************************************************************************/
 
@@ -419,34 +474,284 @@ APV_ERROR_CODE apvConfigureUart(apvUartParity_t            uartParity,
       }
     else
       {
-      if (uartBaudRate >= APV_UART_BAUD_RATE_SELECT_SET)
+      targetRegister = (uartParity << UART_MR_PAR_Pos) | (uartChannelMode << UART_MR_CHMODE_Pos); // build the mode register setting
+      APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_MR, targetRegister);   // assign the setting
+
+      uartErrorCode = apvUartSetBaudRate(uartBaudRate,
+                                         uartBaudRateActual,
+                                         uartBaudRateError);
+      }
+    }
+
+/******************************************************************************/
+
+  return(uartErrorCode);
+
+/******************************************************************************/
+  } /* end of apvConfigureUart                                                */
+
+/******************************************************************************/
+/* apvUartBaudRateDivisor() :                                                 */
+/*  --> masterClock       : the peripheral clock (MCK) in Hz                  */
+/*  --> baudRate          : the target baud rate                              */
+/*  --> clockOversampling : [ APV_UART_MCK_FIXED_DIVIDE_16 |                  */
+/*                            APV_USART_MCK_DIVIDE_8 ]                        */
+/*  --> fractionalSteps   : [ APV_UART_NO_FRACTIONAL_DIVISOR_STEPS |          */
+/*                            APV_USART_FRACTIONAL_DIVISOR_STEPS ]            */
+/*  <-- baudRateDivisor   : the integer clock divisor "CD"                    */
+/*  <-- baudRateFraction  : the fractional clock divisor "FP"                 */
+/*  <-- baudRateActual    : the baud rate the divisors actually give          */
+/*  <-- baudRateError     : the baud rate error in parts-per-million          */
+/*  <-- divisorError      : error codes                                       */
+/*                                                                            */
+/*  - compute the nearest baud rate generator divisor for any target rate :   */
+/*                                                                            */
+/*      baud rate = MCK / ( oversampling * ( CD + ( FP / steps ) ) )          */
+/*                                                                            */
+/*    The combined divisor ( CD * steps ) + FP is rounded to the nearest      */
+/*    whole step so the error is the smallest the hardware can do. The        */
+/*    actual rate and its' error are reported even when the divisor is out    */
+/*    of range so a caller can report why a rate was refused                  */
+/*                                                                            */
+/* Reference : "Atmel-11057C-ATARM-SAM3X-SAM3A-Datasheet_23-Mar-15", p752     */
+/*             and p798                                                       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvUartBaudRateDivisor(uint32_t  masterClock,
+                                      uint32_t  baudRate,
+                                      uint32_t  clockOversampling,
+                                      uint32_t  fractionalSteps,
+                                      uint16_t *baudRateDivisor,
+                                      uint8_t  *baudRateFraction,
+                                      uint32_t *baudRateActual,
+                                      int32_t  *baudRateError)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE divisorError    = APV_ERROR_CODE_NONE;
+
+  uint64_t       divisorSteps    = 0,
+                 divisorScale    = 0,
+                 divisorInteger  = 0;
+
+/******************************************************************************/
+
+  if ((baudRateDivisor == NULL) || (baudRateFraction == NULL) || 
+      (baudRateActual  == NULL) || (baudRateError    == NULL))
+    {
+    divisorError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((masterClock == 0) || (baudRate == 0) || (clockOversampling == 0) || (fractionalSteps == 0))
+      {
+      divisorError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      // Round ( MCK * steps ) / ( oversampling * baud rate ) to the nearest step
+      divisorScale = ((uint64_t)clockOversampling) * baudRate;
+      divisorSteps = ((((uint64_t)masterClock) * fractionalSteps) + (divisorScale >> 1)) / divisorScale;
+
+      if (divisorSteps == 0)
+        {
+        divisorSteps = 1;
+        }
+
+      divisorInteger    = divisorSteps / fractionalSteps;
+
+      *baudRateDivisor  = (uint16_t)divisorInteger;
+      *baudRateFraction = (uint8_t)(divisorSteps % fractionalSteps);
+      *baudRateActual   = (uint32_t)((((uint64_t)masterClock) * fractionalSteps) / (divisorSteps * clockOversampling));
+      *baudRateError    = (int32_t)(((((int64_t)masterClock) * fractionalSteps * APV_UART_BAUD_RATE_ERROR_SCALE_PPM) / 
+                                     ((int64_t)(divisorSteps * clockOversampling)) - 
+                                     (((int64_t)baudRate) * APV_UART_BAUD_RATE_ERROR_SCALE_PPM)) / ((int64_t)baudRate));
+
+      if ((divisorInteger < APV_UART_BAUD_RATE_DIVISOR_MINIMUM) || (divisorInteger > APV_UART_BAUD_RATE_DIVISOR_MAXIMUM))
         {
-        uartErrorCode = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+        divisorError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(divisorError);
+
+/******************************************************************************/
+  } /* end of apvUartBaudRateDivisor                                          */
+
+/******************************************************************************/
+/* apvUartSetBaudRate() :                                                     */
+/*  --> uartBaudRate       : any baud rate the UART divisor can reach         */
+/*  <-- uartBaudRateActual : the baud rate the divisor actually gives         */
+/*  <-- uartBaudRateError  : the baud rate error in parts-per-million         */
+/*  <-- uartErrorCode      : error codes                                      */
+/*                                                                            */
+/*  - set the UART baud rate generator. The UART has no fractional divisor    */
+/*    so above about 230400 the error grows quickly; a rate more than         */
+/*    APV_UART_BAUD_RATE_ERROR_LIMIT_PPM adrift is refused and the baud rate  */
+/*    generator is left alone                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvUartSetBaudRate(uint32_t  uartBaudRate,
+                                  uint32_t *uartBaudRateActual,
+                                  int32_t  *uartBaudRateError)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE uartErrorCode    = APV_ERROR_CODE_NONE;
+
+  uint16_t       baudRateDivisor  = 0;
+  uint8_t        baudRateFraction = 0;
+
+/******************************************************************************/
+
+  uartErrorCode = apvUartBaudRateDivisor(APV_EVENT_TIMER_TIMEBASE_BASECLOCK, // MCK / 16 ALWAYS!
+                                         uartBaudRate,
+                                         APV_UART_MCK_FIXED_DIVIDE_16,
+                                         APV_UART_NO_FRACTIONAL_DIVISOR_STEPS,
+                                        &baudRateDivisor,
+                                        &baudRateFraction,
+                                         uartBaudRateActual,
+                                         uartBaudRateError);
+
+  if (uartErrorCode == APV_ERROR_CODE_NONE)
+    {
+    if ((*uartBaudRateError > APV_UART_BAUD_RATE_ERROR_LIMIT_PPM) || (*uartBaudRateError < (-APV_UART_BAUD_RATE_ERROR_LIMIT_PPM)))
+      {
+      uartErrorCode = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_BRGR, UART_BRGR_CD(baudRateDivisor));
+      }
+    }
+
+/******************************************************************************/
+
+  return(uartErrorCode);
+
+/******************************************************************************/
+  } /* end of apvUartSetBaudRate                                              */
+
+/******************************************************************************/
+/* apvUsartSetBaudRate() :                                                    */
+/*  --> usartControlBlock   : USART0 { .. } USART3                            */
+/*  --> usartBaudRate       : any baud rate the USART divisors can reach      */
+/*  <-- usartBaudRateActual : the baud rate the divisors actually give        */
+/*  <-- usartBaudRateError  : the baud rate error in parts-per-million        */
+/*  <-- usartErrorCode      : error codes                                     */
+/*                                                                            */
+/*  - set a USART baud rate generator using the fractional divisor. Both 16x  */
+/*    and 8x oversampling are tried and the smaller error wins - 16x is kept  */
+/*    on a tie for its' better noise immunity. At 84MHz this reaches 921600   */
+/*    to within 0.2%. A rate more than APV_UART_BAUD_RATE_ERROR_LIMIT_PPM     */
+/*    adrift is refused and the baud rate generator is left alone             */
+/*                                                                            */
+/* Reference : "Atmel-11057C-ATARM-SAM3X-SAM3A-Datasheet_23-Mar-15", p798     */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvUsartSetBaudRate(Usart    *usartControlBlock,
+                                   uint32_t  usartBaudRate,
+                                   uint32_t *usartBaudRateActual,
+                                   int32_t  *usartBaudRateError)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE usartErrorCode       = APV_ERROR_CODE_NONE,
+                 usartErrorCode8      = APV_ERROR_CODE_NONE;
+
+  uint16_t       baudRateDivisor      = 0,
+                 baudRateDivisor8     = 0;
+  uint8_t        baudRateFraction     = 0,
+                 baudRateFraction8    = 0;
+  uint32_t       baudRateActual8      = 0,
+                 usartModeRegister    = 0;
+  int32_t        baudRateError8       = 0;
+  bool           oversampling8        = false;
+
+/******************************************************************************/
+
+  if ((usartControlBlock == NULL) || (usartBaudRateActual == NULL) || (usartBaudRateError == NULL))
+    {
+    usartErrorCode = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    usartErrorCode  = apvUartBaudRateDivisor(APV_EVENT_TIMER_TIMEBASE_BASECLOCK,
+                                             usartBaudRate,
+                                             APV_UART_MCK_FIXED_DIVIDE_16,
+                                             APV_USART_FRACTIONAL_DIVISOR_STEPS,
+                                            &baudRateDivisor,
+                                            &baudRateFraction,
+                                             usartBaudRateActual,
+                                             usartBaudRateError);
+
+    usartErrorCode8 = apvUartBaudRateDivisor(APV_EVENT_TIMER_TIMEBASE_BASECLOCK,
+                                             usartBaudRate,
+                                             APV_USART_MCK_DIVIDE_8,
+                                             APV_USART_FRACTIONAL_DIVISOR_STEPS,
+                                            &baudRateDivisor8,
+                                            &baudRateFraction8,
+                                            &baudRateActual8,
+                                            &baudRateError8);
+
+    // Take the 8x divisor if the 16x divisor is unusable or the 8x divisor is strictly closer
+    if (usartErrorCode8 == APV_ERROR_CODE_NONE)
+      {
+      if (usartErrorCode != APV_ERROR_CODE_NONE)
+        {
+        oversampling8 = true;
         }
       else
         {
-        targetRegister = (uartParity << UART_MR_PAR_Pos) | (uartChannelMode << UART_MR_CHMODE_Pos); // build the mode register setting
-        ApvUartControlBlock.UART_MR    = targetRegister;                                            // shadow-assign the setting
+        if (((baudRateError8 < 0) ? -baudRateError8 : baudRateError8) < ((*usartBaudRateError < 0) ? -*usartBaudRateError : *usartBaudRateError))
+          {
+          oversampling8 = true;
+          }
+        }
+      }
 
-        ApvUartControlBlock_p->UART_MR = targetRegister;                                            // assign the actual setting
+    if (oversampling8 == true)
+      {
+      usartErrorCode       = usartErrorCode8;
+      baudRateDivisor      = baudRateDivisor8;
+      baudRateFraction     = baudRateFraction8;
+      *usartBaudRateActual = baudRateActual8;
+      *usartBaudRateError  = baudRateError8;
+      }
 
-        // Compute the baud-rate generator register setting
-        targetRegister = APV_EVENT_TIMER_TIMEBASE_BASECLOCK / APV_UART_MCK_FIXED_DIVIDE_16; // MCK / 16 ALWAYS!
+    if (usartErrorCode == APV_ERROR_CODE_NONE)
+      {
+      if ((*usartBaudRateError > APV_UART_BAUD_RATE_ERROR_LIMIT_PPM) || (*usartBaudRateError < (-APV_UART_BAUD_RATE_ERROR_LIMIT_PPM)))
+        {
+        usartErrorCode = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+        }
+      else
+        {
+        usartModeRegister = usartControlBlock->US_MR & (~US_MR_OVER);
 
-        targetRegister = targetRegister / (APV_UART_BAUD_RATE_9600 * ((uint32_t)(uartBaudRate + APV_UART_BAUD_RATE_SELECT_19200)));
+        if (oversampling8 == true)
+          {
+          usartModeRegister = usartModeRegister | US_MR_OVER;
+          }
 
-        ApvUartControlBlock.UART_BRGR    = targetRegister;
-        ApvUartControlBlock_p->UART_BRGR = targetRegister;
+        APV_REGISTER_COMMAND(usartControlBlock, US_MR,   usartModeRegister);
+        APV_REGISTER_COMMAND(usartControlBlock, US_BRGR, US_BRGR_CD(baudRateDivisor) | US_BRGR_FP(baudRateFraction));
         }
       }
     }
 
 /******************************************************************************/
 
-  return(uartErrorCode);
+  return(usartErrorCode);
 
 /******************************************************************************/
-  } /* end of apvConfigureUart                                                */
+  } /* end of apvUsartSetBaudRate                                             */
 
 /******************************************************************************/
 /* apvControlUart() :                                                         */
@@ -481,23 +786,19 @@ APV_ERROR_CODE apvControlUart(apvUartControlAction_t uartControlAction)
     switch(uartControlAction)
       {
       case APV_UART_CONTROL_ACTION_RESET :        targetRegister                 = UART_CR_RSTRX | UART_CR_RSTTX; // duplex RESET
-                                                  ApvUartControlBlock.UART_CR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_CR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_CR, targetRegister);
                                                   break;
 
       case APV_UART_CONTROL_ACTION_ENABLE :       targetRegister                 = UART_CR_RXEN | UART_CR_TXEN;   // duplex ENABLE
-                                                  ApvUartControlBlock.UART_CR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_CR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_CR, targetRegister);
                                                   break;
 
       case APV_UART_CONTROL_ACTION_DISABLE :      targetRegister                 = UART_CR_RXDIS | UART_CR_TXDIS; // duplex DISABLE
-                                                  ApvUartControlBlock.UART_CR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_CR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_CR, targetRegister);
                                                   break;
 
       case APV_UART_CONTROL_ACTION_RESET_STATUS : targetRegister                 = UART_CR_RSTSTA;                // duplex RESET STATUS
-                                                  ApvUartControlBlock.UART_CR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_CR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_CR, targetRegister);
                                                   break;
 
       default                                   : uartErrorCode = APV_ERROR_CODE_MESSAGE_DEFINITION_ERROR;
@@ -541,8 +842,7 @@ APV_ERROR_CODE apvUartCharacterTransmit(uint8_t transmitBuffer)
 
   if ((statusRegister & UART_SR_TXEMPTY) && (statusRegister & UART_SR_TXRDY))
     {
-    ApvUartControlBlock_p->UART_THR = transmitBuffer;
-    ApvUartControlBlock.UART_THR    = transmitBuffer;
+    APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_THR, transmitBuffer);
     }
   else
     {
@@ -596,11 +896,10 @@ APV_ERROR_CODE apvUartCharacterTransmitPrime(Uart     *uartControlBlock,
     if ((statusRegister & UART_SR_TXEMPTY) && (statusRegister & UART_SR_TXRDY))
       {
       // Switch on the Tx interrupt
-      uartControlBlock->UART_IER = UART_IER_TXRDY;
+      APV_REGISTER_COMMAND(uartControlBlock, UART_IER, UART_IER_TXRDY);
 
       // Load the character and leave the rest to the ISR
-      uartControlBlock->UART_THR    = transmitBuffer;
-      ApvUartControlBlock.UART_THR  = transmitBuffer; // shadow
+      APV_REGISTER_WRITE(uartControlBlock, ApvUartControlBlock, UART_THR, transmitBuffer);
       }
     else
       {
@@ -620,6 +919,62 @@ APV_ERROR_CODE apvUartCharacterTransmitPrime(Uart     *uartControlBlock,
 /******************************************************************************/
   } /* end of apvUartCharacterTransmitPrime                                   */
 
+/******************************************************************************/
+/* apvUartFrameTransmitPrime() :                                              */
+/*  --> uartControlBlock    : address of the serial UART hardware definition  */
+/*  --> uartPdcTransmit     : the UARTs' PDC transmit frame queue             */
+/*  --> transmitFrame       : a complete framed message                       */
+/*  --> transmitFrameLength : the frame length in characters                  */
+/*  <-- uartErrorCode       : error codes                                     */
+/*                                                                            */
+/* - queue a whole frame for PDC transmission and switch on the end-of-frame  */
+/*   interrupt that chains the following frames. There is no per-character    */
+/*   interrupt and no wait for the transmitter to go idle                     */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvUartFrameTransmitPrime(Uart                   *uartControlBlock,
+                                         apvSerialPdcTransmit_t *uartPdcTransmit,
+                                         const uint8_t          *transmitFrame,
+                                         uint16_t                transmitFrameLength)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE uartErrorCode = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (uartControlBlock == NULL)
+    {
+    uartErrorCode = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_CRITICAL_REGION_ENTRY();
+
+    uartErrorCode = apvSerialPdcTransmitQueue(uartPdcTransmit,
+                                              transmitFrame,
+                                              transmitFrameLength,
+                                              false);
+
+    if (uartErrorCode == APV_ERROR_CODE_NONE)
+      {
+      // Switching the UART interrupts also stops the PDC transfers
+      APV_REGISTER_COMMAND(uartControlBlock, UART_PTCR, UART_PTCR_TXTEN);
+
+      APV_REGISTER_COMMAND(uartControlBlock, UART_IER, UART_IER_ENDTX);
+      }
+
+    APV_CRITICAL_REGION_EXIT();
+    }
+
+/******************************************************************************/
+
+  return(uartErrorCode);
+
+/******************************************************************************/
+  } /* end of apvUartFrameTransmitPrime                                       */
+
 /******************************************************************************/
 /* apvUartBufferTransmitPrime() :                                             */
 /*  --> uartControlBlock       : physical address of the UART peripheral      */
@@ -654,8 +1009,8 @@ APV_ERROR_CODE apvUartBufferTransmitPrime(Uart             *uartControlBlock,
 
     // Does the transmit buffer liat have a buffer in it and does this buffer have characters in it ?
     if (apvRingBufferUnLoad( uartTransmitBufferList,
-                             APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                            (uint32_t *)uartTransmitBuffer,
+                             APV_RING_BUFFER_TOKEN_TYPE_POINTER,
+                             uartTransmitBuffer,
                              sizeof(uint8_t),
                              false) != 0)
       {
@@ -671,11 +1026,10 @@ APV_ERROR_CODE apvUartBufferTransmitPrime(Uart             *uartControlBlock,
         if ((statusRegister & UART_SR_TXEMPTY) && (statusRegister & UART_SR_TXRDY))
           {
           // Switch on the Tx interrupt
-          uartControlBlock->UART_IER    = UART_IER_TXRDY;
+          APV_REGISTER_COMMAND(uartControlBlock, UART_IER, UART_IER_TXRDY);
 
           // Load the first character and leave the rest to the ISR
-          uartControlBlock->UART_THR    = transmitBuffer;
-          ApvUartControlBlock.UART_THR  = transmitBuffer; // shadow
+          APV_REGISTER_WRITE(uartControlBlock, ApvUartControlBlock, UART_THR, transmitBuffer);
           }
         else
           {
@@ -723,7 +1077,7 @@ APV_ERROR_CODE apvUartCharacterReceive(uint8_t *receiveBuffer)
 
 /******************************************************************************/
 
-  *receiveBuffer = ApvUartControlBlock_p->UART_RHR;
+  *receiveBuffer = APV_REGISTER_READ(ApvUartControlBlock_p, UART_RHR);
 
 /******************************************************************************/
 
@@ -736,7 +1090,8 @@ APV_ERROR_CODE apvUartCharacterReceive(uint8_t *receiveBuffer)
 /* apvUartEnableInterrupt() :                                                 */
 /*  --> apvUartInterruptSelect_t : [ APV_UART_INTERRUPT_SELECT_TRANSMIT |     */
 /*                                   APV_UART_INTERRUPT_SELECT_RECEIVE  |     */
-/*                                   APV_UART_INTERRUPT_SELECT_DUPLEX ]       */
+/*                                   APV_UART_INTERRUPT_SELECT_DUPLEX   |     */
+/*                                   APV_UART_INTERRUPT_SELECT_RECEIVE_PDC ]  */
 /*  --> interruptSwitch          : [ false == DISABLE INTERRUPT |             */
 /*                                   true  == ENABLE  INTERRUPT ]             */
 /*  <-- uartErrorCode            : error codes                                */
@@ -766,12 +1121,12 @@ APV_ERROR_CODE apvUartSwitchInterrupt(apvUartInterruptSelect_t interruptSelect,
     targetRegister = UART_IDR_RXRDY | UART_IDR_TXRDY | UART_IDR_ENDRX   | UART_IDR_ENDTX  | UART_IDR_OVRE | 
                      UART_IDR_FRAME | UART_IDR_PARE  | UART_IDR_TXEMPTY | UART_IDR_TXBUFE | UART_IDR_RXBUFF;
 
-    ApvUartControlBlock_p->UART_IDR = targetRegister;
+    APV_REGISTER_COMMAND(ApvUartControlBlock_p, UART_IDR, targetRegister);
 
     // Disable all PDC UART transfers
     targetRegister = UART_PTCR_TXTDIS | UART_PTCR_RXTDIS;
 
-    ApvUartControlBlock_p->UART_PTCR = targetRegister;
+    APV_REGISTER_COMMAND(ApvUartControlBlock_p, UART_PTCR, targetRegister);
 
     switch(interruptSelect)
       {
@@ -779,47 +1134,57 @@ APV_ERROR_CODE apvUartSwitchInterrupt(apvUartInterruptSelect_t interruptSelect,
 
                                                 if (interruptSwitch == true)
                                                   {
-                                                  ApvUartControlBlock.UART_IER    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IER = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IER, targetRegister);
                                                   }
                                                 else
                                                   {
-                                                  ApvUartControlBlock.UART_IDR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IDR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IDR, targetRegister);
                                                   }
 
                                                 break;
 
-      case APV_UART_INTERRUPT_SELECT_RECEIVE  : targetRegister                    = UART_IER_RXRDY;
+      case APV_UART_INTERRUPT_SELECT_RECEIVE  : targetRegister                    = UART_IER_RXRDY | UART_IER_OVRE | UART_IER_FRAME | UART_IER_PARE;
 
                                                 if (interruptSwitch == true)
                                                   {
-                                                  ApvUartControlBlock.UART_IER    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IER = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IER, targetRegister);
                                                   }
                                                 else
                                                   {
-                                                  ApvUartControlBlock.UART_IDR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IDR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IDR, targetRegister);
                                                   }
 
                                                 break;
 
-      case APV_UART_INTERRUPT_SELECT_DUPLEX   : targetRegister                    = UART_IER_TXRDY | UART_IER_RXRDY;
+      case APV_UART_INTERRUPT_SELECT_DUPLEX   : targetRegister                    = UART_IER_TXRDY | UART_IER_RXRDY | UART_IER_OVRE | UART_IER_FRAME | UART_IER_PARE;
 
                                                 if (interruptSwitch == true)
                                                   {
-                                                  ApvUartControlBlock.UART_IER    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IER = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IER, targetRegister);
                                                   }
                                                 else
                                                   {
-                                                  ApvUartControlBlock.UART_IDR    = targetRegister;
-                                                  ApvUartControlBlock_p->UART_IDR = targetRegister;
+                                                  APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IDR, targetRegister);
                                                   }
 
                                                 break;
 
+      case APV_UART_INTERRUPT_SELECT_RECEIVE_PDC : targetRegister                    = UART_IER_ENDRX | UART_IER_RXBUFF | UART_IER_OVRE | UART_IER_FRAME | UART_IER_PARE;
+
+                                                   if (interruptSwitch == true)
+                                                     {
+                                                     APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IER, targetRegister);
+
+                                                     // The PDC receive blocks MUST already be loaded
+                                                     APV_REGISTER_COMMAND(ApvUartControlBlock_p, UART_PTCR, UART_PTCR_RXTEN);
+                                                     }
+                                                   else
+                                                     {
+                                                     APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IDR, targetRegister);
+                                                     }
+
+                                                   break;
+
       default                                 : uartErrorCode = APV_ERROR_CODE_MESSAGE_DEFINITION_ERROR;
                                                 break;
       }
@@ -882,7 +1247,8 @@ APV_ERROR_CODE apvGetInterruptPriority(int16_t  interruptSourceNumber,
 /*  -->  interruptSourceNumber     : APV_SYSTEM_INTERRUPT_ID_NMI              */
 /*                                   { interrupt } APV_PERIPHERAL_IDS         */
 /*  -->  interruptPriority         : [ 0 .. 15 ]                              */
-/*  <--> deviceInterruptPriorities : record of device interrupt priorities    */
+/*  <--> deviceInterruptPriorities : record of device interrupt priorities or */
+/*                                   NULL if none is kept                     */
 /*  <-- priorityError              : error codes                              */
 /*                                                                            */
 /* - set the priority level for an interrupt source, including the CM3 core   */
@@ -917,17 +1283,21 @@ APV_ERROR_CODE apvSetInterruptPriority(int16_t                      interruptSou
                      interruptPriority);
 
     /******************************************************************************/
-    /* Device interrupt priorities are recorded locally                           */
+    /* Device interrupt priorities are recorded locally in debug builds only -    */
+    /* the NVIC itself is the authoritative copy                                  */
     /******************************************************************************/
 
-    interruptPriorityOffset = (interruptSourceNumber + (-APV_SYSTEM_INTERRUPT_ID_MEMORY_MANAGEMENT_FAULT)) / APV_DEVICE_INTERRUPT_PRIORITIES;
-    interruptPriorityPack   = (interruptSourceNumber + (-APV_SYSTEM_INTERRUPT_ID_MEMORY_MANAGEMENT_FAULT)) % APV_DEVICE_INTERRUPT_PRIORITIES;
+    if (deviceInterruptPriorities != NULL)
+      {
+      interruptPriorityOffset = (interruptSourceNumber + (-APV_SYSTEM_INTERRUPT_ID_MEMORY_MANAGEMENT_FAULT)) / APV_DEVICE_INTERRUPT_PRIORITIES;
+      interruptPriorityPack   = (interruptSourceNumber + (-APV_SYSTEM_INTERRUPT_ID_MEMORY_MANAGEMENT_FAULT)) % APV_DEVICE_INTERRUPT_PRIORITIES;
     
-    (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities = 
-          (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities & ((uint32_t)(~(SAM3A_INTERRUPT_PRIORITY_LEVEL_MASK << (interruptPriorityPack * SAM3A_INTERRUPT_PRIORITY_LEVEL_BITS))));
+      (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities = 
+            (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities & ((uint32_t)(~(SAM3A_INTERRUPT_PRIORITY_LEVEL_MASK << (interruptPriorityPack * SAM3A_INTERRUPT_PRIORITY_LEVEL_BITS))));
 
-    (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities = 
-          (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities | ((uint32_t)(interruptPriority << (interruptPriorityPack * SAM3A_INTERRUPT_PRIORITY_LEVEL_BITS)));
+      (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities = 
+            (deviceInterruptPriorities + interruptPriorityOffset)->deviceInterruptPriorities | ((uint32_t)(interruptPriority << (interruptPriorityPack * SAM3A_INTERRUPT_PRIORITY_LEVEL_BITS)));
+      }
 
     /******************************************************************************/
     }
@@ -29,8 +29,23 @@
 
 // The UART minimum baud rate for this project is defined here as 9600
 #define APV_UART_BAUD_RATE_9600                ((uint32_t)9600)
+// The primary serial link always signs on at 19200 and is negotiated up from there
+#define APV_UART_BAUD_RATE_19200               ((uint32_t)19200)
+#define APV_UART_BAUD_RATE_SIGN_ON             APV_UART_BAUD_RATE_19200
 // The UART always divides MCK by 16
 #define APV_UART_MCK_FIXED_DIVIDE_16           ((uint32_t)16)
+// The USARTs can also divide MCK by 8 and add a fractional divisor in 1/8ths
+#define APV_USART_MCK_DIVIDE_8                 ((uint32_t)8)
+#define APV_USART_FRACTIONAL_DIVISOR_STEPS     ((uint32_t)8)
+#define APV_UART_NO_FRACTIONAL_DIVISOR_STEPS   ((uint32_t)1)
+
+#define APV_UART_BAUD_RATE_DIVISOR_MINIMUM     ((uint32_t)1)
+#define APV_UART_BAUD_RATE_DIVISOR_MAXIMUM     ((uint32_t)65535)
+
+// Baud rate errors are reported in parts-per-million. Each end of an asynchronous
+// link can be about 2% adrift before the last bit of a character is mis-sampled
+#define APV_UART_BAUD_RATE_ERROR_SCALE_PPM     ((int64_t)1000000)
+#define APV_UART_BAUD_RATE_ERROR_LIMIT_PPM     ((int32_t)20000)
 
 /******************************************************************************/
 /* SAM3A Interrupt Priority Levels 0 { .. } 15 :                              */
@@ -50,6 +65,13 @@
 
 #define APV_DEVICE_INTERRUPT_PRIORITY_RANGE     ((-(APV_SYSTEM_INTERRUPT_ID_MEMORY_MANAGEMENT_FAULT)) + APV_PERIPHERAL_IDS)   // -( -12 ) + 45  == 57 : 08.07.18
 #define APV_DEVICE_INTERRUPT_PRIORITIES_PACKED  ((APV_DEVICE_INTERRUPT_PRIORITY_RANGE / APV_DEVICE_INTERRUPT_PRIORITIES) + 1) // ( 57 / 4 ) + 1 == 15 : 08.07.18
+
+// The local record of interrupt priorities is only kept in debug builds
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
+#define APV_DEVICE_INTERRUPT_PRIORITY_RECORD    (&apvInterruptPriorities[0])
+#else
+#define APV_DEVICE_INTERRUPT_PRIORITY_RECORD    ((apvInterruptPriorityLevel_t *)NULL)
+#endif
  
 /******************************************************************************/
 /*                *** PROCESS INTERRUPT PRIORITY LEVELS ***                   */
@@ -151,23 +173,12 @@ typedef enum apvUartChannelMode_tTag
   APV_UART_CHANNEL_MODE_SET
   } apvUartChannelMode_t;
 
-typedef enum apvUartBaudRateSelection_tTag
-  {
-  APV_UART_BAUD_RATE_SELECT_9600 = 0,
-  APV_UART_BAUD_RATE_SELECT_19200,
-  APV_UART_BAUD_RATE_SELECT_38400,
-  APV_UART_BAUD_RATE_SELECT_57600,
-  APV_UART_BAUD_RATE_SELECT_76800,
-  APV_UART_BAUD_RATE_SELECT_96000,
-  APV_UART_BAUD_RATE_SELECT_152000,
-  APV_UART_BAUD_RATE_SELECT_SET
-  } apvUartBaudRateSelection_t;
-
 typedef enum apvUartInterruptSelect_tTag
   {
   APV_UART_INTERRUPT_SELECT_TRANSMIT = 0,
   APV_UART_INTERRUPT_SELECT_RECEIVE,
   APV_UART_INTERRUPT_SELECT_DUPLEX,
+  APV_UART_INTERRUPT_SELECT_RECEIVE_PDC, // PDC end-of-block receive, the PDC receive transfer is re-enabled
   APV_UART_INTERRUPT_SELECT_SET
   } apvUartInterruptSelect_t;
 
@@ -352,16 +363,16 @@ typedef enum apvSPIBaudRateSelectors_tTag
 /* Global Variable Definitions :                                              */
 /******************************************************************************/
 
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
 extern          Pmc                          ApvPeripheralControlBlock;                                      // shadow peripheral control block
-extern          Pmc                         *ApvPeripheralControlBlock_p;                                    // physical block address
-
 extern          Uart                         ApvUartControlBlock;                                            // shadow UART control block
-extern volatile Uart                        *ApvUartControlBlock_p;                                          // physical block address
-
 extern          Spi                          ApvSpi0ControlBlock;                                            // Shadow SPI control block
-extern          Spi                         *ApvSpi0ControlBlock_p;
-
 extern          apvInterruptPriorityLevel_t  apvInterruptPriorities[APV_DEVICE_INTERRUPT_PRIORITIES_PACKED]; // shadow device interrupt priorities
+#endif
+
+extern          Pmc                         *ApvPeripheralControlBlock_p;                                    // physical block address
+extern volatile Uart                        *ApvUartControlBlock_p;                                          // physical block address
+extern          Spi                         *ApvSpi0ControlBlock_p;                                          // physical block address
 
 /******************************************************************************/
 /* Function Declarations :                                                    */
@@ -373,9 +384,26 @@ extern APV_ERROR_CODE apvSwitchPeripheralLines(apvPeripheralId_t peripheralLineI
                                                bool              peripheralLineSwitch);
 extern APV_ERROR_CODE apvSwitchNvicDeviceIrq(apvPeripheralId_t peripheralIrqId,
                                              bool              peripheralIrqSwitch);
-extern APV_ERROR_CODE apvConfigureUart(apvUartParity_t            uartParity,
-                                       apvUartChannelMode_t       uartChannelMode,
-                                       apvUartBaudRateSelection_t uartBaudRate);
+extern APV_ERROR_CODE apvConfigureUart(apvUartParity_t       uartParity,
+                                       apvUartChannelMode_t  uartChannelMode,
+                                       uint32_t              uartBaudRate,
+                                       uint32_t             *uartBaudRateActual,
+                                       int32_t              *uartBaudRateError);
+extern APV_ERROR_CODE apvUartBaudRateDivisor(uint32_t  masterClock,
+                                             uint32_t  baudRate,
+                                             uint32_t  clockOversampling,
+                                             uint32_t  fractionalSteps,
+                                             uint16_t *baudRateDivisor,
+                                             uint8_t  *baudRateFraction,
+                                             uint32_t *baudRateActual,
+                                             int32_t  *baudRateError);
+extern APV_ERROR_CODE apvUartSetBaudRate(uint32_t  uartBaudRate,
+                                         uint32_t *uartBaudRateActual,
+                                         int32_t  *uartBaudRateError);
+extern APV_ERROR_CODE apvUsartSetBaudRate(Usart    *usartControlBlock,
+                                          uint32_t  usartBaudRate,
+                                          uint32_t *usartBaudRateActual,
+                                          int32_t  *usartBaudRateError);
 extern APV_ERROR_CODE apvControlUart(apvUartControlAction_t uartControlAction);
 extern APV_ERROR_CODE apvUartCharacterTransmit(uint8_t transmitBuffer);
 extern APV_ERROR_CODE apvUartCharacterReceive(uint8_t *receiveBuffer);
@@ -410,7 +438,7 @@ extern APV_ERROR_CODE apvSPISwitchInterrupt(Spi                     *spiControlB
                                             apvSPIInterruptSelect_t  interruptSelect,
                                             bool                     interruptSwitch);
 extern APV_ERROR_CODE apvSetChipSelectCharacteristics(Spi                                    *spiControlBlock_p,
-                                                      uint8_t                                 chipSelectRegisterNumber,
+                                                      apvChipSelectRegisterInstance_t         chipSelectRegisterNumber,
                                                       apvSPISerialClockPolarity_t             serialClockPolarity,
                                                       apvSPISerialClockPhase_t                serialClockDataChange,
                                                       apvSPIChipSelectBehaviourSingleSlave_t  chipSelectSingleSlave,
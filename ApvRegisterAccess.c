@@ -0,0 +1,177 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvRegisterAccess.c                                                        */
+/* 15.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - debug-build register shadowing and write log. Nothing here is compiled   */
+/*   unless "_APV_DEBUG_REGISTER_SHADOWS_" is defined                         */
+/*                                                                            */
+/******************************************************************************/
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sam3x8e.h>
+#include "ApvRegisterAccess.h"
+
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
+
+/******************************************************************************/
+/* Global Variable Definitions :                                              */
+/******************************************************************************/
+
+apvRegisterWriteLog_t apvRegisterWriteLog;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void apvRegisterWriteLogAppend(volatile uint32_t *registerAddress,
+                                               uint32_t  registerValue);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvRegisterWriteShadowed() :                                               */
+/*  --> registerAddress  : physical peripheral register                       */
+/*  --> shadowAddress    : matching register in the RAM shadow block          */
+/*  --> registerValue    : value to write                                     */
+/*  --> shadowAccumulate : [ false == shadow takes the value |                */
+/*                           true  == shadow ORs in the value ]               */
+/*                                                                            */
+/* - write a peripheral register, shadow it and log the write. Runs with      */
+/*   interrupts masked so ISR and background writes are logged in the order   */
+/*   they reached the peripheral                                              */
+/*                                                                            */
+/******************************************************************************/
+
+void apvRegisterWriteShadowed(volatile uint32_t *registerAddress,
+                              volatile uint32_t *shadowAddress,
+                                       uint32_t  registerValue,
+                                       bool      shadowAccumulate)
+  {
+/******************************************************************************/
+
+  uint32_t interruptMask = 0;
+
+/******************************************************************************/
+
+  interruptMask = __get_PRIMASK();
+
+  __disable_irq();
+
+#ifdef APV_HOST_SIMULATION
+  apvHostRegisterWrite(registerAddress,
+                       registerValue);
+#else
+  *registerAddress = registerValue;
+#endif
+
+  if (shadowAccumulate == true)
+    {
+    *shadowAddress = *shadowAddress | registerValue;
+    }
+  else
+    {
+    *shadowAddress = registerValue;
+    }
+
+  apvRegisterWriteLogAppend(registerAddress,
+                            registerValue);
+
+  // Only re-enable if the caller was not already masked
+  if (interruptMask == 0)
+    {
+    __enable_irq();
+    }
+
+/******************************************************************************/
+  } /* end of apvRegisterWriteShadowed                                        */
+
+/******************************************************************************/
+/* apvRegisterWriteLogged() :                                                 */
+/*  --> registerAddress : physical peripheral command register                */
+/*  --> registerSize    : the register's width in bytes                       */
+/*  --> registerValue   : value to write                                      */
+/*                                                                            */
+/* - write a command register that has no shadow and log the write in order   */
+/*   with the shadowed ones. Host builds model the PDC registers at pointer   */
+/*   width so the store is made at the register's own width and the log keeps */
+/*   the low word                                                             */
+/*                                                                            */
+/******************************************************************************/
+
+void apvRegisterWriteLogged(volatile void     *registerAddress,
+                                     uint32_t  registerSize,
+                                     uintptr_t registerValue)
+  {
+/******************************************************************************/
+
+  uint32_t interruptMask = 0;
+
+/******************************************************************************/
+
+  interruptMask = __get_PRIMASK();
+
+  __disable_irq();
+
+  if (registerSize == sizeof(uint32_t))
+    {
+    *((volatile uint32_t *)registerAddress) = (uint32_t)registerValue;
+    }
+  else
+    {
+    *((volatile uintptr_t *)registerAddress) = registerValue;
+    }
+
+#ifdef APV_HOST_SIMULATION
+  apvHostUpdate();
+#endif
+
+  apvRegisterWriteLogAppend((volatile uint32_t *)registerAddress,
+                            (uint32_t)registerValue);
+
+  if (interruptMask == 0)
+    {
+    __enable_irq();
+    }
+
+/******************************************************************************/
+  } /* end of apvRegisterWriteLogged                                          */
+
+/******************************************************************************/
+/* apvRegisterWriteLogAppend() :                                              */
+/*  --> registerAddress : the register written                                */
+/*  --> registerValue   : the value written                                   */
+/*                                                                            */
+/* - MUST be called with interrupts masked : append a write to the log        */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvRegisterWriteLogAppend(volatile uint32_t *registerAddress,
+                                               uint32_t  registerValue)
+  {
+/******************************************************************************/
+
+  apvRegisterWriteLog.registerWrites[apvRegisterWriteLog.registerWriteIndex].registerAddress = registerAddress;
+  apvRegisterWriteLog.registerWrites[apvRegisterWriteLog.registerWriteIndex].registerValue   = registerValue;
+
+  apvRegisterWriteLog.registerWriteIndex = (apvRegisterWriteLog.registerWriteIndex + 1) % APV_REGISTER_WRITE_LOG_LENGTH;
+  apvRegisterWriteLog.registerWriteCount = apvRegisterWriteLog.registerWriteCount + 1;
+
+/******************************************************************************/
+  } /* end of apvRegisterWriteLogAppend                                       */
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
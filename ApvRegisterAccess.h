@@ -0,0 +1,176 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvRegisterAccess.h                                                        */
+/* 15.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - peripheral register write access. Release builds compile every write     */
+/*   down to the single volatile store. Debug builds (with                    */
+/*   "_APV_DEBUG_REGISTER_SHADOWS_" defined) also copy the value into the RAM */
+/*   shadow of the peripheral block and append it to a circular write log so  */
+/*   the sequence of writes leading up to a fault can be inspected            */
+/* - host builds ("APV_HOST_SIMULATION" defined) pass every write, and every  */
+/*   read with a side-effect ('APV_REGISTER_READ'), to the simulated HAL so   */
+/*   the peripheral models see the access at the point it is made             */
+/* - 'APV_REGISTER_COMMAND' writes a command register that has no shadow      */
+/*   (the PDC "PTCR", "IDR"s, "CR"s) : back-to-back commands must each reach  */
+/*   the model. Debug builds log commands with the other writes. The PDC      */
+/*   pointer and counter registers are written the same way (the PDC moves    */
+/*   them itself so a shadow would mislead) as are the timer-counter and RTT  */
+/*   registers, which have no RAM shadow block                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_REGISTER_ACCESS_H_
+#define _APV_REGISTER_ACCESS_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef APV_HOST_SIMULATION
+#include "ApvHostHal.h"
+#endif
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#if defined(_APV_DEBUG_REGISTER_SHADOWS_)
+
+/******************************************************************************/
+/* Write the register, copy the value into the shadow block and log it. Host  */
+/* builds pass the write on to the simulated HAL from the shadowing function  */
+/******************************************************************************/
+
+#define APV_REGISTER_WRITE(registerBlock_p, shadowBlock, registerName, registerValue)            \
+  apvRegisterWriteShadowed(&((registerBlock_p)->registerName),                                   \
+                           &((shadowBlock).registerName),                                        \
+                           (uint32_t)(registerValue),                                            \
+                           false)
+
+/******************************************************************************/
+/* As above for "write-1-to-set" registers : the shadow accumulates the bits  */
+/******************************************************************************/
+
+#define APV_REGISTER_WRITE_ACCUMULATE(registerBlock_p, shadowBlock, registerName, registerValue) \
+  apvRegisterWriteShadowed(&((registerBlock_p)->registerName),                                   \
+                           &((shadowBlock).registerName),                                        \
+                           (uint32_t)(registerValue),                                            \
+                           true)
+
+/******************************************************************************/
+/* Reads are not logged. Status and receive holding registers change state    */
+/* when read so they are read through here for the host build's benefit       */
+/******************************************************************************/
+
+#if defined(APV_HOST_SIMULATION)
+#define APV_REGISTER_READ(registerBlock_p, registerName)                                         \
+  apvHostRegisterRead(&((registerBlock_p)->registerName))
+#else
+#define APV_REGISTER_READ(registerBlock_p, registerName)                                         \
+  ((registerBlock_p)->registerName)
+#endif
+
+/******************************************************************************/
+/* Commands have no shadow but are logged with the other writes               */
+/******************************************************************************/
+
+#define APV_REGISTER_COMMAND(registerBlock_p, registerName, registerValue)                       \
+  apvRegisterWriteLogged(&((registerBlock_p)->registerName),                                     \
+                         sizeof((registerBlock_p)->registerName),                                \
+                         (uintptr_t)(registerValue))
+
+#elif defined(APV_HOST_SIMULATION)
+
+/******************************************************************************/
+/* HOST ONLY : the simulated HAL makes the store and runs the peripheral      */
+/* model behind the register                                                  */
+/******************************************************************************/
+
+#define APV_REGISTER_WRITE(registerBlock_p, shadowBlock, registerName, registerValue)            \
+  apvHostRegisterWrite(&((registerBlock_p)->registerName),                                       \
+                       (uint32_t)(registerValue))
+
+#define APV_REGISTER_WRITE_ACCUMULATE(registerBlock_p, shadowBlock, registerName, registerValue) \
+  apvHostRegisterWrite(&((registerBlock_p)->registerName),                                       \
+                       (uint32_t)(registerValue))
+
+#define APV_REGISTER_READ(registerBlock_p, registerName)                                         \
+  apvHostRegisterRead(&((registerBlock_p)->registerName))
+
+#define APV_REGISTER_COMMAND(registerBlock_p, registerName, registerValue)                       \
+  (((registerBlock_p)->registerName = (registerValue)), apvHostUpdate())
+
+#else
+
+#define APV_REGISTER_WRITE(registerBlock_p, shadowBlock, registerName, registerValue)            \
+  ((registerBlock_p)->registerName = (registerValue))
+
+#define APV_REGISTER_WRITE_ACCUMULATE(registerBlock_p, shadowBlock, registerName, registerValue) \
+  ((registerBlock_p)->registerName = (registerValue))
+
+#define APV_REGISTER_READ(registerBlock_p, registerName)                                         \
+  ((registerBlock_p)->registerName)
+
+#define APV_REGISTER_COMMAND(registerBlock_p, registerName, registerValue)                       \
+  ((registerBlock_p)->registerName = (registerValue))
+
+#endif
+
+#define APV_REGISTER_WRITE_LOG_LENGTH (128) // most recent register writes kept
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
+
+typedef struct apvRegisterWriteLogEntry_tTag
+  {
+  volatile uint32_t *registerAddress;
+           uint32_t  registerValue;
+  } apvRegisterWriteLogEntry_t;
+
+typedef struct apvRegisterWriteLog_tTag
+  {
+  apvRegisterWriteLogEntry_t registerWrites[APV_REGISTER_WRITE_LOG_LENGTH];
+  uint32_t                   registerWriteIndex; // next entry to be written
+  uint32_t                   registerWriteCount; // total writes since reset
+  } apvRegisterWriteLog_t;
+
+#endif
+
+/******************************************************************************/
+/* Global Variable Declarations :                                             */
+/******************************************************************************/
+
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
+extern apvRegisterWriteLog_t apvRegisterWriteLog;
+#endif
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
+extern void apvRegisterWriteShadowed(volatile uint32_t *registerAddress,
+                                     volatile uint32_t *shadowAddress,
+                                              uint32_t  registerValue,
+                                              bool      shadowAccumulate);
+extern void apvRegisterWriteLogged(volatile void     *registerAddress,
+                                            uint32_t  registerSize,
+                                            uintptr_t registerValue);
+#endif
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
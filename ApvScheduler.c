@@ -0,0 +1,765 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvScheduler.c                                                             */
+/* 19.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - the cooperative periodic task scheduler. Everything here runs from the   */
+/*   main loop (the wake timers' callback is deferred to the main loop too)   */
+/*   so nothing is shared with an interrupt                                   */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ApvError.h"
+#include "ApvEventTimers.h"
+#include "ApvMessageHandling.h"
+#include "ApvControlPortProtocol.h"
+#include "ApvScheduler.h"
+
+/******************************************************************************/
+/* Global Variable Definitions :                                              */
+/******************************************************************************/
+
+apvScheduler_t apvScheduler;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void     apvSchedulerRelease(uint64_t schedulerNow);
+static uint16_t apvSchedulerNext(void);
+static void     apvSchedulerWakeArm(uint64_t schedulerNow);
+static void     apvSchedulerTaskClear(apvSchedulerTask_t *schedulerTask,
+                                      uint64_t            schedulerNow);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvSchedulerInitialise() :                                                 */
+/*  --> coreTimerBlock : the core-timer block the wake timer is taken from    */
+/*  <-- schedulerError : error codes                                          */
+/*                                                                            */
+/* - empty the task table and take the one-shot duration timer that wakes the */
+/*   main loop for the next release. The duration timers must already be      */
+/*   initialised ('apvInitialiseSystemTimer()')                               */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerInitialise(apvCoreTimerBlock_t *coreTimerBlock)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE schedulerError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (coreTimerBlock == NULL)
+    {
+    schedulerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    memset((void *)&apvScheduler, 0, sizeof(apvScheduler_t));
+
+    apvScheduler.schedulerCoreTimerBlock  = coreTimerBlock;
+    apvScheduler.schedulerWakeTimerHandle = APV_DURATION_TIMER_NULL_HANDLE;
+    apvScheduler.schedulerWakeRelease     = APV_SCHEDULER_NO_RELEASE;
+
+    // The first expiry finds nothing to release : from then on it is only set for a release
+    schedulerError = apvAssignDurationTimer( coreTimerBlock,
+                                             apvSchedulerWakeCallBack,
+                                            &apvScheduler,
+                                             APV_DURATION_TIMER_TYPE_ONE_SHOT,
+                                             APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD,
+                                             APV_DURATION_TIMER_SOURCE_SYSTICK,
+                                            &apvScheduler.schedulerWakeTimerHandle);
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerInitialise                                          */
+
+/******************************************************************************/
+/* apvSchedulerTaskAssign() :                                                 */
+/*  --> taskFunction : the task; it must return each time it is run           */
+/*  --> taskContext  : passed to the task (may be NULL)                       */
+/*  --> taskName     : reported with the utilisation (may be NULL)            */
+/*  --> taskPeriod   : microseconds [ APV_SCHEDULER_PERIOD_MINIMUM ..         */
+/*                                    APV_SCHEDULER_PERIOD_MAXIMUM ]          */
+/*  --> taskPriority : [ APV_SCHEDULER_PRIORITY_HIGHEST ..                    */
+/*                       APV_SCHEDULER_PRIORITY_LOWEST ]                      */
+/*  --> taskDeadline : microseconds from the release, no longer than the      */
+/*                     period, or APV_SCHEDULER_DEADLINE_PERIOD               */
+/*  --> taskBudget   : microseconds of execution, no longer than the          */
+/*                     deadline, or APV_SCHEDULER_BUDGET_UNLIMITED            */
+/*  --> taskIndex    : the allocated task or APV_SCHEDULER_NULL_TASK          */
+/*  <-- schedulerError : error codes                                          */
+/*                                                                            */
+/* - register a periodic task. The first release is one period from now       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerTaskAssign(apvSchedulerTaskFunction_t  taskFunction,
+                                      void                       *taskContext,
+                                      const char                 *taskName,
+                                      uint32_t                    taskPeriod,
+                                      uint8_t                     taskPriority,
+                                      uint32_t                    taskDeadline,
+                                      uint32_t                    taskBudget,
+                                      uint16_t                   *taskIndex)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE      schedulerError = APV_ERROR_CODE_NONE;
+  apvSchedulerTask_t *schedulerTask  = NULL;
+  uint64_t            schedulerNow   = 0;
+  uint16_t            task           = 0;
+
+/******************************************************************************/
+
+  if ((taskFunction == NULL) || (taskIndex == NULL))
+    {
+    schedulerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    *taskIndex = APV_SCHEDULER_NULL_TASK;
+
+    if (taskDeadline == APV_SCHEDULER_DEADLINE_PERIOD)
+      {
+      taskDeadline = taskPeriod;
+      }
+
+    if ((taskPeriod   < APV_SCHEDULER_PERIOD_MINIMUM) || (taskPeriod > APV_SCHEDULER_PERIOD_MAXIMUM) ||
+        (taskDeadline > taskPeriod)                   || (taskBudget > taskDeadline))
+      {
+      schedulerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      if (apvScheduler.schedulerCoreTimerBlock == NULL)
+        { // Not initialised : there is nothing to wake the main loop
+        schedulerError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+        }
+      else
+        {
+        while ((task < APV_SCHEDULER_TASKS) && (apvScheduler.schedulerTask[task].taskFunction != NULL))
+          {
+          task = task + 1;
+          }
+
+        if (task == APV_SCHEDULER_TASKS)
+          { // Every task is in use
+          schedulerError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+          }
+        else
+          {
+          schedulerNow  = apvEventTimerTimestamp64();
+          schedulerTask = &apvScheduler.schedulerTask[task];
+
+          memset((void *)schedulerTask, 0, sizeof(apvSchedulerTask_t));
+
+          schedulerTask->taskFunction    = taskFunction;
+          schedulerTask->taskContext     = taskContext;
+          schedulerTask->taskName        = taskName;
+          schedulerTask->taskPeriod      = ((uint64_t)taskPeriod) * APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US;
+          schedulerTask->taskDeadline    = taskDeadline * APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US;
+          schedulerTask->taskBudget      = taskBudget   * APV_EVENT_TIMER_TIMESTAMP_TICKS_PER_US;
+          schedulerTask->taskPriority    = taskPriority;
+          schedulerTask->taskNextRelease = schedulerNow + schedulerTask->taskPeriod;
+
+          apvSchedulerTaskClear(schedulerTask,
+                                schedulerNow);
+
+          apvSchedulerWakeArm(schedulerNow);
+
+          *taskIndex = task;
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerTaskAssign                                          */
+
+/******************************************************************************/
+/* apvSchedulerTaskDeAssign() :                                               */
+/*  --> taskIndex      : the task; set to APV_SCHEDULER_NULL_TASK when freed  */
+/*  <-- schedulerError : error codes                                          */
+/*                                                                            */
+/* - remove a task. A task may remove itself while it runs                    */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerTaskDeAssign(uint16_t *taskIndex)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE schedulerError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (taskIndex == NULL)
+    {
+    schedulerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((*taskIndex >= APV_SCHEDULER_TASKS) || (apvScheduler.schedulerTask[*taskIndex].taskFunction == NULL))
+      {
+      schedulerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      // The wake timer may still be set for this tasks' release : it finds nothing to run
+      memset((void *)&apvScheduler.schedulerTask[*taskIndex], 0, sizeof(apvSchedulerTask_t));
+
+      *taskIndex = APV_SCHEDULER_NULL_TASK;
+      }
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerTaskDeAssign                                        */
+
+/******************************************************************************/
+/* apvSchedulerService() :                                                    */
+/*  <-- schedulerError : error codes                                          */
+/*                                                                            */
+/* - main loop : release every task that is due then run the ready tasks, the */
+/*   most urgent first and the earliest deadline first between equals. The    */
+/*   releases are looked at again after each task so a more urgent task       */
+/*   released meanwhile goes next. At most one run of the task table is made  */
+/*   per call; 'apvSchedulerReady()' says if the main loop must come back     */
+/*   before sleeping. Last of all the wake timer is set for the next release  */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerService(void)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE      schedulerError = APV_ERROR_CODE_NONE;
+  apvSchedulerTask_t *schedulerTask  = NULL;
+  uint64_t            schedulerNow   = 0,
+                      taskStart      = 0,
+                      taskLateness   = 0,
+                      taskResponse   = 0;
+  uint32_t            taskExecution  = 0;
+  uint16_t            task           = APV_SCHEDULER_NULL_TASK,
+                      taskRuns       = 0;
+
+/******************************************************************************/
+
+  if (apvScheduler.schedulerCoreTimerBlock == NULL)
+    {
+    schedulerError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+    }
+  else
+    {
+    schedulerNow = apvEventTimerTimestamp64();
+
+    apvSchedulerRelease(schedulerNow);
+
+    while ((taskRuns < APV_SCHEDULER_TASKS) && ((task = apvSchedulerNext()) != APV_SCHEDULER_NULL_TASK))
+      {
+      schedulerTask            = &apvScheduler.schedulerTask[task];
+      schedulerTask->taskReady = false;
+
+      taskStart = apvEventTimerTimestamp64();
+
+      schedulerTask->taskFunction(schedulerTask->taskContext);
+
+      schedulerNow = apvEventTimerTimestamp64();
+      taskRuns     = taskRuns + 1;
+
+      // The task may have removed itself
+      if (schedulerTask->taskFunction != NULL)
+        {
+        taskExecution = (uint32_t)(schedulerNow - taskStart);
+        taskLateness  = taskStart    - schedulerTask->taskRelease;
+        taskResponse  = schedulerNow - schedulerTask->taskRelease;
+
+        schedulerTask->taskRuns           = schedulerTask->taskRuns + 1;
+        schedulerTask->taskExecutionTotal = schedulerTask->taskExecutionTotal + taskExecution;
+
+        if (taskExecution < schedulerTask->taskExecutionMinimum)
+          {
+          schedulerTask->taskExecutionMinimum = taskExecution;
+          }
+
+        if (taskExecution > schedulerTask->taskExecutionMaximum)
+          {
+          schedulerTask->taskExecutionMaximum = taskExecution;
+          }
+
+        if (taskLateness > schedulerTask->taskLatenessMaximum)
+          {
+          schedulerTask->taskLatenessMaximum = (uint32_t)taskLateness;
+          }
+
+        if (taskResponse > schedulerTask->taskDeadline)
+          {
+          schedulerTask->taskDeadlineMisses = schedulerTask->taskDeadlineMisses + 1;
+          }
+
+        if ((schedulerTask->taskBudget != APV_SCHEDULER_BUDGET_UNLIMITED) && (taskExecution > schedulerTask->taskBudget))
+          {
+          schedulerTask->taskBudgetOverruns = schedulerTask->taskBudgetOverruns + 1;
+          }
+        }
+
+      apvSchedulerRelease(schedulerNow);
+      }
+
+    apvSchedulerWakeArm(schedulerNow);
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerService                                             */
+
+/******************************************************************************/
+/* apvSchedulerReady() :                                                      */
+/*  <-- taskReady : true if any task is released and waiting to run           */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSchedulerReady(void)
+  {
+/******************************************************************************/
+
+  bool     taskReady = false;
+  uint16_t task      = 0;
+
+/******************************************************************************/
+
+  for (task = 0; (task < APV_SCHEDULER_TASKS) && (taskReady == false); task++)
+    {
+    if ((apvScheduler.schedulerTask[task].taskFunction != NULL) && (apvScheduler.schedulerTask[task].taskReady == true))
+      {
+      taskReady = true;
+      }
+    }
+
+/******************************************************************************/
+
+  return(taskReady);
+
+/******************************************************************************/
+  } /* end of apvSchedulerReady                                               */
+
+/******************************************************************************/
+/* apvSchedulerWakeCallBack() :                                               */
+/*  --> schedulerContext : the scheduler ('apvScheduler_t *')                 */
+/*                                                                            */
+/* - the wake timers' duration timer callback, run from the main loop ahead   */
+/*   of 'apvSchedulerService()'. The timer has expired so the next service    */
+/*   must set it again; the tick may have rounded the wait down so the due    */
+/*   releases are left for the service to find                                */
+/*                                                                            */
+/******************************************************************************/
+
+void apvSchedulerWakeCallBack(void *schedulerContext)
+  {
+/******************************************************************************/
+
+  apvScheduler_t *scheduler = (apvScheduler_t *)schedulerContext;
+
+/******************************************************************************/
+
+  if (scheduler != NULL)
+    {
+    scheduler->schedulerWakeRelease = APV_SCHEDULER_NO_RELEASE;
+    }
+
+/******************************************************************************/
+  } /* end of apvSchedulerWakeCallBack                                        */
+
+/******************************************************************************/
+/* apvSchedulerClear() :                                                      */
+/*  --> taskIndex      : the task                                             */
+/*  <-- schedulerError : error codes                                          */
+/*                                                                            */
+/* - clear a tasks' figures and restart its' utilisation measurement          */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerClear(uint16_t taskIndex)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE schedulerError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if ((taskIndex >= APV_SCHEDULER_TASKS) || (apvScheduler.schedulerTask[taskIndex].taskFunction == NULL))
+    {
+    schedulerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    apvSchedulerTaskClear(&apvScheduler.schedulerTask[taskIndex],
+                           apvEventTimerTimestamp64());
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerClear                                               */
+
+/******************************************************************************/
+/* apvSchedulerReport() :                                                     */
+/*  --> taskIndex           : the task                                        */
+/*  --> reportSelect        : [ 'R' == runs | 'O' == overruns |               */
+/*                              'U' == utilisation | 'C' == clear ]           */
+/*  --> report              : the report text buffer                          */
+/*  --> reportMaximumLength : the report text buffer length                   */
+/*  <-- schedulerError      : error codes                                     */
+/*                                                                            */
+/* - format one line of a tasks' figures. All times are timestamp counts. The */
+/*   lines are :                                                              */
+/*     "T<task> R <runs> <minimum>/<mean>/<maximum execution>\r"              */
+/*     "T<task> O <deadline misses> <budget overruns> <releases skipped>      */
+/*      <maximum lateness>\r"                                                 */
+/*     "T<task> U <name> <utilisation in 0.01%>\r"                            */
+/*   and clearing answers "T<task> C\r". Each line fits in a single           */
+/*   (unstuffed) message payload                                              */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSchedulerReport(uint16_t  taskIndex,
+                                  char      reportSelect,
+                                  char     *report,
+                                  uint16_t  reportMaximumLength)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE      schedulerError = APV_ERROR_CODE_NONE;
+  apvSchedulerTask_t *schedulerTask  = NULL;
+  uint64_t            elapsed        = 0,
+                      utilisation    = 0,
+                      mean           = 0;
+  uint32_t            minimum        = 0;
+
+/******************************************************************************/
+
+  if (report == NULL)
+    {
+    schedulerError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((taskIndex           >= APV_SCHEDULER_TASKS) || (apvScheduler.schedulerTask[taskIndex].taskFunction == NULL) ||
+        (reportMaximumLength == 0))
+      {
+      schedulerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      schedulerTask = &apvScheduler.schedulerTask[taskIndex];
+
+      switch(reportSelect)
+        {
+        case APV_SCHEDULER_SELECT_RUN         : if (schedulerTask->taskRuns != 0)
+                                                  {
+                                                  minimum = schedulerTask->taskExecutionMinimum;
+                                                  mean    = schedulerTask->taskExecutionTotal / schedulerTask->taskRuns;
+                                                  }
+
+                                                snprintf(report, reportMaximumLength, "T%u %c %lu %lu/%lu/%lu\r",
+                                                         (unsigned int)taskIndex, reportSelect, (unsigned long)schedulerTask->taskRuns,
+                                                         (unsigned long)minimum, (unsigned long)mean, (unsigned long)schedulerTask->taskExecutionMaximum);
+                                                break;
+
+        case APV_SCHEDULER_SELECT_OVERRUN     : snprintf(report, reportMaximumLength, "T%u %c %lu %lu %lu %lu\r",
+                                                         (unsigned int)taskIndex, reportSelect,
+                                                         (unsigned long)schedulerTask->taskDeadlineMisses,
+                                                         (unsigned long)schedulerTask->taskBudgetOverruns,
+                                                         (unsigned long)schedulerTask->taskReleasesSkipped,
+                                                         (unsigned long)schedulerTask->taskLatenessMaximum);
+                                                break;
+
+        case APV_SCHEDULER_SELECT_UTILISATION : elapsed = apvEventTimerTimestamp64() - schedulerTask->taskStatisticsStart;
+
+                                                if (elapsed != 0)
+                                                  {
+                                                  utilisation = (schedulerTask->taskExecutionTotal * APV_SCHEDULER_UTILISATION_SCALE) / elapsed;
+                                                  }
+
+                                                snprintf(report, reportMaximumLength, "T%u %c %.16s %lu\r",
+                                                         (unsigned int)taskIndex, reportSelect,
+                                                         (schedulerTask->taskName != NULL) ? schedulerTask->taskName : "-",
+                                                         (unsigned long)utilisation);
+                                                break;
+
+        case APV_SCHEDULER_SELECT_CLEAR       : schedulerError = apvSchedulerClear(taskIndex);
+
+                                                snprintf(report, reportMaximumLength, "T%u %c\r", (unsigned int)taskIndex, reportSelect);
+                                                break;
+
+        default                               : schedulerError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+                                                break;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(schedulerError);
+
+/******************************************************************************/
+  } /* end of apvSchedulerReport                                              */
+
+/******************************************************************************/
+/* apvSchedulerAction() :                                                     */
+/*  --> messageAction : the response message buffer, holding a copy of the    */
+/*                      request :                                             */
+/*                        "APV_SCHEDULER <task> [R|O|U|C]"                    */
+/*  <-- : the response message buffer                                         */
+/*                                                                            */
+/* - control protocol action : replace the request payload with one line of   */
+/*   the selected tasks' figures. An unreadable request or a free task        */
+/*   returns an empty payload                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+void *apvSchedulerAction(void *messageAction)
+  {
+/******************************************************************************/
+
+  apvMessageStructure_t *responseMessage = (apvMessageStructure_t *)messageAction;
+
+  uint32_t               taskIndex       = 0;
+  char                   reportSelect    = APV_SCHEDULER_SELECT_RUN;
+  APV_ERROR_CODE         argumentError   = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (responseMessage != NULL)
+    {
+    // The task index is decimal
+    argumentError = apvCommandProtocolDecimalArgument(&responseMessage->apvMessagingPayload[0],
+                                                       responseMessage->apvMessagingLengthOfMessage,
+                                                       (APV_SCHEDULER_TASKS - 1),
+                                                      &taskIndex,
+                                                      &reportSelect);
+
+    responseMessage->apvMessagingPayload[0] = '\0';
+
+    if (argumentError == APV_ERROR_CODE_NONE)
+      {
+      apvSchedulerReport( taskIndex,
+                          reportSelect,
+                         (char *)&responseMessage->apvMessagingPayload[0],
+                          APV_MESSAGING_MAXIMUM_UNSTUFFED_MESSAGE_LENGTH);
+      }
+    }
+
+/******************************************************************************/
+
+  return(messageAction);
+
+/******************************************************************************/
+  } /* end of apvSchedulerAction                                              */
+
+/******************************************************************************/
+/* Static Function Definitions :                                              */
+/******************************************************************************/
+/* apvSchedulerRelease() :                                                    */
+/*  --> schedulerNow : the timestamp now                                      */
+/*                                                                            */
+/* - release every task whose next release has come. If the main loop was     */
+/*   held up for whole periods only the latest release is kept and the rest   */
+/*   are counted as skipped; a task still waiting from its' last release      */
+/*   keeps that release and counts the new one as skipped                     */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvSchedulerRelease(uint64_t schedulerNow)
+  {
+/******************************************************************************/
+
+  apvSchedulerTask_t *schedulerTask = NULL;
+  uint64_t            periodsBehind = 0;
+  uint16_t            task          = 0;
+
+/******************************************************************************/
+
+  for (task = 0; task < APV_SCHEDULER_TASKS; task++)
+    {
+    schedulerTask = &apvScheduler.schedulerTask[task];
+
+    if ((schedulerTask->taskFunction != NULL) && (schedulerNow >= schedulerTask->taskNextRelease))
+      {
+      // Stay on the period grid : only the latest release is run, whole periods missed are skipped
+      if ((schedulerNow - schedulerTask->taskNextRelease) >= schedulerTask->taskPeriod)
+        {
+        periodsBehind = (schedulerNow - schedulerTask->taskNextRelease) / schedulerTask->taskPeriod;
+
+        schedulerTask->taskReleasesSkipped = schedulerTask->taskReleasesSkipped + (uint32_t)periodsBehind;
+        schedulerTask->taskNextRelease     = schedulerTask->taskNextRelease     + (periodsBehind * schedulerTask->taskPeriod);
+        }
+
+      if (schedulerTask->taskReady == true)
+        {
+        schedulerTask->taskReleasesSkipped = schedulerTask->taskReleasesSkipped + 1;
+        }
+      else
+        {
+        schedulerTask->taskReady   = true;
+        schedulerTask->taskRelease = schedulerTask->taskNextRelease;
+        }
+
+      schedulerTask->taskNextRelease = schedulerTask->taskNextRelease + schedulerTask->taskPeriod;
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvSchedulerRelease                                             */
+
+/******************************************************************************/
+/* apvSchedulerNext() :                                                       */
+/*  <-- nextTask : the ready task to run next or APV_SCHEDULER_NULL_TASK      */
+/*                                                                            */
+/* - the most urgent ready task; between equals the earliest deadline         */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvSchedulerNext(void)
+  {
+/******************************************************************************/
+
+  apvSchedulerTask_t *schedulerTask = NULL;
+  uint64_t            nextDeadline  = 0,
+                      taskDeadline  = 0;
+  uint16_t            nextTask      = APV_SCHEDULER_NULL_TASK,
+                      task          = 0;
+
+/******************************************************************************/
+
+  for (task = 0; task < APV_SCHEDULER_TASKS; task++)
+    {
+    schedulerTask = &apvScheduler.schedulerTask[task];
+
+    if ((schedulerTask->taskFunction != NULL) && (schedulerTask->taskReady == true))
+      {
+      taskDeadline = schedulerTask->taskRelease + schedulerTask->taskDeadline;
+
+      if ((nextTask == APV_SCHEDULER_NULL_TASK)                                                   ||
+          (schedulerTask->taskPriority < apvScheduler.schedulerTask[nextTask].taskPriority)       ||
+          ((schedulerTask->taskPriority == apvScheduler.schedulerTask[nextTask].taskPriority) && (taskDeadline < nextDeadline)))
+        {
+        nextTask     = task;
+        nextDeadline = taskDeadline;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(nextTask);
+
+/******************************************************************************/
+  } /* end of apvSchedulerNext                                                */
+
+/******************************************************************************/
+/* apvSchedulerWakeArm() :                                                    */
+/*  --> schedulerNow : the timestamp now                                      */
+/*                                                                            */
+/* - set the wake timer for the earliest release still to come. It is only    */
+/*   touched when that release changes. The wait is rounded up to whole       */
+/*   duration timer ticks so the main loop is not woken before the release    */
+/*   more often than the tick phase makes it unavoidable                      */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvSchedulerWakeArm(uint64_t schedulerNow)
+  {
+/******************************************************************************/
+
+  uint64_t nextRelease = APV_SCHEDULER_NO_RELEASE,
+           wakeDelay   = 0;
+  uint32_t wakeTicks   = 0;
+  uint16_t task        = 0;
+
+/******************************************************************************/
+
+  for (task = 0; task < APV_SCHEDULER_TASKS; task++)
+    {
+    if ((apvScheduler.schedulerTask[task].taskFunction    != NULL) &&
+        (apvScheduler.schedulerTask[task].taskNextRelease  < nextRelease))
+      {
+      nextRelease = apvScheduler.schedulerTask[task].taskNextRelease;
+      }
+    }
+
+  if ((nextRelease != APV_SCHEDULER_NO_RELEASE) && (nextRelease != apvScheduler.schedulerWakeRelease) && (nextRelease > schedulerNow))
+    {
+    // Timestamp counts rounded up to whole duration timer ticks. The wait is never more than a period
+    // ( < 2 ^ 32 counts ) so the division is a 32-bit one by a constant
+    wakeTicks = (((uint32_t)(nextRelease - schedulerNow)) + APV_DURATION_TIMER_TICKLESS_TICK_COUNTS - 1) / APV_DURATION_TIMER_TICKLESS_TICK_COUNTS;
+    wakeDelay = ((uint64_t)wakeTicks) * APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD;
+
+    if (apvReTriggerDurationTimer(apvScheduler.schedulerCoreTimerBlock,
+                                  apvScheduler.schedulerWakeTimerHandle,
+                                  wakeDelay) == APV_ERROR_CODE_NONE)
+      {
+      apvScheduler.schedulerWakeRelease = nextRelease;
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvSchedulerWakeArm                                             */
+
+/******************************************************************************/
+/* apvSchedulerTaskClear() :                                                  */
+/*  --> schedulerTask : the task                                              */
+/*  --> schedulerNow  : the timestamp the utilisation is measured from        */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvSchedulerTaskClear(apvSchedulerTask_t *schedulerTask,
+                                  uint64_t            schedulerNow)
+  {
+/******************************************************************************/
+
+  schedulerTask->taskRuns             = 0;
+  schedulerTask->taskReleasesSkipped  = 0;
+  schedulerTask->taskDeadlineMisses   = 0;
+  schedulerTask->taskBudgetOverruns   = 0;
+  schedulerTask->taskExecutionMinimum = APV_SCHEDULER_MINIMUM_RESET;
+  schedulerTask->taskExecutionMaximum = 0;
+  schedulerTask->taskExecutionTotal   = 0;
+  schedulerTask->taskLatenessMaximum  = 0;
+  schedulerTask->taskStatisticsStart  = schedulerNow;
+
+/******************************************************************************/
+  } /* end of apvSchedulerTaskClear                                           */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,138 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvScheduler.h                                                             */
+/* 19.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - a cooperative scheduler for the main loops' periodic work. A task is a   */
+/*   function and a context registered with a period, a priority, a deadline  */
+/*   and an execution budget; it runs to completion from the main loop. Per-  */
+/*   task figures are reported over the control port by "APV_SCHEDULER"       */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_SCHEDULER_H_
+#define _APV_SCHEDULER_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ApvError.h"
+#include "ApvEventTimers.h"
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+/******************************************************************************/
+/* Releases are kept on the 64-bit timestamp ( MCK/2 : 23.8nsecs ) so periods */
+/* never drift. The main loop is woken for the next release by a one-shot     */
+/* duration timer so a release may be run up to one duration timer tick       */
+/* ( 150usecs ) late; the lateness is recorded. All reported times are in     */
+/* timestamp counts                                                           */
+/******************************************************************************/
+
+#ifndef APV_SCHEDULER_TASKS                                               // the table is sized at build time : no "malloc()"!
+#define APV_SCHEDULER_TASKS                  8
+#endif
+
+#define APV_SCHEDULER_NULL_TASK              ((uint16_t)0xffff)
+#define APV_SCHEDULER_NO_RELEASE             ((uint64_t)~0)
+
+#define APV_SCHEDULER_PRIORITY_HIGHEST       ((uint8_t)0)                   // as the NVIC : the lower the number the more urgent
+#define APV_SCHEDULER_PRIORITY_LOWEST        ((uint8_t)0xff)
+
+#define APV_SCHEDULER_DEADLINE_PERIOD        ((uint32_t)0)                  // the deadline is the next release
+#define APV_SCHEDULER_BUDGET_UNLIMITED       ((uint32_t)0)                  // the execution time is not checked
+
+#define APV_SCHEDULER_PERIOD_MINIMUM         ((uint32_t)100)                // microseconds
+#define APV_SCHEDULER_PERIOD_MAXIMUM         ((uint32_t)100000000)          // microseconds ( 100 seconds )
+
+#define APV_SCHEDULER_UTILISATION_SCALE      ((uint64_t)10000)              // utilisation is reported in 0.01%
+#define APV_SCHEDULER_MINIMUM_RESET          ((uint32_t)0xffffffff)
+
+// Scheduler report selectors (the optional last field of the scheduler command)
+#define APV_SCHEDULER_SELECT_RUN             'R'
+#define APV_SCHEDULER_SELECT_OVERRUN         'O'
+#define APV_SCHEDULER_SELECT_UTILISATION     'U'
+#define APV_SCHEDULER_SELECT_CLEAR           'C'
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef void (*apvSchedulerTaskFunction_t)(void *taskContext);
+
+typedef struct apvSchedulerTask_tTag
+  {
+  apvSchedulerTaskFunction_t  taskFunction;                              // NULL : the table entry is free
+  void                       *taskContext;                               // handed to the function unchanged
+  const char                 *taskName;                                  // reported with the utilisation
+  uint64_t                    taskPeriod;                                // timestamp counts
+  uint32_t                    taskDeadline;                              // release to completion
+  uint32_t                    taskBudget;                                // start to completion or APV_SCHEDULER_BUDGET_UNLIMITED
+  uint8_t                     taskPriority;
+  bool                        taskReady;                                 // released and not yet run
+  uint64_t                    taskRelease;                               // the release waiting to run
+  uint64_t                    taskNextRelease;
+  uint32_t                    taskRuns;
+  uint32_t                    taskReleasesSkipped;                       // released again before the last release ran
+  uint32_t                    taskDeadlineMisses;                        // completed after release + deadline
+  uint32_t                    taskBudgetOverruns;                        // ran for longer than the budget
+  uint32_t                    taskExecutionMinimum;                      // start to completion
+  uint32_t                    taskExecutionMaximum;
+  uint64_t                    taskExecutionTotal;
+  uint32_t                    taskLatenessMaximum;                       // release to start
+  uint64_t                    taskStatisticsStart;                       // the utilisation is measured from here
+  } apvSchedulerTask_t;
+
+typedef struct apvScheduler_tTag
+  {
+  apvSchedulerTask_t        schedulerTask[APV_SCHEDULER_TASKS];
+  apvCoreTimerBlock_t      *schedulerCoreTimerBlock;                     // the duration timers the wake timer comes from
+  apvDurationTimerHandle_t  schedulerWakeTimerHandle;
+  uint64_t                  schedulerWakeRelease;                        // the release the wake timer is set for or APV_SCHEDULER_NO_RELEASE
+  } apvScheduler_t;
+
+/******************************************************************************/
+/* Global Variable Declarations :                                             */
+/******************************************************************************/
+
+extern apvScheduler_t apvScheduler;
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern APV_ERROR_CODE apvSchedulerInitialise(apvCoreTimerBlock_t *coreTimerBlock);
+extern APV_ERROR_CODE apvSchedulerTaskAssign(apvSchedulerTaskFunction_t  taskFunction,
+                                             void                       *taskContext,
+                                             const char                 *taskName,
+                                             uint32_t                    taskPeriod,
+                                             uint8_t                     taskPriority,
+                                             uint32_t                    taskDeadline,
+                                             uint32_t                    taskBudget,
+                                             uint16_t                   *taskIndex);
+extern APV_ERROR_CODE apvSchedulerTaskDeAssign(uint16_t *taskIndex);
+extern APV_ERROR_CODE apvSchedulerService(void);
+extern bool           apvSchedulerReady(void);
+extern void           apvSchedulerWakeCallBack(void *schedulerContext);
+extern APV_ERROR_CODE apvSchedulerClear(uint16_t taskIndex);
+extern APV_ERROR_CODE apvSchedulerReport(uint16_t  taskIndex,
+                                         char      reportSelect,
+                                         char     *report,
+                                         uint16_t  reportMaximumLength);
+extern void          *apvSchedulerAction(void *messageAction);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
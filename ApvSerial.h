@@ -20,6 +20,7 @@
 #include <stdbool.h>
 #include "ApvError.h"
 #include "ApvCommsUtilities.h"
+#include "ApvSerialPdc.h"
 
 /******************************************************************************/
 /* Constant Definitions :                                                     */
@@ -27,6 +28,18 @@
 
 #define APV_SERIAL_BUFFER_MAXIMUM_LENGTH 256 // a simple buffer for 256 x uint8_t
 
+// After a baud rate change the host must be heard from at the new rate within 
+// this many run-time ticks or the link falls back to the last confirmed rate
+#define APV_SERIAL_BAUD_RATE_CONFIRM_TICKS ((uint32_t)2000)
+#define APV_SERIAL_BAUD_RATE_NONE          ((uint32_t)0)
+
+// A full receive ring keeps the frames already waiting and loses the arrivals
+#define APV_SERIAL_RECEIVE_OVERFLOW_POLICY APV_RING_BUFFER_OVERFLOW_DROP_NEWEST
+
+// The most characters each way a serial interrupt handler moves per entry : bounds
+// how long lower-priority interrupts are held off by a continuous stream
+#define APV_SERIAL_INTERRUPT_BATCH_LIMIT   (16)
+
 /******************************************************************************/
 /* Type Definitions :                                                         */
 /******************************************************************************/
@@ -53,6 +66,44 @@ typedef enum apvPrimarySerialPort_tTag
 
 typedef apvPrimarySerialPort_t APV_PRIMARY_SERIAL_PORT;
 
+// Receive one interrupt per character or one interrupt per PDC block
+typedef enum apvSerialReceiveMode_tTag
+  {
+  APV_SERIAL_RECEIVE_MODE_CHARACTER = 0,
+  APV_SERIAL_RECEIVE_MODE_PDC,
+  APV_SERIAL_RECEIVE_MODES
+  } apvSerialReceiveMode_t;
+
+// Transmit one interrupt per character or one interrupt per PDC frame
+typedef enum apvSerialTransmitMode_tTag
+  {
+  APV_SERIAL_TRANSMIT_MODE_CHARACTER = 0,
+  APV_SERIAL_TRANSMIT_MODE_PDC,
+  APV_SERIAL_TRANSMIT_MODES
+  } apvSerialTransmitMode_t;
+
+// The primary serial link signs on at a fixed rate and the host negotiates it 
+// upwards. A new rate is only switched in once the response to the request has 
+// left the transmitter, then held provisionally until the host confirms it
+typedef struct apvSerialBaudRateNegotiation_tTag
+  {
+  uint32_t baudRateConfirmed;       // the last rate the host has been heard at
+  uint32_t baudRateCurrent;         // the rate the baud rate generator is set to
+  uint32_t baudRatePending;         // an accepted rate waiting for the transmitter to drain
+  bool     baudRateConfirming;      // the current rate is provisional
+  uint32_t baudRateConfirmDeadline; // run-time tick the provisional rate must be confirmed by
+  uint16_t baudRateFallBacks;       // provisional rates the host never confirmed
+  } apvSerialBaudRateNegotiation_t;
+
+// Receive errors flagged by the serial hardware; each one marks a gap in the
+// received character stream
+typedef struct apvSerialReceiveErrors_tTag
+  {
+  uint32_t receiveOverruns;         // "OVRE" : a character arrived before the last was read
+  uint32_t receiveFramingErrors;    // "FRAME" : no valid stop bit
+  uint32_t receiveParityErrors;     // "PARE"
+  } apvSerialReceiveErrors_t;
+
 // This is a simplified serial transmit structuer for basic transmission and 
 // testing
 typedef struct apvSerialTransmitBuffer_tTag
@@ -106,6 +157,20 @@ extern apvRingBuffer_t   apvUartPortTransmitBuffer,
 extern apvRingBuffer_t   apvUartPortReceiveBuffer,
                         *apvUartPortPrimaryReceiveRingBuffer_p;
 
+// The primary serial port receive mode and its' PDC receive blocks
+extern apvSerialReceiveMode_t  apvPrimarySerialReceiveMode;
+extern apvSerialPdcReceive_t   apvPrimarySerialPdcReceive;
+
+// The primary serial port transmit mode and its' PDC transmit frame queue
+extern apvSerialTransmitMode_t apvPrimarySerialTransmitMode;
+extern apvSerialPdcTransmit_t  apvPrimarySerialPdcTransmit;
+
+// The primary serial port receive ring overflow handling and hardware errors
+extern apvRingBufferReceiveGuard_t apvPrimarySerialReceiveGuard;
+extern apvSerialReceiveErrors_t    apvPrimarySerialReceiveErrors;
+// The primary serial port baud rate negotiation
+extern apvSerialBaudRateNegotiation_t apvPrimarySerialBaudRate;
+
 /******************************************************************************/
 /* These variables are only intended to implement a simple foreground/back-   */
 /* ground loopback                                                            */
@@ -138,6 +203,19 @@ extern APV_ERROR_CODE        apvUartBufferTransmitPrime(Uart             *uartCo
 extern APV_ERROR_CODE        apvUartCharacterTransmitPrime(Uart     *uartControlBlock,
                                                            uint32_t  transmitBuffer,
                                                            bool      interruptControl);
+extern APV_ERROR_CODE        apvSerialBaudRateInitialise(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                                                         uint32_t                        baudRate);
+extern APV_ERROR_CODE        apvSerialBaudRateRequest(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                                                      uint32_t                        baudRate,
+                                                      uint32_t                       *baudRateActual,
+                                                      int32_t                        *baudRateError);
+extern void                  apvSerialBaudRateConfirm(apvSerialBaudRateNegotiation_t *baudRateNegotiation);
+extern bool                  apvSerialBaudRateService(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                                                      uint32_t                        runTimeTick);
+extern APV_ERROR_CODE        apvUartFrameTransmitPrime(Uart                   *uartControlBlock,
+                                                       apvSerialPdcTransmit_t *uartPdcTransmit,
+                                                       const uint8_t          *transmitFrame,
+                                                       uint16_t                transmitFrameLength);
 
 /******************************************************************************/
 
@@ -0,0 +1,626 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPdc.c                                                             */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - peripheral DMA controller (PDC) driven serial receive :                  */
+/*                                                                            */
+/*   The PDC is given two landing blocks, "current" (RPR/RCR) and "next"      */
+/*   (RNPR/RNCR). When the current block fills the PDC switches to the next   */
+/*   one by itself and raises "ENDRX"; the interrupt then delivers the whole  */
+/*   finished block to the receive ring and hands it back as the new "next"   */
+/*   block. One interrupt per block replaces one interrupt per character.     */
+/*   A part-filled block is delivered by the idle flush when no character has */
+/*   arrived since the previous check (the UART has no receiver time-out)     */
+/*                                                                            */
+/*   Transmit queues whole frames. The PDC sends the "current" frame (TPR/    */
+/*   TCR) and moves straight on to the "next" one (TNPR/TNCR) with no gap;    */
+/*   the "ENDTX" interrupt retires the finished frame and chains another      */
+/*                                                                            */
+/* Reference : "Atmel-11057C-ATARM-SAM3X-SAM3A-Datasheet_23-Mar-15", p502     */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ApvError.h"
+#include "ApvCommsUtilities.h"
+#include "ApvSerialPdc.h"
+#include "ApvRegisterAccess.h"
+#ifndef APV_HOST_SIMULATION
+#include "ApvUtilities.h"
+#endif
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static uint16_t apvSerialPdcReceiveDeliver(apvSerialPdcReceive_t *pdcReceive,
+                                           uint16_t               deliverFrom,
+                                           uint16_t               deliverTo);
+static void     apvSerialPdcTransmitLoad(apvSerialPdcTransmit_t *pdcTransmit);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvSerialPdcReceiveInitialise() :                                          */
+/*  --> pdcReceive        : PDC receive state                                 */
+/*  --> pdcReceiveChannel : the peripherals' PDC register block e.g.          */
+/*                          'PDC_UART'                                        */
+/*  --> pdcReceiveRing    : the ring-buffer delivered characters are loaded   */
+/*                          onto                                              */
+/*  --> pdcReceiveGuard   : the receive ring-buffers' overflow handling       */
+/*  <-- pdcError          : error codes                                       */
+/*                                                                            */
+/* - load both landing blocks into the PDC and start the receive transfer.    */
+/*   The peripherals' "ENDRX" and "RXBUFF" interrupts are enabled separately  */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPdcReceiveInitialise(apvSerialPdcReceive_t       *pdcReceive,
+                                             Pdc                         *pdcReceiveChannel,
+                                             apvRingBuffer_t             *pdcReceiveRing,
+                                             apvRingBufferReceiveGuard_t *pdcReceiveGuard)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE pdcError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if ((pdcReceive == NULL) || (pdcReceiveChannel == NULL) || (pdcReceiveRing == NULL) || (pdcReceiveGuard == NULL))
+    {
+    pdcError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_PTCR, PERIPH_PTCR_RXTDIS);
+
+    pdcReceive->pdcReceiveChannel           = pdcReceiveChannel;
+    pdcReceive->pdcReceiveRing              = pdcReceiveRing;
+    pdcReceive->pdcReceiveGuard             = pdcReceiveGuard;
+    pdcReceive->pdcReceiveActiveBlock       = 0;
+    pdcReceive->pdcReceiveConsumed          = 0;
+    pdcReceive->pdcReceiveBlocksCompleted   = 0;
+    pdcReceive->pdcReceiveIdleFlushes       = 0;
+    pdcReceive->pdcReceiveStalls            = 0;
+    pdcReceive->pdcReceiveCharactersDropped = 0;
+    pdcReceive->pdcReceiveIdlePointer       = (uintptr_t)&pdcReceive->pdcReceiveBlocks[0][0];
+
+    // The pointer registers MUST be written before their counters
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_RPR,  (uintptr_t)&pdcReceive->pdcReceiveBlocks[0][0]);
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_RCR,  APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_RNPR, (uintptr_t)&pdcReceive->pdcReceiveBlocks[1][0]);
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_RNCR, APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+    APV_REGISTER_COMMAND(pdcReceiveChannel, PERIPH_PTCR, PERIPH_PTCR_RXTEN);
+    }
+
+/******************************************************************************/
+
+  return(pdcError);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcReceiveInitialise                                   */
+
+/******************************************************************************/
+/* apvSerialPdcReceiveService() :                                             */
+/*  --> pdcReceive       : PDC receive state                                  */
+/*  --> interruptControl : [ false == called from the peripheral interrupt |  */
+/*                           true  == called from the background loop ]       */
+/*  <-- charactersFound  : [ false == nothing new was delivered |             */
+/*                           true  == characters were delivered to the ring ] */
+/*                                                                            */
+/* - deliver everything the PDC has landed since the last call :              */
+/*   (i)   if the PDC has moved on from the active block, deliver the rest of */
+/*         the active block and hand it back as the "next" block              */
+/*   (ii)  if the PDC has stopped at the end of the active block (both blocks */
+/*         filled before the interrupt was taken) deliver it and restart the  */
+/*         PDC on the other block                                             */
+/*   (iii) otherwise deliver the part of the active block filled so far       */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPdcReceiveService(apvSerialPdcReceive_t *pdcReceive,
+                                bool                   interruptControl)
+  {
+/******************************************************************************/
+
+  bool      charactersFound = false,
+            servicing       = true;
+
+  uintptr_t activeBlock     = 0,
+            receivePointer  = 0,
+            receiveCount    = 0;
+
+  uint8_t   blocksVisited   = 0,
+            fillBlock       = 0;
+
+  uint16_t  delivered       = 0;
+
+/******************************************************************************/
+
+  if ((pdcReceive != NULL) && (pdcReceive->pdcReceiveChannel != NULL))
+    {
+    if (interruptControl == true)
+      {
+      APV_CRITICAL_REGION_ENTRY();
+      }
+
+    // At most both blocks can have completed since the last call
+    while ((servicing == true) && (blocksVisited <= APV_SERIAL_PDC_RECEIVE_BLOCKS))
+      {
+      activeBlock    = (uintptr_t)&pdcReceive->pdcReceiveBlocks[pdcReceive->pdcReceiveActiveBlock][0];
+
+      // A zero count means the PDC has stopped one past the last character it landed
+      receiveCount   = pdcReceive->pdcReceiveChannel->PERIPH_RCR;
+      receivePointer = pdcReceive->pdcReceiveChannel->PERIPH_RPR;
+
+      if (receiveCount == 0)
+        {
+        receivePointer = receivePointer - 1;
+        }
+
+      fillBlock = (uint8_t)((receivePointer - (uintptr_t)&pdcReceive->pdcReceiveBlocks[0][0]) / APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+      if (fillBlock != pdcReceive->pdcReceiveActiveBlock)
+        { // (i) the PDC is filling the other block
+        delivered = apvSerialPdcReceiveDeliver(pdcReceive,
+                                               pdcReceive->pdcReceiveConsumed,
+                                               APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+        APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RNPR, activeBlock);
+        APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RNCR, APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+        pdcReceive->pdcReceiveActiveBlock     = fillBlock;
+        pdcReceive->pdcReceiveConsumed        = 0;
+        pdcReceive->pdcReceiveBlocksCompleted = pdcReceive->pdcReceiveBlocksCompleted + 1;
+        }
+      else
+        {
+        if (receiveCount == 0)
+          { // (ii) the PDC ran out of blocks and stopped
+          delivered = apvSerialPdcReceiveDeliver(pdcReceive,
+                                                 pdcReceive->pdcReceiveConsumed,
+                                                 APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+          pdcReceive->pdcReceiveActiveBlock     = (pdcReceive->pdcReceiveActiveBlock + 1) % APV_SERIAL_PDC_RECEIVE_BLOCKS;
+          pdcReceive->pdcReceiveConsumed        = 0;
+          pdcReceive->pdcReceiveBlocksCompleted = pdcReceive->pdcReceiveBlocksCompleted + 1;
+          pdcReceive->pdcReceiveStalls          = pdcReceive->pdcReceiveStalls          + 1;
+
+          APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RPR,  (uintptr_t)&pdcReceive->pdcReceiveBlocks[pdcReceive->pdcReceiveActiveBlock][0]);
+          APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RCR,  APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+          APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RNPR, activeBlock);
+          APV_REGISTER_COMMAND(pdcReceive->pdcReceiveChannel, PERIPH_RNCR, APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+
+          servicing = false;
+          }
+        else
+          { // (iii) deliver the characters landed so far
+          delivered = apvSerialPdcReceiveDeliver(pdcReceive,
+                                                 pdcReceive->pdcReceiveConsumed,
+                                                 (uint16_t)(receivePointer - activeBlock));
+
+          pdcReceive->pdcReceiveConsumed = (uint16_t)(receivePointer - activeBlock);
+
+          servicing = false;
+          }
+        }
+
+      if (delivered != 0)
+        {
+        charactersFound = true;
+        }
+
+      blocksVisited = blocksVisited + 1;
+      }
+
+    if (interruptControl == true)
+      {
+      APV_CRITICAL_REGION_EXIT();
+      }
+    }
+
+/******************************************************************************/
+
+  return(charactersFound);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcReceiveService                                      */
+
+/******************************************************************************/
+/* apvSerialPdcReceiveIdleFlush() :                                           */
+/*  --> pdcReceive      : PDC receive state                                   */
+/*  <-- charactersFound : [ false == nothing was flushed |                    */
+/*                          true  == a part-filled block was delivered ]      */
+/*                                                                            */
+/* - called from the periodic tick. If the PDC receive pointer has not moved  */
+/*   since the last tick the line has been idle for at least one tick, so any */
+/*   characters waiting in the active block are delivered now rather than     */
+/*   when the block fills                                                     */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPdcReceiveIdleFlush(apvSerialPdcReceive_t *pdcReceive)
+  {
+/******************************************************************************/
+
+  bool      charactersFound = false;
+
+  uintptr_t receivePointer  = 0;
+
+/******************************************************************************/
+
+  if ((pdcReceive != NULL) && (pdcReceive->pdcReceiveChannel != NULL))
+    {
+    receivePointer = pdcReceive->pdcReceiveChannel->PERIPH_RPR;
+
+    if (receivePointer == pdcReceive->pdcReceiveIdlePointer)
+      {
+      if (apvSerialPdcReceiveService(pdcReceive,
+                                     true) == true)
+        {
+        pdcReceive->pdcReceiveIdleFlushes = pdcReceive->pdcReceiveIdleFlushes + 1;
+
+        charactersFound = true;
+        }
+      }
+
+    pdcReceive->pdcReceiveIdlePointer = receivePointer;
+    }
+
+/******************************************************************************/
+
+  return(charactersFound);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcReceiveIdleFlush                                    */
+
+/******************************************************************************/
+/* apvSerialPdcReceiveDeliver() :                                             */
+/*  --> pdcReceive  : PDC receive state                                       */
+/*  --> deliverFrom : the first character of the active block to deliver      */
+/*  --> deliverTo   : one past the last character to deliver                  */
+/*  <-- characterCount : the number of characters taken from the block        */
+/*                                                                            */
+/* - load the characters straight from the landing zone with a single ring-   */
+/*   buffer call, widening them into the 32-bit slots the de-framer reads. If */
+/*   they do not all fit the rings' overflow policy decides what is lost and  */
+/*   the gap is marked                                                        */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvSerialPdcReceiveDeliver(apvSerialPdcReceive_t *pdcReceive,
+                                           uint16_t               deliverFrom,
+                                           uint16_t               deliverTo)
+  {
+/******************************************************************************/
+
+  uint8_t  *activeBlock         = &pdcReceive->pdcReceiveBlocks[pdcReceive->pdcReceiveActiveBlock][0];
+
+  uint16_t  characterCount      = 0;
+
+/******************************************************************************/
+
+  if (deliverTo > deliverFrom)
+    {
+    characterCount = deliverTo - deliverFrom;
+
+    // The landing zone is already byte-packed : hand it straight to the ring-buffer
+    pdcReceive->pdcReceiveCharactersDropped = pdcReceive->pdcReceiveCharactersDropped + 
+                                                apvRingBufferReceiveLoad( pdcReceive->pdcReceiveRing,
+                                                                          pdcReceive->pdcReceiveGuard,
+                                                                          APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                                                                         (uint32_t *)(activeBlock + deliverFrom),
+                                                                          characterCount);
+    }
+
+/******************************************************************************/
+
+  return(characterCount);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcReceiveDeliver                                      */
+
+/******************************************************************************/
+/* apvSerialPdcTransmitInitialise() :                                         */
+/*  --> pdcTransmit        : PDC transmit state                               */
+/*  --> pdcTransmitChannel : the peripherals' PDC register block e.g.         */
+/*                           'PDC_UART'                                       */
+/*  <-- pdcError           : error codes                                      */
+/*                                                                            */
+/* - empty the frame queue and enable the PDC transmit transfer with nothing  */
+/*   loaded. The peripherals' "ENDTX" interrupt is enabled per frame by the   */
+/*   transmit prime                                                           */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPdcTransmitInitialise(apvSerialPdcTransmit_t *pdcTransmit,
+                                              Pdc                    *pdcTransmitChannel)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE pdcError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if ((pdcTransmit == NULL) || (pdcTransmitChannel == NULL))
+    {
+    pdcError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    APV_REGISTER_COMMAND(pdcTransmitChannel, PERIPH_PTCR, PERIPH_PTCR_TXTDIS);
+
+    pdcTransmit->pdcTransmitChannel        = pdcTransmitChannel;
+    pdcTransmit->pdcTransmitHead           = 0;
+    pdcTransmit->pdcTransmitTail           = 0;
+    pdcTransmit->pdcTransmitCount          = 0;
+    pdcTransmit->pdcTransmitInPdc          = 0;
+    pdcTransmit->pdcTransmitFramesSent     = 0;
+    pdcTransmit->pdcTransmitFramesChained  = 0;
+    pdcTransmit->pdcTransmitFramesRejected = 0;
+
+    APV_REGISTER_COMMAND(pdcTransmitChannel, PERIPH_TCR,  0);
+    APV_REGISTER_COMMAND(pdcTransmitChannel, PERIPH_TNCR, 0);
+
+    APV_REGISTER_COMMAND(pdcTransmitChannel, PERIPH_PTCR, PERIPH_PTCR_TXTEN);
+    }
+
+/******************************************************************************/
+
+  return(pdcError);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcTransmitInitialise                                  */
+
+/******************************************************************************/
+/* apvSerialPdcTransmitQueue() :                                              */
+/*  --> pdcTransmit         : PDC transmit state                              */
+/*  --> transmitFrame       : a complete framed message                       */
+/*  --> transmitFrameLength : the frame length in characters                  */
+/*  --> interruptControl    : [ false == interrupts are already masked |      */
+/*                              true  == mask interrupts while queueing ]     */
+/*  <-- pdcError            : error codes                                     */
+/*                                                                            */
+/* - copy the frame into a free frame slot and load it into the PDC if one of */
+/*   the transmit register pairs is free. A frame is never split : it goes    */
+/*   out as one PDC span                                                      */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPdcTransmitQueue(apvSerialPdcTransmit_t *pdcTransmit,
+                                         const uint8_t          *transmitFrame,
+                                         uint16_t                transmitFrameLength,
+                                         bool                    interruptControl)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE pdcError       = APV_ERROR_CODE_NONE;
+
+  uint16_t       frameCharacter = 0;
+
+/******************************************************************************/
+
+  if ((pdcTransmit == NULL) || (pdcTransmit->pdcTransmitChannel == NULL) || (transmitFrame == NULL))
+    {
+    pdcError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if ((transmitFrameLength == 0) || (transmitFrameLength > APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH))
+      {
+      pdcError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      // Only the interrupt frees slots so a free slot seen here stays free
+      if (pdcTransmit->pdcTransmitCount == APV_SERIAL_PDC_TRANSMIT_FRAMES)
+        {
+        pdcTransmit->pdcTransmitFramesRejected = pdcTransmit->pdcTransmitFramesRejected + 1;
+
+        pdcError = APV_SERIAL_ERROR_CODE_TRANSMITTER_NOT_READY;
+        }
+      else
+        {
+        for (frameCharacter = 0; frameCharacter < transmitFrameLength; frameCharacter++)
+          {
+          pdcTransmit->pdcTransmitFrames[pdcTransmit->pdcTransmitHead][frameCharacter] = *(transmitFrame + frameCharacter);
+          }
+
+        pdcTransmit->pdcTransmitFrameLengths[pdcTransmit->pdcTransmitHead] = transmitFrameLength;
+
+        if (interruptControl == true)
+          {
+          APV_CRITICAL_REGION_ENTRY();
+          }
+
+        pdcTransmit->pdcTransmitHead  = (pdcTransmit->pdcTransmitHead + 1) % APV_SERIAL_PDC_TRANSMIT_FRAMES;
+        pdcTransmit->pdcTransmitCount = pdcTransmit->pdcTransmitCount + 1;
+
+        apvSerialPdcTransmitLoad(pdcTransmit);
+
+        if (interruptControl == true)
+          {
+          APV_CRITICAL_REGION_EXIT();
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(pdcError);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcTransmitQueue                                       */
+
+/******************************************************************************/
+/* apvSerialPdcTransmitService() :                                            */
+/*  --> pdcTransmit      : PDC transmit state                                 */
+/*  --> interruptControl : [ false == called from the peripheral interrupt |  */
+/*                           true  == called from the background loop ]       */
+/*  <-- transmitterBusy  : [ false == nothing left to send; switch "ENDTX"    */
+/*                                    off (it stays set while TCR == 0) |     */
+/*                           true  == frames are loaded in the PDC ]          */
+/*                                                                            */
+/* - the "ENDTX" handler : retire the frames the PDC has finished and chain   */
+/*   any waiting frames into the free transmit registers                      */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPdcTransmitService(apvSerialPdcTransmit_t *pdcTransmit,
+                                 bool                    interruptControl)
+  {
+/******************************************************************************/
+
+  bool transmitterBusy = false;
+
+/******************************************************************************/
+
+  if ((pdcTransmit != NULL) && (pdcTransmit->pdcTransmitChannel != NULL))
+    {
+    if (interruptControl == true)
+      {
+      APV_CRITICAL_REGION_ENTRY();
+      }
+
+    apvSerialPdcTransmitLoad(pdcTransmit);
+
+    if (pdcTransmit->pdcTransmitInPdc != 0)
+      {
+      transmitterBusy = true;
+      }
+
+    if (interruptControl == true)
+      {
+      APV_CRITICAL_REGION_EXIT();
+      }
+    }
+
+/******************************************************************************/
+
+  return(transmitterBusy);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcTransmitService                                     */
+
+/******************************************************************************/
+/* apvSerialPdcTransmitSpace() :                                              */
+/*  --> pdcTransmit   : PDC transmit state                                    */
+/*  <-- transmitSpace : [ false == every frame slot is queued or in flight |  */
+/*                        true  == the next frame will be accepted ]          */
+/*                                                                            */
+/* - lets a sender hold a frame back rather than have it rejected. Only the   */
+/*   interrupt frees slots so a free slot seen here stays free                */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPdcTransmitSpace(apvSerialPdcTransmit_t *pdcTransmit)
+  {
+/******************************************************************************/
+
+  bool transmitSpace = false;
+
+/******************************************************************************/
+
+  if ((pdcTransmit != NULL) && (pdcTransmit->pdcTransmitChannel != NULL))
+    {
+    if (pdcTransmit->pdcTransmitCount < APV_SERIAL_PDC_TRANSMIT_FRAMES)
+      {
+      transmitSpace = true;
+      }
+    }
+
+/******************************************************************************/
+
+  return(transmitSpace);
+
+/******************************************************************************/
+  } /* end of apvSerialPdcTransmitSpace                                       */
+
+/******************************************************************************/
+/* apvSerialPdcTransmitLoad() :                                               */
+/*  --> pdcTransmit : PDC transmit state                                      */
+/*                                                                            */
+/* - MUST be called with interrupts masked :                                  */
+/*   (i)  retire finished frames : TCR == 0 means every loaded frame has gone */
+/*        (the PDC stops when it finds TNCR empty); TNCR == 0 with two frames */
+/*        loaded means the first has gone and the second moved to "current"   */
+/*   (ii) load waiting frames into "current" and then "next". If "current"    */
+/*        ran out while "next" was being written the span is moved across by  */
+/*        hand, as the PDC only looks at "next" when "current" reaches zero   */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvSerialPdcTransmitLoad(apvSerialPdcTransmit_t *pdcTransmit)
+  {
+/******************************************************************************/
+
+  Pdc     *pdcChannel     = pdcTransmit->pdcTransmitChannel;
+
+  uint8_t  framesFinished = 0,
+           frameSlot      = 0;
+
+/******************************************************************************/
+
+  if (pdcChannel->PERIPH_TCR == 0)
+    {
+    framesFinished = pdcTransmit->pdcTransmitInPdc;
+    }
+  else
+    {
+    if ((pdcTransmit->pdcTransmitInPdc == APV_SERIAL_PDC_TRANSMIT_REGISTERS) && (pdcChannel->PERIPH_TNCR == 0))
+      {
+      framesFinished = 1;
+      }
+    }
+
+  pdcTransmit->pdcTransmitTail       = (pdcTransmit->pdcTransmitTail + framesFinished) % APV_SERIAL_PDC_TRANSMIT_FRAMES;
+  pdcTransmit->pdcTransmitCount      = pdcTransmit->pdcTransmitCount      - framesFinished;
+  pdcTransmit->pdcTransmitInPdc      = pdcTransmit->pdcTransmitInPdc      - framesFinished;
+  pdcTransmit->pdcTransmitFramesSent = pdcTransmit->pdcTransmitFramesSent + framesFinished;
+
+  while ((pdcTransmit->pdcTransmitInPdc < APV_SERIAL_PDC_TRANSMIT_REGISTERS) &&
+         (pdcTransmit->pdcTransmitInPdc < pdcTransmit->pdcTransmitCount))
+    {
+    frameSlot = (pdcTransmit->pdcTransmitTail + pdcTransmit->pdcTransmitInPdc) % APV_SERIAL_PDC_TRANSMIT_FRAMES;
+
+    // The pointer registers MUST be written before their counters
+    if (pdcTransmit->pdcTransmitInPdc == 0)
+      {
+      APV_REGISTER_COMMAND(pdcChannel, PERIPH_TPR,  (uintptr_t)&pdcTransmit->pdcTransmitFrames[frameSlot][0]);
+      APV_REGISTER_COMMAND(pdcChannel, PERIPH_TCR,  pdcTransmit->pdcTransmitFrameLengths[frameSlot]);
+      }
+    else
+      {
+      APV_REGISTER_COMMAND(pdcChannel, PERIPH_TNPR, (uintptr_t)&pdcTransmit->pdcTransmitFrames[frameSlot][0]);
+      APV_REGISTER_COMMAND(pdcChannel, PERIPH_TNCR, pdcTransmit->pdcTransmitFrameLengths[frameSlot]);
+
+      if ((pdcChannel->PERIPH_TCR == 0) && (pdcChannel->PERIPH_TNCR != 0))
+        {
+        // Retire the "next" frame before the counter starts the current one
+        APV_REGISTER_COMMAND(pdcChannel, PERIPH_TNCR, 0);
+        APV_REGISTER_COMMAND(pdcChannel, PERIPH_TPR,  (uintptr_t)&pdcTransmit->pdcTransmitFrames[frameSlot][0]);
+        APV_REGISTER_COMMAND(pdcChannel, PERIPH_TCR,  pdcTransmit->pdcTransmitFrameLengths[frameSlot]);
+        }
+
+      pdcTransmit->pdcTransmitFramesChained = pdcTransmit->pdcTransmitFramesChained + 1;
+      }
+
+    pdcTransmit->pdcTransmitInPdc = pdcTransmit->pdcTransmitInPdc + 1;
+    }
+
+/******************************************************************************/
+  } /* end of apvSerialPdcTransmitLoad                                        */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
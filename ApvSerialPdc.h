@@ -0,0 +1,109 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPdc.h                                                             */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - peripheral DMA controller (PDC) driven serial receive. The PDC lands     */
+/*   received characters in one of two alternating blocks; completed blocks   */
+/*   are handed to the receive ring-buffer in one go at end-of-block, and any */
+/*   partial block is flushed when the line goes quiet                        */
+/* - PDC driven serial transmit : whole frames are queued and chained through */
+/*   the PDC "current" and "next" transmit registers                          */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_SERIAL_PDC_H_
+#define _APV_SERIAL_PDC_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ApvError.h"
+#include "ApvCommsUtilities.h"
+#ifdef APV_HOST_SIMULATION
+#include "ApvSerialPdcModel.h"
+#else
+#include <sam3x8e.h>
+#endif
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define APV_SERIAL_PDC_RECEIVE_BLOCKS        (2)  // the PDC "current" and "next" landing zones
+#define APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH  (32) // characters per landing zone, ~16ms at 19200 baud
+
+#define APV_SERIAL_PDC_TRANSMIT_REGISTERS    (2)   // the PDC "current" and "next" transmit spans
+#define APV_SERIAL_PDC_TRANSMIT_FRAMES       (4)   // frames queued or in flight
+#define APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH (136) // holds the largest framed message ('APV_MESSAGING_MAXIMUM_PAYLOAD_LENGTH')
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef struct apvSerialPdcReceive_tTag
+  {
+  Pdc                         *pdcReceiveChannel;            // the peripherals' PDC register block
+  apvRingBuffer_t             *pdcReceiveRing;               // the de-framers' character ring
+  apvRingBufferReceiveGuard_t *pdcReceiveGuard;              // the character rings' overflow policy and gap marking
+  uint8_t                      pdcReceiveBlocks[APV_SERIAL_PDC_RECEIVE_BLOCKS][APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH];
+  uint8_t                      pdcReceiveActiveBlock;        // the block the PDC is filling now
+  uint16_t                     pdcReceiveConsumed;           // characters of the active block already delivered
+  uintptr_t                    pdcReceiveIdlePointer;        // the PDC receive pointer at the last idle check
+  uint32_t                     pdcReceiveBlocksCompleted;
+  uint32_t                     pdcReceiveIdleFlushes;
+  uint32_t                     pdcReceiveStalls;             // both blocks filled before the end-of-block interrupt
+  uint32_t                     pdcReceiveCharactersDropped;  // lost to the receive rings' overflow policy
+  } apvSerialPdcReceive_t;
+
+// Frames are sent in order from 'pdcTransmitTail'; the first 'pdcTransmitInPdc' of
+// them are loaded in the PDC transmit registers, the rest are waiting
+typedef struct apvSerialPdcTransmit_tTag
+  {
+  Pdc             *pdcTransmitChannel;
+  uint8_t          pdcTransmitFrames[APV_SERIAL_PDC_TRANSMIT_FRAMES][APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH];
+  uint16_t         pdcTransmitFrameLengths[APV_SERIAL_PDC_TRANSMIT_FRAMES];
+  uint8_t          pdcTransmitHead;                    // the next free frame slot
+  uint8_t          pdcTransmitTail;                    // the oldest frame not yet sent
+  uint8_t          pdcTransmitCount;                   // frames queued or in flight
+  uint8_t          pdcTransmitInPdc;                   // frames loaded in the PDC
+  uint32_t         pdcTransmitFramesSent;
+  uint32_t         pdcTransmitFramesChained;           // loaded into "next" behind a frame still being sent
+  uint32_t         pdcTransmitFramesRejected;          // no free frame slot
+  } apvSerialPdcTransmit_t;
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern APV_ERROR_CODE apvSerialPdcReceiveInitialise(apvSerialPdcReceive_t       *pdcReceive,
+                                                    Pdc                         *pdcReceiveChannel,
+                                                    apvRingBuffer_t             *pdcReceiveRing,
+                                                    apvRingBufferReceiveGuard_t *pdcReceiveGuard);
+extern bool           apvSerialPdcReceiveService(apvSerialPdcReceive_t *pdcReceive,
+                                                 bool                   interruptControl);
+extern bool           apvSerialPdcReceiveIdleFlush(apvSerialPdcReceive_t *pdcReceive);
+
+extern APV_ERROR_CODE apvSerialPdcTransmitInitialise(apvSerialPdcTransmit_t *pdcTransmit,
+                                                     Pdc                    *pdcTransmitChannel);
+extern APV_ERROR_CODE apvSerialPdcTransmitQueue(apvSerialPdcTransmit_t *pdcTransmit,
+                                                const uint8_t          *transmitFrame,
+                                                uint16_t                transmitFrameLength,
+                                                bool                    interruptControl);
+extern bool           apvSerialPdcTransmitService(apvSerialPdcTransmit_t *pdcTransmit,
+                                                  bool                    interruptControl);
+extern bool           apvSerialPdcTransmitSpace(apvSerialPdcTransmit_t *pdcTransmit);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,345 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPdcModel.c                                                        */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : a model of the SAM3X peripheral DMA controller receive and   */
+/*   transmit channels. Characters are "received" one at a time into the      */
+/*   block at RPR/RCR. When RCR reaches zero the PDC loads RNPR/RNCR into     */
+/*   RPR/RCR and raises "ENDRX"; if RNCR is also zero the transfer stops      */
+/*   ("RXBUFF") and further characters are overruns. The "interrupt" is taken */
+/*   a set number of characters after it is raised, to model service latency. */
+/*   Transmit runs the same way from TPR/TCR and TNPR/TNCR. Writing RNCR or   */
+/*   TNCR while stopped does NOT restart the transfer in this model           */
+/*                                                                            */
+/*   Build e.g. :                                                             */
+/*     gcc -DAPV_HOST_SIMULATION ApvSerialPdc.c ApvSerialPdcModel.c           */
+/*         ApvCommsUtilities.c <harness.c>                                    */
+/*   ('ApvCommsUtilities.c' still pulls in the target headers through         */
+/*   'ApvUtilities.h' so host stand-ins for those must be on the path)        */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ApvSerialPdcModel.h"
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void apvPdcModelTransferControl(apvPdcModel_t *pdcModel);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* APV_CRITICAL_REGION_ENTRY()/APV_CRITICAL_REGION_EXIT() :                   */
+/*  - the host model is single-threaded; the "interrupt" only runs from       */
+/*    inside 'apvPdcModelReceive()' and 'apvPdcModelIdle()'                   */
+/******************************************************************************/
+
+void APV_CRITICAL_REGION_ENTRY(void)
+  {
+  } /* end of APV_CRITICAL_REGION_ENTRY                                       */
+
+void APV_CRITICAL_REGION_EXIT(void)
+  {
+  } /* end of APV_CRITICAL_REGION_EXIT                                        */
+
+/******************************************************************************/
+/* apvPdcModelInitialise() :                                                  */
+/*  --> pdcModel         : the model PDC channel                              */
+/*  --> interruptLatency : characters received between raising and taking     */
+/*                         the end-of-block interrupt                         */
+/*  --> interruptHandler : the modelled peripheral interrupt handler          */
+/*  --> interruptContext : passed to the interrupt handler                    */
+/*                                                                            */
+/******************************************************************************/
+
+void apvPdcModelInitialise(apvPdcModel_t  *pdcModel,
+                           uint16_t        interruptLatency,
+                           void          (*interruptHandler)(void *interruptContext),
+                           void           *interruptContext)
+  {
+/******************************************************************************/
+
+  pdcModel->pdcModelRegisters.PERIPH_RPR  = 0;
+  pdcModel->pdcModelRegisters.PERIPH_RCR  = 0;
+  pdcModel->pdcModelRegisters.PERIPH_TPR  = 0;
+  pdcModel->pdcModelRegisters.PERIPH_TCR  = 0;
+  pdcModel->pdcModelRegisters.PERIPH_RNPR = 0;
+  pdcModel->pdcModelRegisters.PERIPH_RNCR = 0;
+  pdcModel->pdcModelRegisters.PERIPH_TNPR = 0;
+  pdcModel->pdcModelRegisters.PERIPH_TNCR = 0;
+  pdcModel->pdcModelRegisters.PERIPH_PTCR = 0;
+  pdcModel->pdcModelRegisters.PERIPH_PTSR = 0;
+
+  pdcModel->pdcModelInterruptLatency   = interruptLatency;
+  pdcModel->pdcModelInterruptCountdown = 0;
+  pdcModel->pdcModelInterruptPending   = false;
+  pdcModel->pdcModelInterrupts         = 0;
+  pdcModel->pdcModelOverruns           = 0;
+  pdcModel->pdcModelInterruptHandler   = interruptHandler;
+  pdcModel->pdcModelInterruptContext   = interruptContext;
+
+/******************************************************************************/
+  } /* end of apvPdcModelInitialise                                           */
+
+/******************************************************************************/
+/* apvPdcModelReceive() :                                                     */
+/*  --> pdcModel           : the model PDC channel                            */
+/*  --> receivedCharacters : characters arriving at the receiver              */
+/*  --> numberOfCharacters : how many                                         */
+/*                                                                            */
+/* - transfer each character as the PDC would, raising and taking the end-    */
+/*   of-block interrupt as it goes                                            */
+/*                                                                            */
+/******************************************************************************/
+
+void apvPdcModelReceive(apvPdcModel_t *pdcModel,
+                        const uint8_t *receivedCharacters,
+                        uint16_t       numberOfCharacters)
+  {
+/******************************************************************************/
+
+  Pdc *pdc = &pdcModel->pdcModelRegisters;
+
+/******************************************************************************/
+
+  while (numberOfCharacters > 0)
+    {
+    apvPdcModelTransferControl(pdcModel);
+
+    if (((pdc->PERIPH_PTSR & PERIPH_PTSR_RXTEN) == PERIPH_PTSR_RXTEN) && (pdc->PERIPH_RCR != 0))
+      {
+      *((uint8_t *)pdc->PERIPH_RPR) = *receivedCharacters;
+
+      pdc->PERIPH_RPR = pdc->PERIPH_RPR + 1;
+      pdc->PERIPH_RCR = pdc->PERIPH_RCR - 1;
+
+      if (pdc->PERIPH_RCR == 0)
+        {
+        if (pdc->PERIPH_RNCR != 0)
+          {
+          pdc->PERIPH_RPR  = pdc->PERIPH_RNPR;
+          pdc->PERIPH_RCR  = pdc->PERIPH_RNCR;
+          pdc->PERIPH_RNCR = 0;
+          }
+
+        if (pdcModel->pdcModelInterruptPending == false)
+          {
+          pdcModel->pdcModelInterruptPending   = true;
+          pdcModel->pdcModelInterruptCountdown = pdcModel->pdcModelInterruptLatency;
+          }
+        }
+      }
+    else
+      {
+      pdcModel->pdcModelOverruns = pdcModel->pdcModelOverruns + 1;
+      }
+
+    // Take the interrupt once the modelled latency has passed
+    if (pdcModel->pdcModelInterruptPending == true)
+      {
+      if (pdcModel->pdcModelInterruptCountdown == 0)
+        {
+        apvPdcModelIdle(pdcModel);
+        }
+      else
+        {
+        pdcModel->pdcModelInterruptCountdown = pdcModel->pdcModelInterruptCountdown - 1;
+        }
+      }
+
+    receivedCharacters = receivedCharacters + 1;
+    numberOfCharacters = numberOfCharacters - 1;
+    }
+
+/******************************************************************************/
+  } /* end of apvPdcModelReceive                                              */
+
+/******************************************************************************/
+/* apvPdcModelIdle() :                                                        */
+/*  --> pdcModel : the model PDC channel                                      */
+/*                                                                            */
+/* - the line is quiet : take any pending interrupt now                       */
+/*                                                                            */
+/******************************************************************************/
+
+void apvPdcModelIdle(apvPdcModel_t *pdcModel)
+  {
+/******************************************************************************/
+
+  apvPdcModelTransferControl(pdcModel);
+
+  if (pdcModel->pdcModelInterruptPending == true)
+    {
+    pdcModel->pdcModelInterruptPending = false;
+    pdcModel->pdcModelInterrupts       = pdcModel->pdcModelInterrupts + 1;
+
+    if (pdcModel->pdcModelInterruptHandler != NULL)
+      {
+      pdcModel->pdcModelInterruptHandler(pdcModel->pdcModelInterruptContext);
+      }
+
+    apvPdcModelTransferControl(pdcModel);
+    }
+
+/******************************************************************************/
+  } /* end of apvPdcModelIdle                                                 */
+
+/******************************************************************************/
+/* apvPdcModelTransmitInitialise() :                                          */
+/*  --> pdcModel        : the model PDC channel                               */
+/*  --> transmitHandler : the modelled "ENDTX" interrupt handler              */
+/*  --> transmitContext : passed to the interrupt handler                     */
+/*                                                                            */
+/* - call after 'apvPdcModelInitialise()'. The transmit interrupt starts off  */
+/*   disabled                                                                 */
+/*                                                                            */
+/******************************************************************************/
+
+void apvPdcModelTransmitInitialise(apvPdcModel_t  *pdcModel,
+                                   void          (*transmitHandler)(void *interruptContext),
+                                   void           *transmitContext)
+  {
+/******************************************************************************/
+
+  pdcModel->pdcModelEndOfTransmit            = false;
+  pdcModel->pdcModelTransmitInterruptEnabled = false;
+  pdcModel->pdcModelTransmitInterrupts       = 0;
+  pdcModel->pdcModelTransmitHandler          = transmitHandler;
+  pdcModel->pdcModelTransmitContext          = transmitContext;
+
+/******************************************************************************/
+  } /* end of apvPdcModelTransmitInitialise                                   */
+
+/******************************************************************************/
+/* apvPdcModelTransmit() :                                                    */
+/*  --> pdcModel              : the model PDC channel                         */
+/*  --> transmittedCharacters : where the "line" output is recorded           */
+/*  --> maximumCharacters     : character times to run the transmitter for    */
+/*  <-- charactersSent        : characters actually sent                      */
+/*                                                                            */
+/* - send from TPR/TCR one character per character time, moving TNPR/TNCR     */
+/*   across when TCR reaches zero. "ENDTX" is level-sensitive : while it is   */
+/*   enabled and TCR is zero the handler is called once per character time    */
+/*                                                                            */
+/******************************************************************************/
+
+uint16_t apvPdcModelTransmit(apvPdcModel_t *pdcModel,
+                             uint8_t       *transmittedCharacters,
+                             uint16_t       maximumCharacters)
+  {
+/******************************************************************************/
+
+  Pdc      *pdc            = &pdcModel->pdcModelRegisters;
+
+  uint16_t  charactersSent = 0;
+
+/******************************************************************************/
+
+  while (maximumCharacters > 0)
+    {
+    apvPdcModelTransferControl(pdcModel);
+
+    if (((pdc->PERIPH_PTSR & PERIPH_PTSR_TXTEN) == PERIPH_PTSR_TXTEN) && (pdc->PERIPH_TCR != 0))
+      {
+      *(transmittedCharacters + charactersSent) = *((uint8_t *)pdc->PERIPH_TPR);
+
+      charactersSent  = charactersSent  + 1;
+
+      pdc->PERIPH_TPR = pdc->PERIPH_TPR + 1;
+      pdc->PERIPH_TCR = pdc->PERIPH_TCR - 1;
+
+      if (pdc->PERIPH_TCR == 0)
+        {
+        pdcModel->pdcModelEndOfTransmit = true;
+
+        if (pdc->PERIPH_TNCR != 0)
+          {
+          pdc->PERIPH_TPR  = pdc->PERIPH_TNPR;
+          pdc->PERIPH_TCR  = pdc->PERIPH_TNCR;
+          pdc->PERIPH_TNCR = 0;
+          }
+        }
+      }
+
+    if ((pdcModel->pdcModelEndOfTransmit == true) && (pdcModel->pdcModelTransmitInterruptEnabled == true))
+      {
+      pdcModel->pdcModelEndOfTransmit      = false;
+      pdcModel->pdcModelTransmitInterrupts = pdcModel->pdcModelTransmitInterrupts + 1;
+
+      if (pdcModel->pdcModelTransmitHandler != NULL)
+        {
+        pdcModel->pdcModelTransmitHandler(pdcModel->pdcModelTransmitContext);
+        }
+
+      apvPdcModelTransferControl(pdcModel);
+      }
+
+    if (pdc->PERIPH_TCR == 0)
+      {
+      pdcModel->pdcModelEndOfTransmit = true;
+      }
+
+    maximumCharacters = maximumCharacters - 1;
+    }
+
+/******************************************************************************/
+
+  return(charactersSent);
+
+/******************************************************************************/
+  } /* end of apvPdcModelTransmit                                             */
+
+/******************************************************************************/
+/* apvPdcModelTransferControl() :                                             */
+/*  --> pdcModel : the model PDC channel                                      */
+/*                                                                            */
+/* - act on (and clear) any write to the write-only transfer control register */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPdcModelTransferControl(apvPdcModel_t *pdcModel)
+  {
+/******************************************************************************/
+
+  Pdc *pdc = &pdcModel->pdcModelRegisters;
+
+/******************************************************************************/
+
+  if ((pdc->PERIPH_PTCR & PERIPH_PTCR_RXTEN) == PERIPH_PTCR_RXTEN)
+    {
+    pdc->PERIPH_PTSR = pdc->PERIPH_PTSR | PERIPH_PTSR_RXTEN;
+    }
+
+  if ((pdc->PERIPH_PTCR & PERIPH_PTCR_RXTDIS) == PERIPH_PTCR_RXTDIS)
+    {
+    pdc->PERIPH_PTSR = pdc->PERIPH_PTSR & ~((uintptr_t)PERIPH_PTSR_RXTEN);
+    }
+
+  if ((pdc->PERIPH_PTCR & PERIPH_PTCR_TXTEN) == PERIPH_PTCR_TXTEN)
+    {
+    pdc->PERIPH_PTSR = pdc->PERIPH_PTSR | PERIPH_PTSR_TXTEN;
+    }
+
+  if ((pdc->PERIPH_PTCR & PERIPH_PTCR_TXTDIS) == PERIPH_PTCR_TXTDIS)
+    {
+    pdc->PERIPH_PTSR = pdc->PERIPH_PTSR & ~((uintptr_t)PERIPH_PTSR_TXTEN);
+    }
+
+  pdc->PERIPH_PTCR = 0;
+
+/******************************************************************************/
+  } /* end of apvPdcModelTransferControl                                      */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,101 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPdcModel.h                                                        */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : a model of the SAM3X peripheral DMA controller receive and   */
+/*   transmit channels so 'ApvSerialPdc.c' can be built and exercised off-    */
+/*   target with 'APV_HOST_SIMULATION' defined                                */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_SERIAL_PDC_MODEL_H_
+#define _APV_SERIAL_PDC_MODEL_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define PERIPH_PTCR_RXTEN                 (0x1u << 0) // as "sam3x8e.h"
+#define PERIPH_PTCR_RXTDIS                (0x1u << 1)
+#define PERIPH_PTCR_TXTEN                 (0x1u << 8)
+#define PERIPH_PTCR_TXTDIS                (0x1u << 9)
+
+#define PERIPH_PTSR_RXTEN                 (0x1u << 0)
+#define PERIPH_PTSR_TXTEN                 (0x1u << 8)
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+// The register block is pointer-width so host addresses fit the pointer registers
+typedef struct Pdc
+  {
+  volatile uintptr_t PERIPH_RPR;
+  volatile uintptr_t PERIPH_RCR;
+  volatile uintptr_t PERIPH_TPR;
+  volatile uintptr_t PERIPH_TCR;
+  volatile uintptr_t PERIPH_RNPR;
+  volatile uintptr_t PERIPH_RNCR;
+  volatile uintptr_t PERIPH_TNPR;
+  volatile uintptr_t PERIPH_TNCR;
+  volatile uintptr_t PERIPH_PTCR;
+  volatile uintptr_t PERIPH_PTSR;
+  } Pdc;
+
+typedef struct apvPdcModel_tTag
+  {
+  Pdc        pdcModelRegisters;
+  uint16_t   pdcModelInterruptLatency;                  // characters received before a raised interrupt is taken
+  uint16_t   pdcModelInterruptCountdown;
+  bool       pdcModelInterruptPending;
+  uint32_t   pdcModelInterrupts;
+  uint32_t   pdcModelOverruns;                          // characters arriving with no receive block
+  void     (*pdcModelInterruptHandler)(void *interruptContext);
+  void      *pdcModelInterruptContext;
+  bool       pdcModelEndOfTransmit;                     // "ENDTX" : TCR reached zero
+  bool       pdcModelTransmitInterruptEnabled;          // as 'UART_IER_ENDTX'/'UART_IDR_ENDTX'
+  uint32_t   pdcModelTransmitInterrupts;
+  void     (*pdcModelTransmitHandler)(void *interruptContext);
+  void      *pdcModelTransmitContext;
+  } apvPdcModel_t;
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern void APV_CRITICAL_REGION_ENTRY(void);
+extern void APV_CRITICAL_REGION_EXIT(void);
+
+extern void apvPdcModelInitialise(apvPdcModel_t  *pdcModel,
+                                  uint16_t        interruptLatency,
+                                  void          (*interruptHandler)(void *interruptContext),
+                                  void           *interruptContext);
+extern void apvPdcModelReceive(apvPdcModel_t *pdcModel,
+                               const uint8_t *receivedCharacters,
+                               uint16_t       numberOfCharacters);
+extern void apvPdcModelIdle(apvPdcModel_t *pdcModel);
+extern void apvPdcModelTransmitInitialise(apvPdcModel_t  *pdcModel,
+                                          void          (*transmitHandler)(void *interruptContext),
+                                          void           *transmitContext);
+extern uint16_t apvPdcModelTransmit(apvPdcModel_t *pdcModel,
+                                    uint8_t       *transmittedCharacters,
+                                    uint16_t       maximumCharacters);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,747 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPort.c                                                            */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - per-port serial driver for the USARTs. Every port is a self-contained    */
+/*   object : its' own receive and transmit rings, interrupt handler, de-     */
+/*   framing state-machine and statistics. A port is bound to the matching    */
+/*   comms plane so frames received on it are routed to the components        */
+/*   serving that plane, and responses on that plane go back out of it. All   */
+/*   open ports run concurrently with the primary UART link                   */
+/*                                                                            */
+/*   Receive is one interrupt per character onto the receive ring; transmit   */
+/*   loads a whole frame onto the transmit ring and lets the "TXRDY"          */
+/*   interrupt drain it. The USART register block layout is used throughout   */
+/*                                                                            */
+/* Reference : "Atmel-11057C-ATARM-SAM3X-SAM3A-Datasheet_23-Mar-15", p797     */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <sam3x8e.h>
+#include "ApvError.h"
+#include "ApvUtilities.h"
+#include "ApvCommsUtilities.h"
+#include "ApvMessageHandling.h"
+#include "ApvRegisterAccess.h"
+#include "ApvPeripheralControl.h"
+#include "ApvSerialPort.h"
+#include "ApvInterruptLatency.h"
+
+/******************************************************************************/
+/* Global Variable Definitions :                                              */
+/******************************************************************************/
+
+apvSerialPort_t apvSerialPorts[APV_SERIAL_PORTS];
+
+/******************************************************************************/
+/* Static Variable Definitions :                                              */
+/******************************************************************************/
+/* The fixed identity of each port : comms plane, peripheral and registers    */
+/******************************************************************************/
+
+static const apvCommsPlanes_t  apvSerialPortCommsPlanes[APV_SERIAL_PORTS] =
+  {
+  APV_COMMS_PLANE_SERIAL_USART_0,
+  APV_COMMS_PLANE_SERIAL_USART_1,
+  APV_COMMS_PLANE_SERIAL_USART_2,
+  APV_COMMS_PLANE_SERIAL_USART_3
+  };
+
+static const apvPeripheralId_t apvSerialPortPeripheralIds[APV_SERIAL_PORTS] =
+  {
+  APV_PERIPHERAL_ID_USART0,
+  APV_PERIPHERAL_ID_USART1,
+  APV_PERIPHERAL_ID_USART2,
+  APV_PERIPHERAL_ID_USART3
+  };
+
+static Usart * const           apvSerialPortRegisters[APV_SERIAL_PORTS] =
+  {
+  USART0,
+  USART1,
+  USART2,
+  USART3
+  };
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void apvSerialPortReceiveErrorCheck(apvSerialPort_t *serialPort,
+                                           uint32_t         statusRegister);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvSerialPortInitialise() :                                                */
+/*  <-- serialPortError : error codes                                         */
+/*                                                                            */
+/* - give every port its' identity and mark it closed                         */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPortInitialise(void)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE serialPortError = APV_ERROR_CODE_NONE;
+
+  uint16_t       serialPort      = 0;
+
+/******************************************************************************/
+
+  for (serialPort = APV_PRIMARY_SERIAL_PORT_USART0; serialPort < APV_SERIAL_PORTS; serialPort++)
+    {
+    apvSerialPorts[serialPort].serialPortId             = (apvPrimarySerialPort_t)serialPort;
+    apvSerialPorts[serialPort].serialPortCommsPlane     = apvSerialPortCommsPlanes[serialPort];
+    apvSerialPorts[serialPort].serialPortPeripheralId   = apvSerialPortPeripheralIds[serialPort];
+    apvSerialPorts[serialPort].serialPortRegisters      = apvSerialPortRegisters[serialPort];
+    apvSerialPorts[serialPort].serialPortOpen           = false;
+    apvSerialPorts[serialPort].serialPortTransmitActive = false;
+    apvSerialPorts[serialPort].serialPortReceiveSignal  = false;
+    apvSerialPorts[serialPort].serialPortMessageBuffers = NULL;
+    apvSerialPorts[serialPort].serialPortBaudRate       = APV_SERIAL_BAUD_RATE_NONE;
+    }
+
+/******************************************************************************/
+
+  return(serialPortError);
+
+/******************************************************************************/
+  } /* end of apvSerialPortInitialise                                         */
+
+/******************************************************************************/
+/* apvSerialPortOpen() :                                                      */
+/*  --> serialPortId             : USART0 - 3                                 */
+/*  --> serialPortBaudRate       : the requested baud rate                    */
+/*  --> serialPortMessageBuffers : the free message buffer pool the ports'    */
+/*                                 de-framer assembles frames in              */
+/*  <-- serialPortBaudRateActual : the baud rate the divisor gives            */
+/*  <-- serialPortBaudRateError  : the baud rate error in parts-per-million   */
+/*  <-- serialPortError          : error codes                                */
+/*                                                                            */
+/* - switch on the ports' clock and lines, set it to 8N1 at the nearest baud  */
+/*   rate, create its' rings and de-framer and enable the receive interrupt   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPortOpen(apvPrimarySerialPort_t  serialPortId,
+                                 uint32_t                serialPortBaudRate,
+                                 apvRingBuffer_t        *serialPortMessageBuffers,
+                                 uint32_t               *serialPortBaudRateActual,
+                                 int32_t                *serialPortBaudRateError)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE   serialPortError = APV_ERROR_CODE_NONE;
+
+  apvSerialPort_t *serialPort      = NULL;
+
+/******************************************************************************/
+
+  if ((serialPortMessageBuffers == NULL) || (serialPortBaudRateActual == NULL) || (serialPortBaudRateError == NULL))
+    {
+    serialPortError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (serialPortId >= APV_SERIAL_PORTS)
+      { // The UART is not a port here - it is already assigned to the primary serial driver
+      serialPortError = APV_SERIAL_ERROR_CODE_PRIMARY_SERIAL_PORT_ALREADY_ASSIGNED;
+      }
+    else
+      {
+      serialPort = &apvSerialPorts[serialPortId];
+
+      if (serialPort->serialPortOpen == true)
+        {
+        serialPortError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+        }
+      else
+        {
+        // The registers are only writeable with the peripheral clock running
+        apvSwitchPeripheralClock(serialPort->serialPortPeripheralId,
+                                 true);
+
+        serialPortError = apvSwitchPeripheralLines(serialPort->serialPortPeripheralId,
+                                                   true);
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_IDR, 0xffffffff);
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_CR, US_CR_RSTRX | US_CR_RSTTX | US_CR_RXDIS | US_CR_TXDIS | US_CR_RSTSTA);
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_MR, US_MR_CHRL_8_BIT | US_MR_PAR_NO | US_MR_NBSTOP_1_BIT | US_MR_CHMODE_NORMAL);
+
+          // The mode register MUST be set first : the oversampling choice is merged into it
+          serialPortError = apvUsartSetBaudRate(serialPort->serialPortRegisters,
+                                                serialPortBaudRate,
+                                                serialPortBaudRateActual,
+                                                serialPortBaudRateError);
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          serialPortError = apvRingBufferInitialise(&serialPort->serialPortReceiveRing,
+                                                     APV_SERIAL_PORT_RECEIVE_RING_LENGTH);
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          serialPortError = apvRingBufferReceiveGuardInitialise(&serialPort->serialPortReceiveGuard,
+                                                                 APV_SERIAL_RECEIVE_OVERFLOW_POLICY);
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          serialPortError = apvRingBufferInitialise(&serialPort->serialPortTransmitRing,
+                                                     APV_SERIAL_PORT_TRANSMIT_RING_LENGTH);
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          // Each port de-frames with its' own copy of the state-machine so partial frames 
+          // arriving on different ports stay apart
+          serialPortError = apvDeFrameMessageStateMachineCreate(&serialPort->serialPortDeFramer[0],
+                                                                &serialPort->serialPortDeFramerVariables);
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          if (apvDeFrameMessageInitialisation(&serialPort->serialPortReceiveRing,
+                                               serialPortMessageBuffers,
+                                              &serialPort->serialPortDeFramer[0]) != APV_STATE_MACHINE_CODE_NONE)
+            {
+            serialPortError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+            }
+          }
+
+        if (serialPortError == APV_ERROR_CODE_NONE)
+          {
+          serialPort->serialPortMessageBuffers = serialPortMessageBuffers;
+          serialPort->serialPortBaudRate       = serialPortBaudRate;
+          serialPort->serialPortTransmitActive = false;
+          serialPort->serialPortReceiveSignal  = false;
+
+          serialPort->serialPortStatistics.interrupts            = 0;
+          serialPort->serialPortStatistics.charactersReceived    = 0;
+          serialPort->serialPortStatistics.charactersTransmitted = 0;
+          serialPort->serialPortStatistics.framesTransmitted     = 0;
+          serialPort->serialPortStatistics.framesRejected        = 0;
+
+          serialPort->serialPortStatistics.receiveErrors.receiveOverruns      = 0;
+          serialPort->serialPortStatistics.receiveErrors.receiveFramingErrors = 0;
+          serialPort->serialPortStatistics.receiveErrors.receiveParityErrors  = 0;
+
+          serialPort->serialPortOpen = true;
+
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_CR, US_CR_RXEN | US_CR_TXEN);
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_IER, US_IER_RXRDY | US_IER_OVRE | US_IER_FRAME | US_IER_PARE);
+
+          serialPortError = apvSwitchNvicDeviceIrq(serialPort->serialPortPeripheralId,
+                                                   true);
+          }
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(serialPortError);
+
+/******************************************************************************/
+  } /* end of apvSerialPortOpen                                               */
+
+/******************************************************************************/
+/* apvSerialPortClose() :                                                     */
+/*  --> serialPortId    : USART0 - 3                                          */
+/*  <-- serialPortError : error codes                                         */
+/*                                                                            */
+/* - stop the port and hand its' lines back to the PIO. Anything still on the */
+/*   rings is discarded                                                       */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPortClose(apvPrimarySerialPort_t serialPortId)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE   serialPortError = APV_ERROR_CODE_NONE;
+
+  apvSerialPort_t *serialPort      = NULL;
+
+/******************************************************************************/
+
+  if (serialPortId >= APV_SERIAL_PORTS)
+    {
+    serialPortError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+    }
+  else
+    {
+    serialPort = &apvSerialPorts[serialPortId];
+
+    if (serialPort->serialPortOpen == true)
+      {
+      apvSwitchNvicDeviceIrq(serialPort->serialPortPeripheralId,
+                             false);
+
+      APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_IDR, 0xffffffff);
+      APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_CR, US_CR_RXDIS | US_CR_TXDIS);
+
+      apvSwitchPeripheralLines(serialPort->serialPortPeripheralId,
+                               false);
+      apvSwitchPeripheralClock(serialPort->serialPortPeripheralId,
+                               false);
+
+      serialPort->serialPortOpen           = false;
+      serialPort->serialPortTransmitActive = false;
+      serialPort->serialPortReceiveSignal  = false;
+      }
+    }
+
+/******************************************************************************/
+
+  return(serialPortError);
+
+/******************************************************************************/
+  } /* end of apvSerialPortClose                                              */
+
+/******************************************************************************/
+/* apvSerialPortFindByCommsPlane() :                                          */
+/*  --> commsPlane : a comms plane identifier                                 */
+/*  <-- serialPort : the open port carrying the comms plane or NULL           */
+/*                                                                            */
+/******************************************************************************/
+
+apvSerialPort_t *apvSerialPortFindByCommsPlane(apvCommsPlanes_t commsPlane)
+  {
+/******************************************************************************/
+
+  apvSerialPort_t *serialPort = NULL;
+
+  uint16_t         portIndex  = 0;
+
+/******************************************************************************/
+
+  for (portIndex = APV_PRIMARY_SERIAL_PORT_USART0; portIndex < APV_SERIAL_PORTS; portIndex++)
+    {
+    if ((apvSerialPorts[portIndex].serialPortOpen       == true) &&
+        (apvSerialPorts[portIndex].serialPortCommsPlane == commsPlane))
+      {
+      serialPort = &apvSerialPorts[portIndex];
+      }
+    }
+
+/******************************************************************************/
+
+  return(serialPort);
+
+/******************************************************************************/
+  } /* end of apvSerialPortFindByCommsPlane                                   */
+
+/******************************************************************************/
+/* apvSerialPortTransmitSpace() :                                             */
+/*  --> serialPort          : the port                                        */
+/*  --> transmitFrameLength : the frame to be sent                            */
+/*  <-- transmitSpace       : [ false == the frame would be rejected |        */
+/*                              true  == the frame will be accepted ]         */
+/*                                                                            */
+/* - lets a sender hold a frame back rather than have it rejected. Only the   */
+/*   interrupt unloads the transmit ring so space seen here stays free        */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPortTransmitSpace(apvSerialPort_t *serialPort,
+                                uint16_t         transmitFrameLength)
+  {
+/******************************************************************************/
+
+  bool transmitSpace = false;
+
+/******************************************************************************/
+
+  if ((serialPort != NULL) && (serialPort->serialPortOpen == true))
+    {
+    if ((serialPort->serialPortTransmitRing.apvCommsRingBufferLength - serialPort->serialPortTransmitRing.apvCommsRingBufferLoad) >= transmitFrameLength)
+      {
+      transmitSpace = true;
+      }
+    }
+
+/******************************************************************************/
+
+  return(transmitSpace);
+
+/******************************************************************************/
+  } /* end of apvSerialPortTransmitSpace                                      */
+
+/******************************************************************************/
+/* apvSerialPortTransmit() :                                                  */
+/*  --> serialPort          : an open port                                    */
+/*  --> transmitFrame       : the framed message                              */
+/*  --> transmitFrameLength : the framed message length                       */
+/*  <-- serialPortError     : error codes                                     */
+/*                                                                            */
+/* - load a whole frame onto the ports' transmit ring or none of it, so       */
+/*   frames are never interleaved or truncated, and start the transmitter if  */
+/*   it is idle. The frame is copied so the caller can release its' buffer    */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialPortTransmit(apvSerialPort_t *serialPort,
+                                     const uint8_t   *transmitFrame,
+                                     uint16_t         transmitFrameLength)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE serialPortError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if ((serialPort == NULL) || (transmitFrame == NULL))
+    {
+    serialPortError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (serialPort->serialPortOpen == false)
+      {
+      serialPortError = APV_ERROR_CODE_CONFIGURATION_ERROR;
+      }
+    else
+      {
+      APV_CRITICAL_REGION_ENTRY();
+
+      if ((serialPort->serialPortTransmitRing.apvCommsRingBufferLength - serialPort->serialPortTransmitRing.apvCommsRingBufferLoad) < transmitFrameLength)
+        {
+        serialPort->serialPortStatistics.framesRejected = serialPort->serialPortStatistics.framesRejected + 1;
+
+        serialPortError = APV_SERIAL_ERROR_CODE_TRANSMITTER_NOT_READY;
+        }
+      else
+        {
+        apvRingBufferLoad(&serialPort->serialPortTransmitRing,
+                           APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                          (uint32_t *)transmitFrame,
+                           transmitFrameLength,
+                           false);
+
+        serialPort->serialPortStatistics.framesTransmitted = serialPort->serialPortStatistics.framesTransmitted + 1;
+
+        // An idle transmitter holding register is empty so "TXRDY" fires as soon as it is enabled
+        if (serialPort->serialPortTransmitActive == false)
+          {
+          serialPort->serialPortTransmitActive    = true;
+          APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_IER, US_IER_TXRDY);
+          }
+        }
+
+      APV_CRITICAL_REGION_EXIT();
+      }
+    }
+
+/******************************************************************************/
+
+  return(serialPortError);
+
+/******************************************************************************/
+  } /* end of apvSerialPortTransmit                                           */
+
+/******************************************************************************/
+/* apvSerialPortInterruptHandler() :                                          */
+/*  --> serialPort : the interrupting port                                    */
+/*                                                                            */
+/* - move received characters onto the receive ring and the next characters   */
+/*   off the transmit ring, for as long as the USART has a character waiting  */
+/*   or room for another up to "APV_SERIAL_INTERRUPT_BATCH_LIMIT" each way.   */
+/*   Received characters are gathered byte-packed and loaded in one call. A   */
+/*   full receive ring loses characters by its' overflow policy; that and any */
+/*   hardware receive error put a gap marker in front of the de-framer        */
+/*                                                                            */
+/******************************************************************************/
+
+void apvSerialPortInterruptHandler(apvSerialPort_t *serialPort)
+  {
+/******************************************************************************/
+
+  uint32_t statusRegister = 0;
+
+  uint8_t  receivedCharacters[APV_SERIAL_INTERRUPT_BATCH_LIMIT],
+           transmitCharacter = 0;
+
+  uint16_t receivedCount     = 0,
+           transmitCount     = 0;
+
+  bool     servicePending    = true;
+
+/******************************************************************************/
+
+  statusRegister = APV_REGISTER_READ(serialPort->serialPortRegisters, US_CSR);
+
+  serialPort->serialPortStatistics.interrupts = serialPort->serialPortStatistics.interrupts + 1;
+
+  while (servicePending == true)
+    {
+    servicePending = false;
+
+    apvSerialPortReceiveErrorCheck(serialPort,
+                                   statusRegister);
+
+    if (((statusRegister & US_CSR_RXRDY) == US_CSR_RXRDY) &&
+        (receivedCount                   <  APV_SERIAL_INTERRUPT_BATCH_LIMIT))
+      {
+      receivedCharacters[receivedCount] = (uint8_t)APV_REGISTER_READ(serialPort->serialPortRegisters, US_RHR);
+      receivedCount                     = receivedCount + 1;
+
+      servicePending = true;
+      }
+
+    if (((statusRegister                          & US_CSR_TXRDY) == US_CSR_TXRDY) &&
+        ((serialPort->serialPortRegisters->US_IMR & US_CSR_TXRDY) == US_CSR_TXRDY) &&
+        (transmitCount                            <  APV_SERIAL_INTERRUPT_BATCH_LIMIT))
+      {
+      if (apvRingBufferUnLoad(&serialPort->serialPortTransmitRing,
+                               APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                              (uint32_t *)&transmitCharacter,
+                               sizeof(uint8_t),
+                               false) != 0)
+        {
+        APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_THR, transmitCharacter);
+
+        transmitCount  = transmitCount + 1;
+        servicePending = true;
+        }
+      else
+        {
+        // No transmit characters left - shut down the transmit interrupt
+        APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_IDR, US_IDR_TXRDY);
+        serialPort->serialPortTransmitActive    = false;
+        }
+      }
+
+    if (servicePending == true)
+      {
+      statusRegister = APV_REGISTER_READ(serialPort->serialPortRegisters, US_CSR);
+      }
+    }
+
+  if (receivedCount != 0)
+    {
+    apvRingBufferReceiveLoad(&serialPort->serialPortReceiveRing,
+                             &serialPort->serialPortReceiveGuard,
+                              APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                             (uint32_t *)&receivedCharacters[0],
+                              receivedCount);
+
+    serialPort->serialPortStatistics.charactersReceived = serialPort->serialPortStatistics.charactersReceived + receivedCount;
+
+    // Wake the background loop to de-frame the new characters
+    serialPort->serialPortReceiveSignal = true;
+    }
+
+  serialPort->serialPortStatistics.charactersTransmitted = serialPort->serialPortStatistics.charactersTransmitted + transmitCount;
+
+/******************************************************************************/
+  } /* end of apvSerialPortInterruptHandler                                   */
+
+/******************************************************************************/
+/* apvSerialPortReceiveErrorCheck() :                                         */
+/*  --> serialPort     : the interrupting port                                */
+/*  --> statusRegister : the latest USART status                              */
+/*                                                                            */
+/* - count and clear any receive errors. The error bits stay set until reset; */
+/*   the de-framer must drop the frame it is in                               */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvSerialPortReceiveErrorCheck(apvSerialPort_t *serialPort,
+                                           uint32_t         statusRegister)
+  {
+/******************************************************************************/
+
+  if ((statusRegister & (US_CSR_OVRE | US_CSR_FRAME | US_CSR_PARE)) != 0)
+    {
+    if ((statusRegister & US_CSR_OVRE) == US_CSR_OVRE)
+      {
+      serialPort->serialPortStatistics.receiveErrors.receiveOverruns = serialPort->serialPortStatistics.receiveErrors.receiveOverruns + 1;
+      }
+
+    if ((statusRegister & US_CSR_FRAME) == US_CSR_FRAME)
+      {
+      serialPort->serialPortStatistics.receiveErrors.receiveFramingErrors = serialPort->serialPortStatistics.receiveErrors.receiveFramingErrors + 1;
+      }
+
+    if ((statusRegister & US_CSR_PARE) == US_CSR_PARE)
+      {
+      serialPort->serialPortStatistics.receiveErrors.receiveParityErrors = serialPort->serialPortStatistics.receiveErrors.receiveParityErrors + 1;
+      }
+
+    APV_REGISTER_COMMAND(serialPort->serialPortRegisters, US_CR, US_CR_RSTSTA);
+    serialPort->serialPortReceiveGuard.receiveGapPending = true;
+    }
+
+/******************************************************************************/
+  } /* end of apvSerialPortReceiveErrorCheck                                  */
+
+/******************************************************************************/
+/* apvSerialPortReceiveSignalled() :                                          */
+/*  --> signalClear     : [ false == leave the port signals set |             */
+/*                          true  == clear the port signals ]                 */
+/*  <-- receiveSignal   : [ false == no port has received characters |        */
+/*                          true  == one or more ports have ]                 */
+/*                                                                            */
+/* - MUST be called with interrupts masked when 'signalClear' is 'true'       */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialPortReceiveSignalled(bool signalClear)
+  {
+/******************************************************************************/
+
+  bool     receiveSignal = false;
+
+  uint16_t portIndex     = 0;
+
+/******************************************************************************/
+
+  for (portIndex = APV_PRIMARY_SERIAL_PORT_USART0; portIndex < APV_SERIAL_PORTS; portIndex++)
+    {
+    if (apvSerialPorts[portIndex].serialPortReceiveSignal == true)
+      {
+      receiveSignal = true;
+
+      if (signalClear == true)
+        {
+        apvSerialPorts[portIndex].serialPortReceiveSignal = false;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(receiveSignal);
+
+/******************************************************************************/
+  } /* end of apvSerialPortReceiveSignalled                                   */
+
+/******************************************************************************/
+/* apvSerialPortDeFrameAll() :                                                */
+/*                                                                            */
+/* - run every open ports' de-framer over its' receive ring. Completed frames */
+/*   are routed by the de-framer to the component serving the frames'         */
+/*   inbound planes                                                           */
+/*                                                                            */
+/******************************************************************************/
+
+void apvSerialPortDeFrameAll(void)
+  {
+/******************************************************************************/
+
+  uint16_t portIndex = 0;
+
+/******************************************************************************/
+
+  for (portIndex = APV_PRIMARY_SERIAL_PORT_USART0; portIndex < APV_SERIAL_PORTS; portIndex++)
+    {
+    if (apvSerialPorts[portIndex].serialPortOpen == true)
+      {
+      apvDeFrameMessage(&apvSerialPorts[portIndex].serialPortDeFramer[0]);
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvSerialPortDeFrameAll                                         */
+
+/******************************************************************************/
+/* USARTn Handlers :                                                          */
+/*  - USART interrupt handlers (replace the "weak" default definitions). The  */
+/*    pending bit is cleared on entry; clearing it again on the way out would */
+/*    lose a request raised while the handler was running. A serial interrupt */
+/*    is not scheduled so only its' service time is kept                      */
+/******************************************************************************/
+
+void USART0_Handler(void)
+  {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
+/******************************************************************************/
+
+  apvSerialPortInterruptHandler(&apvSerialPorts[APV_PRIMARY_SERIAL_PORT_USART0]);
+
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_USART0,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
+
+/******************************************************************************/
+  } /* end of USART0_Handler                                                  */
+
+/******************************************************************************/
+
+void USART1_Handler(void)
+  {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
+/******************************************************************************/
+
+  apvSerialPortInterruptHandler(&apvSerialPorts[APV_PRIMARY_SERIAL_PORT_USART1]);
+
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_USART1,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
+
+/******************************************************************************/
+  } /* end of USART1_Handler                                                  */
+
+/******************************************************************************/
+
+void USART2_Handler(void)
+  {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
+/******************************************************************************/
+
+  apvSerialPortInterruptHandler(&apvSerialPorts[APV_PRIMARY_SERIAL_PORT_USART2]);
+
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_USART2,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
+
+/******************************************************************************/
+  } /* end of USART2_Handler                                                  */
+
+/******************************************************************************/
+
+void USART3_Handler(void)
+  {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
+/******************************************************************************/
+
+  apvSerialPortInterruptHandler(&apvSerialPorts[APV_PRIMARY_SERIAL_PORT_USART3]);
+
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_USART3,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
+
+/******************************************************************************/
+  } /* end of USART3_Handler                                                  */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,106 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvSerialPort.h                                                            */
+/* 14.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - per-port serial driver for the USARTs : each port owns its' receive and  */
+/*   transmit rings, interrupt handler, de-framer and statistics and is bound */
+/*   to the matching comms plane. The UART stays on the primary serial driver */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_SERIAL_PORT_H_
+#define _APV_SERIAL_PORT_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sam3x8e.h>
+#include "ApvError.h"
+#include "ApvUtilities.h"
+#include "ApvCommsUtilities.h"
+#include "ApvMessageHandling.h"
+#include "ApvSerial.h"
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define APV_SERIAL_PORTS                   APV_PRIMARY_SERIAL_PORT_UART // USART0 - 3; the UART is the primary serial port
+
+#define APV_SERIAL_PORT_RECEIVE_RING_LENGTH  APV_COMMS_RING_BUFFER_MAXIMUM_LENGTH
+#define APV_SERIAL_PORT_TRANSMIT_RING_LENGTH APV_COMMS_RING_BUFFER_MAXIMUM_LENGTH
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef struct apvSerialPortStatistics_tTag
+  {
+  uint32_t                 interrupts;
+  uint32_t                 charactersReceived;
+  uint32_t                 charactersTransmitted;
+  uint32_t                 framesTransmitted;
+  uint32_t                 framesRejected;             // no room on the transmit ring for the whole frame
+  apvSerialReceiveErrors_t receiveErrors;              // hardware receive errors
+  } apvSerialPortStatistics_t;
+
+typedef struct apvSerialPort_tTag
+  {
+  apvPrimarySerialPort_t        serialPortId;
+  apvCommsPlanes_t              serialPortCommsPlane;  // the comms plane this port carries
+  apvPeripheralId_t             serialPortPeripheralId;
+  Usart                        *serialPortRegisters;
+  bool                          serialPortOpen;
+  apvRingBuffer_t               serialPortReceiveRing;
+  apvRingBufferReceiveGuard_t   serialPortReceiveGuard;    // receive ring overflow policy, gap marking and losses
+  apvRingBuffer_t               serialPortTransmitRing;
+  volatile bool                 serialPortTransmitActive;
+  volatile bool                 serialPortReceiveSignal;   // new characters for the de-framer
+  apvRingBuffer_t              *serialPortMessageBuffers;  // the de-framers' free message buffer pool
+  apvMessagingDeFramingState_t  serialPortDeFramer[APV_MESSAGE_FRAME_STATES];
+  apvMessagingStateVariables_t  serialPortDeFramerVariables;
+  uint32_t                      serialPortBaudRate;
+  apvSerialPortStatistics_t     serialPortStatistics;
+  } apvSerialPort_t;
+
+/******************************************************************************/
+/* Global Variable Declarations :                                             */
+/******************************************************************************/
+
+extern apvSerialPort_t apvSerialPorts[APV_SERIAL_PORTS];
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern APV_ERROR_CODE   apvSerialPortInitialise(void);
+extern APV_ERROR_CODE   apvSerialPortOpen(apvPrimarySerialPort_t  serialPortId,
+                                          uint32_t                serialPortBaudRate,
+                                          apvRingBuffer_t        *serialPortMessageBuffers,
+                                          uint32_t               *serialPortBaudRateActual,
+                                          int32_t                *serialPortBaudRateError);
+extern APV_ERROR_CODE   apvSerialPortClose(apvPrimarySerialPort_t serialPortId);
+extern apvSerialPort_t *apvSerialPortFindByCommsPlane(apvCommsPlanes_t commsPlane);
+extern APV_ERROR_CODE   apvSerialPortTransmit(apvSerialPort_t *serialPort,
+                                              const uint8_t   *transmitFrame,
+                                              uint16_t         transmitFrameLength);
+extern bool             apvSerialPortTransmitSpace(apvSerialPort_t *serialPort,
+                                                   uint16_t         transmitFrameLength);
+extern void             apvSerialPortInterruptHandler(apvSerialPort_t *serialPort);
+extern bool             apvSerialPortReceiveSignalled(bool signalClear);
+extern void             apvSerialPortDeFrameAll(void);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
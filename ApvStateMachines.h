@@ -51,7 +51,7 @@ typedef enum apvGenericStates_tTag
   APV_GENERIC_STATES
   } apvGenericStates_t;
 
-typedef uint32_t  apvGenericVariable_t; // generic state-variable type
+typedef uintptr_t apvGenericVariable_t; // generic state-variable type : wide enough to carry a pointer
 
 typedef void     *apvGenericResults_t;
 
@@ -31,7 +31,9 @@ APV_GLOBAL_ERROR_FLAG  apvGlobalErrorFlags                          = APV_GLOBAL
 uint32_t               apvInterruptCounters[APV_INTERRUPT_COUNTERS] = { 0x00000000, 0x00000000 };
 
 // This definition avoids extravagant casting effort from the Atmel constants
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
 Pio  ApvPeripheralLineControlBlock[APV_PERIPHERAL_LINE_GROUPS];    // shadow PIO control blocks
+#endif
 Pio *ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUPS] = // physical block addresses
   {
   APV_PIO_BLOCK_A,
@@ -35,11 +35,11 @@
                                                  // and start at an "ID" offset to avoid the Atmel MCU ids (sam3x8e.h)
 
 
-// The physical addresses of the four peripheral I/O controller blocks
-#define APV_PIO_BLOCK_A ((Pio *)0x400E0E00U)
-#define APV_PIO_BLOCK_B ((Pio *)0x400E1000U)
-#define APV_PIO_BLOCK_C ((Pio *)0x400E1200U)
-#define APV_PIO_BLOCK_D ((Pio *)0x400E1400U)
+// The four peripheral I/O controller blocks ("sam3x8e.h" : 0x400E0E00, 0x400E1000, 0x400E1200, 0x400E1400)
+#define APV_PIO_BLOCK_A PIOA
+#define APV_PIO_BLOCK_B PIOB
+#define APV_PIO_BLOCK_C PIOC
+#define APV_PIO_BLOCK_D PIOD
 
 
 #define  APV_SYSTEM_INTERRUPT_ID_NMI                      ((int16_t)-14)
@@ -111,19 +111,6 @@ typedef enum apvPeripheralId_tTag
   APV_PERIPHERAL_IDS
   } apvPeripheralId_t;
 
-typedef enum apvPointerConversionWords_tTag
-  {
-  APV_POINTER_CONVERSION_WORD_LOW = 0,
-  APV_POINTER_CONVERSION_WORD_HIGH,
-  APV_POINTER_CONVERSION_WORDS
-  } apvPointerConversionWords_t;
-
-typedef union apvPointerConversion_tTag
-  {
-  uint32_t apvPointerConversionWords[APV_POINTER_CONVERSION_WORDS]; // map the low-word to [0], high-word to [1]
-  uint32_t apvPointerConversion;
-  } apvPointerConversion_t;
-
 typedef enum apvInterruptCounters_tTag
   {
   APV_TRANSMIT_INTERRUPT_COUNTER = 0,
@@ -145,7 +132,9 @@ extern int16_t                apvInterruptNestingCount;
 extern APV_GLOBAL_ERROR_FLAG  apvGlobalErrorFlags;
 extern uint32_t               apvInterruptCounters[APV_INTERRUPT_COUNTERS];
 
+#ifdef _APV_DEBUG_REGISTER_SHADOWS_
 extern Pio                     ApvPeripheralLineControlBlock[APV_PERIPHERAL_LINE_GROUPS];   // shadow PIO control blocks
+#endif
 extern Pio                    *ApvPeripheralLineControlBlock_p[APV_PERIPHERAL_LINE_GROUPS]; // physical block addresses
 
 /******************************************************************************/
@@ -22,19 +22,27 @@
 #include "ApvControlPortProtocol.h"
 #include "ApvMessageHandling.h"
 #include "ApvMessagingLayerManager.h"
+#include "ApvSerialPort.h"
 #include "ApvLsm9ds1.h"
+#include "ApvInterruptLatency.h"
+#include "ApvScheduler.h"
 
 /******************************************************************************/
 /* Constant Definitions :                                                     */
 /******************************************************************************/
 
-#define APV_RUN_TIME_TX_MODULUS ((uint64_t)1024)
+#define APV_RUN_TIME_TX_MODULUS        ((uint64_t)1024)
+
+#define APV_MESSAGING_TICK_TASK_PERIOD ((uint32_t)1000) // microseconds
 
 /******************************************************************************/
 /* Local Variable Definitions :                                               */
 /******************************************************************************/
 
-static uint32_t apvDurationTimer0Index = APV_DURATION_TIMER_NULL_INDEX; // the first countdown timer is an 150usecs timer
+#ifdef _APV_DEBUG_DURATION_STROBE_
+static apvDurationTimerHandle_t apvDurationTimer0Handle     = APV_DURATION_TIMER_NULL_HANDLE; // the first countdown timer is an 150usecs timer
+#endif
+static uint16_t                 apvMessagingTickTaskIndex   = APV_SCHEDULER_NULL_TASK;
 
 /******************************************************************************/
 /* Local Function Declarations :                                              */
@@ -42,6 +50,8 @@ static uint32_t apvDurationTimer0Index = APV_DURATION_TIMER_NULL_INDEX; // the f
 
 int main(void);
 
+static void apvMessagingTickTask(void *taskContext);
+
 /******************************************************************************/
 /* Function Definitions :                                                     */
 /******************************************************************************/
@@ -51,13 +61,19 @@ int main(void)
 /******************************************************************************/
 
            APV_SERIAL_ERROR_CODE  apvSerialErrorCode        = APV_SERIAL_ERROR_CODE_NONE;
-  volatile uint64_t               apvRunTimeCounter         = 0,
-                                  apvRunTimeCounterOld      = 0;
+  volatile uint64_t               apvRunTimeCounter         = 0;
 
-           bool                   apvPrimarySerialPortStart = false;
+           bool                   apvPrimarySerialPortStart = false,
+                                  apvMessagingWorkPending   = true;  // the first pass always runs
 
            uint16_t components                              = 0,
-                    messageCount                            = 0;
+                    serialPort                              = 0,
+                    serialPortComponent                     = 0;
+
+           uint64_t serviceStart                            = 0;
+
+           uint32_t apvUartBaudRateActual                   = 0;
+           int32_t  apvUartBaudRateError                    = 0;
 
            int16_t  interruptSource                         = 0;
            uint8_t  interruptPriority                       = 0;
@@ -74,9 +90,18 @@ int main(void)
                                                &apvMessagingLayerFreeBuffers[0],
                                                 APV_MESSAGING_LAYER_FREE_MESSAGE_BUFFER_SET_SIZE);
 
-  // Initialise the array of message layer handling components
+  // Initialise the whole message layer handling component table and the plane routes
   apvSerialErrorCode = apvMessagingLayerComponentInitialise(&apvMessagingLayerComponents[0],
-                                                             APV_MESSAGING_LAYER_COMPONENT_ENTRIES);
+                                                             APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE);
+
+  // Clear the messaging layer publish/subscribe lists
+  apvSerialErrorCode = apvMessagingLayerSubscriptionInitialise();
+
+  // Clear the messaging layer components' residency and service time statistics
+  apvSerialErrorCode = apvMessagingLayerStatisticsInitialise();
+
+  // Start the cycle counter and clear the interrupt latency figures before any interrupt is enabled
+  apvSerialErrorCode = apvInterruptLatencyInitialise();
 
   // Load the serial UART messaging layer received message interpreter
   apvSerialErrorCode = apvMessagingLayerComponentLoad( APV_PLANE_SERIAL_UART_CONTROL_0,
@@ -100,6 +125,18 @@ int main(void)
                                                        APV_SIGNAL_PLANE_CONTROL_1,
                                                       &apvMessagingLayerSerialUARTOutputHandler);
 
+  // Hold requests while there is no response buffer and responses while the transmitter is full
+  apvSerialErrorCode = apvMessagingLayerComponentGate( APV_PLANE_SERIAL_UART_CONTROL_0,
+                                                      &apvMessagingLayerSerialUARTInputReady);
+
+  apvSerialErrorCode = apvMessagingLayerComponentGate( APV_PLANE_SERIAL_UART_CONTROL_1,
+                                                      &apvMessagingLayerSerialUARTOutputReady);
+
+  // Build the command protocol dispatch table (perfect hash over the command identifiers)
+  apvSerialErrorCode = apvCommandProtocolBuildDispatch(&apvCommandProtocol[0],
+                                                        APV_COMMAND_PROTOCOL_MESSAGE_DEFINITIONS,
+                                                       &apvCommandProtocolDispatch);
+
   /******************************************************************************/
   /* Set all the interrupt source priorities to the lowest possible, for all    */
   /* configurable priorities                                                    */
@@ -112,7 +149,7 @@ int main(void)
       {
       apvSetInterruptPriority( interruptSource,
                                APV_DEVICE_INTERRUPT_PRIORITY_BASE,
-                              &apvInterruptPriorities[0]);
+                               APV_DEVICE_INTERRUPT_PRIORITY_RECORD);
       }
     }
 
@@ -122,7 +159,12 @@ int main(void)
 
   apvSetInterruptPriority( APV_SYSTEM_INTERRUPT_ID_SYSTEM_TICK,
                            APV_DEVICE_INTERRUPT_PRIORITY_SYSTICK,
-                          &apvInterruptPriorities[0]);
+                           APV_DEVICE_INTERRUPT_PRIORITY_RECORD);
+
+  // ...and the timestamp channel compare that replaces it in tickless mode
+  apvSetInterruptPriority( APV_EVENT_TIMER_TIMESTAMP_ID,
+                           APV_DEVICE_INTERRUPT_PRIORITY_SYSTICK,
+                           APV_DEVICE_INTERRUPT_PRIORITY_RECORD);
 
   /******************************************************************************/
 
@@ -131,7 +173,9 @@ int main(void)
 
   apvSerialErrorCode = apvAssignEventTimer( APV_EVENT_TIMER_GENERAL_PURPOSE_ID,
                                            &apvEventTimerBlock[APV_EVENT_TIMER_0], // BASE ADDRESS
-                                            apvEventTimerChannel0CallBack);
+                                            apvEventTimerHotShotCallBack,
+                                            NULL,
+                                            TC_SR_CPCS);
 
   // Set the general-purpose (system tick) timebase to 1 millisecond (1000000 nanoseconds)
   apvEventTimerGeneralPurposeTimeBaseTarget = APV_EVENT_TIMER_GENERAL_PURPOSE_TIME_BASE;
@@ -156,6 +200,47 @@ int main(void)
                                                    &apvEventTimerBlock[APV_EVENT_TIMER_0],
                                                     true);
 
+  /******************************************************************************/
+  /* The free-running timestamp counter and the chained channel counting its'   */
+  /* wraps : the 64-bit time base for latency, sample timestamps and profiling  */
+  /******************************************************************************/
+
+  apvSerialErrorCode = apvAssignEventTimer( APV_EVENT_TIMER_TIMESTAMP_ID,
+                                           &apvEventTimerBlock[APV_EVENT_TIMER_0], // BASE ADDRESS
+                                            apvDurationTimerTicklessCallBack,
+                                            &apvCoreTimeBaseBlock,
+                                            TC_SR_CPBS);
+
+  apvSerialErrorCode = apvAssignEventTimer( APV_EVENT_TIMER_TIMESTAMP_HIGH_ID,
+                                           &apvEventTimerBlock[APV_EVENT_TIMER_0], // BASE ADDRESS
+                                            NULL,                                   // counts only : no interrupts
+                                            NULL,
+                                            0);
+
+  // The channel registers are only writeable with the peripheral clock running
+  apvSerialErrorCode = apvSwitchPeripheralClock(ID_TC1,
+                                                true);
+
+  apvSerialErrorCode = apvSwitchPeripheralClock(ID_TC2,
+                                                true);
+
+  apvSerialErrorCode = apvConfigureFreeRunningEventTimer( APV_EVENT_TIMER_TIMESTAMP_ID,
+                                                         &apvEventTimerBlock[APV_EVENT_TIMER_0],
+                                                          APV_EVENT_TIMER_TIMESTAMP_CLOCK);
+
+  apvSerialErrorCode = apvConfigureChainedEventTimer( APV_EVENT_TIMER_TIMESTAMP_ID,
+                                                      APV_EVENT_TIMER_TIMESTAMP_HIGH_ID,
+                                                     &apvEventTimerBlock[APV_EVENT_TIMER_0]);
+
+  // The chained channel first so it is counting before the first TIOA edge
+  apvSerialErrorCode = apvSwitchWaveformEventTimer( APV_EVENT_TIMER_TIMESTAMP_HIGH_ID,
+                                                   &apvEventTimerBlock[APV_EVENT_TIMER_0],
+                                                    true);
+
+  apvSerialErrorCode = apvSwitchWaveformEventTimer( APV_EVENT_TIMER_TIMESTAMP_ID,
+                                                   &apvEventTimerBlock[APV_EVENT_TIMER_0],
+                                                    true);
+
   // Default to using the UART for primary serial comms
   apvSerialErrorCode = apvSerialCommsManager(APV_PRIMARY_SERIAL_PORT_UART,
                                              APV_PRIMARY_SERIAL_RING_BUFFER_SET);
@@ -170,17 +255,94 @@ int main(void)
   apvSerialErrorCode = apvControlUart(APV_UART_CONTROL_ACTION_RESET_STATUS);
   apvSerialErrorCode = apvControlUart(APV_UART_CONTROL_ACTION_ENABLE);
 
-  apvSerialErrorCode = apvConfigureUart(APV_UART_PARITY_NONE,
-                                        APV_UART_CHANNEL_MODE_NORMAL,
-                                        APV_UART_BAUD_RATE_SELECT_19200);
+  // The link always signs on at the same rate; the host negotiates it upwards from there
+  apvSerialErrorCode = apvConfigureUart( APV_UART_PARITY_NONE,
+                                         APV_UART_CHANNEL_MODE_NORMAL,
+                                         APV_UART_BAUD_RATE_SIGN_ON,
+                                        &apvUartBaudRateActual,
+                                        &apvUartBaudRateError);
+
+  apvSerialErrorCode = apvSerialBaudRateInitialise(&apvPrimarySerialBaudRate,
+                                                    APV_UART_BAUD_RATE_SIGN_ON);
+
+  // A full receive ring never stops the receiver : the overflow policy decides what is lost
+  apvSerialErrorCode = apvRingBufferReceiveGuardInitialise(&apvPrimarySerialReceiveGuard,
+                                                            APV_SERIAL_RECEIVE_OVERFLOW_POLICY);
+
+  // Receive by PDC block : the landing blocks MUST be loaded before the PDC receive is switched on
+  apvSerialErrorCode = apvSerialPdcReceiveInitialise(&apvPrimarySerialPdcReceive,
+                                                      PDC_UART,
+                                                      apvPrimarySerialCommsReceiveBuffer,
+                                                     &apvPrimarySerialReceiveGuard);
 
   // SWITCH ON THE NVIC/UART IRQ
-  apvSerialErrorCode = apvUartSwitchInterrupt(APV_UART_INTERRUPT_SELECT_RECEIVE,
-                                              true);
+  if (apvSerialErrorCode == APV_ERROR_CODE_NONE)
+    {
+    apvPrimarySerialReceiveMode = APV_SERIAL_RECEIVE_MODE_PDC;
+
+    apvSerialErrorCode = apvUartSwitchInterrupt(APV_UART_INTERRUPT_SELECT_RECEIVE_PDC,
+                                                true);
+    }
+  else
+    {
+    apvSerialErrorCode = apvUartSwitchInterrupt(APV_UART_INTERRUPT_SELECT_RECEIVE,
+                                                true);
+    }
+
+  // Transmit by PDC frame : the ENDTX interrupt is only enabled while frames are queued
+  if (apvSerialPdcTransmitInitialise(&apvPrimarySerialPdcTransmit,
+                                      PDC_UART) == APV_ERROR_CODE_NONE)
+    {
+    apvPrimarySerialTransmitMode = APV_SERIAL_TRANSMIT_MODE_PDC;
+    }
 
   apvSerialErrorCode = apvSwitchNvicDeviceIrq(APV_PERIPHERAL_ID_UART,
                                               true);
 
+  /******************************************************************************/
+  /* The USART ports run alongside the UART as independent links, each on its'  */
+  /* own comms plane with an input/output component pair. USART2 stays closed : */
+  /* its' receive line PB21 is SPI0_NPCS2. The ports share the serial UART free */
+  /* message buffer pool                                                        */
+  /******************************************************************************/
+
+  apvSerialErrorCode = apvSerialPortInitialise();
+
+  for (serialPort = APV_PRIMARY_SERIAL_PORT_USART0; serialPort < APV_SERIAL_PORTS; serialPort++)
+    {
+    if (serialPort != APV_PRIMARY_SERIAL_PORT_USART2)
+      {
+      if (apvSerialPortOpen((apvPrimarySerialPort_t)serialPort,
+                             APV_UART_BAUD_RATE_SIGN_ON,
+                            &apvMessageSerialUartFreeBufferSet,
+                            &apvUartBaudRateActual,
+                            &apvUartBaudRateError) == APV_ERROR_CODE_NONE)
+        {
+        apvSerialErrorCode = apvMessagingLayerComponentRegister(&apvMessageSerialUartFreeBufferSet,                          // serial port free buffer set/pool
+                                                                &apvMessagingLayerFreeBufferSet,                             // messaging layer free buffer set/pool
+                                                                &apvMessagingLayerComponentSerialPortRxBuffer[serialPort],   // serial port component input ring
+                                                                 apvSerialPorts[serialPort].serialPortCommsPlane,
+                                                                 APV_SIGNAL_PLANE_CONTROL_0,
+                                                                &apvMessagingLayerSerialUARTInputHandler,
+                                                                &serialPortComponent);
+
+        apvSerialErrorCode = apvMessagingLayerComponentGate( serialPortComponent,
+                                                            &apvMessagingLayerSerialUARTInputReady);
+
+        apvSerialErrorCode = apvMessagingLayerComponentRegister(&apvMessagingLayerFreeBufferSet,                             // messaging layer free buffer set/pool
+                                                                &apvMessageSerialUartFreeBufferSet,                          // serial port free buffer set/pool
+                                                                &apvMessagingLayerComponentSerialPortTxBuffer[serialPort],   // serial port component output ring
+                                                                 apvSerialPorts[serialPort].serialPortCommsPlane,
+                                                                 APV_SIGNAL_PLANE_CONTROL_1,
+                                                                &apvMessagingLayerSerialPortOutputHandler,
+                                                                &serialPortComponent);
+
+        apvSerialErrorCode = apvMessagingLayerComponentGate( serialPortComponent,
+                                                            &apvMessagingLayerSerialPortOutputReady);
+        }
+      }
+    }
+
 #if (0)
   /******************************************************************************/
   /* SPI Setup :                                                                */
@@ -267,35 +429,61 @@ int main(void)
   // Assign a dummy SPI timer for this test
   /* apvSerialErrorCode = apvAssignDurationTimer(&apvCoreTimeBaseBlock,
                                                apvSpiStateTimer,
+                                               NULL,
                                                APV_DURATION_TIMER_TYPE_PERIODIC,
                                                APV_CORE_TIMER_CLOCK_MINIMUM_INTERVAL,
                                                APV_DURATION_TIMER_SOURCE_RTT,
-                                              &spiTimerIndex); */
+                                              &spiTimerHandle); */
+
+  // Switch on the peripheral I/O "C" channel clock
+  apvSerialErrorCode = apvSwitchPeripheralClock(ID_PIOC,
+                                                true);
 
+#ifdef _APV_DEBUG_DURATION_STROBE_
+  // Toggle the timer strobe every minimum period to scope the duration timers. This
+  // costs a compare interrupt every 150us in tickless mode so it is a debug opt-in
   apvSerialErrorCode = apvAssignDurationTimer(&apvCoreTimeBaseBlock,
                                                apvDurationStateTimer,
+                                               NULL,
                                                APV_DURATION_TIMER_TYPE_PERIODIC,
                                                APV_SYSTEM_TIMER_CLOCK_MINIMUM_PERIOD,
                                                APV_DURATION_TIMER_SOURCE_SYSTICK,
-                                              &apvDurationTimer0Index);
-
-  // Switch on the peripheral I/O "C" channel clock
-  apvSerialErrorCode = apvSwitchPeripheralClock(ID_PIOC,
-                                                true);
+                                              &apvDurationTimer0Handle);
 
   // Switch on the timer strobe
   apvSerialErrorCode = apvSwitchResourceLines(APV_RESOURCE_ID_STROBE_0,
                                               true);
+#endif
 
   // Switch on the core timer interrupt
   /* apvSerialErrorCode = apvSwitchNvicDeviceIrq(APV_CORE_TIMER_ID,
                                               true); */
 
-  apvSerialErrorCode = apvStartSystemTimer(&apvCoreTimeBaseBlock);
+  // Tickless : the duration timers only interrupt when one is due. The periodic
+  // tick is 'apvStartSystemTimer()' instead
+  /* apvSerialErrorCode = apvStartSystemTimer(&apvCoreTimeBaseBlock); */
+
+  apvSerialErrorCode = apvStartTicklessTimer(&apvCoreTimeBaseBlock);
+
+  apvSerialErrorCode = apvSwitchNvicDeviceIrq(APV_EVENT_TIMER_TIMESTAMP_ID,
+                                              true);
 
   apvSerialErrorCode = apvInitialiseLsm9ds1(ApvSpi0ControlBlock_p,
                                             &apvCoreTimeBaseBlock);
 
+  // The periodic main loop work is registered with the scheduler rather than written into the
+  // loop. The tasks are registered last so the sensor start-up is not counted against them
+  apvSerialErrorCode = apvSchedulerInitialise(&apvCoreTimeBaseBlock);
+
+  apvSerialErrorCode = apvSchedulerTaskAssign( apvMessagingTickTask,
+                                              &apvMessagingWorkPending,
+                                               "messaging tick",
+                                               APV_MESSAGING_TICK_TASK_PERIOD,
+                                               APV_SCHEDULER_PRIORITY_HIGHEST,
+                                               APV_SCHEDULER_DEADLINE_PERIOD,
+                                               APV_SCHEDULER_BUDGET_UNLIMITED,
+                                              &apvMessagingTickTaskIndex);
+
 /******************************************************************************/
 
   if (apvSerialErrorCode == APV_SERIAL_ERROR_CODE_NONE)
@@ -312,9 +500,7 @@ int main(void)
          {
          apvEventTimerHotShot.Flags.APV_EVENT_TIMER_CHANNEL_0_FLAG = APV_EVENT_TIMER_FLAG_CLEAR;
 
-         apvRunTimeCounterOld = apvRunTimeCounter;
-
-         apvRunTimeCounter    = apvRunTimeCounter + 1;
+         apvRunTimeCounter = apvRunTimeCounter + 1;
          }
 
        /******************************************************************************/
@@ -328,15 +514,52 @@ int main(void)
          apvCoreTimerFlag           = APV_CORE_TIMER_FLAG_LOW;
          }
 
+       /******************************************************************************/
+       /* This is the messaging "work" event detector : the receive interrupt flags  */
+       /* new characters for the de-framer                                          */
+       /******************************************************************************/
+
+       if (receiveInterrupt == true)
+         {
+         receiveInterrupt        = false;
+         apvMessagingWorkPending = true;
+         }
+
+       if (apvSerialPortReceiveSignalled(true) == true)
+         {
+         apvMessagingWorkPending = true;
+         }
+
        __enable_irq();
 
        /******************************************************************************/
-       /* FOR NOW, AT EACH MILLISECOND...                                            */
+       /* The core-timer interrupt only lists the process timers that expired : run  */
+       /* their callbacks here at thread level                                       */
+       /******************************************************************************/
+
+       if (apvCoreTimerBackgroundFlag == APV_CORE_TIMER_FLAG_HIGH)
+         {
+         apvCoreTimerBackgroundFlag = APV_CORE_TIMER_FLAG_LOW;
+
+         apvSerialErrorCode = apvRunDurationTimerCallBacks(&apvCoreTimeBaseBlock);
+         }
+
+       /******************************************************************************/
+       /* Periodic jobs are scheduler tasks : run every task that has been released */
        /******************************************************************************/
 
-       if (apvRunTimeCounterOld != apvRunTimeCounter)
+       apvSerialErrorCode = apvSchedulerService();
+
+       /******************************************************************************/
+       /* Messaging runs to completion as soon as work is signalled : de-frame all   */
+       /* received characters, then service every component with waiting messages.  */
+       /* If any component ran it may have routed messages on to another component  */
+       /* so go round again before sleeping                                          */
+       /******************************************************************************/
+
+       if (apvMessagingWorkPending == true)
          {
-         apvRunTimeCounterOld = apvRunTimeCounter;
+         apvMessagingWorkPending = false;
 
          /******************************************************************************/
          /* Low-level message input de-framing is handled here :                       */
@@ -371,6 +594,9 @@ int main(void)
          // Run the serial UART comms message state-machine
          apvSerialErrorCode = apvDeFrameMessage(&apvMessagingDeFramingStateMachine[0]);
 
+         // Run each open USART ports' own message state-machine
+         apvSerialPortDeFrameAll();
+
          /******************************************************************************/
          /* The second level of any message activity is handled here :                 */
          /*                                                                            */
@@ -389,32 +615,26 @@ int main(void)
          /* before acting on it                                                        */
          /******************************************************************************/
 
-         for (components = 0; components < APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE; components++)
-           { // Visit each CHANNEL once at each pass
-           if (apvMessagingLayerComponents[components].messagingLayerComponentLoaded == true)
-             { // Check if the component is loaded
-             if (apvRingBufferReportFillState( apvMessagingLayerComponents[components].messagingLayerInputBuffers,
-                                              &messageCount,
-                                               true) == APV_ERROR_CODE_NONE)
-               { // Only service components that have messages waiting at their input ports
-               if (messageCount != 0)
-                 {
-                 apvMessagingLayerComponentReady[components] = true;
-                 }
-               else
-                 {
-                 apvMessagingLayerComponentReady[components] = false;
-                 }
-               }
-             }
+         for (components = 0; components < apvMessagingLayerComponentCount; components++)
+           { // Visit each CHANNEL once at each pass. Only service loaded components that have 
+             // messages waiting at their input ports and whose gate (if any) is open
+           apvMessagingLayerComponentReady[components] = apvMessagingLayerComponentWaiting(components);
            }
 
-         for (components = 0; components < APV_MESSAGING_LAYER_COMPONENT_ENTRIES_SIZE; components++)
+         for (components = 0; components < apvMessagingLayerComponentCount; components++)
            {
            if (apvMessagingLayerComponentReady[components] == true)
              {
+             serviceStart = apvEventTimerTimestamp64();
+
              apvMessagingLayerComponents[components].messagingLayerServiceManager(&apvMessagingLayerComponents[components],
                                                                                   (apvMessagingLayerComponent_t *)&apvMessagingLayerComponents);
+
+             apvMessagingLayerRecordService(components,
+                                            serviceStart,
+                                            apvEventTimerTimestamp64());
+
+             apvMessagingWorkPending = true;
              }
            }
 
@@ -422,6 +642,40 @@ int main(void)
 
          }
 
+       /******************************************************************************/
+       /* A negotiated baud rate change waits for messaging to settle so the         */
+       /* response to the request has been handed to the transmitter first          */
+       /******************************************************************************/
+
+       if (apvMessagingWorkPending == false)
+         {
+         apvSerialBaudRateService(&apvPrimarySerialBaudRate,
+                                  (uint32_t)apvRunTimeCounter);
+         }
+
+       /******************************************************************************/
+       /* Nothing left to do : sleep until the next interrupt. The flags are checked */
+       /* with interrupts masked so an event arriving after the check still wakes    */
+       /* the core from "WFI" (a pending interrupt ends "WFI" even when masked) and  */
+       /* is serviced as soon as interrupts are unmasked again                       */
+       /******************************************************************************/
+
+       __disable_irq();
+
+       if ((apvMessagingWorkPending                                   == false)                      &&
+           (receiveInterrupt                                          == false)                      &&
+           (apvSerialPortReceiveSignalled(false)                      == false)                      &&
+           (apvMessagingLayerComponentsWaiting()                      == false)                      &&
+           (apvSchedulerReady()                                       == false)                      &&
+           (apvEventTimerHotShot.Flags.APV_EVENT_TIMER_CHANNEL_0_FLAG == APV_EVENT_TIMER_FLAG_CLEAR) &&
+           (apvCoreTimerFlag                                          == APV_CORE_TIMER_FLAG_LOW))
+         {
+         __DSB();
+         __WFI();
+         }
+
+       __enable_irq();
+
 #if (0)
        if (receiveInterrupt == true)
          {
@@ -468,20 +722,6 @@ int main(void)
        __enable_irq();
 #endif
 
-      /******************************************************************************/
-      /* Run scheduled tasks in the background                                      */
-      /******************************************************************************/
-      /* TASK 1 : run the core-timer to derive process-based timers                 */
-      /******************************************************************************/
-
- /*     if (apvCoreTimerBackgroundFlag == APV_CORE_TIMER_FLAG_HIGH)
-        {
-        apvCoreTimerBackgroundFlag = APV_CORE_TIMER_FLAG_LOW;
-
-        // Execute any assigned process timers
-        apvSerialErrorCode = apvExecuteDurationTimers(&apvCoreTimeBaseBlock);
-        } */
-
       /******************************************************************************/
       }
     }
@@ -493,6 +733,34 @@ int main(void)
 /******************************************************************************/
   } /* end of main                                                            */
 
+/******************************************************************************/
+/* apvMessagingTickTask() :                                                   */
+/*  --> taskContext : the main loops' messaging work flag ('bool *')          */
+/*                                                                            */
+/* - scheduler task : run a messaging pass every tick so nothing signalled    */
+/*   can be stranded for longer than a tick, and hand any part-filled PDC     */
+/*   receive block to the de-framer once the line goes quiet                  */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvMessagingTickTask(void *taskContext)
+  {
+/******************************************************************************/
+
+  bool *messagingWorkPending = (bool *)taskContext;
+
+/******************************************************************************/
+
+  *messagingWorkPending = true;
+
+  if (apvPrimarySerialReceiveMode == APV_SERIAL_RECEIVE_MODE_PDC)
+    {
+    apvSerialPdcReceiveIdleFlush(&apvPrimarySerialPdcReceive);
+    }
+
+/******************************************************************************/
+  } /* end of apvMessagingTickTask                                            */
+
 /******************************************************************************/
 /* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
 /******************************************************************************/
@@ -19,8 +19,11 @@
 #include "ApvUtilities.h"
 #include "ApvError.h"
 #include "ApvSerial.h"
+#include "ApvRegisterAccess.h"
 #include "ApvPeripheralControl.h"
 #include "ApvCommsUtilities.h"
+#include "ApvEventTimers.h"
+#include "ApvInterruptLatency.h"
 
 /******************************************************************************/
 /* Global Variable Definitions :                                              */
@@ -60,12 +63,32 @@ apvRingBuffer_t *apvPrimarySerialCommsTransmitBuffer = NULL;
 
 uint8_t          apvPrimarySerialBufferIndex         = APV_PRIMARY_SERIAL_RING_BUFFER_0;
 
+// Character-at-a-time receive until the PDC receive blocks are loaded
+apvSerialReceiveMode_t  apvPrimarySerialReceiveMode  = APV_SERIAL_RECEIVE_MODE_CHARACTER;
+apvSerialPdcReceive_t   apvPrimarySerialPdcReceive;
+
+// Character-at-a-time transmit until the PDC transmit queue is set up
+apvSerialTransmitMode_t apvPrimarySerialTransmitMode = APV_SERIAL_TRANSMIT_MODE_CHARACTER;
+apvSerialPdcTransmit_t  apvPrimarySerialPdcTransmit;
+
+apvSerialBaudRateNegotiation_t apvPrimarySerialBaudRate;
+
+apvRingBufferReceiveGuard_t    apvPrimarySerialReceiveGuard;
+apvSerialReceiveErrors_t       apvPrimarySerialReceiveErrors;
+
 /******************************************************************************/
 /* Static Variable Definitions :                                              */
 /******************************************************************************/
 
 static    bool  apvSerialCommsManagerAssigned                  = false;
 static    void  (*apvPrimarySerialCommsInterruptHandler)(void) = NULL;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static bool apvSerialTransmitterDrained(void);
+static void apvPrimarySerialReceiveErrorCheck(uint32_t statusRegister);
  
 /******************************************************************************/
 /* These variables are only intended to implement a simple foreground/back-   */
@@ -293,9 +316,19 @@ APV_SERIAL_ERROR_CODE apvSerialCommsManager(APV_PRIMARY_SERIAL_PORT   apvPrimary
 /*   per-character operation where the received characters are loaded onto a  */
 /*   known ring-buffer for consumption by higher processing layers and those  */
 /*   layers load a known ring-buffer in the opposite direction for transmit.  */
-/*   Currently the ring-buffers have a native element of 32-bits to allow the */
-/*   storage of 1, 2, 3 and 4-byte values. Hence all operations need to be    */
-/*   four-byte aligned when pushing and pulling values                        */
+/*   Each entry keeps servicing the UART while a character is waiting or the  */
+/*   holding register is free, up to "APV_SERIAL_INTERRUPT_BATCH_LIMIT"       */
+/*   characters each way, so a burst shares one interrupt entry and exit.     */
+/*   Received characters are gathered byte-packed and loaded in one call;     */
+/*   the ring-buffer widens them into its' 32-bit slots.                      */
+/*   In PDC receive mode the receiver interrupts at the end of each PDC block */
+/*   instead and the whole block is delivered to the receive ring-buffer. In  */
+/*   PDC transmit mode the transmitter interrupts at the end of each frame    */
+/*   ("ENDTX") and the next queued frame is chained into the PDC.             */
+/*   Nothing here ever waits : a full receive ring-buffer loses characters by */
+/*   its' overflow policy and a hardware receive error is counted and         */
+/*   cleared. Either way the de-framer is sent a gap marker so only the frame */
+/*   caught in the gap is lost                                                */
 /*                                                                            */
 /******************************************************************************/
 
@@ -304,62 +337,427 @@ void apvPrimarySerialCommsHandler(APV_PRIMARY_SERIAL_PORT apvPrimarySerialPort)
 /******************************************************************************/
 
    uint32_t statusRegister = 0;
-   uint32_t txRxBuffer     = 0;
+
+   uint8_t  receivedCharacters[APV_SERIAL_INTERRUPT_BATCH_LIMIT], // received characters packed one per byte
+            transmitCharacter = 0;
+
+   uint16_t receivedCount     = 0,
+            transmitCount     = 0;
+
+   bool     servicePending    = true;
 
 /******************************************************************************/
 
   if (apvPrimarySerialPort == APV_PRIMARY_SERIAL_PORT_UART)
     {
-    statusRegister = ApvUartControlBlock_p->UART_SR;
+    statusRegister = APV_REGISTER_READ(ApvUartControlBlock_p, UART_SR);
+
+    apvPrimarySerialReceiveErrorCheck(statusRegister);
 
-    if ((statusRegister & UART_SR_RXRDY) == UART_SR_RXRDY)
+    if (apvPrimarySerialReceiveMode == APV_SERIAL_RECEIVE_MODE_PDC)
       {
-      apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] = apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] + 1;
+      if ((statusRegister & (UART_SR_ENDRX | UART_SR_RXBUFF)) != 0)
+        {
+        apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] = apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] + 1;
+
+        // Deliver the finished block(s) and hand them back to the PDC
+        if (apvSerialPdcReceiveService(&apvPrimarySerialPdcReceive,
+                                        false) == true)
+          {
+          receiveInterrupt = true;
+          }
+        }
+      }
+
+    if (apvPrimarySerialTransmitMode == APV_SERIAL_TRANSMIT_MODE_PDC)
+      {
+      if (((statusRegister                  & UART_SR_ENDTX)  == UART_SR_ENDTX) &&
+          ((ApvUartControlBlock_p->UART_IMR & UART_IMR_ENDTX) == UART_IMR_ENDTX))
+        {
+        apvInterruptCounters[APV_TRANSMIT_INTERRUPT_COUNTER] = apvInterruptCounters[APV_TRANSMIT_INTERRUPT_COUNTER] + 1;
+
+        // Retire the finished frame and chain the next; "ENDTX" stays set while
+        // the PDC is idle so switch it off once the queue is empty
+        if (apvSerialPdcTransmitService(&apvPrimarySerialPdcTransmit,
+                                         false) == false)
+          {
+          APV_REGISTER_COMMAND(ApvUartControlBlock_p, UART_IDR, UART_IDR_ENDTX);
+          }
+        }
+      }
+
+    /******************************************************************************/
+    /* Per-character work : keep moving characters while the UART has one        */
+    /* waiting or room for another, up to the per-entry bound each way. Received  */
+    /* characters are collected here and go onto the ring-buffer in one call      */
+    /******************************************************************************/
+
+    while (servicePending == true)
+      {
+      servicePending = false;
+
+      if ((apvPrimarySerialReceiveMode   == APV_SERIAL_RECEIVE_MODE_CHARACTER) &&
+          ((statusRegister & UART_SR_RXRDY) == UART_SR_RXRDY)                  &&
+          (receivedCount                   <  APV_SERIAL_INTERRUPT_BATCH_LIMIT))
+        {
+        receivedCharacters[receivedCount] = (uint8_t)APV_REGISTER_READ(ApvUartControlBlock_p, UART_RHR);
+        receivedCount                     = receivedCount + 1;
+
+        servicePending = true;
+        }
+
+      // Only the holding register needs to be free : waiting for "TXEMPTY" as well
+      // leaves the shift register idle between characters
+      if ((apvPrimarySerialTransmitMode  == APV_SERIAL_TRANSMIT_MODE_CHARACTER) &&
+          ((statusRegister & UART_SR_TXRDY) == UART_SR_TXRDY)                   &&
+          (transmitInterrupt             == true)                               &&
+          (transmitCount                 <  APV_SERIAL_INTERRUPT_BATCH_LIMIT))
+        {
+        // Send the next character if one exists
+        if (apvRingBufferUnLoad( apvPrimarySerialCommsTransmitBuffer,
+                                 APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                                (uint32_t *)&transmitCharacter,
+                                 sizeof(uint8_t),
+                                 false) != 0)
+          {
+          APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_THR, transmitCharacter);
+
+          transmitCount  = transmitCount + 1;
+          servicePending = true;
+          }
+        else
+          {
+          transmitInterrupt = false;
 
-      // Read the new character
-      apvUartCharacterReceive((uint8_t *)&txRxBuffer);
+          // No transmit characters left - shut down the transmit interrupt
+          APV_REGISTER_WRITE(ApvUartControlBlock_p, ApvUartControlBlock, UART_IDR, UART_IDR_TXRDY);
+          }
+        }
 
-      // Put it into the current receiver ring buffer if there is room
-      if (apvRingBufferLoad( apvPrimarySerialCommsReceiveBuffer,
-                             APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                            (uint32_t *)&txRxBuffer,
-                             sizeof(uint8_t),
-                             false) == 0)
+      if (servicePending == true)
         {
-        while (true)
-          ;
+        statusRegister = APV_REGISTER_READ(ApvUartControlBlock_p, UART_SR);
+
+        apvPrimarySerialReceiveErrorCheck(statusRegister);
         }
       }
 
-    if (((statusRegister & UART_SR_TXEMPTY) == UART_SR_TXEMPTY) && 
-        ((statusRegister & UART_SR_TXRDY)   == UART_SR_TXRDY)   &&
-        (transmitInterrupt                  == true))
+    if (receivedCount != 0)
+      {
+      apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] = apvInterruptCounters[APV_RECEIVE_INTERRUPT_COUNTER] + 1;
+
+      // If there is no room the overflow policy decides what is lost
+      apvRingBufferReceiveLoad( apvPrimarySerialCommsReceiveBuffer,
+                               &apvPrimarySerialReceiveGuard,
+                                APV_RING_BUFFER_TOKEN_TYPE_ONE_BYTE,
+                               (uint32_t *)&receivedCharacters[0],
+                                receivedCount);
+
+      // Wake the background loop to de-frame the new characters
+      receiveInterrupt = true;
+      }
+
+    if (transmitCount != 0)
       {
       apvInterruptCounters[APV_TRANSMIT_INTERRUPT_COUNTER] = apvInterruptCounters[APV_TRANSMIT_INTERRUPT_COUNTER] + 1;
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvPrimarySerialCommsHandler                                    */
+
+/******************************************************************************/
+/* apvPrimarySerialReceiveErrorCheck() :                                      */
+/*  --> statusRegister : the latest UART status                               */
+/*                                                                            */
+/* - count and clear any UART receive errors. The error bits stay set until   */
+/*   reset; a character has been lost or mangled so the de-framer must drop   */
+/*   the frame it is in                                                       */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPrimarySerialReceiveErrorCheck(uint32_t statusRegister)
+  {
+/******************************************************************************/
+
+  if ((statusRegister & (UART_SR_OVRE | UART_SR_FRAME | UART_SR_PARE)) != 0)
+    {
+    if ((statusRegister & UART_SR_OVRE) == UART_SR_OVRE)
+      {
+      apvPrimarySerialReceiveErrors.receiveOverruns = apvPrimarySerialReceiveErrors.receiveOverruns + 1;
+      }
+
+    if ((statusRegister & UART_SR_FRAME) == UART_SR_FRAME)
+      {
+      apvPrimarySerialReceiveErrors.receiveFramingErrors = apvPrimarySerialReceiveErrors.receiveFramingErrors + 1;
+      }
+
+    if ((statusRegister & UART_SR_PARE) == UART_SR_PARE)
+      {
+      apvPrimarySerialReceiveErrors.receiveParityErrors = apvPrimarySerialReceiveErrors.receiveParityErrors + 1;
+      }
+
+    APV_REGISTER_COMMAND(ApvUartControlBlock_p, UART_CR, UART_CR_RSTSTA);
+
+    apvPrimarySerialReceiveGuard.receiveGapPending = true;
+    }
+
+/******************************************************************************/
+  } /* end of apvPrimarySerialReceiveErrorCheck                               */
+
+/******************************************************************************/
+/* apvSerialBaudRateInitialise() :                                            */
+/*  --> baudRateNegotiation : the baud rate negotiation state                 */
+/*  --> baudRate            : the sign-on baud rate already set in the UART   */
+/*  <-- negotiationError    : error codes                                     */
+/*                                                                            */
+/*  - start the baud rate negotiation from the sign-on rate                   */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialBaudRateInitialise(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                                           uint32_t                        baudRate)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE negotiationError = APV_ERROR_CODE_NONE;
+
+/******************************************************************************/
+
+  if (baudRateNegotiation == NULL)
+    {
+    negotiationError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    if (baudRate == APV_SERIAL_BAUD_RATE_NONE)
+      {
+      negotiationError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
+      }
+    else
+      {
+      baudRateNegotiation->baudRateConfirmed       = baudRate;
+      baudRateNegotiation->baudRateCurrent         = baudRate;
+      baudRateNegotiation->baudRatePending         = APV_SERIAL_BAUD_RATE_NONE;
+      baudRateNegotiation->baudRateConfirming      = false;
+      baudRateNegotiation->baudRateConfirmDeadline = 0;
+      baudRateNegotiation->baudRateFallBacks       = 0;
+      }
+    }
+
+/******************************************************************************/
+
+  return(negotiationError);
+
+/******************************************************************************/
+  } /* end of apvSerialBaudRateInitialise                                     */
 
-      // Send the next character if one exists
-      if (apvRingBufferUnLoad( apvPrimarySerialCommsTransmitBuffer,
-                               APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
-                              (uint32_t *)&txRxBuffer,
-                               sizeof(uint8_t),
-                               false) != 0)
+/******************************************************************************/
+/* apvSerialBaudRateRequest() :                                               */
+/*  --> baudRateNegotiation : the baud rate negotiation state                 */
+/*  --> baudRate            : the baud rate the host has asked for            */
+/*  <-- baudRateActual      : the baud rate the UART divisor would give       */
+/*  <-- baudRateError       : the baud rate error in parts-per-million        */
+/*  <-- negotiationError    : error codes                                     */
+/*                                                                            */
+/*  - accept or refuse a host baud rate request. Nothing is changed here : an */
+/*    accepted rate is left pending so the response to the request still      */
+/*    goes out at the old rate. The host steps down through its' list of      */
+/*    rates until one is accepted                                             */
+/*                                                                            */
+/******************************************************************************/
+
+APV_ERROR_CODE apvSerialBaudRateRequest(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                                        uint32_t                        baudRate,
+                                        uint32_t                       *baudRateActual,
+                                        int32_t                        *baudRateError)
+  {
+/******************************************************************************/
+
+  APV_ERROR_CODE negotiationError = APV_ERROR_CODE_NONE;
+
+  uint16_t       baudRateDivisor  = 0;
+  uint8_t        baudRateFraction = 0;
+
+/******************************************************************************/
+
+  if (baudRateNegotiation == NULL)
+    {
+    negotiationError = APV_ERROR_CODE_NULL_PARAMETER;
+    }
+  else
+    {
+    negotiationError = apvUartBaudRateDivisor(APV_EVENT_TIMER_TIMEBASE_BASECLOCK,
+                                              baudRate,
+                                              APV_UART_MCK_FIXED_DIVIDE_16,
+                                              APV_UART_NO_FRACTIONAL_DIVISOR_STEPS,
+                                             &baudRateDivisor,
+                                             &baudRateFraction,
+                                              baudRateActual,
+                                              baudRateError);
+
+    if (negotiationError == APV_ERROR_CODE_NONE)
+      {
+      if ((*baudRateError > APV_UART_BAUD_RATE_ERROR_LIMIT_PPM) || (*baudRateError < (-APV_UART_BAUD_RATE_ERROR_LIMIT_PPM)))
         {
-        ApvUartControlBlock_p->UART_THR = (uint8_t)txRxBuffer;
-        ApvUartControlBlock.UART_THR    = (uint8_t)txRxBuffer;
+        negotiationError = APV_ERROR_CODE_PARAMETER_OUT_OF_RANGE;
         }
       else
         {
-        transmitInterrupt = false;
+        baudRateNegotiation->baudRatePending = baudRate;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(negotiationError);
+
+/******************************************************************************/
+  } /* end of apvSerialBaudRateRequest                                        */
+
+/******************************************************************************/
+/* apvSerialBaudRateConfirm() :                                               */
+/*  --> baudRateNegotiation : the baud rate negotiation state                 */
+/*                                                                            */
+/*  - the host has been heard from i.e. a command has been resolved, so the   */
+/*    current baud rate works in both directions and becomes the fall-back    */
+/*                                                                            */
+/******************************************************************************/
+
+void apvSerialBaudRateConfirm(apvSerialBaudRateNegotiation_t *baudRateNegotiation)
+  {
+/******************************************************************************/
+
+  if (baudRateNegotiation != NULL)
+    {
+    baudRateNegotiation->baudRateConfirmed  = baudRateNegotiation->baudRateCurrent;
+    baudRateNegotiation->baudRateConfirming = false;
+    }
+
+/******************************************************************************/
+  } /* end of apvSerialBaudRateConfirm                                        */
+
+/******************************************************************************/
+/* apvSerialBaudRateService() :                                               */
+/*  --> baudRateNegotiation : the baud rate negotiation state                 */
+/*  --> runTimeTick         : the background loop run-time tick               */
+/*  <-- baudRateChanged     : [ false == no change | true == the baud rate    */
+/*                              generator has been changed ]                  */
+/*                                                                            */
+/*  - run from the background loop once messaging has settled. A pending      */
+/*    rate is switched in when the transmitter has drained and then held      */
+/*    provisionally; if the host is not heard from at the new rate before the */
+/*    deadline the link falls back to the last confirmed rate                 */
+/*                                                                            */
+/******************************************************************************/
+
+bool apvSerialBaudRateService(apvSerialBaudRateNegotiation_t *baudRateNegotiation,
+                              uint32_t                        runTimeTick)
+  {
+/******************************************************************************/
+
+  bool     baudRateChanged = false;
+
+  uint32_t baudRateActual  = 0;
+  int32_t  baudRateError   = 0;
+
+/******************************************************************************/
+
+  if (baudRateNegotiation != NULL)
+    {
+    if (baudRateNegotiation->baudRatePending != APV_SERIAL_BAUD_RATE_NONE)
+      {
+      if (apvSerialTransmitterDrained() == true)
+        {
+        if (apvUartSetBaudRate( baudRateNegotiation->baudRatePending,
+                               &baudRateActual,
+                               &baudRateError) == APV_ERROR_CODE_NONE)
+          {
+          baudRateNegotiation->baudRateCurrent         = baudRateNegotiation->baudRatePending;
+          baudRateNegotiation->baudRateConfirming      = true;
+          baudRateNegotiation->baudRateConfirmDeadline = runTimeTick + APV_SERIAL_BAUD_RATE_CONFIRM_TICKS;
+
+          baudRateChanged = true;
+          }
+
+        baudRateNegotiation->baudRatePending = APV_SERIAL_BAUD_RATE_NONE;
+        }
+      }
+    else
+      {
+      if (baudRateNegotiation->baudRateConfirming == true)
+        {
+        // The tick wraps so compare the signed difference
+        if (((int32_t)(runTimeTick - baudRateNegotiation->baudRateConfirmDeadline)) >= 0)
+          {
+          apvUartSetBaudRate( baudRateNegotiation->baudRateConfirmed,
+                             &baudRateActual,
+                             &baudRateError);
+
+          baudRateNegotiation->baudRateCurrent    = baudRateNegotiation->baudRateConfirmed;
+          baudRateNegotiation->baudRateConfirming = false;
+          baudRateNegotiation->baudRateFallBacks  = baudRateNegotiation->baudRateFallBacks + 1;
 
-        // No transmit characters left - shut down the transmit interrupt
-        ApvUartControlBlock_p->UART_IDR = UART_IDR_TXRDY;
-        ApvUartControlBlock.UART_IDR    = UART_IDR_TXRDY;
+          baudRateChanged = true;
+          }
         }
       }
     }
 
 /******************************************************************************/
-  } /* end of apvPrimarySerialCommsHandler                                    */
+
+  return(baudRateChanged);
+
+/******************************************************************************/
+  } /* end of apvSerialBaudRateService                                        */
+
+/******************************************************************************/
+/* apvSerialTransmitterDrained() :                                            */
+/*  <-- transmitterDrained : [ false == characters queued or on the line |    */
+/*                             true  == the transmitter is idle ]             */
+/*                                                                            */
+/*  - nothing is queued in the current transmit mode and the last character   */
+/*    has left the shift register                                             */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvSerialTransmitterDrained(void)
+  {
+/******************************************************************************/
+
+  bool transmitterDrained = false;
+
+/******************************************************************************/
+
+  APV_CRITICAL_REGION_ENTRY();
+
+  if ((APV_REGISTER_READ(ApvUartControlBlock_p, UART_SR) & UART_SR_TXEMPTY) == UART_SR_TXEMPTY)
+    {
+    if (apvPrimarySerialTransmitMode == APV_SERIAL_TRANSMIT_MODE_PDC)
+      {
+      if (apvPrimarySerialPdcTransmit.pdcTransmitCount == 0)
+        {
+        transmitterDrained = true;
+        }
+      }
+    else
+      {
+      if (transmitInterrupt == false)
+        {
+        transmitterDrained = true;
+        }
+      }
+    }
+
+  APV_CRITICAL_REGION_EXIT();
+
+/******************************************************************************/
+
+  return(transmitterDrained);
+
+/******************************************************************************/
+  } /* end of apvSerialTransmitterDrained                                     */
 
 /******************************************************************************/
 /* UART Handler :                                                             */
@@ -368,6 +766,10 @@ void apvPrimarySerialCommsHandler(APV_PRIMARY_SERIAL_PORT apvPrimarySerialPort)
 
 void UART_Handler(void)
   {
+/******************************************************************************/
+
+  uint32_t entryCycles = apvInterruptLatencyStamp();
+
 /******************************************************************************/
 
   // What comms protocol is the UART supporting ?
@@ -377,7 +779,13 @@ void UART_Handler(void)
     apvPrimarySerialCommsHandler(APV_PRIMARY_SERIAL_PORT_UART);
     }
 
-  NVIC_ClearPendingIRQ(UART_IRQn);
+  // The pending bit was cleared on entry : it is deliberately not cleared again
+  // here, that would lose a request raised while the handler was running
+
+  // A serial interrupt is not scheduled : only its' service time is kept
+  apvInterruptLatencyRecord(APV_INTERRUPT_LATENCY_SOURCE_UART,
+                            entryCycles,
+                            APV_INTERRUPT_LATENCY_UNSCHEDULED);
 
 /******************************************************************************/
   } /* end of UART_Handler                                                    */
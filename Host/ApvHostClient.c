@@ -0,0 +1,735 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvHostClient.c                                                            */
+/* 23.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : a POSIX command-and-control client for the loopback harness. */
+/*   It opens the pty of an 'ApvHost -p' run, optionally moves the link to a  */
+/*   new baud rate ("APV_BAUD_RATE") and then keeps up to a window of framed  */
+/*   "APV_SIGN_ON" requests in flight, matching each '\r'-ended response to   */
+/*   the oldest request. The report is frames/s, bytes/s each way and the     */
+/*   round-trip time of the answered requests. The firmwares' own drop counts */
+/*   for the UART components are read back afterwards so a loss can be told   */
+/*   apart from a loss the firmware never saw                                 */
+/*                                                                            */
+/*   ApvHostClient -p pty [-b baud] [-n frames] [-w window] [-r seconds]      */
+/*                 [-c seconds] [-z]                                          */
+/*                                                                            */
+/*    -p : the pty slave path 'ApvHost -p' wrote to "stdout"                  */
+/*    -b : baud rate to ask the firmware for (default : stay at sign-on rate) */
+/*    -n : requests to send (default 100)                                     */
+/*    -w : most requests in flight at once (default 1)                        */
+/*    -r : a request not answered in this time is lost (default 1s)           */
+/*    -c : time to wait for the firmware to first answer (default 30s)        */
+/*    -z : fail unless every request is answered intact (a clean line)        */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#define _GNU_SOURCE // 'cfmakeraw()'
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <termios.h>
+#include "ApvCrcGenerator.h"
+#include "ApvMessageHandling.h"
+#include "ApvControlPortProtocol.h"
+#include "ApvMessagingLayerManager.h"
+
+/******************************************************************************/
+/* Constant Definitions :                                                     */
+/******************************************************************************/
+
+#define APV_HOST_CLIENT_FRAMES_DEFAULT     (100)
+#define APV_HOST_CLIENT_WINDOW_DEFAULT     (1)
+#define APV_HOST_CLIENT_WINDOW_MAXIMUM     (64)
+#define APV_HOST_CLIENT_TIMEOUT_DEFAULT    (1.0)  // seconds
+#define APV_HOST_CLIENT_CONNECT_DEFAULT    (30.0) // seconds
+#define APV_HOST_CLIENT_BAUD_RATE_TRIES    (3)
+#define APV_HOST_CLIENT_DRAIN_TIME         (0.25) // seconds of silence before the statistics are read
+#define APV_HOST_CLIENT_UART_COMPONENTS    (2)
+
+#define APV_HOST_CLIENT_LINE_MAXIMUM       (APV_SERIAL_BUFFER_MAXIMUM_LENGTH)
+#define APV_HOST_CLIENT_LINE_END           '\r'
+#define APV_HOST_CLIENT_COMMAND_MAXIMUM    (APV_MESSAGING_MAXIMUM_UNSTUFFED_MESSAGE_LENGTH)
+
+#define APV_HOST_CLIENT_MILLISECONDS       (1000.0)
+#define APV_HOST_CLIENT_NANOSECONDS        (1000000000.0)
+
+// Requests go in on the UART control plane and are answered on the next one
+#define APV_HOST_CLIENT_INBOUND_PLANES     ((uint8_t)((APV_SIGNAL_PLANE_CONTROL_0 << APV_MESSAGE_PLANE_SHIFT) | APV_COMMS_PLANE_SERIAL_UART))
+#define APV_HOST_CLIENT_OUTBOUND_PLANES    ((uint8_t)((APV_SIGNAL_PLANE_CONTROL_1 << APV_MESSAGE_PLANE_SHIFT) | APV_COMMS_PLANE_SERIAL_UART))
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef struct apvHostClientLink_tTag
+  {
+  int      linkFile;
+  char     linkLine[APV_HOST_CLIENT_LINE_MAXIMUM + 1];
+  uint32_t linkLineLength;
+  uint64_t linkBytesSent;
+  uint64_t linkBytesReceived;
+  } apvHostClientLink_t;
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static double   apvHostClientNow(void);
+static uint16_t apvHostClientFrame(const char *command,
+                                   uint8_t    *frame);
+static bool     apvHostClientSend(apvHostClientLink_t *link,
+                                  const char          *command);
+static bool     apvHostClientReceive(apvHostClientLink_t *link,
+                                     double               deadline);
+static bool     apvHostClientSignOn(apvHostClientLink_t *link,
+                                    double               timeout);
+static bool     apvHostClientBaudRate(apvHostClientLink_t *link,
+                                      uint32_t             baudRate,
+                                      double               timeout);
+static bool     apvHostClientDrops(apvHostClientLink_t *link,
+                                   uint16_t             component,
+                                   double               timeout,
+                                   unsigned long       *drops);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+  {
+/******************************************************************************/
+
+  apvHostClientLink_t link;
+  struct termios      linkLine;
+  int                 option         = 0,
+                      exitCode       = EXIT_SUCCESS;
+  const char         *ptyPath        = NULL;
+  uint32_t            baudRate       = 0,
+                      frames         = APV_HOST_CLIENT_FRAMES_DEFAULT,
+                      window         = APV_HOST_CLIENT_WINDOW_DEFAULT,
+                      sent           = 0,
+                      answered       = 0,
+                      corrupted      = 0,
+                      lost           = 0,
+                      inFlight       = 0,
+                      oldest         = 0;
+  bool                zeroLoss       = false;
+  unsigned long       drops[APV_MESSAGING_LAYER_DROPS],
+                      firmwareDrops  = 0;
+  const uint16_t      uartComponents[APV_HOST_CLIENT_UART_COMPONENTS] = { APV_PLANE_SERIAL_UART_CONTROL_0, APV_PLANE_SERIAL_UART_CONTROL_1 };
+  uint16_t            uartComponent  = 0,
+                      component      = 0,
+                      drop           = 0;
+  double              timeout        = APV_HOST_CLIENT_TIMEOUT_DEFAULT,
+                      connectTimeout = APV_HOST_CLIENT_CONNECT_DEFAULT,
+                      sendTimes[APV_HOST_CLIENT_WINDOW_MAXIMUM],
+                      runStart       = 0.0,
+                      runTime        = 0.0,
+                      roundTrip      = 0.0,
+                      roundTripMin   = 0.0,
+                      roundTripMax   = 0.0,
+                      roundTripSum   = 0.0;
+  uint64_t            bytesSent      = 0,
+                      bytesReceived  = 0;
+
+/******************************************************************************/
+
+  memset(&link, 0, sizeof(link));
+
+  link.linkFile = -1;
+
+  while ((option = getopt(argc, argv, "p:b:n:w:r:c:z")) != -1)
+    {
+    switch(option)
+      {
+      case 'p' : ptyPath        = optarg;
+                 break;
+
+      case 'b' : baudRate       = (uint32_t)strtoul(optarg, NULL, 0);
+                 break;
+
+      case 'n' : frames         = (uint32_t)strtoul(optarg, NULL, 0);
+                 break;
+
+      case 'w' : window         = (uint32_t)strtoul(optarg, NULL, 0);
+                 break;
+
+      case 'r' : timeout        = atof(optarg);
+                 break;
+
+      case 'c' : connectTimeout = atof(optarg);
+                 break;
+
+      case 'z' : zeroLoss       = true;
+                 break;
+
+      default  : exitCode       = EXIT_FAILURE;
+                 break;
+      }
+    }
+
+  if ((ptyPath == NULL) || (window == 0) || (window > APV_HOST_CLIENT_WINDOW_MAXIMUM) || (frames == 0))
+    {
+    exitCode = EXIT_FAILURE;
+    }
+
+  if (exitCode == EXIT_SUCCESS)
+    {
+    link.linkFile = open(ptyPath, O_RDWR | O_NOCTTY);
+
+    if (link.linkFile < 0)
+      {
+      perror(ptyPath);
+      exitCode = EXIT_FAILURE;
+      }
+    else
+      {
+      if (tcgetattr(link.linkFile, &linkLine) == 0)
+        {
+        cfmakeraw(&linkLine);
+        tcsetattr(link.linkFile, TCSANOW, &linkLine);
+        }
+      }
+    }
+  else
+    {
+    fprintf(stderr, "usage : %s -p pty [-b baud] [-n frames] [-w window 1..%d] [-r seconds] [-c seconds] [-z]\n",
+            argv[0], APV_HOST_CLIENT_WINDOW_MAXIMUM);
+    }
+
+  // The firmware reads nothing until its' start-up is over : keep asking
+  if ((exitCode == EXIT_SUCCESS) && (apvHostClientSignOn(&link, connectTimeout) == false))
+    {
+    fprintf(stderr, "no answer from the firmware\n");
+    exitCode = EXIT_FAILURE;
+    }
+
+  if ((exitCode == EXIT_SUCCESS) && (baudRate != 0) && (apvHostClientBaudRate(&link, baudRate, timeout) == false))
+    {
+    exitCode = EXIT_FAILURE;
+    }
+
+/******************************************************************************/
+/* The measured run : the link counts start from here                         */
+/******************************************************************************/
+
+  if (exitCode == EXIT_SUCCESS)
+    {
+    bytesSent     = link.linkBytesSent;
+    bytesReceived = link.linkBytesReceived;
+    runStart      = apvHostClientNow();
+
+    while ((answered + corrupted + lost) < frames)
+      {
+      while ((inFlight < window) && (sent < frames))
+        {
+        sendTimes[(oldest + inFlight) % APV_HOST_CLIENT_WINDOW_MAXIMUM] = apvHostClientNow();
+
+        if (apvHostClientSend(&link, APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_SIGN_ON) == false)
+          {
+          frames = sent; // the pty has gone
+          break;
+          }
+
+        sent     = sent     + 1;
+        inFlight = inFlight + 1;
+        }
+
+      if (inFlight == 0)
+        {
+        break;
+        }
+
+      // Each response, good or bad, answers the oldest request in flight
+      if (apvHostClientReceive(&link, sendTimes[oldest] + timeout) == true)
+        {
+        if (strcmp(link.linkLine, APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SIGN_ON) == 0)
+          {
+          roundTrip = apvHostClientNow() - sendTimes[oldest];
+
+          if ((answered == 0) || (roundTrip < roundTripMin))
+            {
+            roundTripMin = roundTrip;
+            }
+
+          if (roundTrip > roundTripMax)
+            {
+            roundTripMax = roundTrip;
+            }
+
+          roundTripSum = roundTripSum + roundTrip;
+          answered     = answered     + 1;
+          }
+        else
+          {
+          corrupted = corrupted + 1;
+          }
+        }
+      else
+        {
+        lost = lost + 1;
+        }
+
+      oldest   = (oldest + 1) % APV_HOST_CLIENT_WINDOW_MAXIMUM;
+      inFlight = inFlight - 1;
+      }
+
+    runTime       = apvHostClientNow()     - runStart;
+    bytesSent     = link.linkBytesSent     - bytesSent;
+    bytesReceived = link.linkBytesReceived - bytesReceived;
+
+    fprintf(stdout, "requests      : %u sent, %u answered, %u corrupted, %u lost (window %u)\n",
+            sent, answered, corrupted, lost, window);
+    fprintf(stdout, "run time      : %.3f s\n", runTime);
+
+    if (runTime > 0.0)
+      {
+      fprintf(stdout, "throughput    : %.1f frames/s, %.1f bytes/s sent, %.1f bytes/s received\n",
+              ((double)answered)      / runTime,
+              ((double)bytesSent)     / runTime,
+              ((double)bytesReceived) / runTime);
+      }
+
+    if (answered != 0)
+      {
+      fprintf(stdout, "round trip    : %.3f ms min, %.3f ms mean, %.3f ms max\n",
+              roundTripMin                       * APV_HOST_CLIENT_MILLISECONDS,
+              (roundTripSum / (double)answered)  * APV_HOST_CLIENT_MILLISECONDS,
+              roundTripMax                       * APV_HOST_CLIENT_MILLISECONDS);
+      }
+    else
+      {
+      exitCode = EXIT_FAILURE;
+      }
+
+    // Late answers to requests already counted as lost must not be taken for statistics
+    while (apvHostClientReceive(&link, apvHostClientNow() + APV_HOST_CLIENT_DRAIN_TIME) == true)
+      {
+      }
+
+    // The UART input component takes the requests, the output component sends the responses
+    for (uartComponent = 0; uartComponent < APV_HOST_CLIENT_UART_COMPONENTS; uartComponent++)
+      {
+      component = uartComponents[uartComponent];
+
+      if (apvHostClientDrops(&link, component, timeout, &drops[0]) == true)
+        {
+        fprintf(stdout, "firmware C%u   : %lu ring full, %lu no buffer, %lu transmit refused\n",
+                component,
+                drops[APV_MESSAGING_LAYER_DROP_RING_FULL],
+                drops[APV_MESSAGING_LAYER_DROP_NO_BUFFER],
+                drops[APV_MESSAGING_LAYER_DROP_TRANSMIT]);
+
+        for (drop = 0; drop < APV_MESSAGING_LAYER_DROPS; drop++)
+          {
+          firmwareDrops = firmwareDrops + drops[drop];
+          }
+        }
+      else
+        {
+        fprintf(stdout, "firmware C%u   : no statistics\n", component);
+        }
+      }
+
+    if ((lost + corrupted) != 0)
+      {
+      fprintf(stdout, "loss          : %u requests, %lu dropped by the firmware\n",
+              lost + corrupted, firmwareDrops);
+
+      if (zeroLoss == true)
+        {
+        fprintf(stderr, "%u requests lost or corrupted on a clean line\n", lost + corrupted);
+        exitCode = EXIT_FAILURE;
+        }
+      }
+    }
+
+  if (link.linkFile >= 0)
+    {
+    close(link.linkFile);
+    }
+
+/******************************************************************************/
+
+  return(exitCode);
+
+/******************************************************************************/
+  } /* end of main                                                            */
+
+/******************************************************************************/
+/* Static Function Definitions :                                              */
+/******************************************************************************/
+/* apvHostClientNow() :                                                       */
+/*  <-- now : the monotonic clock in seconds                                  */
+/*                                                                            */
+/******************************************************************************/
+
+static double apvHostClientNow(void)
+  {
+/******************************************************************************/
+
+  struct timespec now = { 0, 0 };
+
+/******************************************************************************/
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+/******************************************************************************/
+
+  return(((double)now.tv_sec) + (((double)now.tv_nsec) / APV_HOST_CLIENT_NANOSECONDS));
+
+/******************************************************************************/
+  } /* end of apvHostClientNow                                                */
+
+/******************************************************************************/
+/* apvHostClientFrame() :                                                     */
+/*  --> command     : the text command                                        */
+/*  <-- frame       : the link frame : room for the longest payload and <EOM> */
+/*  <-- frameLength : the number of bytes in the frame                        */
+/*                                                                            */
+/* - <SOM> <inbound> <outbound> <length> <stuffed command> <CRC> <EOM> with   */
+/*   the CRC over the stuffed command as the de-framer checks it              */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvHostClientFrame(const char *command,
+                                   uint8_t    *frame)
+  {
+/******************************************************************************/
+
+  uint16_t stuffedLength = 0,
+           crc           = 0;
+
+/******************************************************************************/
+
+  frame[APV_COMMS_MESSAGE_PAYLOAD_SOM_FIELD_OFFSET]             = APV_MESSAGING_START_OF_MESSAGE;
+  frame[APV_COMMS_MESSAGE_PAYLOAD_INBOUND_PLANES_FIELD_OFFSET]  = APV_HOST_CLIENT_INBOUND_PLANES;
+  frame[APV_COMMS_MESSAGE_PAYLOAD_OUTBOUND_PLANES_FIELD_OFFSET] = APV_HOST_CLIENT_OUTBOUND_PLANES;
+
+  while ((*command != '\0') && (stuffedLength < (APV_MESSAGING_MAXIMUM_STUFFED_MESSAGE_LENGTH - 1)))
+    {
+    if ((*command == APV_MESSAGING_START_OF_MESSAGE) || (*command == APV_MESSAGING_STUFFING_FLAG))
+      {
+      frame[APV_COMMS_MESSAGE_PAYLOAD_MESSAGE_FIELD_OFFSET + stuffedLength] = APV_MESSAGING_STUFFING_FLAG;
+      stuffedLength                                                         = stuffedLength + 1;
+      }
+
+    frame[APV_COMMS_MESSAGE_PAYLOAD_MESSAGE_FIELD_OFFSET + stuffedLength] = (uint8_t)*command;
+    stuffedLength                                                         = stuffedLength + 1;
+    command                                                               = command       + 1;
+    }
+
+  frame[APV_COMMS_MESSAGE_PAYLOAD_LENGTH_FIELD_OFFSET] = (uint8_t)stuffedLength;
+
+  // The CRC is stored high byte first straight after the command
+  apvBlockComputeCrc(&frame[APV_COMMS_MESSAGE_PAYLOAD_MESSAGE_FIELD_OFFSET],
+                     stuffedLength,
+                     &crc);
+
+  frame[APV_COMMS_MESSAGE_PAYLOAD_MESSAGE_FIELD_OFFSET + stuffedLength + APV_CRC_WORD_WIDTH] = APV_MESSAGING_END_OF_MESSAGE;
+
+/******************************************************************************/
+
+  return(APV_COMMS_MESSAGE_PAYLOAD_MESSAGE_FIELD_OFFSET + stuffedLength + APV_CRC_WORD_WIDTH + 1);
+
+/******************************************************************************/
+  } /* end of apvHostClientFrame                                              */
+
+/******************************************************************************/
+/* apvHostClientSend() :                                                      */
+/*  --> link    : the pty link                                                */
+/*  --> command : the text command to frame and send                          */
+/*  <-- sent    : [ false == the pty has gone | true == sent ]                */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvHostClientSend(apvHostClientLink_t *link,
+                              const char          *command)
+  {
+/******************************************************************************/
+
+  uint8_t  frame[APV_MESSAGING_MAXIMUM_PAYLOAD_LENGTH + 1];
+  uint16_t frameLength = 0,
+           frameIndex  = 0;
+  ssize_t  written     = 0;
+  bool     sent        = true;
+
+/******************************************************************************/
+
+  frameLength = apvHostClientFrame(command, &frame[0]);
+
+  while ((frameIndex < frameLength) && (sent == true))
+    {
+    written = write(link->linkFile, &frame[frameIndex], frameLength - frameIndex);
+
+    if (written > 0)
+      {
+      frameIndex          = frameIndex          + (uint16_t)written;
+      link->linkBytesSent = link->linkBytesSent + (uint64_t)written;
+      }
+    else
+      {
+      if ((written < 0) && (errno != EINTR))
+        {
+        sent = false;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(sent);
+
+/******************************************************************************/
+  } /* end of apvHostClientSend                                               */
+
+/******************************************************************************/
+/* apvHostClientReceive() :                                                   */
+/*  --> link     : the pty link                                               */
+/*  --> deadline : 'apvHostClientNow()' time to give up at                    */
+/*  <-- received : [ false == timed out | true == 'linkLine' holds a response */
+/*                 up to and including its' '\r' ]                            */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvHostClientReceive(apvHostClientLink_t *link,
+                                 double               deadline)
+  {
+/******************************************************************************/
+
+  struct pollfd linkPoll = { link->linkFile, POLLIN, 0 };
+  double        waitTime = 0.0;
+  char          character = '\0';
+  bool          received = false;
+
+/******************************************************************************/
+
+  while (received == false)
+    {
+    waitTime = deadline - apvHostClientNow();
+
+    if ((waitTime < 0.0) || (poll(&linkPoll, 1, (int)(waitTime * APV_HOST_CLIENT_MILLISECONDS) + 1) <= 0))
+      {
+      break;
+      }
+
+    if (read(link->linkFile, &character, 1) == 1)
+      {
+      link->linkBytesReceived = link->linkBytesReceived + 1;
+
+      if (link->linkLineLength < APV_HOST_CLIENT_LINE_MAXIMUM)
+        {
+        link->linkLine[link->linkLineLength] = character;
+        link->linkLineLength                 = link->linkLineLength + 1;
+        }
+
+      if (character == APV_HOST_CLIENT_LINE_END)
+        {
+        link->linkLine[link->linkLineLength] = '\0';
+        link->linkLineLength                 = 0;
+
+        received = true;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(received);
+
+/******************************************************************************/
+  } /* end of apvHostClientReceive                                            */
+
+/******************************************************************************/
+/* apvHostClientSignOn() :                                                    */
+/*  --> link    : the pty link                                                */
+/*  --> timeout : the longest to keep trying for                              */
+/*  <-- signOn  : [ false == no answer | true == signed on ]                  */
+/*                                                                            */
+/* - send "APV_SIGN_ON" every second until it is answered                     */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvHostClientSignOn(apvHostClientLink_t *link,
+                                double               timeout)
+  {
+/******************************************************************************/
+
+  double giveUp = apvHostClientNow() + timeout;
+  bool   signOn = false;
+
+/******************************************************************************/
+
+  while ((signOn == false) && (apvHostClientNow() < giveUp))
+    {
+    if (apvHostClientSend(link, APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_SIGN_ON) == false)
+      {
+      break;
+      }
+
+    while ((signOn == false) && (apvHostClientReceive(link, apvHostClientNow() + APV_HOST_CLIENT_TIMEOUT_DEFAULT) == true))
+      {
+      if (strcmp(link->linkLine, APV_COMMAND_PROTOCOL_MESSAGE_RESPONSE_SIGN_ON) == 0)
+        {
+        signOn = true;
+        }
+      }
+    }
+
+  // Answers to the retries may still be on their way : let them go
+  while (apvHostClientReceive(link, apvHostClientNow() + APV_HOST_CLIENT_TIMEOUT_DEFAULT) == true)
+    {
+    }
+
+/******************************************************************************/
+
+  return(signOn);
+
+/******************************************************************************/
+  } /* end of apvHostClientSignOn                                             */
+
+/******************************************************************************/
+/* apvHostClientBaudRate() :                                                  */
+/*  --> link     : the pty link                                               */
+/*  --> baudRate : the rate to move the link to                               */
+/*  --> timeout  : the longest to wait for each response                      */
+/*  <-- accepted : [ false == refused or not answered | true == moved ]       */
+/*                                                                            */
+/* - "APV_BAUD_RATE <baud>" answered "B<requested> <actual> <ppm> A|R". An    */
+/*   accepted rate is confirmed by signing on again at the new rate           */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvHostClientBaudRate(apvHostClientLink_t *link,
+                                  uint32_t             baudRate,
+                                  double               timeout)
+  {
+/******************************************************************************/
+
+  char          command[APV_HOST_CLIENT_COMMAND_MAXIMUM + 1];
+  unsigned long requested = 0,
+                actual    = 0;
+  long          errorPpm  = 0;
+  char          verdict   = '\0';
+  uint32_t      tries     = 0;
+  bool          answered  = false,
+                accepted  = false;
+
+/******************************************************************************/
+
+  snprintf(command, sizeof(command), "%s %u", APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_BAUD_RATE, baudRate);
+
+  for (tries = 0; (tries < APV_HOST_CLIENT_BAUD_RATE_TRIES) && (answered == false); tries++)
+    {
+    if (apvHostClientSend(link, command) == false)
+      {
+      break;
+      }
+
+    while ((answered == false) && (apvHostClientReceive(link, apvHostClientNow() + timeout) == true))
+      {
+      if (sscanf(link->linkLine, "B%lu %lu %ld %c", &requested, &actual, &errorPpm, &verdict) == 4)
+        {
+        answered = true;
+        }
+      }
+    }
+
+  if (answered == false)
+    {
+    fprintf(stderr, "baud rate %u : no answer\n", baudRate);
+    }
+  else
+    {
+    fprintf(stdout, "baud rate     : %lu requested, %lu actual, %ld ppm, %s\n",
+            requested, actual, errorPpm,
+            (verdict == APV_COMMAND_PROTOCOL_BAUD_RATE_ACCEPTED) ? "accepted" : "refused");
+
+    if (verdict == APV_COMMAND_PROTOCOL_BAUD_RATE_ACCEPTED)
+      {
+      accepted = apvHostClientSignOn(link, timeout * APV_HOST_CLIENT_BAUD_RATE_TRIES);
+
+      if (accepted == false)
+        {
+        fprintf(stderr, "baud rate %lu : not confirmed\n", actual);
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(accepted);
+
+/******************************************************************************/
+  } /* end of apvHostClientBaudRate                                           */
+
+/******************************************************************************/
+/* apvHostClientDrops() :                                                     */
+/*  --> link      : the pty link                                              */
+/*  --> component : the firmware component table index                        */
+/*  --> timeout   : the longest to wait for the response                      */
+/*  <-- drops     : the components' drop counts by cause                      */
+/*  <-- answered  : [ false == not answered | true == 'drops' is filled in ]  */
+/*                                                                            */
+/* - "APV_COMPONENT_STATISTICS <component> D" answered                        */
+/*   "C<component> D <ring full> <no buffer> <transmit refused>"              */
+/*                                                                            */
+/******************************************************************************/
+
+static bool apvHostClientDrops(apvHostClientLink_t *link,
+                               uint16_t             component,
+                               double               timeout,
+                               unsigned long       *drops)
+  {
+/******************************************************************************/
+
+  char          command[APV_HOST_CLIENT_COMMAND_MAXIMUM + 1];
+  unsigned int  reported = 0;
+  char          select   = '\0';
+  bool          answered = false;
+
+/******************************************************************************/
+
+  snprintf(command, sizeof(command), "%s %u %c", APV_COMMAND_PROTOCOL_MESSAGE_COMMAND_COMPONENT_STATISTICS,
+           component, APV_MESSAGING_LAYER_STATISTICS_SELECT_DROPS);
+
+  if (apvHostClientSend(link, command) == true)
+    {
+    while ((answered == false) && (apvHostClientReceive(link, apvHostClientNow() + timeout) == true))
+      {
+      if ((sscanf(link->linkLine, "C%u %c %lu %lu %lu", &reported, &select,
+                  &drops[APV_MESSAGING_LAYER_DROP_RING_FULL],
+                  &drops[APV_MESSAGING_LAYER_DROP_NO_BUFFER],
+                  &drops[APV_MESSAGING_LAYER_DROP_TRANSMIT]) == 5) &&
+          (reported == component) && (select == APV_MESSAGING_LAYER_STATISTICS_SELECT_DROPS))
+        {
+        answered = true;
+        }
+      }
+    }
+
+/******************************************************************************/
+
+  return(answered);
+
+/******************************************************************************/
+  } /* end of apvHostClientDrops                                              */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,1951 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvHostHal.c                                                               */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : the simulated SAM3X8E HAL. The register blocks the firmware  */
+/*   addresses are plain variables; at every update point the models below    */
+/*   consume the command registers ("CR", "IER", "IDR", "CCR", "PTCR" : zero  */
+/*   reads as "no command"), advance to the virtual time, rebuild the status  */
+/*   registers and drive the interrupt lines into the NVIC model              */
+/*                                                                            */
+/*   Modelled : the NVIC (enable, pending, priority, PRIMASK and pre-emption  */
+/*   by strictly higher priority only), "SysTick", the nine timer counter     */
+/*   channels (up and up-to-RC waveform counting, RC compare with or without  */
+/*   a counter reset, RA and RB compare, overflow and a channel clocked by    */
+/*   another's TIOA through "XC<n>"), the DWT cycle counter, the RTT alarm,   */
+/*   the PMC peripheral clock enables and the UART and USART receivers and    */
+/*   transmitters with their PDC channels, paced at the programmed baud rate. */
+/*   The PIO and SPI blocks are register storage only                         */
+/*                                                                            */
+/*   The serial lines can corrupt characters at a set rate in both directions */
+/*   and in real-time mode every idle jump waits for the wall-clock to catch  */
+/*   up : input that is not there yet is looked for again a character later   */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sam3x8e.h>
+#include "ApvHostHal.h"
+
+/******************************************************************************/
+/* Constant Definitions :                                                     */
+/******************************************************************************/
+
+#define APV_HOST_REGISTER(hostRegister)   (*(volatile uint32_t *)&(hostRegister))
+
+#define APV_HOST_SERIAL_STATUS_STICKY     (UART_SR_RXRDY | UART_SR_OVRE | UART_SR_FRAME | UART_SR_PARE)
+
+#define APV_HOST_TIMER_COUNTER_RANGE      (((uint64_t)1) << 32)
+#define APV_HOST_TIMER_CLOCK_SELECT_MASK  (0x7u)
+#define APV_HOST_TIMER_WAVSEL_MASK        (0x3u << 13)
+#define APV_HOST_TIMER_ACPA_MASK          (0x3u << 16)
+#define APV_HOST_TIMER_XC_SELECT_MASK     (0x3u)      // "TC_BMR" : a "TC<n>XC<n>S" field
+#define APV_HOST_TIMER_XC_SELECT_WIDTH    (2)
+#define APV_HOST_TIMER_XC_SELECT_TIOA     (0x2u)      // the first of the two TIOA selections
+
+#define APV_HOST_RTT_PRESCALER_MASK       (0xffffu)
+#define APV_HOST_RTT_ALARM_STATUS         (1u << 0) // "RTT_SR_ALMS"
+
+#define APV_HOST_SPI_READY                (SPI_IER_TDRE | SPI_IER_TXEMPTY)
+
+#define APV_HOST_ERROR_RATE_SCALE         (4294967296.0) // error rate to a 32-bit generator threshold
+#define APV_HOST_SERIAL_DATA_BITS         (8)
+
+#define APV_HOST_NANOSECONDS_PER_SECOND   (1000000000)
+#define APV_HOST_NANOSECONDS_PER_CYCLE_DIVISOR (APV_HOST_MASTER_CLOCK_HZ / 1000000) // ns == (cycles * 1000) / 84
+
+#define APV_HOST_SYSTICK_VECTOR           (APV_HOST_NVIC_EXCEPTIONS + SysTick_IRQn)
+#define APV_HOST_NVIC_DEFAULT_PRIORITY    ((1 << APV_HOST_NVIC_PRIORITY_BITS) - 1) // "SysTick_Config()" default
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef void (*apvHostHandler_t)(void);
+
+/******************************************************************************/
+/* Weak Handler References : a vector the firmware does not supply is NULL    */
+/******************************************************************************/
+
+#pragma weak SysTick_Handler
+#pragma weak RTT_Handler
+#pragma weak UART_Handler
+#pragma weak USART0_Handler
+#pragma weak USART1_Handler
+#pragma weak USART2_Handler
+#pragma weak USART3_Handler
+#pragma weak SPI0_Handler
+#pragma weak TC0_Handler
+#pragma weak TC1_Handler
+#pragma weak TC2_Handler
+#pragma weak TC3_Handler
+#pragma weak TC4_Handler
+#pragma weak TC5_Handler
+#pragma weak TC6_Handler
+#pragma weak TC7_Handler
+#pragma weak TC8_Handler
+
+/******************************************************************************/
+/* Global Variable Definitions :                                              */
+/******************************************************************************/
+
+Uart           apvHostUart;
+Usart          apvHostUsart[4];
+Tc             apvHostTc[3];
+Pmc            apvHostPmc;
+Pio            apvHostPio[4];
+Spi            apvHostSpi;
+Rtt            apvHostRtt;
+SysTick_Type   apvHostSysTick;
+DWT_Type       apvHostDwt;
+CoreDebug_Type apvHostCoreDebug;
+
+apvHostCycles_t apvHostClock    = 0;
+apvHostCycles_t apvHostRunLimit = APV_HOST_CYCLES_NEVER;
+apvHostNvic_t   apvHostNvic;
+apvHostSerial_t apvHostSerial[APV_HOST_SERIAL_PORTS];
+bool            apvHostRealTime = false;
+
+/******************************************************************************/
+/* Local Variable Definitions :                                               */
+/******************************************************************************/
+
+static apvHostTimer_t         apvHostTimers[APV_HOST_TIMER_CHANNELS];
+static apvHostSystemTick_t    apvHostSystemTick;
+static apvHostRealTimeTimer_t apvHostRealTimeTimer;
+static bool                   apvHostStopping = false;
+static apvHostCycles_t        apvHostCycleCounterLast = 0; // virtual time "CYCCNT" was last brought up to
+
+static apvHostCycles_t        apvHostRealTimeStart   = 0;     // virtual time the wall-clock origin stands for
+static bool                   apvHostRealTimeRunning = false;
+static struct timespec        apvHostRealTimeOrigin;
+
+static const apvHostHandler_t apvHostVectors[APV_HOST_NVIC_VECTORS] =
+  {
+  [APV_HOST_NVIC_EXCEPTIONS + SysTick_IRQn] = SysTick_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + RTT_IRQn]     = RTT_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + UART_IRQn]    = UART_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + USART0_IRQn]  = USART0_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + USART1_IRQn]  = USART1_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + USART2_IRQn]  = USART2_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + USART3_IRQn]  = USART3_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + SPI0_IRQn]    = SPI0_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC0_IRQn]     = TC0_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC1_IRQn]     = TC1_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC2_IRQn]     = TC2_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC3_IRQn]     = TC3_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC4_IRQn]     = TC4_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC5_IRQn]     = TC5_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC6_IRQn]     = TC6_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC7_IRQn]     = TC7_Handler,
+  [APV_HOST_NVIC_EXCEPTIONS + TC8_IRQn]     = TC8_Handler
+  };
+
+/******************************************************************************/
+/* Static Function Declarations :                                             */
+/******************************************************************************/
+
+static void            apvHostModelsUpdate(void);
+static void            apvHostInterruptsDispatch(void);
+static int32_t         apvHostInterruptNext(void);
+static void            apvHostInterruptLine(int32_t irq, bool lineLevel);
+static int32_t         apvHostVector(IRQn_Type irq);
+static void            apvHostSerialInitialise(apvHostSerial_t *serial,
+                                               const char      *serialName,
+                                               IRQn_Type        serialIrq,
+                                               volatile void   *serialRegisters,
+                                               Pdc             *serialPdc,
+                                               bool             serialUsart);
+static void            apvHostSerialUpdate(apvHostSerial_t *serial);
+static void            apvHostSerialReceive(apvHostSerial_t *serial,
+                                            uint8_t          receivedCharacter);
+static uint8_t         apvHostSerialLine(apvHostSerial_t *serial,
+                                         uint8_t          lineCharacter);
+static uint32_t        apvHostSerialErrorDraw(apvHostSerial_t *serial);
+static apvHostCycles_t apvHostSerialCharacterCycles(apvHostSerial_t *serial);
+static void            apvHostTimerUpdate(uint32_t timerIndex);
+static void            apvHostTimerSchedule(apvHostTimer_t *timer,
+                                            TcChannel      *channel);
+static apvHostCycles_t apvHostTimerCompareNext(apvHostTimer_t *timer,
+                                               uint32_t        timerCompare);
+static uint32_t        apvHostTimerChainSource(uint32_t timerIndex);
+static apvHostCycles_t apvHostTimerCycles(uint32_t timerMode,
+                                          uint64_t timerTicks);
+static uint64_t        apvHostTimerTicks(uint32_t        timerMode,
+                                         apvHostCycles_t timerCycles);
+static void            apvHostSystemTickUpdate(void);
+static void            apvHostCycleCounterUpdate(void);
+static void            apvHostRealTimeTimerUpdate(void);
+static apvHostCycles_t apvHostNextEvent(void);
+static void            apvHostRealTimePace(apvHostCycles_t paceTo);
+static void            apvHostStop(void);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+/* apvHostHalInitialise() :                                                   */
+/*  --> runLimit : the virtual time, in MCK cycles, the run stops at          */
+/*                                                                            */
+/* - put every model into its' reset state                                    */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostHalInitialise(apvHostCycles_t runLimit)
+  {
+/******************************************************************************/
+
+  uint32_t vector = 0;
+
+/******************************************************************************/
+
+  apvHostClock    = 0;
+  apvHostRunLimit = runLimit;
+  apvHostStopping = false;
+
+  memset(&apvHostNvic, 0, sizeof(apvHostNvic));
+
+  apvHostNvic.nvicActivePriority = APV_HOST_NVIC_THREAD_PRIORITY;
+
+  for (vector = 0; vector < APV_HOST_NVIC_VECTORS; vector++)
+    {
+    apvHostNvic.nvicEnabled[vector] = (vector < APV_HOST_NVIC_EXCEPTIONS) ? true : false; // system exceptions cannot be disabled
+    }
+
+  apvHostSerialInitialise(&apvHostSerial[APV_HOST_SERIAL_UART],   "UART",   UART_IRQn,   &apvHostUart,     PDC_UART,   false);
+  apvHostSerialInitialise(&apvHostSerial[APV_HOST_SERIAL_USART0], "USART0", USART0_IRQn, &apvHostUsart[0], PDC_USART0, true);
+  apvHostSerialInitialise(&apvHostSerial[APV_HOST_SERIAL_USART1], "USART1", USART1_IRQn, &apvHostUsart[1], PDC_USART1, true);
+  apvHostSerialInitialise(&apvHostSerial[APV_HOST_SERIAL_USART2], "USART2", USART2_IRQn, &apvHostUsart[2], PDC_USART2, true);
+  apvHostSerialInitialise(&apvHostSerial[APV_HOST_SERIAL_USART3], "USART3", USART3_IRQn, &apvHostUsart[3], PDC_USART3, true);
+
+  memset(&apvHostTc[0],          0, sizeof(apvHostTc));
+  memset(&apvHostTimers[0],      0, sizeof(apvHostTimers));
+  memset(&apvHostPmc,            0, sizeof(apvHostPmc));
+  memset(&apvHostPio[0],         0, sizeof(apvHostPio));
+  memset(&apvHostSpi,            0, sizeof(apvHostSpi));
+  memset(&apvHostRtt,            0, sizeof(apvHostRtt));
+  memset(&apvHostSysTick,        0, sizeof(apvHostSysTick));
+  memset(&apvHostDwt,            0, sizeof(apvHostDwt));
+  memset(&apvHostCoreDebug,      0, sizeof(apvHostCoreDebug));
+  memset(&apvHostSystemTick,     0, sizeof(apvHostSystemTick));
+  memset(&apvHostRealTimeTimer,  0, sizeof(apvHostRealTimeTimer));
+
+  APV_HOST_REGISTER(apvHostSpi.SPI_SR) = APV_HOST_SPI_READY;
+  apvHostRealTimeTimer.rttNextAlarm    = APV_HOST_CYCLES_NEVER;
+  apvHostCycleCounterLast              = 0;
+
+/******************************************************************************/
+  } /* end of apvHostHalInitialise                                            */
+
+/******************************************************************************/
+/* apvHostSerialConnect() :                                                   */
+/*  --> serialPort   : [ APV_HOST_SERIAL_UART .. APV_HOST_SERIAL_USART3 ]     */
+/*  --> serialInput  : file descriptor streamed into the receiver at line     */
+/*                     rate or -1                                             */
+/*  --> serialOutput : file descriptor the transmitter writes to or -1        */
+/*  --> inputStart   : virtual time the first input character may arrive      */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostSerialConnect(uint32_t        serialPort,
+                          int             serialInput,
+                          int             serialOutput,
+                          apvHostCycles_t inputStart)
+  {
+/******************************************************************************/
+
+  if (serialPort < APV_HOST_SERIAL_PORTS)
+    {
+    apvHostSerial[serialPort].serialInput       = serialInput;
+    apvHostSerial[serialPort].serialOutput      = serialOutput;
+    apvHostSerial[serialPort].serialNextArrival = inputStart;
+    }
+
+/******************************************************************************/
+  } /* end of apvHostSerialConnect                                            */
+
+/******************************************************************************/
+/* apvHostSerialErrors() :                                                    */
+/*  --> serialPort : [ APV_HOST_SERIAL_UART .. APV_HOST_SERIAL_USART3 ]       */
+/*  --> errorRate  : [ 0.0 .. 1.0 ] chance each character on the line has one */
+/*                   bit inverted, received and transmitted alike             */
+/*  --> errorSeed  : line error generator seed, 0 for the default             */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostSerialErrors(uint32_t serialPort,
+                         double   errorRate,
+                         uint32_t errorSeed)
+  {
+/******************************************************************************/
+
+  if (serialPort < APV_HOST_SERIAL_PORTS)
+    {
+    if (errorRate <= 0.0)
+      {
+      apvHostSerial[serialPort].serialErrorThreshold = 0;
+      }
+    else
+      {
+      if (errorRate >= 1.0)
+        {
+        apvHostSerial[serialPort].serialErrorThreshold = UINT32_MAX;
+        }
+      else
+        {
+        apvHostSerial[serialPort].serialErrorThreshold = (uint32_t)(errorRate * APV_HOST_ERROR_RATE_SCALE);
+        }
+      }
+
+    // xorshift32 never leaves the all-zero state
+    apvHostSerial[serialPort].serialErrorState = (errorSeed != 0) ? errorSeed : APV_HOST_SERIAL_ERROR_SEED;
+    }
+
+/******************************************************************************/
+  } /* end of apvHostSerialErrors                                             */
+
+/******************************************************************************/
+/* apvHostRealTimeEnable() :                                                  */
+/*  --> realTimeStart : virtual time the run starts keeping to the wall-clock */
+/*                                                                            */
+/* - the run is free to go as fast as it can up to 'realTimeStart' (the       */
+/*   sensor start-up) and from there on idles in step with the wall-clock     */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostRealTimeEnable(apvHostCycles_t realTimeStart)
+  {
+/******************************************************************************/
+
+  apvHostRealTime        = true;
+  apvHostRealTimeStart   = realTimeStart;
+  apvHostRealTimeRunning = false;
+
+/******************************************************************************/
+  } /* end of apvHostRealTimeEnable                                           */
+
+/******************************************************************************/
+/* apvHostUpdate() :                                                          */
+/*                                                                            */
+/* - an update point : charge the virtual time for the code run since the     */
+/*   last one, bring the models up to date and take any interrupt now due     */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostUpdate(void)
+  {
+/******************************************************************************/
+
+  apvHostClock = apvHostClock + APV_HOST_UPDATE_POINT_CYCLES;
+
+  apvHostModelsUpdate();
+  apvHostInterruptsDispatch();
+
+/******************************************************************************/
+  } /* end of apvHostUpdate                                                   */
+
+/******************************************************************************/
+/* apvHostIdle() :                                                            */
+/*                                                                            */
+/* - "WFI" : if no interrupt is waiting jump the virtual time to the next     */
+/*   model event. A waiting interrupt ends the wait even with PRIMASK set     */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostIdle(void)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t nextEvent = APV_HOST_CYCLES_NEVER;
+
+/******************************************************************************/
+
+  apvHostModelsUpdate();
+
+  if (apvHostInterruptNext() < 0)
+    {
+    nextEvent = apvHostNextEvent();
+
+    if ((nextEvent == APV_HOST_CYCLES_NEVER) || (nextEvent > apvHostRunLimit))
+      {
+      nextEvent = apvHostRunLimit;
+      }
+
+    if (nextEvent > apvHostClock)
+      {
+      apvHostRealTimePace(nextEvent);
+
+      apvHostClock = nextEvent;
+      }
+    }
+
+  apvHostUpdate();
+
+/******************************************************************************/
+  } /* end of apvHostIdle                                                     */
+
+/******************************************************************************/
+/* apvHostRegisterWrite() :                                                   */
+/*  --> registerAddress : the peripheral register                             */
+/*  --> registerValue   : value to write                                      */
+/*                                                                            */
+/* - 'APV_REGISTER_WRITE' : the model sees the write as it is made            */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostRegisterWrite(volatile uint32_t *registerAddress,
+                                   uint32_t  registerValue)
+  {
+/******************************************************************************/
+
+  *registerAddress = registerValue;
+
+  apvHostUpdate();
+
+/******************************************************************************/
+  } /* end of apvHostRegisterWrite                                            */
+
+/******************************************************************************/
+/* apvHostRegisterRead() :                                                    */
+/*  --> registerAddress : the peripheral register                             */
+/* <--  registerValue   : the register as of now                              */
+/*                                                                            */
+/* - 'APV_REGISTER_READ' : reading a receive holding register clears "RXRDY"  */
+/*   and reading a timer channel or RTT status register clears its' events    */
+/*                                                                            */
+/******************************************************************************/
+
+uint32_t apvHostRegisterRead(const volatile uint32_t *registerAddress)
+  {
+/******************************************************************************/
+
+  uint32_t registerValue = 0,
+           index         = 0;
+
+/******************************************************************************/
+
+  apvHostClock = apvHostClock + APV_HOST_UPDATE_POINT_CYCLES;
+
+  apvHostModelsUpdate();
+
+  registerValue = *registerAddress;
+
+  for (index = 0; index < APV_HOST_SERIAL_PORTS; index++)
+    {
+    if (registerAddress == apvHostSerial[index].serialRHR)
+      {
+      apvHostSerial[index].serialStatus = apvHostSerial[index].serialStatus & (~UART_SR_RXRDY);
+      }
+    }
+
+  for (index = 0; index < APV_HOST_TIMER_CHANNELS; index++)
+    {
+    if (registerAddress == &apvHostTc[index / TCCHANNEL_NUMBER].TC_CHANNEL[index % TCCHANNEL_NUMBER].TC_SR)
+      {
+      apvHostTimers[index].timerStatus = 0;
+      }
+    }
+
+  if (registerAddress == &apvHostRtt.RTT_SR)
+    {
+    apvHostRealTimeTimer.rttStatus = 0;
+    }
+
+  // The read may have dropped an interrupt line
+  apvHostModelsUpdate();
+  apvHostInterruptsDispatch();
+
+/******************************************************************************/
+
+  return(registerValue);
+
+/******************************************************************************/
+  } /* end of apvHostRegisterRead                                             */
+
+/******************************************************************************/
+/* apvHostReport() :                                                          */
+/*                                                                            */
+/* - the run summary to "stderr" : virtual time, interrupts taken by vector   */
+/*   and the serial character counts                                          */
+/*                                                                            */
+/******************************************************************************/
+
+void apvHostReport(void)
+  {
+/******************************************************************************/
+
+  uint32_t        vector    = 0,
+                  port      = 0;
+  struct timespec wallClock = { 0, 0 };
+
+/******************************************************************************/
+
+  fprintf(stderr, "virtual time  : %.6f s (%llu MCK cycles)\n",
+          ((double)apvHostClock) / ((double)APV_HOST_MASTER_CLOCK_HZ),
+          (unsigned long long)apvHostClock);
+
+  if (apvHostRealTimeRunning == true)
+    {
+    clock_gettime(CLOCK_MONOTONIC, &wallClock);
+
+    fprintf(stderr, "real time     : %.6f s from %.6f s virtual\n",
+            ((double)(wallClock.tv_sec  - apvHostRealTimeOrigin.tv_sec)) +
+            ((double)(wallClock.tv_nsec - apvHostRealTimeOrigin.tv_nsec)) / ((double)APV_HOST_NANOSECONDS_PER_SECOND),
+            ((double)apvHostRealTimeStart) / ((double)APV_HOST_MASTER_CLOCK_HZ));
+    }
+
+  for (vector = 0; vector < APV_HOST_NVIC_VECTORS; vector++)
+    {
+    if (apvHostNvic.nvicHandled[vector] != 0)
+      {
+      fprintf(stderr, "vector %-6d : %llu interrupts\n",
+              (int)vector - APV_HOST_NVIC_EXCEPTIONS,
+              (unsigned long long)apvHostNvic.nvicHandled[vector]);
+      }
+    }
+
+  for (port = 0; port < APV_HOST_SERIAL_PORTS; port++)
+    {
+    if ((apvHostSerial[port].serialReceived != 0) || (apvHostSerial[port].serialTransmitted != 0))
+      {
+      fprintf(stderr, "%-6s        : %llu received, %llu transmitted, %llu overruns, %llu corrupted, %llu dropped\n",
+              apvHostSerial[port].serialName,
+              (unsigned long long)apvHostSerial[port].serialReceived,
+              (unsigned long long)apvHostSerial[port].serialTransmitted,
+              (unsigned long long)apvHostSerial[port].serialOverruns,
+              (unsigned long long)apvHostSerial[port].serialErrors,
+              (unsigned long long)apvHostSerial[port].serialDropped);
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvHostReport                                                   */
+
+/******************************************************************************/
+/* CMSIS Core Functions :                                                     */
+/******************************************************************************/
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+  {
+  if (apvHostVector(IRQn) >= 0)
+    {
+    apvHostNvic.nvicEnabled[apvHostVector(IRQn)] = true;
+    }
+
+  apvHostUpdate();
+  } /* end of NVIC_EnableIRQ                                                  */
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+  {
+  if (apvHostVector(IRQn) >= APV_HOST_NVIC_EXCEPTIONS)
+    {
+    apvHostNvic.nvicEnabled[apvHostVector(IRQn)] = false;
+    }
+
+  apvHostUpdate();
+  } /* end of NVIC_DisableIRQ                                                 */
+
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+  {
+  if (apvHostVector(IRQn) >= 0)
+    {
+    apvHostNvic.nvicPending[apvHostVector(IRQn)] = true;
+    }
+
+  apvHostUpdate();
+  } /* end of NVIC_SetPendingIRQ                                              */
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+  {
+  if (apvHostVector(IRQn) >= 0)
+    {
+    apvHostNvic.nvicPending[apvHostVector(IRQn)] = false;
+    }
+
+  apvHostUpdate();
+  } /* end of NVIC_ClearPendingIRQ                                            */
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn)
+  {
+  uint32_t pending = 0;
+
+  if (apvHostVector(IRQn) >= 0)
+    {
+    pending = (apvHostNvic.nvicPending[apvHostVector(IRQn)] == true) ? 1 : 0;
+    }
+
+  return(pending);
+  } /* end of NVIC_GetPendingIRQ                                              */
+
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+  {
+  if (apvHostVector(IRQn) >= 0)
+    {
+    apvHostNvic.nvicPriority[apvHostVector(IRQn)] = priority & ((1 << APV_HOST_NVIC_PRIORITY_BITS) - 1);
+    }
+  } /* end of NVIC_SetPriority                                                */
+
+uint32_t NVIC_GetPriority(IRQn_Type IRQn)
+  {
+  uint32_t priority = 0;
+
+  if (apvHostVector(IRQn) >= 0)
+    {
+    priority = apvHostNvic.nvicPriority[apvHostVector(IRQn)];
+    }
+
+  return(priority);
+  } /* end of NVIC_GetPriority                                                */
+
+uint32_t SysTick_Config(uint32_t ticks)
+  {
+  uint32_t configError = 1;
+
+  if ((ticks != 0) && ((ticks - 1) <= SysTick_LOAD_RELOAD_Msk))
+    {
+    SysTick->LOAD = ticks - 1;
+    SysTick->VAL  = 0;
+
+    NVIC_SetPriority(SysTick_IRQn, APV_HOST_NVIC_DEFAULT_PRIORITY); // as CMSIS
+
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    apvHostSystemTick.tickEnabled = false; // restart the count
+
+    configError = 0;
+    }
+
+  apvHostUpdate();
+
+  return(configError);
+  } /* end of SysTick_Config                                                  */
+
+uint32_t __get_PRIMASK(void)
+  {
+  return(apvHostNvic.nvicPrimask);
+  } /* end of __get_PRIMASK                                                   */
+
+void __disable_irq(void)
+  {
+  apvHostNvic.nvicPrimask = 1;
+  } /* end of __disable_irq                                                   */
+
+void __enable_irq(void)
+  {
+  apvHostNvic.nvicPrimask = 0;
+
+  apvHostUpdate();
+  } /* end of __enable_irq                                                    */
+
+void __WFI(void)
+  {
+  apvHostIdle();
+  } /* end of __WFI                                                           */
+
+void __NOP(void)
+  { // The firmware only "nop"s in loops waiting on an interrupt : skip the wait
+  apvHostIdle();
+  } /* end of __NOP                                                           */
+
+void __DSB(void)
+  {
+  } /* end of __DSB                                                           */
+
+void __ISB(void)
+  {
+  } /* end of __ISB                                                           */
+
+/******************************************************************************/
+/* Static Function Definitions :                                              */
+/******************************************************************************/
+/* apvHostModelsUpdate() :                                                    */
+/*                                                                            */
+/* - bring every model up to the virtual time and sample the interrupt lines  */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostModelsUpdate(void)
+  {
+/******************************************************************************/
+
+  uint32_t index = 0;
+
+/******************************************************************************/
+
+  if (apvHostClock >= apvHostRunLimit)
+    {
+    apvHostStop();
+    }
+
+  // Peripheral clock enables
+  APV_HOST_REGISTER(apvHostPmc.PMC_PCSR0) = (apvHostPmc.PMC_PCSR0 | apvHostPmc.PMC_PCER0) & (~apvHostPmc.PMC_PCDR0);
+  APV_HOST_REGISTER(apvHostPmc.PMC_PCSR1) = (apvHostPmc.PMC_PCSR1 | apvHostPmc.PMC_PCER1) & (~apvHostPmc.PMC_PCDR1);
+
+  apvHostPmc.PMC_PCER0 = 0;
+  apvHostPmc.PMC_PCDR0 = 0;
+  apvHostPmc.PMC_PCER1 = 0;
+  apvHostPmc.PMC_PCDR1 = 0;
+
+  for (index = 0; index < APV_HOST_SERIAL_PORTS; index++)
+    {
+    apvHostSerialUpdate(&apvHostSerial[index]);
+    }
+
+  for (index = 0; index < APV_HOST_TIMER_CHANNELS; index++)
+    {
+    apvHostTimerUpdate(index);
+    }
+
+  apvHostSystemTickUpdate();
+  apvHostCycleCounterUpdate();
+  apvHostRealTimeTimerUpdate();
+
+/******************************************************************************/
+  } /* end of apvHostModelsUpdate                                             */
+
+/******************************************************************************/
+/* apvHostInterruptsDispatch() :                                              */
+/*                                                                            */
+/* - with PRIMASK clear call each pending handler that out-ranks the running  */
+/*   priority. A handler entry clears the pending flag; a line still asserted */
+/*   when the handler returns pends it again                                  */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostInterruptsDispatch(void)
+  {
+/******************************************************************************/
+
+  int32_t  vector         = 0;
+  uint32_t activePriority = 0;
+
+/******************************************************************************/
+
+  while ((apvHostNvic.nvicPrimask == 0) && ((vector = apvHostInterruptNext()) >= 0))
+    {
+    activePriority                      = apvHostNvic.nvicActivePriority;
+    apvHostNvic.nvicActivePriority      = apvHostNvic.nvicPriority[vector];
+    apvHostNvic.nvicPending[vector]     = false;
+    apvHostNvic.nvicActive[vector]      = true;
+    apvHostNvic.nvicHandled[vector]     = apvHostNvic.nvicHandled[vector] + 1;
+    apvHostNvic.nvicNesting             = apvHostNvic.nvicNesting + 1;
+
+    if (apvHostVectors[vector] != NULL)
+      {
+      apvHostVectors[vector]();
+      }
+    else
+      { // The target would run the default handler and hang there
+      fprintf(stderr, "no handler for vector %d\n", (int)vector - APV_HOST_NVIC_EXCEPTIONS);
+
+      apvHostStop();
+      }
+
+    apvHostNvic.nvicActive[vector]      = false;
+    apvHostNvic.nvicNesting             = apvHostNvic.nvicNesting - 1;
+    apvHostNvic.nvicActivePriority      = activePriority;
+
+    apvHostModelsUpdate();
+    }
+
+/******************************************************************************/
+  } /* end of apvHostInterruptsDispatch                                       */
+
+/******************************************************************************/
+/* apvHostInterruptNext() :                                                   */
+/*  <-- vector : the highest priority pending, enabled vector that out-ranks  */
+/*               the running priority or -1                                   */
+/*                                                                            */
+/******************************************************************************/
+
+static int32_t apvHostInterruptNext(void)
+  {
+/******************************************************************************/
+
+  int32_t  vector       = 0,
+           nextVector   = -1;
+  uint32_t nextPriority = apvHostNvic.nvicActivePriority;
+
+/******************************************************************************/
+
+  for (vector = 0; vector < APV_HOST_NVIC_VECTORS; vector++)
+    {
+    if ((apvHostNvic.nvicPending[vector]  == true) &&
+        (apvHostNvic.nvicEnabled[vector]  == true) &&
+        (apvHostNvic.nvicPriority[vector]  < nextPriority))
+      {
+      nextVector   = vector;
+      nextPriority = apvHostNvic.nvicPriority[vector];
+      }
+    }
+
+/******************************************************************************/
+
+  return(nextVector);
+
+/******************************************************************************/
+  } /* end of apvHostInterruptNext                                            */
+
+/******************************************************************************/
+/* apvHostInterruptLine() :                                                   */
+/*  --> irq       : the peripheral interrupt                                  */
+/*  --> lineLevel : the peripherals' interrupt output                         */
+/*                                                                            */
+/* - a level-sensitive line pends its' interrupt while it is asserted and     */
+/*   its' handler is not running : a line still asserted as the handler       */
+/*   returns pends it again                                                   */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostInterruptLine(int32_t irq, bool lineLevel)
+  {
+/******************************************************************************/
+
+  if ((lineLevel == true) && (apvHostNvic.nvicActive[APV_HOST_NVIC_EXCEPTIONS + irq] == false))
+    {
+    apvHostNvic.nvicPending[APV_HOST_NVIC_EXCEPTIONS + irq] = true;
+    }
+
+/******************************************************************************/
+  } /* end of apvHostInterruptLine                                            */
+
+/******************************************************************************/
+/* apvHostVector() :                                                          */
+/*  --> irq    : CMSIS interrupt number                                       */
+/*  <-- vector : index into the NVIC model or -1                              */
+/*                                                                            */
+/******************************************************************************/
+
+static int32_t apvHostVector(IRQn_Type irq)
+  {
+/******************************************************************************/
+
+  int32_t vector = ((int32_t)irq) + APV_HOST_NVIC_EXCEPTIONS;
+
+/******************************************************************************/
+
+  if ((vector < 0) || (vector >= APV_HOST_NVIC_VECTORS))
+    {
+    vector = -1;
+    }
+
+/******************************************************************************/
+
+  return(vector);
+
+/******************************************************************************/
+  } /* end of apvHostVector                                                   */
+
+/******************************************************************************/
+/* apvHostSerialInitialise() :                                                */
+/*  --> serial          : the serial model                                    */
+/*  --> serialName      : for the run summary                                 */
+/*  --> serialIrq       : the peripherals' interrupt                          */
+/*  --> serialRegisters : the 'Uart' or 'Usart' register block                */
+/*  --> serialPdc       : the peripherals' PDC register block                 */
+/*  --> serialUsart     : [ false == 'Uart' | true == 'Usart' ]               */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostSerialInitialise(apvHostSerial_t *serial,
+                                    const char      *serialName,
+                                    IRQn_Type        serialIrq,
+                                    volatile void   *serialRegisters,
+                                    Pdc             *serialPdc,
+                                    bool             serialUsart)
+  {
+/******************************************************************************/
+
+  Uart  *uart  = (Uart  *)serialRegisters;
+  Usart *usart = (Usart *)serialRegisters;
+
+/******************************************************************************/
+
+  memset(serial, 0, sizeof(apvHostSerial_t));
+
+  if (serialUsart == true)
+    {
+    memset(usart, 0, sizeof(Usart));
+
+    serial->serialCR   = &APV_HOST_REGISTER(usart->US_CR);
+    serial->serialMR   = &APV_HOST_REGISTER(usart->US_MR);
+    serial->serialIER  = &APV_HOST_REGISTER(usart->US_IER);
+    serial->serialIDR  = &APV_HOST_REGISTER(usart->US_IDR);
+    serial->serialIMR  = &APV_HOST_REGISTER(usart->US_IMR);
+    serial->serialSR   = &APV_HOST_REGISTER(usart->US_CSR);
+    serial->serialRHR  = &APV_HOST_REGISTER(usart->US_RHR);
+    serial->serialTHR  = &APV_HOST_REGISTER(usart->US_THR);
+    serial->serialBRGR = &APV_HOST_REGISTER(usart->US_BRGR);
+    }
+  else
+    {
+    memset(uart, 0, sizeof(Uart));
+
+    serial->serialCR   = &APV_HOST_REGISTER(uart->UART_CR);
+    serial->serialMR   = &APV_HOST_REGISTER(uart->UART_MR);
+    serial->serialIER  = &APV_HOST_REGISTER(uart->UART_IER);
+    serial->serialIDR  = &APV_HOST_REGISTER(uart->UART_IDR);
+    serial->serialIMR  = &APV_HOST_REGISTER(uart->UART_IMR);
+    serial->serialSR   = &APV_HOST_REGISTER(uart->UART_SR);
+    serial->serialRHR  = &APV_HOST_REGISTER(uart->UART_RHR);
+    serial->serialTHR  = &APV_HOST_REGISTER(uart->UART_THR);
+    serial->serialBRGR = &APV_HOST_REGISTER(uart->UART_BRGR);
+    }
+
+  serial->serialName   = serialName;
+  serial->serialIrq    = serialIrq;
+  serial->serialPdc    = serialPdc;
+  serial->serialUsart  = serialUsart;
+  serial->serialInput  = -1;
+  serial->serialOutput = -1;
+
+  *serial->serialTHR   = APV_HOST_SERIAL_HOLDING_EMPTY;
+
+/******************************************************************************/
+  } /* end of apvHostSerialInitialise                                         */
+
+/******************************************************************************/
+/* apvHostSerialUpdate() :                                                    */
+/*  --> serial : the serial model                                             */
+/*                                                                            */
+/* - consume the command registers, finish characters whose shift time has    */
+/*   passed, refill the transmit holding register from the PDC, take in any   */
+/*   input characters now due and rebuild the status register                 */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostSerialUpdate(apvHostSerial_t *serial)
+  {
+/******************************************************************************/
+
+  Pdc             *pdc             = (Pdc *)serial->serialPdc;
+  uint32_t         command         = 0,
+                   status          = 0;
+  apvHostCycles_t  characterCycles = 0;
+  uint8_t          character       = 0;
+  ssize_t          readLength      = 0;
+
+/******************************************************************************/
+
+  command = *serial->serialCR;
+
+  if (command != 0)
+    {
+    if ((command & UART_CR_RSTRX) == UART_CR_RSTRX)
+      {
+      serial->serialReceiverEnabled = false;
+      serial->serialStatus          = serial->serialStatus & (~UART_SR_RXRDY);
+      }
+
+    if ((command & UART_CR_RSTTX) == UART_CR_RSTTX)
+      {
+      serial->serialTransmitterEnabled = false;
+      serial->serialShifterBusy        = false;
+      *serial->serialTHR               = APV_HOST_SERIAL_HOLDING_EMPTY;
+      }
+
+    if ((command & UART_CR_RXDIS) == UART_CR_RXDIS)
+      {
+      serial->serialReceiverEnabled = false;
+      }
+    else
+      {
+      if ((command & UART_CR_RXEN) == UART_CR_RXEN)
+        {
+        serial->serialReceiverEnabled = true;
+        }
+      }
+
+    if ((command & UART_CR_TXDIS) == UART_CR_TXDIS)
+      {
+      serial->serialTransmitterEnabled = false;
+      }
+    else
+      {
+      if ((command & UART_CR_TXEN) == UART_CR_TXEN)
+        {
+        serial->serialTransmitterEnabled = true;
+        }
+      }
+
+    if ((command & UART_CR_RSTSTA) == UART_CR_RSTSTA)
+      {
+      serial->serialStatus = serial->serialStatus & (~(UART_SR_OVRE | UART_SR_FRAME | UART_SR_PARE));
+      }
+
+    *serial->serialCR = 0;
+    }
+
+  *serial->serialIMR = (*serial->serialIMR | *serial->serialIER) & (~(*serial->serialIDR));
+  *serial->serialIER = 0;
+  *serial->serialIDR = 0;
+
+  if (pdc->PERIPH_PTCR != 0)
+    {
+    if ((pdc->PERIPH_PTCR & PERIPH_PTCR_RXTDIS) == PERIPH_PTCR_RXTDIS)
+      {
+      pdc->PERIPH_PTSR = pdc->PERIPH_PTSR & (~PERIPH_PTSR_RXTEN);
+      }
+    else
+      {
+      if ((pdc->PERIPH_PTCR & PERIPH_PTCR_RXTEN) == PERIPH_PTCR_RXTEN)
+        {
+        pdc->PERIPH_PTSR = pdc->PERIPH_PTSR | PERIPH_PTSR_RXTEN;
+        }
+      }
+
+    if ((pdc->PERIPH_PTCR & PERIPH_PTCR_TXTDIS) == PERIPH_PTCR_TXTDIS)
+      {
+      pdc->PERIPH_PTSR = pdc->PERIPH_PTSR & (~PERIPH_PTSR_TXTEN);
+      }
+    else
+      {
+      if ((pdc->PERIPH_PTCR & PERIPH_PTCR_TXTEN) == PERIPH_PTCR_TXTEN)
+        {
+        pdc->PERIPH_PTSR = pdc->PERIPH_PTSR | PERIPH_PTSR_TXTEN;
+        }
+      }
+
+    pdc->PERIPH_PTCR = 0;
+    }
+
+  characterCycles = apvHostSerialCharacterCycles(serial);
+
+/******************************************************************************/
+/* Transmit : the shifter, then the holding register, then the PDC            */
+/******************************************************************************/
+
+  while (true)
+    {
+    if ((serial->serialShifterBusy == true) && (apvHostClock >= serial->serialShifterDone))
+      {
+      if (serial->serialOutput >= 0)
+        {
+        character = apvHostSerialLine(serial,
+                                      serial->serialShifter);
+
+        if (write(serial->serialOutput, &character, 1) != 1)
+          {
+          if ((errno == EAGAIN) || (errno == EIO))
+            { // A full pty or no client on it : the character is lost off the end of the line
+            serial->serialDropped = serial->serialDropped + 1;
+            }
+          else
+            {
+            serial->serialOutput = -1;
+            }
+          }
+        }
+
+      serial->serialShifterBusy = false;
+      serial->serialTransmitted = serial->serialTransmitted + 1;
+      }
+
+    if ((serial->serialTransmitterEnabled             == true)                          &&
+        (*serial->serialTHR                           == APV_HOST_SERIAL_HOLDING_EMPTY) &&
+        ((pdc->PERIPH_PTSR & PERIPH_PTSR_TXTEN)       == PERIPH_PTSR_TXTEN)             &&
+        (pdc->PERIPH_TCR                               > 0))
+      {
+      *serial->serialTHR = *((uint8_t *)pdc->PERIPH_TPR);
+      pdc->PERIPH_TPR    = pdc->PERIPH_TPR + 1;
+      pdc->PERIPH_TCR    = pdc->PERIPH_TCR - 1;
+
+      if ((pdc->PERIPH_TCR == 0) && (pdc->PERIPH_TNCR != 0))
+        {
+        pdc->PERIPH_TPR  = pdc->PERIPH_TNPR;
+        pdc->PERIPH_TCR  = pdc->PERIPH_TNCR;
+        pdc->PERIPH_TNCR = 0;
+        }
+      }
+
+    if ((serial->serialTransmitterEnabled == true)                          &&
+        (serial->serialShifterBusy        == false)                         &&
+        (*serial->serialTHR               != APV_HOST_SERIAL_HOLDING_EMPTY) &&
+        (characterCycles                  != 0))
+      { // A character waiting for the shifter follows the last one without a gap
+      if (serial->serialShifterDone < (apvHostClock - APV_HOST_UPDATE_POINT_CYCLES))
+        {
+        serial->serialShifterDone = apvHostClock;
+        }
+
+      serial->serialShifter     = (uint8_t)*serial->serialTHR;
+      serial->serialShifterDone = serial->serialShifterDone + characterCycles;
+      serial->serialShifterBusy = true;
+      *serial->serialTHR        = APV_HOST_SERIAL_HOLDING_EMPTY;
+      }
+    else
+      {
+      break;
+      }
+    }
+
+/******************************************************************************/
+/* Receive : input characters arrive back-to-back at the line rate            */
+/******************************************************************************/
+
+  if ((serial->serialReceiverEnabled == false) || (characterCycles == 0))
+    { // Nothing is lost while the line is down, the input just waits
+    if (serial->serialNextArrival < apvHostClock)
+      {
+      serial->serialNextArrival = apvHostClock;
+      }
+    }
+  else
+    {
+    while ((serial->serialInput >= 0) && (apvHostClock >= serial->serialNextArrival))
+      {
+      readLength = read(serial->serialInput, &character, 1);
+
+      if (readLength == 1)
+        {
+        apvHostSerialReceive(serial,
+                             apvHostSerialLine(serial,
+                                               character));
+
+        serial->serialInputSeen   = true;
+        serial->serialNextArrival = serial->serialNextArrival + characterCycles;
+        }
+      else
+        {
+        if ((readLength < 0) && ((errno == EAGAIN) || (errno == EINTR) ||
+                                 ((errno == EIO) && (serial->serialInputSeen == false))))
+          { // Nothing to read yet (a pty reads "EIO" until its' client opens it) : look again a character time later
+          serial->serialNextArrival = apvHostClock + characterCycles;
+          }
+        else
+          {
+          serial->serialInput = -1;
+
+          if ((apvHostRealTime == true) && (serial->serialInputSeen == true))
+            { // The client has gone : end the run
+            apvHostStop();
+            }
+          }
+
+        break;
+        }
+      }
+    }
+
+/******************************************************************************/
+/* Status and the interrupt line                                              */
+/******************************************************************************/
+
+  status = serial->serialStatus & APV_HOST_SERIAL_STATUS_STICKY;
+
+  if ((serial->serialTransmitterEnabled == true) && (*serial->serialTHR == APV_HOST_SERIAL_HOLDING_EMPTY))
+    {
+    status = status | UART_SR_TXRDY;
+
+    if (serial->serialShifterBusy == false)
+      {
+      status = status | UART_SR_TXEMPTY;
+      }
+    }
+
+  if (pdc->PERIPH_RCR == 0)
+    {
+    status = status | UART_SR_ENDRX;
+
+    if (pdc->PERIPH_RNCR == 0)
+      {
+      status = status | UART_SR_RXBUFF;
+      }
+    }
+
+  if (pdc->PERIPH_TCR == 0)
+    {
+    status = status | UART_SR_ENDTX;
+
+    if (pdc->PERIPH_TNCR == 0)
+      {
+      status = status | UART_SR_TXBUFE;
+      }
+    }
+
+  *serial->serialSR = status;
+
+  apvHostInterruptLine(serial->serialIrq,
+                       ((status & *serial->serialIMR) != 0) ? true : false);
+
+/******************************************************************************/
+  } /* end of apvHostSerialUpdate                                             */
+
+/******************************************************************************/
+/* apvHostSerialReceive() :                                                   */
+/*  --> serial            : the serial model                                  */
+/*  --> receivedCharacter : the character off the line                        */
+/*                                                                            */
+/* - the PDC takes the character if it has a receive count left, otherwise    */
+/*   it lands in "RHR". Landing on an unread character is an overrun          */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostSerialReceive(apvHostSerial_t *serial,
+                                 uint8_t          receivedCharacter)
+  {
+/******************************************************************************/
+
+  Pdc *pdc = (Pdc *)serial->serialPdc;
+
+/******************************************************************************/
+
+  serial->serialReceived = serial->serialReceived + 1;
+
+  if (((pdc->PERIPH_PTSR & PERIPH_PTSR_RXTEN) == PERIPH_PTSR_RXTEN) && (pdc->PERIPH_RCR > 0))
+    {
+    *((uint8_t *)pdc->PERIPH_RPR) = receivedCharacter;
+    pdc->PERIPH_RPR               = pdc->PERIPH_RPR + 1;
+    pdc->PERIPH_RCR               = pdc->PERIPH_RCR - 1;
+
+    if ((pdc->PERIPH_RCR == 0) && (pdc->PERIPH_RNCR != 0))
+      {
+      pdc->PERIPH_RPR  = pdc->PERIPH_RNPR;
+      pdc->PERIPH_RCR  = pdc->PERIPH_RNCR;
+      pdc->PERIPH_RNCR = 0;
+      }
+    }
+  else
+    {
+    if ((serial->serialStatus & UART_SR_RXRDY) == UART_SR_RXRDY)
+      {
+      serial->serialStatus   = serial->serialStatus | UART_SR_OVRE;
+      serial->serialOverruns = serial->serialOverruns + 1;
+      }
+
+    *serial->serialRHR   = receivedCharacter;
+    serial->serialStatus = serial->serialStatus | UART_SR_RXRDY;
+    }
+
+/******************************************************************************/
+  } /* end of apvHostSerialReceive                                            */
+
+/******************************************************************************/
+/* apvHostSerialLine() :                                                      */
+/*  --> serial        : the serial model                                      */
+/*  --> lineCharacter : the character put on the line                         */
+/*  <-- lineCharacter : the character taken off the line                      */
+/*                                                                            */
+/* - at the set error rate invert one data bit chosen at random               */
+/*                                                                            */
+/******************************************************************************/
+
+static uint8_t apvHostSerialLine(apvHostSerial_t *serial,
+                                 uint8_t          lineCharacter)
+  {
+/******************************************************************************/
+
+  if ((serial->serialErrorThreshold != 0) && (apvHostSerialErrorDraw(serial) < serial->serialErrorThreshold))
+    {
+    lineCharacter        = lineCharacter ^ ((uint8_t)(1 << (apvHostSerialErrorDraw(serial) % APV_HOST_SERIAL_DATA_BITS)));
+    serial->serialErrors = serial->serialErrors + 1;
+    }
+
+/******************************************************************************/
+
+  return(lineCharacter);
+
+/******************************************************************************/
+  } /* end of apvHostSerialLine                                               */
+
+/******************************************************************************/
+/* apvHostSerialErrorDraw() :                                                 */
+/*  --> serial : the serial model                                             */
+/*  <-- draw   : the next xorshift32 number of the line error generator       */
+/*                                                                            */
+/******************************************************************************/
+
+static uint32_t apvHostSerialErrorDraw(apvHostSerial_t *serial)
+  {
+/******************************************************************************/
+
+  serial->serialErrorState = serial->serialErrorState ^ (serial->serialErrorState << 13);
+  serial->serialErrorState = serial->serialErrorState ^ (serial->serialErrorState >> 17);
+  serial->serialErrorState = serial->serialErrorState ^ (serial->serialErrorState <<  5);
+
+/******************************************************************************/
+
+  return(serial->serialErrorState);
+
+/******************************************************************************/
+  } /* end of apvHostSerialErrorDraw                                          */
+
+/******************************************************************************/
+/* apvHostSerialCharacterCycles() :                                           */
+/*  --> serial          : the serial model                                    */
+/*  <-- characterCycles : MCK cycles per character or 0 for no baud clock     */
+/*                                                                            */
+/* - UART : baud = MCK / (16 * CD). USART : baud = MCK / (8 * (2 - OVER) *    */
+/*   (CD + FP / 8))                                                           */
+/*                                                                            */
+/******************************************************************************/
+
+static apvHostCycles_t apvHostSerialCharacterCycles(apvHostSerial_t *serial)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t characterCycles = 0,
+                  clockDivider    = 0,
+                  fractionDivider = 0,
+                  oversampling    = 2;
+
+/******************************************************************************/
+
+  clockDivider = (*serial->serialBRGR) & US_BRGR_CD_Msk;
+
+  if (clockDivider != 0)
+    {
+    if (serial->serialUsart == true)
+      {
+      fractionDivider = ((*serial->serialBRGR) & US_BRGR_FP_Msk) >> US_BRGR_FP_Pos;
+
+      if (((*serial->serialMR) & US_MR_OVER) == US_MR_OVER)
+        {
+        oversampling = 1;
+        }
+
+      characterCycles = APV_HOST_SERIAL_CHARACTER_BITS * oversampling * ((8 * clockDivider) + fractionDivider);
+      }
+    else
+      {
+      characterCycles = APV_HOST_SERIAL_CHARACTER_BITS * 16 * clockDivider;
+      }
+    }
+
+/******************************************************************************/
+
+  return(characterCycles);
+
+/******************************************************************************/
+  } /* end of apvHostSerialCharacterCycles                                    */
+
+/******************************************************************************/
+/* apvHostTimerUpdate() :                                                     */
+/*  --> timerIndex : [ 0 .. APV_HOST_TIMER_CHANNELS - 1 ]                     */
+/*                                                                            */
+/* - a channel counts from its' last reset while its' clock is enabled. In    */
+/*   "up to RC" waveform mode an RC compare sets "CPCS" and resets the count; */
+/*   otherwise the count wraps at 2^32 and sets "COVFS" and the RA, RB and RC */
+/*   compares set "CPAS", "CPBS" and "CPCS" once per wrap without touching    */
+/*   the count. TIOA is only followed as far as a chained channel needs it :  */
+/*   an RA compare that sets it is a rising edge (the RC compare is taken to  */
+/*   clear it again in between). A chained channel counts its' source's edges */
+/*   and has no compare or overflow events of its' own                        */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostTimerUpdate(uint32_t timerIndex)
+  {
+/******************************************************************************/
+
+  TcChannel      *channel     = &apvHostTc[timerIndex / TCCHANNEL_NUMBER].TC_CHANNEL[timerIndex % TCCHANNEL_NUMBER];
+  apvHostTimer_t *timer       = &apvHostTimers[timerIndex];
+  uint32_t        command     = 0,
+                  sourceIndex = 0;
+
+/******************************************************************************/
+
+  sourceIndex = apvHostTimerChainSource(timerIndex);
+
+  command     = channel->TC_CCR;
+
+  if (command != 0)
+    {
+    if ((command & TC_CCR_CLKDIS) == TC_CCR_CLKDIS)
+      {
+      timer->timerClockEnabled = false;
+      }
+    else
+      {
+      if ((command & TC_CCR_CLKEN) == TC_CCR_CLKEN)
+        {
+        if (timer->timerClockEnabled == false)
+          {
+          timer->timerClockEnabled = true;
+          timer->timerOrigin       = apvHostClock;
+          timer->timerEdgeOrigin   = (sourceIndex < APV_HOST_TIMER_CHANNELS) ? apvHostTimers[sourceIndex].timerEdges : 0;
+
+          apvHostTimerSchedule(timer,
+                               channel);
+          }
+        }
+      }
+
+    if (((command & TC_CCR_SWTRG) == TC_CCR_SWTRG) && (timer->timerClockEnabled == true))
+      {
+      timer->timerOrigin     = apvHostClock;
+      timer->timerEdgeOrigin = (sourceIndex < APV_HOST_TIMER_CHANNELS) ? apvHostTimers[sourceIndex].timerEdges : 0;
+
+      apvHostTimerSchedule(timer,
+                           channel);
+      }
+
+    APV_HOST_REGISTER(channel->TC_CCR) = 0;
+    }
+
+  APV_HOST_REGISTER(channel->TC_IMR) = (channel->TC_IMR | channel->TC_IER) & (~channel->TC_IDR);
+  APV_HOST_REGISTER(channel->TC_IER) = 0;
+  APV_HOST_REGISTER(channel->TC_IDR) = 0;
+
+  if (timer->timerClockEnabled == true)
+    {
+    if ((channel->TC_RA  != timer->timerCompareA) ||
+        (channel->TC_RB  != timer->timerCompareB) ||
+        (channel->TC_RC  != timer->timerCompare)  ||
+        (channel->TC_CMR != timer->timerMode))
+      {
+      apvHostTimerSchedule(timer,
+                           channel);
+      }
+
+    while (apvHostClock >= timer->timerNextCompareA)
+      {
+      timer->timerStatus = timer->timerStatus | TC_SR_CPAS;
+
+      if ((timer->timerMode & APV_HOST_TIMER_ACPA_MASK) == TC_CMR_ACPA_SET)
+        {
+        timer->timerEdges = timer->timerEdges + 1;
+        }
+
+      timer->timerNextCompareA = timer->timerNextCompareA + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+      }
+
+    while (apvHostClock >= timer->timerNextCompareB)
+      {
+      timer->timerStatus       = timer->timerStatus | TC_SR_CPBS;
+      timer->timerNextCompareB = timer->timerNextCompareB + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+      }
+
+    while (apvHostClock >= timer->timerNextCompare)
+      {
+      timer->timerStatus = timer->timerStatus | TC_SR_CPCS;
+
+      if (timer->timerNextOverflow == APV_HOST_CYCLES_NEVER)
+        { // "up to RC" : the compare resets the count
+        timer->timerOrigin = timer->timerNextCompare;
+
+        apvHostTimerSchedule(timer,
+                             channel);
+        }
+      else
+        {
+        timer->timerNextCompare = timer->timerNextCompare + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+        }
+      }
+
+    while (apvHostClock >= timer->timerNextOverflow)
+      {
+      timer->timerStatus       = timer->timerStatus | TC_SR_COVFS;
+      timer->timerOrigin       = timer->timerNextOverflow;
+      timer->timerNextOverflow = timer->timerNextOverflow + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+      }
+
+    if (sourceIndex < APV_HOST_TIMER_CHANNELS)
+      {
+      APV_HOST_REGISTER(channel->TC_CV) = (uint32_t)(apvHostTimers[sourceIndex].timerEdges - timer->timerEdgeOrigin);
+      }
+    else
+      {
+      APV_HOST_REGISTER(channel->TC_CV) = (uint32_t)apvHostTimerTicks(channel->TC_CMR,
+                                                                      apvHostClock - timer->timerOrigin);
+      }
+    }
+
+  APV_HOST_REGISTER(channel->TC_SR) = timer->timerStatus;
+
+  apvHostInterruptLine(TC0_IRQn + timerIndex,
+                       ((timer->timerStatus & channel->TC_IMR) != 0) ? true : false);
+
+/******************************************************************************/
+  } /* end of apvHostTimerUpdate                                              */
+
+/******************************************************************************/
+/* apvHostTimerSchedule() :                                                   */
+/*  --> timer   : the channel model                                           */
+/*  --> channel : the channel registers                                       */
+/*                                                                            */
+/* - the next compare and counter overflow times from the last reset. A       */
+/*   compare that does not reset the count and is already behind the          */
+/*   counter next matches after the wrap                                      */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostTimerSchedule(apvHostTimer_t *timer,
+                                 TcChannel      *channel)
+  {
+/******************************************************************************/
+
+  bool upToCompare = false;
+
+/******************************************************************************/
+
+  timer->timerCompareA     = channel->TC_RA;
+  timer->timerCompareB     = channel->TC_RB;
+  timer->timerCompare      = channel->TC_RC;
+  timer->timerMode         = channel->TC_CMR;
+  timer->timerNextCompareA = APV_HOST_CYCLES_NEVER;
+  timer->timerNextCompareB = APV_HOST_CYCLES_NEVER;
+  timer->timerNextCompare  = APV_HOST_CYCLES_NEVER;
+  timer->timerNextOverflow = APV_HOST_CYCLES_NEVER;
+
+  upToCompare = (((timer->timerMode & TC_CMR_WAVE) == TC_CMR_WAVE) &&
+                 ((timer->timerMode & APV_HOST_TIMER_WAVSEL_MASK) == TC_CMR_WAVSEL_UP_RC)) ? true : false;
+
+  if (apvHostTimerCycles(timer->timerMode, 1) != APV_HOST_CYCLES_NEVER)
+    {
+    if ((upToCompare == true) && (timer->timerCompare != 0))
+      {
+      timer->timerNextCompare  = timer->timerOrigin + apvHostTimerCycles(timer->timerMode, timer->timerCompare);
+      }
+    else
+      {
+      timer->timerNextOverflow = timer->timerOrigin + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+      timer->timerNextCompareA = apvHostTimerCompareNext(timer, timer->timerCompareA);
+      timer->timerNextCompareB = apvHostTimerCompareNext(timer, timer->timerCompareB);
+      timer->timerNextCompare  = apvHostTimerCompareNext(timer, timer->timerCompare);
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvHostTimerSchedule                                            */
+
+/******************************************************************************/
+/* apvHostTimerCompareNext() :                                                */
+/*  --> timer        : the channel model                                      */
+/*  --> timerCompare : "TC_RA", "TC_RB" or "TC_RC"                            */
+/*  <-- compareNext  : when the count next matches without a counter reset    */
+/*                                                                            */
+/******************************************************************************/
+
+static apvHostCycles_t apvHostTimerCompareNext(apvHostTimer_t *timer,
+                                               uint32_t        timerCompare)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t compareNext = 0;
+
+/******************************************************************************/
+
+  compareNext = timer->timerOrigin + apvHostTimerCycles(timer->timerMode, timerCompare);
+
+  if (compareNext <= apvHostClock)
+    {
+    compareNext = compareNext + apvHostTimerCycles(timer->timerMode, APV_HOST_TIMER_COUNTER_RANGE);
+    }
+
+/******************************************************************************/
+
+  return(compareNext);
+
+/******************************************************************************/
+  } /* end of apvHostTimerCompareNext                                         */
+
+/******************************************************************************/
+/* apvHostTimerChainSource() :                                                */
+/*  --> timerIndex  : [ 0 .. APV_HOST_TIMER_CHANNELS - 1 ]                    */
+/*  <-- sourceIndex : the channel whose TIOA clocks this one or               */
+/*                    APV_HOST_TIMER_CHANNELS if it is not chained            */
+/*                                                                            */
+/* - a channel clocked from "XC<n>" with the block's "TC<n>XC<n>S" field      */
+/*   selecting a TIOA : the two choices are the other two channels of the     */
+/*   block, lowest first                                                      */
+/*                                                                            */
+/******************************************************************************/
+
+static uint32_t apvHostTimerChainSource(uint32_t timerIndex)
+  {
+/******************************************************************************/
+
+  Tc       *block       = &apvHostTc[timerIndex / TCCHANNEL_NUMBER];
+  uint32_t  sourceIndex = APV_HOST_TIMER_CHANNELS,
+            external    = 0,
+            selection   = 0;
+
+/******************************************************************************/
+
+  external = block->TC_CHANNEL[timerIndex % TCCHANNEL_NUMBER].TC_CMR & APV_HOST_TIMER_CLOCK_SELECT_MASK;
+
+  if (external >= TC_CMR_TCCLKS_XC0)
+    {
+    external  = external - TC_CMR_TCCLKS_XC0;
+    selection = (block->TC_BMR >> (external * APV_HOST_TIMER_XC_SELECT_WIDTH)) & APV_HOST_TIMER_XC_SELECT_MASK;
+
+    if (selection >= APV_HOST_TIMER_XC_SELECT_TIOA)
+      {
+      sourceIndex = selection - APV_HOST_TIMER_XC_SELECT_TIOA;
+
+      // "XC<n>" cannot select its' "own" channel's TIOA
+      if (sourceIndex >= external)
+        {
+        sourceIndex = sourceIndex + 1;
+        }
+
+      sourceIndex = (timerIndex - (timerIndex % TCCHANNEL_NUMBER)) + sourceIndex;
+      }
+    }
+
+/******************************************************************************/
+
+  return(sourceIndex);
+
+/******************************************************************************/
+  } /* end of apvHostTimerChainSource                                         */
+
+/******************************************************************************/
+/* apvHostTimerCycles() :                                                     */
+/*  --> timerMode   : "TC_CMR"                                                */
+/*  --> timerTicks  : counter ticks                                           */
+/*  <-- timerCycles : MCK cycles for that many ticks of the selected clock    */
+/*                    (rounded up) or APV_HOST_CYCLES_NEVER for an external   */
+/*                    clock                                                   */
+/*                                                                            */
+/******************************************************************************/
+
+static apvHostCycles_t apvHostTimerCycles(uint32_t timerMode,
+                                          uint64_t timerTicks)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t timerCycles = APV_HOST_CYCLES_NEVER;
+
+/******************************************************************************/
+
+  switch(timerMode & APV_HOST_TIMER_CLOCK_SELECT_MASK)
+    {
+    case TC_CMR_TCCLKS_TIMER_CLOCK1 : timerCycles = timerTicks * 2;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK2 : timerCycles = timerTicks * 8;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK3 : timerCycles = timerTicks * 32;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK4 : timerCycles = timerTicks * 128;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK5 : timerCycles = ((timerTicks * APV_HOST_MASTER_CLOCK_HZ) + (APV_HOST_SLOW_CLOCK_HZ - 1)) / APV_HOST_SLOW_CLOCK_HZ;
+                                      break;
+    default                         : break; // XC0 .. XC2 : nothing drives them
+    }
+
+/******************************************************************************/
+
+  return(timerCycles);
+
+/******************************************************************************/
+  } /* end of apvHostTimerCycles                                              */
+
+/******************************************************************************/
+/* apvHostTimerTicks() :                                                      */
+/*  --> timerMode   : "TC_CMR"                                                */
+/*  --> timerCycles : MCK cycles                                              */
+/*  <-- timerTicks  : whole ticks of the selected clock in that time          */
+/*                                                                            */
+/******************************************************************************/
+
+static uint64_t apvHostTimerTicks(uint32_t        timerMode,
+                                  apvHostCycles_t timerCycles)
+  {
+/******************************************************************************/
+
+  uint64_t timerTicks = 0;
+
+/******************************************************************************/
+
+  switch(timerMode & APV_HOST_TIMER_CLOCK_SELECT_MASK)
+    {
+    case TC_CMR_TCCLKS_TIMER_CLOCK1 : timerTicks = timerCycles / 2;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK2 : timerTicks = timerCycles / 8;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK3 : timerTicks = timerCycles / 32;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK4 : timerTicks = timerCycles / 128;
+                                      break;
+    case TC_CMR_TCCLKS_TIMER_CLOCK5 : timerTicks = (timerCycles * APV_HOST_SLOW_CLOCK_HZ) / APV_HOST_MASTER_CLOCK_HZ;
+                                      break;
+    default                         : break;
+    }
+
+/******************************************************************************/
+
+  return(timerTicks);
+
+/******************************************************************************/
+  } /* end of apvHostTimerTicks                                               */
+
+/******************************************************************************/
+/* apvHostSystemTickUpdate() :                                                */
+/*                                                                            */
+/* - "SysTick" counts MCK down from "LOAD" and pends its' exception on each   */
+/*   reload while "TICKINT" is set                                            */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostSystemTickUpdate(void)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t tickPeriod = ((apvHostCycles_t)(SysTick->LOAD & SysTick_LOAD_RELOAD_Msk)) + 1;
+
+/******************************************************************************/
+
+  if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) == SysTick_CTRL_ENABLE_Msk)
+    {
+    if (apvHostSystemTick.tickEnabled == false)
+      {
+      apvHostSystemTick.tickEnabled = true;
+      apvHostSystemTick.tickNext    = apvHostClock + tickPeriod;
+      }
+
+    while (apvHostClock >= apvHostSystemTick.tickNext)
+      {
+      SysTick->CTRL              = SysTick->CTRL | SysTick_CTRL_COUNTFLAG_Msk;
+      apvHostSystemTick.tickNext = apvHostSystemTick.tickNext + tickPeriod;
+
+      if ((SysTick->CTRL & SysTick_CTRL_TICKINT_Msk) == SysTick_CTRL_TICKINT_Msk)
+        {
+        apvHostNvic.nvicPending[APV_HOST_SYSTICK_VECTOR] = true;
+        }
+      }
+
+    SysTick->VAL = (uint32_t)(apvHostSystemTick.tickNext - apvHostClock - 1);
+    }
+  else
+    {
+    apvHostSystemTick.tickEnabled = false;
+    }
+
+/******************************************************************************/
+  } /* end of apvHostSystemTickUpdate                                         */
+
+/******************************************************************************/
+/* apvHostCycleCounterUpdate() :                                              */
+/*                                                                            */
+/* - "CYCCNT" counts MCK while both the trace enable and the counter enable   */
+/*   are set. It is advanced rather than recomputed so a firmware write to it */
+/*   holds                                                                    */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostCycleCounterUpdate(void)
+  {
+/******************************************************************************/
+
+  if (((CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) == CoreDebug_DEMCR_TRCENA_Msk) &&
+      ((DWT->CTRL        & DWT_CTRL_CYCCNTENA_Msk)     == DWT_CTRL_CYCCNTENA_Msk))
+    {
+    DWT->CYCCNT = DWT->CYCCNT + (uint32_t)(apvHostClock - apvHostCycleCounterLast);
+    }
+
+  apvHostCycleCounterLast = apvHostClock;
+
+/******************************************************************************/
+  } /* end of apvHostCycleCounterUpdate                                       */
+
+/******************************************************************************/
+/* apvHostRealTimeTimerUpdate() :                                             */
+/*                                                                            */
+/* - the RTT counts SLCK / "RTPRES" from its' last "RTTRST" and raises "ALMS" */
+/*   once as it passes "RTT_AR"                                               */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostRealTimeTimerUpdate(void)
+  {
+/******************************************************************************/
+
+  uint64_t prescaler = apvHostRtt.RTT_MR & APV_HOST_RTT_PRESCALER_MASK;
+
+/******************************************************************************/
+
+  if (prescaler == 0)
+    {
+    prescaler = APV_HOST_RTT_PRESCALER_MASK + 1;
+    }
+
+  if ((apvHostRtt.RTT_MR & RTT_MR_RTTRST) == RTT_MR_RTTRST)
+    {
+    apvHostRtt.RTT_MR                 = apvHostRtt.RTT_MR & (~RTT_MR_RTTRST); // self-clearing
+    apvHostRealTimeTimer.rttOrigin    = apvHostClock;
+    apvHostRealTimeTimer.rttNextAlarm = apvHostClock +
+                                        (((((uint64_t)apvHostRtt.RTT_AR) + 1) * prescaler * APV_HOST_MASTER_CLOCK_HZ) / APV_HOST_SLOW_CLOCK_HZ);
+    }
+
+  if (apvHostClock >= apvHostRealTimeTimer.rttNextAlarm)
+    {
+    apvHostRealTimeTimer.rttStatus    = apvHostRealTimeTimer.rttStatus | APV_HOST_RTT_ALARM_STATUS;
+    apvHostRealTimeTimer.rttNextAlarm = APV_HOST_CYCLES_NEVER;
+    }
+
+  APV_HOST_REGISTER(apvHostRtt.RTT_VR) = (uint32_t)((((apvHostClock - apvHostRealTimeTimer.rttOrigin) * APV_HOST_SLOW_CLOCK_HZ) / APV_HOST_MASTER_CLOCK_HZ) / prescaler);
+  APV_HOST_REGISTER(apvHostRtt.RTT_SR) = apvHostRealTimeTimer.rttStatus;
+
+  apvHostInterruptLine(RTT_IRQn,
+                       (((apvHostRtt.RTT_MR & RTT_MR_ALMIEN) == RTT_MR_ALMIEN) &&
+                        ((apvHostRealTimeTimer.rttStatus & APV_HOST_RTT_ALARM_STATUS) != 0)) ? true : false);
+
+/******************************************************************************/
+  } /* end of apvHostRealTimeTimerUpdate                                      */
+
+/******************************************************************************/
+/* apvHostNextEvent() :                                                       */
+/*  <-- nextEvent : the earliest time any model changes state by itself or    */
+/*                  APV_HOST_CYCLES_NEVER                                     */
+/*                                                                            */
+/******************************************************************************/
+
+static apvHostCycles_t apvHostNextEvent(void)
+  {
+/******************************************************************************/
+
+  apvHostCycles_t nextEvent = APV_HOST_CYCLES_NEVER;
+  uint32_t        index     = 0;
+
+/******************************************************************************/
+
+  for (index = 0; index < APV_HOST_SERIAL_PORTS; index++)
+    {
+    if ((apvHostSerial[index].serialShifterBusy == true) && (apvHostSerial[index].serialShifterDone < nextEvent))
+      {
+      nextEvent = apvHostSerial[index].serialShifterDone;
+      }
+
+    if ((apvHostSerial[index].serialInput           >= 0)    &&
+        (apvHostSerial[index].serialReceiverEnabled == true) &&
+        (apvHostSerial[index].serialNextArrival      < nextEvent))
+      {
+      nextEvent = apvHostSerial[index].serialNextArrival;
+      }
+    }
+
+  for (index = 0; index < APV_HOST_TIMER_CHANNELS; index++)
+    {
+    if (apvHostTimers[index].timerClockEnabled == true)
+      {
+      if (apvHostTimers[index].timerNextCompareA < nextEvent)
+        {
+        nextEvent = apvHostTimers[index].timerNextCompareA;
+        }
+
+      if (apvHostTimers[index].timerNextCompareB < nextEvent)
+        {
+        nextEvent = apvHostTimers[index].timerNextCompareB;
+        }
+
+      if (apvHostTimers[index].timerNextCompare < nextEvent)
+        {
+        nextEvent = apvHostTimers[index].timerNextCompare;
+        }
+
+      if (apvHostTimers[index].timerNextOverflow < nextEvent)
+        {
+        nextEvent = apvHostTimers[index].timerNextOverflow;
+        }
+      }
+    }
+
+  if ((apvHostSystemTick.tickEnabled == true) && (apvHostSystemTick.tickNext < nextEvent))
+    {
+    nextEvent = apvHostSystemTick.tickNext;
+    }
+
+  if (apvHostRealTimeTimer.rttNextAlarm < nextEvent)
+    {
+    nextEvent = apvHostRealTimeTimer.rttNextAlarm;
+    }
+
+/******************************************************************************/
+
+  return(nextEvent);
+
+/******************************************************************************/
+  } /* end of apvHostNextEvent                                                */
+
+/******************************************************************************/
+/* apvHostRealTimePace() :                                                    */
+/*  --> paceTo : the virtual time about to be jumped to                       */
+/*                                                                            */
+/* - in real-time mode sleep until the wall-clock reaches 'paceTo'. A run     */
+/*   that has fallen behind the wall-clock does not wait                      */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostRealTimePace(apvHostCycles_t paceTo)
+  {
+/******************************************************************************/
+
+  struct timespec wakeUp      = { 0, 0 };
+  uint64_t        nanoseconds = 0;
+
+/******************************************************************************/
+
+  if ((apvHostRealTime == true) && (paceTo > apvHostRealTimeStart))
+    {
+    if (apvHostRealTimeRunning == false)
+      { // The wall-clock origin is taken as the virtual time first passes the real-time start
+      if (apvHostClock > apvHostRealTimeStart)
+        {
+        apvHostRealTimeStart = apvHostClock;
+        }
+
+      clock_gettime(CLOCK_MONOTONIC, &apvHostRealTimeOrigin);
+
+      apvHostRealTimeRunning = true;
+      }
+
+    nanoseconds = ((paceTo - apvHostRealTimeStart) * 1000) / APV_HOST_NANOSECONDS_PER_CYCLE_DIVISOR;
+
+    wakeUp.tv_sec  = apvHostRealTimeOrigin.tv_sec  + (time_t)(nanoseconds / APV_HOST_NANOSECONDS_PER_SECOND);
+    wakeUp.tv_nsec = apvHostRealTimeOrigin.tv_nsec + (long)(nanoseconds % APV_HOST_NANOSECONDS_PER_SECOND);
+
+    if (wakeUp.tv_nsec >= APV_HOST_NANOSECONDS_PER_SECOND)
+      {
+      wakeUp.tv_sec  = wakeUp.tv_sec  + 1;
+      wakeUp.tv_nsec = wakeUp.tv_nsec - APV_HOST_NANOSECONDS_PER_SECOND;
+      }
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUp, NULL) == EINTR)
+      {
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvHostRealTimePace                                             */
+
+/******************************************************************************/
+/* apvHostStop() :                                                            */
+/*                                                                            */
+/* - the run limit has been reached : report and end the process              */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvHostStop(void)
+  {
+/******************************************************************************/
+
+  if (apvHostStopping == false)
+    {
+    apvHostStopping = true;
+
+    apvHostReport();
+
+    exit(EXIT_SUCCESS);
+    }
+
+/******************************************************************************/
+  } /* end of apvHostStop                                                     */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,181 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvHostHal.h                                                               */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : a simulated SAM3X8E HAL so the firmware core builds and runs */
+/*   as a Linux process with 'APV_HOST_SIMULATION' defined. Time is a virtual */
+/*   MCK cycle count that only moves at "update points" : register hooks,     */
+/*   interrupt unmasking, NVIC calls, '__NOP()' and '__WFI()'. At each update */
+/*   point the peripheral models are brought up to date, their interrupt      */
+/*   lines are sampled into the NVIC model and any enabled, unmasked and high */
+/*   enough pending interrupt handler is called directly                      */
+/*                                                                            */
+/*   In real-time mode (the pty loopback) the virtual time is held back to    */
+/*   the wall-clock once it reaches the real-time start so a client on the    */
+/*   other end of the serial port sees the link at its simulated baud rate    */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _APV_HOST_HAL_H_
+#define _APV_HOST_HAL_H_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define APV_HOST_MASTER_CLOCK_HZ          (84000000)  // MCK
+#define APV_HOST_SLOW_CLOCK_HZ            (32768)     // SLCK
+#define APV_HOST_UPDATE_POINT_CYCLES      (16)        // virtual time charged for the code between two update points
+
+#define APV_HOST_NVIC_EXCEPTIONS          (16)        // Cortex-M3 system exceptions ahead of the peripheral IRQs
+#define APV_HOST_NVIC_PERIPHERALS         (45)        // 'PERIPH_COUNT_IRQn'
+#define APV_HOST_NVIC_VECTORS             (APV_HOST_NVIC_EXCEPTIONS + APV_HOST_NVIC_PERIPHERALS)
+#define APV_HOST_NVIC_PRIORITY_BITS       (4)
+#define APV_HOST_NVIC_THREAD_PRIORITY     (256)       // below every configurable priority
+
+#define APV_HOST_SERIAL_UART              (0)
+#define APV_HOST_SERIAL_USART0            (1)
+#define APV_HOST_SERIAL_USART1            (2)
+#define APV_HOST_SERIAL_USART2            (3)
+#define APV_HOST_SERIAL_USART3            (4)
+#define APV_HOST_SERIAL_PORTS             (5)
+
+#define APV_HOST_SERIAL_CHARACTER_BITS    (10)        // start + 8 data + stop
+#define APV_HOST_SERIAL_HOLDING_EMPTY     (0xffffffff) // "THR" holds no character
+#define APV_HOST_SERIAL_ERROR_SEED        (0x2545f491) // line error generator seed when none is given
+
+#define APV_HOST_TIMER_CHANNELS           (9)         // TC0 .. TC8
+
+#define APV_HOST_CYCLES_NEVER             (UINT64_MAX)
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef uint64_t apvHostCycles_t;
+
+typedef struct apvHostNvic_tTag
+  {
+  bool          nvicEnabled[APV_HOST_NVIC_VECTORS];
+  bool          nvicPending[APV_HOST_NVIC_VECTORS];
+  bool          nvicActive[APV_HOST_NVIC_VECTORS];
+  uint32_t      nvicPriority[APV_HOST_NVIC_VECTORS];
+  uint32_t      nvicActivePriority;                  // the running handlers' priority, thread mode when none
+  uint32_t      nvicPrimask;
+  uint32_t      nvicNesting;
+  uint64_t      nvicHandled[APV_HOST_NVIC_VECTORS];
+  } apvHostNvic_t;
+
+typedef struct apvHostSerial_tTag
+  {
+  const char            *serialName;
+  int                    serialIrq;                  // 'IRQn_Type'
+  volatile uint32_t     *serialCR;
+  volatile uint32_t     *serialMR;
+  volatile uint32_t     *serialIER;
+  volatile uint32_t     *serialIDR;
+  volatile uint32_t     *serialIMR;
+  volatile uint32_t     *serialSR;
+  volatile uint32_t     *serialRHR;
+  volatile uint32_t     *serialTHR;
+  volatile uint32_t     *serialBRGR;
+  void                  *serialPdc;                  // 'Pdc *' : NULL for no PDC
+  bool                   serialUsart;                // "BRGR" has a fractional part and "MR" an "OVER" bit
+  bool                   serialReceiverEnabled;
+  bool                   serialTransmitterEnabled;
+  uint32_t               serialStatus;               // the sticky status bits : RXRDY, OVRE, FRAME, PARE
+  bool                   serialShifterBusy;
+  uint8_t                serialShifter;
+  apvHostCycles_t        serialShifterDone;
+  apvHostCycles_t        serialNextArrival;
+  int                    serialInput;                // file descriptor or -1
+  int                    serialOutput;               // file descriptor or -1
+  uint64_t               serialReceived;
+  uint64_t               serialTransmitted;
+  uint64_t               serialOverruns;
+  uint32_t               serialErrorThreshold;       // a character is corrupted when the generator draws below this
+  uint32_t               serialErrorState;           // xorshift32 line error generator
+  uint64_t               serialErrors;               // characters corrupted, both directions
+  uint64_t               serialDropped;              // transmitted characters the output could not take
+  bool                   serialInputSeen;            // the input has delivered at least one character
+  } apvHostSerial_t;
+
+typedef struct apvHostTimer_tTag
+  {
+  bool                   timerClockEnabled;
+  uint32_t               timerStatus;                // COVFS, CPAS, CPBS, CPCS : cleared by reading "TC_SR"
+  apvHostCycles_t        timerOrigin;                // time of the last counter reset
+  apvHostCycles_t        timerNextCompareA;          // the RA and RB compares : plain up counting only
+  apvHostCycles_t        timerNextCompareB;
+  apvHostCycles_t        timerNextCompare;
+  apvHostCycles_t        timerNextOverflow;
+  uint32_t               timerCompareA;              // "TC_RA" the events were scheduled against
+  uint32_t               timerCompareB;              // "TC_RB" the events were scheduled against
+  uint32_t               timerCompare;               // "TC_RC" the events were scheduled against
+  uint32_t               timerMode;                  // "TC_CMR" the events were scheduled against
+  uint64_t               timerEdges;                 // TIOA rising edges : the RA compares set TIOA ("ACPA")
+  uint64_t               timerEdgeOrigin;            // chained : the source channel's edges at the last counter reset
+  } apvHostTimer_t;
+
+typedef struct apvHostSystemTick_tTag
+  {
+  bool                   tickEnabled;
+  apvHostCycles_t        tickOrigin;
+  apvHostCycles_t        tickNext;
+  } apvHostSystemTick_t;
+
+typedef struct apvHostRealTimeTimer_tTag
+  {
+  apvHostCycles_t        rttOrigin;
+  apvHostCycles_t        rttNextAlarm;
+  uint32_t               rttStatus;
+  } apvHostRealTimeTimer_t;
+
+/******************************************************************************/
+/* Global Variable Declarations :                                             */
+/******************************************************************************/
+
+extern apvHostCycles_t  apvHostClock;
+extern apvHostCycles_t  apvHostRunLimit;
+extern apvHostNvic_t    apvHostNvic;
+extern apvHostSerial_t  apvHostSerial[APV_HOST_SERIAL_PORTS];
+extern bool             apvHostRealTime;
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern void            apvHostHalInitialise(apvHostCycles_t runLimit);
+extern void            apvHostSerialConnect(uint32_t        serialPort,
+                                            int             serialInput,
+                                            int             serialOutput,
+                                            apvHostCycles_t inputStart);
+extern void            apvHostSerialErrors(uint32_t serialPort,
+                                           double   errorRate,
+                                           uint32_t errorSeed);
+extern void            apvHostRealTimeEnable(apvHostCycles_t realTimeStart);
+extern void            apvHostUpdate(void);
+extern void            apvHostIdle(void);
+extern void            apvHostReport(void);
+extern void            apvHostRegisterWrite(volatile uint32_t *registerAddress,
+                                                     uint32_t  registerValue);
+extern uint32_t        apvHostRegisterRead(const volatile uint32_t *registerAddress);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,232 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvHostMain.c                                                              */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : runs the firmware ('ArduinoDueMain.c' built with its' "main" */
+/*   renamed 'apvFirmwareMain') on the simulated HAL for a fixed virtual time */
+/*                                                                            */
+/*   ApvHost [-i input] [-o output] [-p] [-t seconds] [-d seconds]            */
+/*           [-e rate] [-s seed]                                              */
+/*                                                                            */
+/*    -i : file streamed into the UART receiver at the line rate              */
+/*    -o : file the UART transmitter writes to                                */
+/*    -p : connect the UART to a new pseudo-terminal instead and run in real  */
+/*         time from the end of the input delay. The pty slave path is the    */
+/*         one line written to "stdout"; the run ends when the client that    */
+/*         opened it closes it ('ApvHostClient.c')                            */
+/*    -t : virtual run time (default 20s)                                     */
+/*    -d : virtual time the input is held back for (default 12s : the sensor  */
+/*         start-up waits ~11s with the messaging loop not yet running)       */
+/*    -e : chance each UART character is corrupted, both ways (default 0.0)   */
+/*    -s : seed for the line errors                                           */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#define _GNU_SOURCE // 'posix_openpt()', 'ptsname()' and 'cfmakeraw()'
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <sam3x8e.h>
+#include "ApvHostHal.h"
+
+/******************************************************************************/
+/* Constant Definitions :                                                     */
+/******************************************************************************/
+
+#define APV_HOST_RUN_TIME_DEFAULT         (20.0) // seconds
+#define APV_HOST_INPUT_DELAY_DEFAULT      (12.0) // seconds
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern int apvFirmwareMain(void);
+
+static int apvHostPseudoTerminalOpen(void);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+
+int main(int argc, char *argv[])
+  {
+/******************************************************************************/
+
+  int      option      = 0,
+           inputFile   = -1,
+           outputFile  = -1,
+           exitCode    = EXIT_SUCCESS;
+  bool     realTime    = false;
+  double   runTime     = APV_HOST_RUN_TIME_DEFAULT,
+           inputDelay  = APV_HOST_INPUT_DELAY_DEFAULT,
+           errorRate   = 0.0;
+  uint32_t errorSeed   = 0;
+
+/******************************************************************************/
+
+  while ((option = getopt(argc, argv, "i:o:pt:d:e:s:")) != -1)
+    {
+    switch(option)
+      {
+      case 'i' : inputFile = open(optarg, O_RDONLY);
+
+                 if (inputFile < 0)
+                   {
+                   perror(optarg);
+                   exitCode = EXIT_FAILURE;
+                   }
+                 break;
+
+      case 'o' : outputFile = open(optarg, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+                 if (outputFile < 0)
+                   {
+                   perror(optarg);
+                   exitCode = EXIT_FAILURE;
+                   }
+                 break;
+
+      case 'p' : realTime   = true;
+                 break;
+
+      case 't' : runTime    = atof(optarg);
+                 break;
+
+      case 'd' : inputDelay = atof(optarg);
+                 break;
+
+      case 'e' : errorRate  = atof(optarg);
+                 break;
+
+      case 's' : errorSeed  = (uint32_t)strtoul(optarg, NULL, 0);
+                 break;
+
+      default  : exitCode   = EXIT_FAILURE;
+                 break;
+      }
+    }
+
+  if ((exitCode == EXIT_SUCCESS) && (realTime == true))
+    {
+    inputFile  = apvHostPseudoTerminalOpen();
+    outputFile = inputFile;
+
+    if (inputFile < 0)
+      {
+      exitCode = EXIT_FAILURE;
+      }
+    }
+
+  if (exitCode == EXIT_SUCCESS)
+    {
+    apvHostHalInitialise((apvHostCycles_t)(runTime * APV_HOST_MASTER_CLOCK_HZ));
+
+    apvHostSerialErrors(APV_HOST_SERIAL_UART,
+                        errorRate,
+                        errorSeed);
+
+    if (realTime == true)
+      {
+      apvHostRealTimeEnable((apvHostCycles_t)(inputDelay * APV_HOST_MASTER_CLOCK_HZ));
+      }
+
+    apvHostSerialConnect(APV_HOST_SERIAL_UART,
+                         inputFile,
+                         outputFile,
+                         (apvHostCycles_t)(inputDelay * APV_HOST_MASTER_CLOCK_HZ));
+
+    // Returns only if the firmware start-up failed : the run limit ends a good run
+    apvFirmwareMain();
+
+    fprintf(stderr, "firmware start-up failed\n");
+
+    apvHostReport();
+
+    exitCode = EXIT_FAILURE;
+    }
+  else
+    {
+    fprintf(stderr, "usage : %s [-i input] [-o output] [-p] [-t seconds] [-d seconds] [-e rate] [-s seed]\n", argv[0]);
+    }
+
+/******************************************************************************/
+
+  return(exitCode);
+
+/******************************************************************************/
+  } /* end of main                                                            */
+
+/******************************************************************************/
+/* apvHostPseudoTerminalOpen() :                                              */
+/*  <-- ptyMaster : the non-blocking pty master or -1                         */
+/*                                                                            */
+/* - open a pty, put its' line discipline into raw mode and publish the slave */
+/*   path on "stdout" for the client                                          */
+/*                                                                            */
+/******************************************************************************/
+
+static int apvHostPseudoTerminalOpen(void)
+  {
+/******************************************************************************/
+
+  int             ptyMaster = -1,
+                  ptySlave  = -1;
+  const char     *ptyPath   = NULL;
+  struct termios  ptyLine;
+
+/******************************************************************************/
+
+  ptyMaster = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+  if ((ptyMaster < 0) || (grantpt(ptyMaster) != 0) || (unlockpt(ptyMaster) != 0) || ((ptyPath = ptsname(ptyMaster)) == NULL))
+    {
+    perror("pty");
+    }
+  else
+    {
+    // The slave is closed again at once : the master reads "EIO" until the client opens it
+    ptySlave = open(ptyPath, O_RDWR | O_NOCTTY);
+
+    if ((ptySlave >= 0) && (tcgetattr(ptySlave, &ptyLine) == 0))
+      {
+      cfmakeraw(&ptyLine);
+      tcsetattr(ptySlave, TCSANOW, &ptyLine);
+      }
+
+    if (ptySlave >= 0)
+      {
+      close(ptySlave);
+      }
+
+    fprintf(stdout, "%s\n", ptyPath);
+    fflush(stdout);
+    }
+
+  if ((ptyMaster >= 0) && (ptyPath == NULL))
+    {
+    close(ptyMaster);
+
+    ptyMaster = -1;
+    }
+
+/******************************************************************************/
+
+  return(ptyMaster);
+
+/******************************************************************************/
+  } /* end of apvHostPseudoTerminalOpen                                       */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,559 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* ApvHostPdcCheck.c                                                          */
+/* 18.10.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : checks 'ApvSerialPdc.c' against a PDC register block in RAM. */
+/*   The check plays the part of the PDC itself, landing and sending          */
+/*   characters exactly as the hardware moves its' pointers and counters, so  */
+/*   each step of the driver can be compared with the registers it leaves     */
+/*                                                                            */
+/*   ApvHostPdcCheck                                                          */
+/*                                                                            */
+/*   Exits with EXIT_FAILURE if any check fails                               */
+/*                                                                            */
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sam3x8e.h>
+#include "ApvHostHal.h"
+#include "ApvCommsUtilities.h"
+#include "ApvSerialPdc.h"
+
+/******************************************************************************/
+/* Constant Definitions :                                                     */
+/******************************************************************************/
+
+#define APV_PDC_CHECK_RUN_TIME            (1.0) // seconds : only the register writes charge virtual time
+#define APV_PDC_CHECK_RING_LENGTH         (APV_COMMS_RING_BUFFER_MAXIMUM_LENGTH)
+#define APV_PDC_CHECK_RECEIVE_PARTIAL     (10)  // characters landed before an unfilled block is serviced
+#define APV_PDC_CHECK_TRANSMIT_LENGTH     (8)   // the first frames' length; each following frame is one longer
+
+/******************************************************************************/
+/* Local Variables :                                                          */
+/******************************************************************************/
+
+static uint32_t                    apvPdcCheckFailures = 0;
+
+static Pdc                         apvPdcCheckReceiveChannel;
+static apvSerialPdcReceive_t       apvPdcCheckReceive;
+static apvRingBuffer_t             apvPdcCheckReceiveRing;
+static apvRingBufferReceiveGuard_t apvPdcCheckReceiveGuard;
+
+static Pdc                         apvPdcCheckTransmitChannel;
+static apvSerialPdcTransmit_t      apvPdcCheckTransmit;
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+static void     apvPdcCheck(bool        checkPassed,
+                            const char *checkDescription);
+static void     apvPdcCheckLand(Pdc           *pdcChannel,
+                                const uint8_t *landCharacters,
+                                uint16_t       numberOfCharacters);
+static uint16_t apvPdcCheckDrain(apvRingBuffer_t *ringBuffer,
+                                 uint8_t         *drainCharacters,
+                                 uint16_t         maximumCharacters);
+static uint16_t apvPdcCheckSend(Pdc      *pdcChannel,
+                                uint8_t  *sendCharacters,
+                                uint16_t  maximumCharacters);
+static void     apvPdcCheckReceiveChecks(void);
+static void     apvPdcCheckTransmitChecks(void);
+
+/******************************************************************************/
+/* Function Definitions :                                                     */
+/******************************************************************************/
+
+int main(void)
+  {
+/******************************************************************************/
+
+  int exitCode = EXIT_SUCCESS;
+
+/******************************************************************************/
+
+  // Every driver register write is an update point of the simulated HAL
+  apvHostHalInitialise((apvHostCycles_t)(APV_PDC_CHECK_RUN_TIME * APV_HOST_MASTER_CLOCK_HZ));
+
+  apvPdcCheckReceiveChecks();
+  apvPdcCheckTransmitChecks();
+
+  if (apvPdcCheckFailures != 0)
+    {
+    fprintf(stderr, "PDC checks : %u failed\n", apvPdcCheckFailures);
+    exitCode = EXIT_FAILURE;
+    }
+  else
+    {
+    fprintf(stdout, "PDC checks : all passed\n");
+    }
+
+/******************************************************************************/
+
+  return(exitCode);
+
+/******************************************************************************/
+  } /* end of main                                                            */
+
+/******************************************************************************/
+/* apvPdcCheck() :                                                            */
+/*  --> checkPassed      : the outcome of one check                           */
+/*  --> checkDescription : what was checked                                   */
+/*                                                                            */
+/* - report and count a failed check                                          */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPdcCheck(bool        checkPassed,
+                        const char *checkDescription)
+  {
+/******************************************************************************/
+
+  if (checkPassed == false)
+    {
+    fprintf(stderr, "FAILED : %s\n", checkDescription);
+    apvPdcCheckFailures = apvPdcCheckFailures + 1;
+    }
+
+/******************************************************************************/
+  } /* end of apvPdcCheck                                                     */
+
+/******************************************************************************/
+/* apvPdcCheckLand() :                                                        */
+/*  --> pdcChannel         : the PDC register block                           */
+/*  --> landCharacters     : characters arriving at the receiver              */
+/*  --> numberOfCharacters : the number of arriving characters                */
+/*                                                                            */
+/* - the PDC receive channel : each character is stored at RPR and counted    */
+/*   off RCR; when RCR reaches zero a non-zero RNCR moves "next" into         */
+/*   "current". With both counters zero the PDC has stopped and the character */
+/*   is lost                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPdcCheckLand(Pdc           *pdcChannel,
+                            const uint8_t *landCharacters,
+                            uint16_t       numberOfCharacters)
+  {
+/******************************************************************************/
+
+  uint16_t landCharacter = 0;
+
+/******************************************************************************/
+
+  for (landCharacter = 0; landCharacter < numberOfCharacters; landCharacter++)
+    {
+    if (pdcChannel->PERIPH_RCR != 0)
+      {
+      *((uint8_t *)pdcChannel->PERIPH_RPR) = *(landCharacters + landCharacter);
+
+      pdcChannel->PERIPH_RPR = pdcChannel->PERIPH_RPR + 1;
+      pdcChannel->PERIPH_RCR = pdcChannel->PERIPH_RCR - 1;
+
+      if ((pdcChannel->PERIPH_RCR == 0) && (pdcChannel->PERIPH_RNCR != 0))
+        {
+        pdcChannel->PERIPH_RPR  = pdcChannel->PERIPH_RNPR;
+        pdcChannel->PERIPH_RCR  = pdcChannel->PERIPH_RNCR;
+        pdcChannel->PERIPH_RNCR = 0;
+        }
+      }
+    }
+
+/******************************************************************************/
+  } /* end of apvPdcCheckLand                                                 */
+
+/******************************************************************************/
+/* apvPdcCheckSend() :                                                        */
+/*  --> pdcChannel        : the PDC register block                            */
+/*  --> sendCharacters    : the characters the transmitter sent               */
+/*  --> maximumCharacters : the number of characters to send at most          */
+/*  <-- charactersSent    : the number of characters sent                     */
+/*                                                                            */
+/* - the PDC transmit channel : each character is taken from TPR and counted  */
+/*   off TCR; when TCR reaches zero a non-zero TNCR moves "next" into         */
+/*   "current". With both counters zero the PDC has nothing left to send      */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvPdcCheckSend(Pdc      *pdcChannel,
+                                uint8_t  *sendCharacters,
+                                uint16_t  maximumCharacters)
+  {
+/******************************************************************************/
+
+  uint16_t charactersSent = 0;
+
+/******************************************************************************/
+
+  while ((charactersSent < maximumCharacters) && (pdcChannel->PERIPH_TCR != 0))
+    {
+    *(sendCharacters + charactersSent) = *((uint8_t *)pdcChannel->PERIPH_TPR);
+
+    charactersSent         = charactersSent         + 1;
+    pdcChannel->PERIPH_TPR = pdcChannel->PERIPH_TPR + 1;
+    pdcChannel->PERIPH_TCR = pdcChannel->PERIPH_TCR - 1;
+
+    if ((pdcChannel->PERIPH_TCR == 0) && (pdcChannel->PERIPH_TNCR != 0))
+      {
+      pdcChannel->PERIPH_TPR  = pdcChannel->PERIPH_TNPR;
+      pdcChannel->PERIPH_TCR  = pdcChannel->PERIPH_TNCR;
+      pdcChannel->PERIPH_TNCR = 0;
+      }
+    }
+
+/******************************************************************************/
+
+  return(charactersSent);
+
+/******************************************************************************/
+  } /* end of apvPdcCheckSend                                                 */
+
+/******************************************************************************/
+/* apvPdcCheckDrain() :                                                       */
+/*  --> ringBuffer        : a receive ring-buffer                             */
+/*  --> drainCharacters   : the characters taken off the ring-buffer          */
+/*  --> maximumCharacters : the room in 'drainCharacters'                     */
+/*  <-- charactersDrained : the number of characters taken                    */
+/*                                                                            */
+/* - empty the ring-buffer as the de-framer would                             */
+/*                                                                            */
+/******************************************************************************/
+
+static uint16_t apvPdcCheckDrain(apvRingBuffer_t *ringBuffer,
+                                 uint8_t         *drainCharacters,
+                                 uint16_t         maximumCharacters)
+  {
+/******************************************************************************/
+
+  uint16_t charactersDrained = 0;
+  uint32_t ringToken         = 0;
+
+/******************************************************************************/
+
+  while ((charactersDrained < maximumCharacters) &&
+         (apvRingBufferUnLoad(ringBuffer,
+                              APV_RING_BUFFER_TOKEN_TYPE_LONG_WORD,
+                              &ringToken,
+                              1,
+                              false) != 0))
+    {
+    *(drainCharacters + charactersDrained) = (uint8_t)ringToken;
+    charactersDrained                      = charactersDrained + 1;
+    }
+
+/******************************************************************************/
+
+  return(charactersDrained);
+
+/******************************************************************************/
+  } /* end of apvPdcCheckDrain                                                */
+
+/******************************************************************************/
+/* apvPdcCheckReceiveChecks() :                                               */
+/*                                                                            */
+/* - the receive double-buffer :                                              */
+/*   (i)   both landing blocks are loaded at start-up                         */
+/*   (ii)  a full block is delivered once the PDC has moved on, and handed    */
+/*         back as RNPR/RNCR                                                  */
+/*   (iii) a part-filled block is delivered without being handed back         */
+/*   (iv)  both blocks filled before the service stalls the PDC; the service  */
+/*         delivers both in order and restarts the PDC on the other block     */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPdcCheckReceiveChecks(void)
+  {
+/******************************************************************************/
+
+  Pdc       *pdcChannel      = &apvPdcCheckReceiveChannel;
+  uintptr_t  receiveBlock[APV_SERIAL_PDC_RECEIVE_BLOCKS];
+  uint8_t    receiveCharacters[APV_SERIAL_PDC_RECEIVE_BLOCKS * APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH * 2],
+             drainCharacters[APV_SERIAL_PDC_RECEIVE_BLOCKS * APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH * 2];
+  uint16_t   receiveCharacter  = 0,
+             receiveLanded     = 0,
+             receiveLength     = 0,
+             charactersDrained = 0;
+
+/******************************************************************************/
+
+  for (receiveCharacter = 0; receiveCharacter < sizeof(receiveCharacters); receiveCharacter++)
+    {
+    receiveCharacters[receiveCharacter] = (uint8_t)((receiveCharacter * 7) + 1);
+    }
+
+  memset(pdcChannel, 0, sizeof(Pdc));
+
+  apvRingBufferInitialise(&apvPdcCheckReceiveRing,
+                          APV_PDC_CHECK_RING_LENGTH);
+  apvRingBufferReceiveGuardInitialise(&apvPdcCheckReceiveGuard,
+                                      APV_RING_BUFFER_OVERFLOW_DROP_NEWEST);
+
+  apvPdcCheck(apvSerialPdcReceiveInitialise(&apvPdcCheckReceive,
+                                            pdcChannel,
+                                            &apvPdcCheckReceiveRing,
+                                            &apvPdcCheckReceiveGuard) == APV_ERROR_CODE_NONE,
+              "receive initialise");
+
+  receiveBlock[0] = (uintptr_t)&apvPdcCheckReceive.pdcReceiveBlocks[0][0];
+  receiveBlock[1] = (uintptr_t)&apvPdcCheckReceive.pdcReceiveBlocks[1][0];
+
+  // (i) "current" is block 0, "next" is block 1
+  apvPdcCheck((pdcChannel->PERIPH_RPR  == receiveBlock[0])                       &&
+              (pdcChannel->PERIPH_RCR  == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH)   &&
+              (pdcChannel->PERIPH_RNPR == receiveBlock[1])                       &&
+              (pdcChannel->PERIPH_RNCR == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH)   &&
+              (pdcChannel->PERIPH_PTCR == PERIPH_PTCR_RXTEN),
+              "receive blocks loaded at start-up");
+
+  // (ii) fill block 0 : the PDC moves to block 1 and the service hands block 0 back
+  apvPdcCheckLand(pdcChannel,
+                  &receiveCharacters[receiveLanded],
+                  APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH);
+  receiveLanded = receiveLanded + APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH;
+
+  apvPdcCheck((pdcChannel->PERIPH_RPR == receiveBlock[1]) && (pdcChannel->PERIPH_RNCR == 0),
+              "receive PDC swapped to block 1");
+
+  apvPdcCheck(apvSerialPdcReceiveService(&apvPdcCheckReceive,
+                                         false) == true,
+              "receive block 0 serviced");
+
+  apvPdcCheck((pdcChannel->PERIPH_RNPR == receiveBlock[0])                       &&
+              (pdcChannel->PERIPH_RNCR == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH)   &&
+              (apvPdcCheckReceive.pdcReceiveActiveBlock     == 1)                &&
+              (apvPdcCheckReceive.pdcReceiveBlocksCompleted == 1),
+              "receive block 0 re-armed as RNPR/RNCR");
+
+  charactersDrained = apvPdcCheckDrain(&apvPdcCheckReceiveRing,
+                                       &drainCharacters[receiveLength],
+                                       sizeof(drainCharacters) - receiveLength);
+  receiveLength     = receiveLength + charactersDrained;
+
+  apvPdcCheck(charactersDrained == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH,
+              "receive block 0 delivered whole");
+
+  // (iii) part-fill block 1 : delivered, but block 1 stays with the PDC
+  apvPdcCheckLand(pdcChannel,
+                  &receiveCharacters[receiveLanded],
+                  APV_PDC_CHECK_RECEIVE_PARTIAL);
+  receiveLanded = receiveLanded + APV_PDC_CHECK_RECEIVE_PARTIAL;
+
+  apvPdcCheck(apvSerialPdcReceiveService(&apvPdcCheckReceive,
+                                         false) == true,
+              "receive part-filled block serviced");
+
+  apvPdcCheck((apvPdcCheckReceive.pdcReceiveActiveBlock     == 1)                             &&
+              (apvPdcCheckReceive.pdcReceiveConsumed        == APV_PDC_CHECK_RECEIVE_PARTIAL) &&
+              (apvPdcCheckReceive.pdcReceiveBlocksCompleted == 1)                             &&
+              (pdcChannel->PERIPH_RNPR == receiveBlock[0])                                    &&
+              (pdcChannel->PERIPH_RNCR == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH),
+              "receive part-filled block kept by the PDC");
+
+  charactersDrained = apvPdcCheckDrain(&apvPdcCheckReceiveRing,
+                                       &drainCharacters[receiveLength],
+                                       sizeof(drainCharacters) - receiveLength);
+  receiveLength     = receiveLength + charactersDrained;
+
+  apvPdcCheck(charactersDrained == APV_PDC_CHECK_RECEIVE_PARTIAL,
+              "receive part-filled block delivered");
+
+  // (iv) fill the rest of block 1 and all of block 0 : the PDC stops, then restarts on block 1
+  apvPdcCheckLand(pdcChannel,
+                  &receiveCharacters[receiveLanded],
+                  (2 * APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH) - APV_PDC_CHECK_RECEIVE_PARTIAL);
+  receiveLanded = receiveLanded + (2 * APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH) - APV_PDC_CHECK_RECEIVE_PARTIAL;
+
+  apvPdcCheck((pdcChannel->PERIPH_RCR == 0) && (pdcChannel->PERIPH_RNCR == 0),
+              "receive PDC stalled with both blocks full");
+
+  apvPdcCheck(apvSerialPdcReceiveService(&apvPdcCheckReceive,
+                                         false) == true,
+              "receive stalled blocks serviced");
+
+  apvPdcCheck((pdcChannel->PERIPH_RPR  == receiveBlock[1])                       &&
+              (pdcChannel->PERIPH_RCR  == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH)   &&
+              (pdcChannel->PERIPH_RNPR == receiveBlock[0])                       &&
+              (pdcChannel->PERIPH_RNCR == APV_SERIAL_PDC_RECEIVE_BLOCK_LENGTH)   &&
+              (apvPdcCheckReceive.pdcReceiveActiveBlock     == 1)                &&
+              (apvPdcCheckReceive.pdcReceiveBlocksCompleted == 3)                &&
+              (apvPdcCheckReceive.pdcReceiveStalls          == 1),
+              "receive PDC restarted after the stall");
+
+  charactersDrained = apvPdcCheckDrain(&apvPdcCheckReceiveRing,
+                                       &drainCharacters[receiveLength],
+                                       sizeof(drainCharacters) - receiveLength);
+  receiveLength     = receiveLength + charactersDrained;
+
+  // Every character arrives once and in order
+  apvPdcCheck((receiveLength == receiveLanded) && (memcmp(receiveCharacters, drainCharacters, receiveLength) == 0),
+              "receive characters delivered in order");
+
+  apvPdcCheck((apvPdcCheckReceive.pdcReceiveCharactersDropped == 0) && (apvPdcCheckReceiveGuard.receiveOverflows == 0),
+              "receive characters not dropped");
+
+/******************************************************************************/
+  } /* end of apvPdcCheckReceiveChecks                                        */
+
+/******************************************************************************/
+/* apvPdcCheckTransmitChecks() :                                              */
+/*                                                                            */
+/* - the transmit frame queue :                                               */
+/*   (i)   the first frame goes into TPR/TCR, the second is chained into      */
+/*         TNPR/TNCR and the third and fourth wait in their slots             */
+/*   (ii)  a fifth frame is refused while all the slots are taken             */
+/*   (iii) as each frame finishes the next waiting one is chained behind the  */
+/*         frame now being sent, until the queue is empty                     */
+/*   (iv)  the frame slots are reused after the queue wraps                   */
+/*                                                                            */
+/******************************************************************************/
+
+static void apvPdcCheckTransmitChecks(void)
+  {
+/******************************************************************************/
+
+  Pdc       *pdcChannel = &apvPdcCheckTransmitChannel;
+  uint8_t    transmitFrames[APV_SERIAL_PDC_TRANSMIT_FRAMES * 2][APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH],
+             transmitExpected[APV_SERIAL_PDC_TRANSMIT_FRAMES * 2 * APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH],
+             sendCharacters[APV_SERIAL_PDC_TRANSMIT_FRAMES * 2 * APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH];
+  uint16_t   transmitFrameLength = 0,
+             transmitLength      = 0,
+             sendLength          = 0,
+             frameCharacter      = 0;
+  uint8_t    transmitFrame       = 0,
+             framesQueued        = 0;
+
+/******************************************************************************/
+
+  for (transmitFrame = 0; transmitFrame < (APV_SERIAL_PDC_TRANSMIT_FRAMES * 2); transmitFrame++)
+    {
+    for (frameCharacter = 0; frameCharacter < APV_SERIAL_PDC_TRANSMIT_FRAME_LENGTH; frameCharacter++)
+      {
+      transmitFrames[transmitFrame][frameCharacter] = (uint8_t)((transmitFrame << 5) + frameCharacter);
+      }
+    }
+
+  memset(pdcChannel, 0, sizeof(Pdc));
+
+  apvPdcCheck(apvSerialPdcTransmitInitialise(&apvPdcCheckTransmit,
+                                             pdcChannel) == APV_ERROR_CODE_NONE,
+              "transmit initialise");
+
+  apvPdcCheck((pdcChannel->PERIPH_TCR  == 0) &&
+              (pdcChannel->PERIPH_TNCR == 0) &&
+              (pdcChannel->PERIPH_PTCR == PERIPH_PTCR_TXTEN),
+              "transmit idle at start-up");
+
+  // (i) fill every frame slot
+  for (transmitFrame = 0; transmitFrame < APV_SERIAL_PDC_TRANSMIT_FRAMES; transmitFrame++)
+    {
+    transmitFrameLength = APV_PDC_CHECK_TRANSMIT_LENGTH + transmitFrame;
+
+    apvPdcCheck(apvSerialPdcTransmitQueue(&apvPdcCheckTransmit,
+                                          &transmitFrames[transmitFrame][0],
+                                          transmitFrameLength,
+                                          true) == APV_ERROR_CODE_NONE,
+                "transmit frame queued");
+
+    memcpy(&transmitExpected[transmitLength], &transmitFrames[transmitFrame][0], transmitFrameLength);
+    transmitLength = transmitLength + transmitFrameLength;
+    framesQueued   = framesQueued   + 1;
+    }
+
+  apvPdcCheck((pdcChannel->PERIPH_TPR  == (uintptr_t)&apvPdcCheckTransmit.pdcTransmitFrames[0][0]) &&
+              (pdcChannel->PERIPH_TCR  == APV_PDC_CHECK_TRANSMIT_LENGTH)                            &&
+              (pdcChannel->PERIPH_TNPR == (uintptr_t)&apvPdcCheckTransmit.pdcTransmitFrames[1][0]) &&
+              (pdcChannel->PERIPH_TNCR == (APV_PDC_CHECK_TRANSMIT_LENGTH + 1)),
+              "transmit first frame current, second chained");
+
+  apvPdcCheck((apvPdcCheckTransmit.pdcTransmitCount         == APV_SERIAL_PDC_TRANSMIT_FRAMES)    &&
+              (apvPdcCheckTransmit.pdcTransmitInPdc         == APV_SERIAL_PDC_TRANSMIT_REGISTERS) &&
+              (apvPdcCheckTransmit.pdcTransmitFramesChained == 1),
+              "transmit third and fourth frames waiting");
+
+  // (ii) no slot is free
+  apvPdcCheck(apvSerialPdcTransmitSpace(&apvPdcCheckTransmit) == false,
+              "transmit space refused with every slot taken");
+
+  apvPdcCheck(apvSerialPdcTransmitQueue(&apvPdcCheckTransmit,
+                                        &transmitFrames[APV_SERIAL_PDC_TRANSMIT_FRAMES][0],
+                                        APV_PDC_CHECK_TRANSMIT_LENGTH,
+                                        true) == APV_SERIAL_ERROR_CODE_TRANSMITTER_NOT_READY,
+              "transmit fifth frame refused");
+
+  apvPdcCheck((apvPdcCheckTransmit.pdcTransmitFramesRejected == 1)                              &&
+              (apvPdcCheckTransmit.pdcTransmitCount          == APV_SERIAL_PDC_TRANSMIT_FRAMES) &&
+              (apvPdcCheckTransmit.pdcTransmitHead           == apvPdcCheckTransmit.pdcTransmitTail),
+              "transmit refused frame not queued");
+
+  // (iii) send the first frame : the PDC moves to the second and the third is chained behind it
+  sendLength = sendLength + apvPdcCheckSend(pdcChannel,
+                                            &sendCharacters[sendLength],
+                                            APV_PDC_CHECK_TRANSMIT_LENGTH);
+
+  apvPdcCheck(apvSerialPdcTransmitService(&apvPdcCheckTransmit,
+                                          false) == true,
+              "transmit busy after the first frame");
+
+  apvPdcCheck((pdcChannel->PERIPH_TPR  == (uintptr_t)&apvPdcCheckTransmit.pdcTransmitFrames[1][0]) &&
+              (pdcChannel->PERIPH_TCR  == (APV_PDC_CHECK_TRANSMIT_LENGTH + 1))                      &&
+              (pdcChannel->PERIPH_TNPR == (uintptr_t)&apvPdcCheckTransmit.pdcTransmitFrames[2][0]) &&
+              (pdcChannel->PERIPH_TNCR == (APV_PDC_CHECK_TRANSMIT_LENGTH + 2))                      &&
+              (apvPdcCheckTransmit.pdcTransmitFramesSent    == 1)                                   &&
+              (apvPdcCheckTransmit.pdcTransmitFramesChained == 2),
+              "transmit third frame chained into TNPR/TNCR");
+
+  apvPdcCheck(apvSerialPdcTransmitSpace(&apvPdcCheckTransmit) == true,
+              "transmit space after the first frame");
+
+  // (iv) refill the freed slot : it is slot 0 again
+  apvPdcCheck(apvSerialPdcTransmitQueue(&apvPdcCheckTransmit,
+                                        &transmitFrames[framesQueued][0],
+                                        APV_PDC_CHECK_TRANSMIT_LENGTH + framesQueued,
+                                        true) == APV_ERROR_CODE_NONE,
+              "transmit frame queued into the freed slot");
+
+  memcpy(&transmitExpected[transmitLength], &transmitFrames[framesQueued][0], APV_PDC_CHECK_TRANSMIT_LENGTH + framesQueued);
+  transmitLength = transmitLength + APV_PDC_CHECK_TRANSMIT_LENGTH + framesQueued;
+  framesQueued   = framesQueued   + 1;
+
+  // Send everything, one frame at a time with the "ENDTX" service after each
+  while (apvPdcCheckTransmit.pdcTransmitInPdc != 0)
+    {
+    sendLength = sendLength + apvPdcCheckSend(pdcChannel,
+                                              &sendCharacters[sendLength],
+                                              (uint16_t)pdcChannel->PERIPH_TCR);
+
+    apvSerialPdcTransmitService(&apvPdcCheckTransmit,
+                                false);
+    }
+
+  apvPdcCheck((pdcChannel->PERIPH_TCR  == 0)                                                    &&
+              (pdcChannel->PERIPH_TNCR == 0)                                                    &&
+              (apvPdcCheckTransmit.pdcTransmitCount         == 0)                               &&
+              (apvPdcCheckTransmit.pdcTransmitFramesSent    == framesQueued)                    &&
+              (apvPdcCheckTransmit.pdcTransmitFramesChained == (uint32_t)(framesQueued - 1)),
+              "transmit queue emptied with every frame chained");
+
+  apvPdcCheck((sendLength == transmitLength) && (memcmp(sendCharacters, transmitExpected, sendLength) == 0),
+              "transmit frames sent whole and in order");
+
+  apvPdcCheck(apvSerialPdcTransmitService(&apvPdcCheckTransmit,
+                                          false) == false,
+              "transmit idle with the queue empty");
+
+/******************************************************************************/
+  } /* end of apvPdcCheckTransmitChecks                                       */
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
@@ -0,0 +1,23 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* __armlib.h                                                                 */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : stands in for the Crossworks ARM library header. The         */
+/*   firmware uses nothing from it that the C library does not already have   */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef ____ARMLIB_H
+#define ____ARMLIB_H
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
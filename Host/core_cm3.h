@@ -0,0 +1,103 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* core_cm3.h                                                                 */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : stands in for the CMSIS Cortex-M3 core header. The NVIC,     */
+/*   "SysTick" and interrupt masking intrinsics are functions of the          */
+/*   simulated HAL ('ApvHostHal.c') and every one of them is an update point. */
+/*   The DWT cycle counter counts the virtual MCK cycles                      */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef __CORE_CM3_H_GENERIC
+#define __CORE_CM3_H_GENERIC
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define SysTick_CTRL_ENABLE_Msk           (1u << 0)
+#define SysTick_CTRL_TICKINT_Msk          (1u << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk        (1u << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk        (1u << 16)
+#define SysTick_LOAD_RELOAD_Msk           (0xffffffu)
+
+#define DWT_CTRL_CYCCNTENA_Msk            (1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk        (1u << 24)
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef struct
+  {
+  volatile uint32_t CTRL;
+  volatile uint32_t LOAD;
+  volatile uint32_t VAL;
+  volatile uint32_t CALIB;
+  } SysTick_Type;
+
+typedef struct
+  {
+  volatile uint32_t CTRL;
+  volatile uint32_t CYCCNT;
+  } DWT_Type;
+
+typedef struct
+  {
+  volatile uint32_t DHCSR;
+  volatile uint32_t DCRSR;
+  volatile uint32_t DCRDR;
+  volatile uint32_t DEMCR;
+  } CoreDebug_Type;
+
+/******************************************************************************/
+/* Core Peripheral Instances :                                                */
+/******************************************************************************/
+
+extern SysTick_Type   apvHostSysTick;
+extern DWT_Type       apvHostDwt;
+extern CoreDebug_Type apvHostCoreDebug;
+
+#define SysTick                           (&apvHostSysTick)
+#define DWT                               (&apvHostDwt)
+#define CoreDebug                         (&apvHostCoreDebug)
+
+/******************************************************************************/
+/* Function Declarations :                                                    */
+/******************************************************************************/
+
+extern void     NVIC_EnableIRQ(IRQn_Type IRQn);
+extern void     NVIC_DisableIRQ(IRQn_Type IRQn);
+extern void     NVIC_SetPendingIRQ(IRQn_Type IRQn);
+extern void     NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+extern uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn);
+extern void     NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+extern uint32_t NVIC_GetPriority(IRQn_Type IRQn);
+extern uint32_t SysTick_Config(uint32_t ticks);
+
+extern uint32_t __get_PRIMASK(void);
+extern void     __disable_irq(void);
+extern void     __enable_irq(void);
+extern void     __WFI(void);
+extern void     __NOP(void);
+extern void     __DSB(void);
+extern void     __ISB(void);
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
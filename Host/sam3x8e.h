@@ -0,0 +1,647 @@
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/
+/*                                                                            */
+/* sam3x8e.h                                                                  */
+/* 16.07.18                                                                   */
+/* Paul O'Brien                                                               */
+/*                                                                            */
+/* - HOST ONLY : stands in for the Atmel device header. The peripheral        */
+/*   register blocks keep the device layout but are ordinary variables owned  */
+/*   by the simulated HAL ('ApvHostHal.c'); the peripheral DMA registers are  */
+/*   pointer-width as in 'ApvSerialPdcModel.h'. Only the definitions the      */
+/*   firmware uses are here                                                   */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef _SAM3X8E_
+#define _SAM3X8E_
+
+/******************************************************************************/
+/* Include Files :                                                            */
+/******************************************************************************/
+
+#include <stdint.h>
+#include "ApvSerialPdcModel.h"
+
+/******************************************************************************/
+/* Definitions :                                                              */
+/******************************************************************************/
+
+#define __I                               volatile const
+#define __O                               volatile
+#define __IO                              volatile
+
+#define __NVIC_PRIO_BITS                  4
+
+#define TCCHANNEL_NUMBER                  3
+
+/******************************************************************************/
+/* Peripheral Identifiers :                                                   */
+/******************************************************************************/
+
+#define ID_SUPC                           0
+#define ID_RSTC                           1
+#define ID_RTC                            2
+#define ID_RTT                            3
+#define ID_WDT                            4
+#define ID_PMC                            5
+#define ID_EFC0                           6
+#define ID_EFC1                           7
+#define ID_UART                           8
+#define ID_SMC                            9
+#define ID_PIOA                           11
+#define ID_PIOB                           12
+#define ID_PIOC                           13
+#define ID_PIOD                           14
+#define ID_USART0                         17
+#define ID_USART1                         18
+#define ID_USART2                         19
+#define ID_USART3                         20
+#define ID_HSMCI                          21
+#define ID_TWI0                           22
+#define ID_TWI1                           23
+#define ID_SPI0                           24
+#define ID_SSC                            26
+#define ID_TC0                            27
+#define ID_TC1                            28
+#define ID_TC2                            29
+#define ID_TC3                            30
+#define ID_TC4                            31
+#define ID_TC5                            32
+#define ID_TC6                            33
+#define ID_TC7                            34
+#define ID_TC8                            35
+#define ID_PWM                            36
+#define ID_ADC                            37
+#define ID_DACC                           38
+#define ID_DMAC                           39
+#define ID_UOTGHS                         40
+#define ID_TRNG                           41
+#define ID_EMAC                           42
+#define ID_CAN0                           43
+#define ID_CAN1                           44
+
+/******************************************************************************/
+/* Type Definitions :                                                         */
+/******************************************************************************/
+
+typedef enum IRQn
+  {
+  NonMaskableInt_IRQn   = -14,
+  MemoryManagement_IRQn = -12,
+  BusFault_IRQn         = -11,
+  UsageFault_IRQn       = -10,
+  SVCall_IRQn           =  -5,
+  DebugMonitor_IRQn     =  -4,
+  PendSV_IRQn           =  -2,
+  SysTick_IRQn          =  -1,
+  SUPC_IRQn             =   0,
+  RSTC_IRQn             =   1,
+  RTC_IRQn              =   2,
+  RTT_IRQn              =   3,
+  WDT_IRQn              =   4,
+  PMC_IRQn              =   5,
+  EFC0_IRQn             =   6,
+  EFC1_IRQn             =   7,
+  UART_IRQn             =   8,
+  SMC_IRQn              =   9,
+  PIOA_IRQn             =  11,
+  PIOB_IRQn             =  12,
+  PIOC_IRQn             =  13,
+  PIOD_IRQn             =  14,
+  USART0_IRQn           =  17,
+  USART1_IRQn           =  18,
+  USART2_IRQn           =  19,
+  USART3_IRQn           =  20,
+  HSMCI_IRQn            =  21,
+  TWI0_IRQn             =  22,
+  TWI1_IRQn             =  23,
+  SPI0_IRQn             =  24,
+  SSC_IRQn              =  26,
+  TC0_IRQn              =  27,
+  TC1_IRQn              =  28,
+  TC2_IRQn              =  29,
+  TC3_IRQn              =  30,
+  TC4_IRQn              =  31,
+  TC5_IRQn              =  32,
+  TC6_IRQn              =  33,
+  TC7_IRQn              =  34,
+  TC8_IRQn              =  35,
+  PWM_IRQn              =  36,
+  ADC_IRQn              =  37,
+  DACC_IRQn             =  38,
+  DMAC_IRQn             =  39,
+  UOTGHS_IRQn           =  40,
+  TRNG_IRQn             =  41,
+  EMAC_IRQn             =  42,
+  CAN0_IRQn             =  43,
+  CAN1_IRQn             =  44,
+  PERIPH_COUNT_IRQn     =  45
+  } IRQn_Type;
+
+typedef struct
+  {
+  __O  uint32_t  UART_CR;
+  __IO uint32_t  UART_MR;
+  __O  uint32_t  UART_IER;
+  __O  uint32_t  UART_IDR;
+  __I  uint32_t  UART_IMR;
+  __I  uint32_t  UART_SR;
+  __I  uint32_t  UART_RHR;
+  __O  uint32_t  UART_THR;
+  __IO uint32_t  UART_BRGR;
+       uint32_t  Reserved1[55];
+  __IO uintptr_t UART_RPR;             // the PDC registers in 'Pdc' order
+  __IO uintptr_t UART_RCR;
+  __IO uintptr_t UART_TPR;
+  __IO uintptr_t UART_TCR;
+  __IO uintptr_t UART_RNPR;
+  __IO uintptr_t UART_RNCR;
+  __IO uintptr_t UART_TNPR;
+  __IO uintptr_t UART_TNCR;
+  __O  uintptr_t UART_PTCR;
+  __I  uintptr_t UART_PTSR;
+  } Uart;
+
+typedef struct
+  {
+  __O  uint32_t  US_CR;
+  __IO uint32_t  US_MR;
+  __O  uint32_t  US_IER;
+  __O  uint32_t  US_IDR;
+  __I  uint32_t  US_IMR;
+  __I  uint32_t  US_CSR;
+  __I  uint32_t  US_RHR;
+  __O  uint32_t  US_THR;
+  __IO uint32_t  US_BRGR;
+  __IO uint32_t  US_RTOR;
+  __IO uint32_t  US_TTGR;
+       uint32_t  Reserved1[5];
+  __IO uint32_t  US_FIDI;
+  __I  uint32_t  US_NER;
+       uint32_t  Reserved2[1];
+  __IO uint32_t  US_IF;
+  __IO uint32_t  US_MAN;
+  __IO uint32_t  US_LINMR;
+  __IO uint32_t  US_LINIR;
+       uint32_t  Reserved3[34];
+  __IO uint32_t  US_WPMR;
+  __I  uint32_t  US_WPSR;
+       uint32_t  Reserved4[5];
+  __IO uintptr_t US_RPR;               // the PDC registers in 'Pdc' order
+  __IO uintptr_t US_RCR;
+  __IO uintptr_t US_TPR;
+  __IO uintptr_t US_TCR;
+  __IO uintptr_t US_RNPR;
+  __IO uintptr_t US_RNCR;
+  __IO uintptr_t US_TNPR;
+  __IO uintptr_t US_TNCR;
+  __O  uintptr_t US_PTCR;
+  __I  uintptr_t US_PTSR;
+  } Usart;
+
+typedef struct
+  {
+  __O  uint32_t  TC_CCR;
+  __IO uint32_t  TC_CMR;
+  __IO uint32_t  TC_SMMR;
+       uint32_t  Reserved1[1];
+  __I  uint32_t  TC_CV;
+  __IO uint32_t  TC_RA;
+  __IO uint32_t  TC_RB;
+  __IO uint32_t  TC_RC;
+  __I  uint32_t  TC_SR;
+  __O  uint32_t  TC_IER;
+  __O  uint32_t  TC_IDR;
+  __I  uint32_t  TC_IMR;
+       uint32_t  Reserved2[4];
+  } TcChannel;
+
+typedef struct
+  {
+       TcChannel TC_CHANNEL[TCCHANNEL_NUMBER];
+  __O  uint32_t  TC_BCR;
+  __IO uint32_t  TC_BMR;
+  __O  uint32_t  TC_QIER;
+  __O  uint32_t  TC_QIDR;
+  __I  uint32_t  TC_QIMR;
+  __I  uint32_t  TC_QISR;
+  __IO uint32_t  TC_FMR;
+       uint32_t  Reserved1[2];
+  __IO uint32_t  TC_WPMR;
+  } Tc;
+
+typedef struct
+  {
+  __O  uint32_t  PMC_SCER;
+  __O  uint32_t  PMC_SCDR;
+  __I  uint32_t  PMC_SCSR;
+       uint32_t  Reserved1[1];
+  __O  uint32_t  PMC_PCER0;
+  __O  uint32_t  PMC_PCDR0;
+  __I  uint32_t  PMC_PCSR0;
+  __IO uint32_t  CKGR_UCKR;
+  __IO uint32_t  CKGR_MOR;
+  __I  uint32_t  CKGR_MCFR;
+  __IO uint32_t  CKGR_PLLAR;
+       uint32_t  Reserved2[1];
+  __IO uint32_t  PMC_MCKR;
+       uint32_t  Reserved3[1];
+  __IO uint32_t  PMC_USB;
+       uint32_t  Reserved4[1];
+  __IO uint32_t  PMC_PCK[3];
+       uint32_t  Reserved5[5];
+  __O  uint32_t  PMC_IER;
+  __O  uint32_t  PMC_IDR;
+  __I  uint32_t  PMC_SR;
+  __I  uint32_t  PMC_IMR;
+  __IO uint32_t  PMC_FSMR;
+  __IO uint32_t  PMC_FSPR;
+  __O  uint32_t  PMC_FOCR;
+       uint32_t  Reserved6[26];
+  __IO uint32_t  PMC_WPMR;
+  __I  uint32_t  PMC_WPSR;
+       uint32_t  Reserved7[5];
+  __O  uint32_t  PMC_PCER1;
+  __O  uint32_t  PMC_PCDR1;
+  __I  uint32_t  PMC_PCSR1;
+  __IO uint32_t  PMC_PCR;
+  } Pmc;
+
+typedef struct
+  {
+  __O  uint32_t  PIO_PER;
+  __O  uint32_t  PIO_PDR;
+  __I  uint32_t  PIO_PSR;
+       uint32_t  Reserved1[1];
+  __O  uint32_t  PIO_OER;
+  __O  uint32_t  PIO_ODR;
+  __I  uint32_t  PIO_OSR;
+       uint32_t  Reserved2[1];
+  __O  uint32_t  PIO_IFER;
+  __O  uint32_t  PIO_IFDR;
+  __I  uint32_t  PIO_IFSR;
+       uint32_t  Reserved3[1];
+  __O  uint32_t  PIO_SODR;
+  __O  uint32_t  PIO_CODR;
+  __IO uint32_t  PIO_ODSR;
+  __I  uint32_t  PIO_PDSR;
+  __O  uint32_t  PIO_IER;
+  __O  uint32_t  PIO_IDR;
+  __I  uint32_t  PIO_IMR;
+  __I  uint32_t  PIO_ISR;
+  __O  uint32_t  PIO_MDER;
+  __O  uint32_t  PIO_MDDR;
+  __I  uint32_t  PIO_MDSR;
+       uint32_t  Reserved4[1];
+  __O  uint32_t  PIO_PUDR;
+  __O  uint32_t  PIO_PUER;
+  __I  uint32_t  PIO_PUSR;
+       uint32_t  Reserved5[1];
+  __IO uint32_t  PIO_ABSR;
+  } Pio;
+
+typedef struct
+  {
+  __O  uint32_t  SPI_CR;
+  __IO uint32_t  SPI_MR;
+  __I  uint32_t  SPI_RDR;
+  __O  uint32_t  SPI_TDR;
+  __I  uint32_t  SPI_SR;
+  __O  uint32_t  SPI_IER;
+  __O  uint32_t  SPI_IDR;
+  __I  uint32_t  SPI_IMR;
+       uint32_t  Reserved1[4];
+  __IO uint32_t  SPI_CSR[4];
+  } Spi;
+
+typedef struct
+  {
+  __IO uint32_t  RTT_MR;
+  __IO uint32_t  RTT_AR;
+  __I  uint32_t  RTT_VR;
+  __I  uint32_t  RTT_SR;
+  } Rtt;
+
+/******************************************************************************/
+/* Peripheral Instances :                                                     */
+/******************************************************************************/
+
+extern Uart  apvHostUart;
+extern Usart apvHostUsart[4];
+extern Tc    apvHostTc[3];
+extern Pmc   apvHostPmc;
+extern Pio   apvHostPio[4];
+extern Spi   apvHostSpi;
+extern Rtt   apvHostRtt;
+
+#define UART                              (&apvHostUart)
+#define USART0                            (&apvHostUsart[0])
+#define USART1                            (&apvHostUsart[1])
+#define USART2                            (&apvHostUsart[2])
+#define USART3                            (&apvHostUsart[3])
+#define TC0                               (&apvHostTc[0])
+#define TC1                               (&apvHostTc[1])
+#define TC2                               (&apvHostTc[2])
+#define PMC                               (&apvHostPmc)
+#define PIOA                              (&apvHostPio[0])
+#define PIOB                              (&apvHostPio[1])
+#define PIOC                              (&apvHostPio[2])
+#define PIOD                              (&apvHostPio[3])
+#define SPI0                              (&apvHostSpi)
+#define RTT                               (&apvHostRtt)
+
+#define PDC_UART                          ((Pdc *)&apvHostUart.UART_RPR)
+#define PDC_USART0                        ((Pdc *)&apvHostUsart[0].US_RPR)
+#define PDC_USART1                        ((Pdc *)&apvHostUsart[1].US_RPR)
+#define PDC_USART2                        ((Pdc *)&apvHostUsart[2].US_RPR)
+#define PDC_USART3                        ((Pdc *)&apvHostUsart[3].US_RPR)
+
+/******************************************************************************/
+/* UART Register Fields :                                                     */
+/******************************************************************************/
+
+#define UART_CR_RSTRX                     (1u<<2)
+#define UART_CR_RSTTX                     (1u<<3)
+#define UART_CR_RXEN                      (1u<<4)
+#define UART_CR_RXDIS                     (1u<<5)
+#define UART_CR_TXEN                      (1u<<6)
+#define UART_CR_TXDIS                     (1u<<7)
+#define UART_CR_RSTSTA                    (1u<<8)
+#define UART_MR_PAR_Pos                   9
+#define UART_MR_CHMODE_Pos                14
+#define UART_SR_RXRDY                     (1u<<0)
+#define UART_SR_TXRDY                     (1u<<1)
+#define UART_SR_ENDRX                     (1u<<3)
+#define UART_SR_ENDTX                     (1u<<4)
+#define UART_SR_OVRE                      (1u<<5)
+#define UART_SR_FRAME                     (1u<<6)
+#define UART_SR_PARE                      (1u<<7)
+#define UART_SR_TXEMPTY                   (1u<<9)
+#define UART_SR_TXBUFE                    (1u<<11)
+#define UART_SR_RXBUFF                    (1u<<12)
+#define UART_IER_RXRDY                    UART_SR_RXRDY
+#define UART_IER_TXRDY                    UART_SR_TXRDY
+#define UART_IER_ENDRX                    UART_SR_ENDRX
+#define UART_IER_ENDTX                    UART_SR_ENDTX
+#define UART_IER_OVRE                     UART_SR_OVRE
+#define UART_IER_FRAME                    UART_SR_FRAME
+#define UART_IER_PARE                     UART_SR_PARE
+#define UART_IER_TXEMPTY                  UART_SR_TXEMPTY
+#define UART_IER_TXBUFE                   UART_SR_TXBUFE
+#define UART_IER_RXBUFF                   UART_SR_RXBUFF
+#define UART_IDR_RXRDY                    UART_SR_RXRDY
+#define UART_IDR_TXRDY                    UART_SR_TXRDY
+#define UART_IDR_ENDRX                    UART_SR_ENDRX
+#define UART_IDR_ENDTX                    UART_SR_ENDTX
+#define UART_IDR_OVRE                     UART_SR_OVRE
+#define UART_IDR_FRAME                    UART_SR_FRAME
+#define UART_IDR_PARE                     UART_SR_PARE
+#define UART_IDR_TXEMPTY                  UART_SR_TXEMPTY
+#define UART_IDR_TXBUFE                   UART_SR_TXBUFE
+#define UART_IDR_RXBUFF                   UART_SR_RXBUFF
+#define UART_IMR_ENDTX                    UART_SR_ENDTX
+#define UART_IMR_ENDRX                    UART_SR_ENDRX
+#define UART_PTCR_RXTEN                   (1u<<0)
+#define UART_PTCR_RXTDIS                  (1u<<1)
+#define UART_PTCR_TXTEN                   (1u<<8)
+#define UART_PTCR_TXTDIS                  (1u<<9)
+#define UART_BRGR_CD(v)                   ((0xffffu & (v)))
+
+/******************************************************************************/
+/* USART Register Fields :                                                    */
+/******************************************************************************/
+
+#define US_CR_RSTRX                       (1u<<2)
+#define US_CR_RSTTX                       (1u<<3)
+#define US_CR_RXEN                        (1u<<4)
+#define US_CR_RXDIS                       (1u<<5)
+#define US_CR_TXEN                        (1u<<6)
+#define US_CR_TXDIS                       (1u<<7)
+#define US_CR_RSTSTA                      (1u<<8)
+#define US_CR_STTTO                       (1u<<11)
+#define US_CR_RETTO                       (1u<<15)
+#define US_MR_CHRL_8_BIT                  (0x3u << 6)
+#define US_MR_PAR_NO                      (0x4u << 9)
+#define US_MR_NBSTOP_1_BIT                (0x0u << 12)
+#define US_MR_CHMODE_NORMAL               (0x0u << 14)
+#define US_MR_OVER                        (1u<<19)
+#define US_CSR_RXRDY                      (1u<<0)
+#define US_CSR_TXRDY                      (1u<<1)
+#define US_CSR_ENDRX                      (1u<<3)
+#define US_CSR_ENDTX                      (1u<<4)
+#define US_CSR_OVRE                       (1u<<5)
+#define US_CSR_FRAME                      (1u<<6)
+#define US_CSR_PARE                       (1u<<7)
+#define US_CSR_TIMEOUT                    (1u<<8)
+#define US_CSR_TXEMPTY                    (1u<<9)
+#define US_IER_RXRDY                      US_CSR_RXRDY
+#define US_IER_OVRE                       US_CSR_OVRE
+#define US_IER_FRAME                      US_CSR_FRAME
+#define US_IER_PARE                       US_CSR_PARE
+#define US_IER_TXRDY                      US_CSR_TXRDY
+#define US_IER_TIMEOUT                    US_CSR_TIMEOUT
+#define US_IDR_RXRDY                      US_CSR_RXRDY
+#define US_IDR_TXRDY                      US_CSR_TXRDY
+#define US_IDR_TIMEOUT                    US_CSR_TIMEOUT
+#define US_BRGR_CD_Pos                    0
+#define US_BRGR_CD_Msk                    (0xffffu << US_BRGR_CD_Pos)
+#define US_BRGR_CD(v)                     ((US_BRGR_CD_Msk & ((v) << US_BRGR_CD_Pos)))
+#define US_BRGR_FP_Pos                    16
+#define US_BRGR_FP_Msk                    (0x7u << US_BRGR_FP_Pos)
+#define US_BRGR_FP(v)                     ((US_BRGR_FP_Msk & ((v) << US_BRGR_FP_Pos)))
+#define US_RTOR_TO(v)                     ((0xffffu & (v)))
+#define US_PTCR_RXTEN                     (1u<<0)
+#define US_PTCR_RXTDIS                    (1u<<1)
+#define US_PTCR_TXTEN                     (1u<<8)
+#define US_PTCR_TXTDIS                    (1u<<9)
+
+/******************************************************************************/
+/* Timer Counter Register Fields :                                            */
+/******************************************************************************/
+
+#define TC_CCR_CLKEN                      (1u<<0)
+#define TC_CCR_CLKDIS                     (1u<<1)
+#define TC_CCR_SWTRG                      (1u<<2)
+#define TC_BCR_SYNC                       (1u<<0)
+#define TC_CMR_TCCLKS_TIMER_CLOCK1        (0x0u)
+#define TC_CMR_TCCLKS_TIMER_CLOCK2        (0x1u)
+#define TC_CMR_TCCLKS_TIMER_CLOCK3        (0x2u)
+#define TC_CMR_TCCLKS_TIMER_CLOCK4        (0x3u)
+#define TC_CMR_TCCLKS_TIMER_CLOCK5        (0x4u)
+#define TC_CMR_TCCLKS_XC0                 (0x5u)
+#define TC_CMR_TCCLKS_XC1                 (0x6u)
+#define TC_CMR_TCCLKS_XC2                 (0x7u)
+#define TC_CMR_TCCLKS_Msk                 (0x7u)
+#define TC_CMR_EEVT_XC0                   (0x1u << 10)
+#define TC_CMR_WAVE                       (1u<<15)
+#define TC_CMR_WAVSEL_UP                  (0x0u << 13)
+#define TC_CMR_WAVSEL_UP_RC               (0x2u << 13)
+#define TC_CMR_WAVSEL_Msk                 (0x3u << 13)
+#define TC_CMR_ACPA_SET                   (0x1u << 16)
+#define TC_CMR_ACPC_CLEAR                 (0x2u << 18)
+#define TC_CMR_ACPC_TOGGLE                (0x3u << 18)
+#define TC_BMR_TC0XC0S_TCLK0              (0x0u << 0)
+#define TC_BMR_TC0XC0S_TIOA1              (0x2u << 0)
+#define TC_BMR_TC0XC0S_TIOA2              (0x3u << 0)
+#define TC_BMR_TC1XC1S_TCLK1              (0x0u << 2)
+#define TC_BMR_TC1XC1S_TIOA0              (0x2u << 2)
+#define TC_BMR_TC1XC1S_TIOA2              (0x3u << 2)
+#define TC_BMR_TC2XC2S_TCLK2              (0x0u << 4)
+#define TC_BMR_TC2XC2S_TIOA0              (0x2u << 4)
+#define TC_BMR_TC2XC2S_TIOA1              (0x3u << 4)
+#define TC_IER_COVFS                      (1u<<0)
+#define TC_IER_CPAS                       (1u<<2)
+#define TC_IER_CPBS                       (1u<<3)
+#define TC_IER_CPCS                       (1u<<4)
+#define TC_IDR_COVFS                      (1u<<0)
+#define TC_IDR_CPBS                       (1u<<3)
+#define TC_IDR_CPCS                       (1u<<4)
+#define TC_SR_COVFS                       (1u<<0)
+#define TC_SR_CPAS                        (1u<<2)
+#define TC_SR_CPBS                        (1u<<3)
+#define TC_SR_CPCS                        (1u<<4)
+
+/******************************************************************************/
+/* RTT Register Fields :                                                      */
+/******************************************************************************/
+
+#define RTT_MR_ALMIEN                     (1u<<16)
+#define RTT_MR_RTTRST                     (1u<<18)
+
+/******************************************************************************/
+/* SPI Register Fields :                                                      */
+/******************************************************************************/
+
+#define SPI_CR_SPIEN                      (1u<<0)
+#define SPI_CR_SPIDIS                     (1u<<1)
+#define SPI_CR_SWRST                      (1u<<7)
+#define SPI_CR_LASTXFER                   (1u<<24)
+#define SPI_MR_MSTR                       (1u<<0)
+#define SPI_MR_PS                         (1u<<1)
+#define SPI_MR_PCSDEC                     (1u<<2)
+#define SPI_MR_MODFDIS                    (1u<<4)
+#define SPI_MR_WDRBT                      (1u<<5)
+#define SPI_MR_LLB                        (1u<<7)
+#define SPI_MR_PCS_Msk                    (0xfu << 16)
+#define SPI_MR_PCS(v)                     ((SPI_MR_PCS_Msk & ((v) << 16)))
+#define SPI_MR_DLYBCS(v)                  ((0xffu << 24) & ((v) << 24))
+#define SPI_TDR_PCS(v)                    ((0xfu << 16) & ((v) << 16))
+#define SPI_TDR_LASTXFER                  (1u<<24)
+#define SPI_IER_RDRF                      (1u<<0)
+#define SPI_IER_TDRE                      (1u<<1)
+#define SPI_IER_MODF                      (1u<<2)
+#define SPI_IER_OVRES                     (1u<<3)
+#define SPI_IER_NSSR                      (1u<<8)
+#define SPI_IER_TXEMPTY                   (1u<<9)
+#define SPI_IER_UNDES                     (1u<<10)
+#define SPI_IDR_RDRF                      SPI_IER_RDRF
+#define SPI_IDR_TDRE                      SPI_IER_TDRE
+#define SPI_IDR_MODF                      SPI_IER_MODF
+#define SPI_IDR_OVRES                     SPI_IER_OVRES
+#define SPI_IDR_NSSR                      SPI_IER_NSSR
+#define SPI_IDR_TXEMPTY                   SPI_IER_TXEMPTY
+#define SPI_IDR_UNDES                     SPI_IER_UNDES
+#define SPI_CSR_CPOL                      (1u<<0)
+#define SPI_CSR_NCPHA                     (1u<<1)
+#define SPI_CSR_CSNAAT                    (1u<<2)
+#define SPI_CSR_CSAAT                     (1u<<3)
+#define SPI_CSR_BITS_Pos                  4
+#define SPI_CSR_SCBR(v)                   ((0xffu << 8) & ((v) << 8))
+#define SPI_CSR_DLYBS(v)                  ((0xffu << 16) & ((v) << 16))
+#define SPI_CSR_DLYBCT(v)                 ((0xffu << 24) & ((v) << 24))
+
+/******************************************************************************/
+/* PIO Register Fields :                                                      */
+/******************************************************************************/
+
+#define PIO_P(n)                          (1u << (n))
+#define PIO_ABSR_P21                      PIO_P(21)
+#define PIO_ABSR_P25                      PIO_P(25)
+#define PIO_ABSR_P26                      PIO_P(26)
+#define PIO_ABSR_P27                      PIO_P(27)
+#define PIO_ABSR_P28                      PIO_P(28)
+#define PIO_ABSR_P29                      PIO_P(29)
+#define PIO_CODR_P3                       PIO_P(3)
+#define PIO_CODR_P31                      PIO_P(31)
+#define PIO_ODR_P3                        PIO_P(3)
+#define PIO_OER_P3                        PIO_P(3)
+#define PIO_PDR_P21                       PIO_P(21)
+#define PIO_PDR_P25                       PIO_P(25)
+#define PIO_PDR_P26                       PIO_P(26)
+#define PIO_PDR_P27                       PIO_P(27)
+#define PIO_PDR_P28                       PIO_P(28)
+#define PIO_PDR_P29                       PIO_P(29)
+#define PIO_PDR_P3                        PIO_P(3)
+#define PIO_PDR_P8                        PIO_P(8)
+#define PIO_PDR_P9                        PIO_P(9)
+#define PIO_PER_P3                        PIO_P(3)
+#define PIO_PSR_P3                        PIO_P(3)
+#define PIO_PUER_P3                       PIO_P(3)
+#define PIO_PUER_P8                       PIO_P(8)
+#define PIO_PUER_P9                       PIO_P(9)
+#define PIO_PDR_P4                        PIO_P(4)
+#define PIO_PUER_P4                       PIO_P(4)
+#define PIO_ABSR_P4                       PIO_P(4)
+#define PIO_PER_P4                        PIO_P(4)
+#define PIO_PDR_P5                        PIO_P(5)
+#define PIO_PUER_P5                       PIO_P(5)
+#define PIO_ABSR_P5                       PIO_P(5)
+#define PIO_PER_P5                        PIO_P(5)
+#define PIO_PDR_P10                       PIO_P(10)
+#define PIO_PUER_P10                      PIO_P(10)
+#define PIO_ABSR_P10                      PIO_P(10)
+#define PIO_PER_P10                       PIO_P(10)
+#define PIO_PDR_P11                       PIO_P(11)
+#define PIO_PUER_P11                      PIO_P(11)
+#define PIO_ABSR_P11                      PIO_P(11)
+#define PIO_PER_P11                       PIO_P(11)
+#define PIO_PDR_P12                       PIO_P(12)
+#define PIO_PUER_P12                      PIO_P(12)
+#define PIO_ABSR_P12                      PIO_P(12)
+#define PIO_PER_P12                       PIO_P(12)
+#define PIO_PDR_P13                       PIO_P(13)
+#define PIO_PUER_P13                      PIO_P(13)
+#define PIO_ABSR_P13                      PIO_P(13)
+#define PIO_PER_P13                       PIO_P(13)
+#define PIO_PDR_P20                       PIO_P(20)
+#define PIO_PUER_P20                      PIO_P(20)
+#define PIO_ABSR_P20                      PIO_P(20)
+#define PIO_PER_P20                       PIO_P(20)
+#define PIO_PUER_P21                      PIO_P(21)
+#define PIO_PER_P21                       PIO_P(21)
+
+/******************************************************************************/
+/* Interrupt Handlers : the firmware supplies these                           */
+/******************************************************************************/
+
+extern void SysTick_Handler(void);
+extern void RTT_Handler(void);
+extern void UART_Handler(void);
+extern void USART0_Handler(void);
+extern void USART1_Handler(void);
+extern void USART2_Handler(void);
+extern void USART3_Handler(void);
+extern void SPI0_Handler(void);
+extern void TC0_Handler(void);
+extern void TC1_Handler(void);
+extern void TC2_Handler(void);
+extern void TC3_Handler(void);
+extern void TC4_Handler(void);
+extern void TC5_Handler(void);
+extern void TC6_Handler(void);
+extern void TC7_Handler(void);
+extern void TC8_Handler(void);
+
+/******************************************************************************/
+
+#include "core_cm3.h"
+
+/******************************************************************************/
+
+#endif
+
+/******************************************************************************/
+/* (C) PulsingCoreSoftware Limited 2018 (C)                                   */
+/******************************************************************************/